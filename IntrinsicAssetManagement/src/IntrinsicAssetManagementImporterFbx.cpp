@@ -36,6 +36,13 @@ namespace
 {
 FbxManager* _fbxManager = nullptr;
 
+// Each LOD halves the triangle count of the previous one and is used if the
+// mesh covers less than the given fraction of the viewport
+const uint32_t _lodCount = 4u;
+const float _lodScreenSizes[_lodCount - 1u] = {0.02f, 0.008f, 0.003f};
+const float _lodMaxError = 0.05f;
+const uint32_t _minTriangleCountForLods = 256u;
+
 void stripDuplicateVertices(Dod::Ref p_MeshRef)
 {
   const uint32_t subMeshCount =
@@ -153,6 +160,73 @@ void stripDuplicateVertices(Dod::Ref p_MeshRef)
   }
 }
 
+void generateLods(Dod::Ref p_MeshRef)
+{
+  const IndicesPerSubMeshArray& indicesPerSubMesh =
+      MeshManager::_descIndicesPerSubMesh(p_MeshRef);
+  const uint32_t subMeshCount = (uint32_t)indicesPerSubMesh.size();
+
+  LodIndicesPerSubMeshArray& lodIndicesPerSubMesh =
+      MeshManager::_descLodIndicesPerSubMesh(p_MeshRef);
+  lodIndicesPerSubMesh.resize(subMeshCount);
+
+  uint32_t triangleCount = 0u;
+  for (uint32_t subMeshIdx = 0u; subMeshIdx < subMeshCount; ++subMeshIdx)
+  {
+    triangleCount += (uint32_t)indicesPerSubMesh[subMeshIdx].size() / 3u;
+  }
+
+  if (triangleCount < _minTriangleCountForLods)
+  {
+    _INTR_LOG_INFO("Mesh too simple, skipping LOD generation...");
+    return;
+  }
+
+  _INTR_LOG_INFO("Generating %u LODs for %u sub meshes...", _lodCount - 1u,
+                 subMeshCount);
+
+  MeshManager::_descLodScreenSizes(p_MeshRef)
+      .assign(_lodScreenSizes, _lodScreenSizes + _lodCount - 1u);
+
+  _INTR_ARRAY(uint32_t) simplifiedIndices;
+
+  for (uint32_t subMeshIdx = 0u; subMeshIdx < subMeshCount; ++subMeshIdx)
+  {
+    const _INTR_ARRAY(glm::vec3)& positions =
+        MeshManager::_descPositionsPerSubMesh(p_MeshRef)[subMeshIdx];
+    lodIndicesPerSubMesh[subMeshIdx].resize(_lodCount - 1u);
+
+    for (uint32_t lodIdx = 1u; lodIdx < _lodCount; ++lodIdx)
+    {
+      // Simplify the previous LOD
+      const _INTR_ARRAY(uint32_t)& sourceIndices =
+          lodIdx == 1u ? indicesPerSubMesh[subMeshIdx]
+                       : lodIndicesPerSubMesh[subMeshIdx][lodIdx - 2u];
+      const uint32_t targetIndexCount =
+          (uint32_t)sourceIndices.size() / 6u * 3u;
+
+      simplifiedIndices.resize(sourceIndices.size());
+      const uint32_t indexCount = MeshSimplifier::simplify(
+          positions.data(), (uint32_t)positions.size(), sourceIndices.data(),
+          (uint32_t)sourceIndices.size(), targetIndexCount, _lodMaxError,
+          simplifiedIndices.data());
+
+      // Cache-optimize faces
+      _INTR_ARRAY(uint32_t)& lodIndices =
+          lodIndicesPerSubMesh[subMeshIdx][lodIdx - 1u];
+      lodIndices.resize(indexCount);
+      TriangleOptimizer::optimizeFaces(simplifiedIndices.data(), indexCount,
+                                       (uint32_t)positions.size(),
+                                       lodIndices.data(), 32u);
+
+      _INTR_LOG_INFO("LOD #%u of sub mesh #%u: %u triangles", lodIdx,
+                     subMeshIdx, indexCount / 3u);
+    }
+  }
+}
+
+// <-
+
 void importMesh(FbxMesh* p_Mesh, _INTR_ARRAY(MeshRef) & p_ImportedMeshes)
 {
   const char* meshName = p_Mesh->GetNode()->GetName();
@@ -424,6 +498,7 @@ void importMesh(FbxMesh* p_Mesh, _INTR_ARRAY(MeshRef) & p_ImportedMeshes)
   }
 
   stripDuplicateVertices(meshRef);
+  generateLods(meshRef);
   p_ImportedMeshes.push_back(meshRef);
 }
 
@@ -45,7 +45,8 @@ void Physics::createPhysicsTriangleMeshes(
 
     const _INTR_STRING meshFilePath =
         "media/physics_meshes/" +
-        CResources::MeshManager::_name(meshRef).getString() + ".pm";
+        _INTR_STRING(CResources::MeshManager::_name(meshRef).getString()) +
+        ".pm";
 
     physx::PxTriangleMeshDesc meshDesc;
     meshDesc.points.count =
@@ -72,7 +73,7 @@ void Physics::createPhysicsTriangleMeshes(
     {
       _INTR_LOG_WARNING(
           "Failed to cook physics triangle mesh for mesh \"%s\"!",
-          CResources::MeshManager::_name(meshRef).getString().c_str());
+          CResources::MeshManager::_name(meshRef).c_str());
       std::remove(meshFilePath.c_str());
     }
   }
@@ -89,7 +90,8 @@ void Physics::createPhysicsConvexMeshes(
 
     const _INTR_STRING convexMeshFilePath =
         "media/physics_meshes/" +
-        CResources::MeshManager::_name(meshRef).getString() + ".pcm";
+        _INTR_STRING(CResources::MeshManager::_name(meshRef).getString()) +
+        ".pcm";
 
     physx::PxConvexMeshDesc convexMeshDesc;
     convexMeshDesc.flags |= physx::PxConvexFlag::eCOMPUTE_CONVEX;
@@ -114,7 +116,7 @@ void Physics::createPhysicsConvexMeshes(
       _INTR_LOG_WARNING(
           "Failed to cook physics convex mesh for mesh \"%s\"! Trying to "
           "generate a convex hull from the AABB...",
-          CResources::MeshManager::_name(meshRef).getString().c_str());
+          CResources::MeshManager::_name(meshRef).c_str());
       std::remove(convexMeshFilePath.c_str());
 
       CResources::AABBPerSubMeshArray& aabbs =
@@ -144,7 +146,7 @@ void Physics::createPhysicsConvexMeshes(
       {
         _INTR_LOG_WARNING(
             "Failed to cook physics convex mesh from AABB for mesh \"%s\"!",
-            CResources::MeshManager::_name(meshRef).getString().c_str());
+            CResources::MeshManager::_name(meshRef).c_str());
         std::remove(convexMeshFilePath.c_str());
       }
     }
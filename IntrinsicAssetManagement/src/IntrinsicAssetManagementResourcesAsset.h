@@ -49,15 +49,15 @@ enum Enum
 
 struct AssetData : Dod::Resources::ResourceDataBase
 {
-  AssetData() : Dod::Resources::ResourceDataBase(_INTR_MAX_ASSET_COUNT)
+  AssetData()
   {
-    descAssetFileName.resize(_INTR_MAX_ASSET_COUNT);
-    descAssetType.resize(_INTR_MAX_ASSET_COUNT);
+    registerArray(descAssetFileName);
+    registerArray(descAssetType);
   }
 
   // Description
-  _INTR_ARRAY(_INTR_STRING) descAssetFileName;
-  _INTR_ARRAY(AssetType::Enum) descAssetType;
+  _INTR_PAGED_ARRAY(_INTR_STRING) descAssetFileName;
+  _INTR_PAGED_ARRAY(AssetType::Enum) descAssetType;
 };
 
 struct AssetManager
@@ -14,6 +14,10 @@
 
 #pragma once
 
+#define _INTR_RADIX_SORT_DIGIT_COUNT 8u
+#define _INTR_RADIX_SORT_BUCKET_COUNT 256u
+#define _INTR_RADIX_SORT_MIN_PARTITION_SIZE 2048u
+
 namespace Intrinsic
 {
 namespace Core
@@ -71,9 +75,9 @@ _INTR_INLINE void parallelSort(_INTR_ARRAY(Type) & p_Array,
     uint32_t _end;
   };
 
-  _INTR_ARRAY(MergeTaskSet) mergeTaskSets;
+  _INTR_FRAME_ARRAY(MergeTaskSet) mergeTaskSets;
   mergeTaskSets.resize(partitionCount);
-  _INTR_ARRAY(SortTaskSet) sortTaskSets;
+  _INTR_FRAME_ARRAY(SortTaskSet) sortTaskSets;
   sortTaskSets.resize(partitionCount);
 
   uint32_t actualPartCount = 0u;
@@ -156,6 +160,265 @@ _INTR_INLINE void parallelSort(_INTR_ARRAY(Type) & p_Array,
     }
   }
 }
+
+// <-
+
+template <class Type> struct RadixSortEntry
+{
+  uint64_t key;
+  Type value;
+};
+
+/**
+ * Sorts the array in ascending order of the 64-bit keys returned by the key
+ * function using a parallel least significant digit radix sort with 8-bit
+ * digits. The sort is stable and skips the digits shared by all keys.
+ */
+template <class ArrayType, class KeyFunctionType>
+_INTR_INLINE void parallelRadixSort(ArrayType& p_Array,
+                                    const KeyFunctionType& p_KeyFunction)
+{
+  typedef typename ArrayType::value_type Type;
+  typedef RadixSortEntry<Type> Entry;
+
+  const uint32_t elementCount = (uint32_t)p_Array.size();
+  if (elementCount < 2u)
+  {
+    return;
+  }
+
+  const uint32_t partitionCount =
+      std::max(std::min(Application::_scheduler.GetNumTaskThreads(),
+                        elementCount / _INTR_RADIX_SORT_MIN_PARTITION_SIZE),
+               1u);
+  const uint32_t elementsPerPart =
+      (elementCount + partitionCount - 1u) / partitionCount;
+  const uint32_t histogramSize =
+      _INTR_RADIX_SORT_DIGIT_COUNT * _INTR_RADIX_SORT_BUCKET_COUNT;
+
+  // Per partition histograms of all digits and bucket offsets of the current
+  // digit
+  _INTR_FRAME_ARRAY(uint32_t) histograms;
+  histograms.resize(partitionCount * histogramSize);
+  _INTR_FRAME_ARRAY(uint32_t) offsets;
+  offsets.resize(partitionCount * _INTR_RADIX_SORT_BUCKET_COUNT);
+
+  _INTR_FRAME_ARRAY(Entry) entries;
+  entries.resize(elementCount);
+  _INTR_FRAME_ARRAY(Entry) scratch;
+  scratch.resize(elementCount);
+
+  struct KeyTaskSet : enki::ITaskSet
+  {
+    virtual ~KeyTaskSet() {}
+
+    void ExecuteRange(enki::TaskSetPartition p_Range,
+                      uint32_t p_ThreadNum) override
+    {
+      _INTR_PROFILE_CPU("General", "Radix Sort Key Job");
+
+      for (uint32_t partIdx = p_Range.start; partIdx < p_Range.end; ++partIdx)
+      {
+        uint32_t* histogram = &(*_histograms)[partIdx * _histogramSize];
+        memset(histogram, 0x00, _histogramSize * sizeof(uint32_t));
+
+        const uint32_t start = partIdx * _elementsPerPart;
+        const uint32_t end =
+            std::min(start + _elementsPerPart, (uint32_t)_array->size());
+
+        for (uint32_t i = start; i < end; ++i)
+        {
+          Entry& entry = (*_entries)[i];
+          entry.value = (*_array)[i];
+          entry.key = (*_keyFunction)(entry.value);
+
+          for (uint32_t digitIdx = 0u; digitIdx < _INTR_RADIX_SORT_DIGIT_COUNT;
+               ++digitIdx)
+          {
+            ++histogram[digitIdx * _INTR_RADIX_SORT_BUCKET_COUNT +
+                        ((entry.key >> (digitIdx * 8u)) & 0xFFu)];
+          }
+        }
+      }
+    };
+
+    const KeyFunctionType* _keyFunction;
+    const ArrayType* _array;
+    _INTR_FRAME_ARRAY(Entry) * _entries;
+    _INTR_FRAME_ARRAY(uint32_t) * _histograms;
+    uint32_t _elementsPerPart;
+    uint32_t _histogramSize;
+  };
+
+  struct HistogramTaskSet : enki::ITaskSet
+  {
+    virtual ~HistogramTaskSet() {}
+
+    void ExecuteRange(enki::TaskSetPartition p_Range,
+                      uint32_t p_ThreadNum) override
+    {
+      _INTR_PROFILE_CPU("General", "Radix Sort Histogram Job");
+
+      for (uint32_t partIdx = p_Range.start; partIdx < p_Range.end; ++partIdx)
+      {
+        uint32_t* histogram =
+            &(*_histograms)[partIdx * _histogramSize +
+                            _digitIdx * _INTR_RADIX_SORT_BUCKET_COUNT];
+        memset(histogram, 0x00,
+               _INTR_RADIX_SORT_BUCKET_COUNT * sizeof(uint32_t));
+
+        const uint32_t start = partIdx * _elementsPerPart;
+        const uint32_t end =
+            std::min(start + _elementsPerPart, (uint32_t)_entries->size());
+
+        for (uint32_t i = start; i < end; ++i)
+        {
+          ++histogram[((*_entries)[i].key >> (_digitIdx * 8u)) & 0xFFu];
+        }
+      }
+    };
+
+    const _INTR_FRAME_ARRAY(Entry) * _entries;
+    _INTR_FRAME_ARRAY(uint32_t) * _histograms;
+    uint32_t _elementsPerPart;
+    uint32_t _histogramSize;
+    uint32_t _digitIdx;
+  };
+
+  struct ScatterTaskSet : enki::ITaskSet
+  {
+    virtual ~ScatterTaskSet() {}
+
+    void ExecuteRange(enki::TaskSetPartition p_Range,
+                      uint32_t p_ThreadNum) override
+    {
+      _INTR_PROFILE_CPU("General", "Radix Sort Scatter Job");
+
+      for (uint32_t partIdx = p_Range.start; partIdx < p_Range.end; ++partIdx)
+      {
+        uint32_t* offsets =
+            &(*_offsets)[partIdx * _INTR_RADIX_SORT_BUCKET_COUNT];
+
+        const uint32_t start = partIdx * _elementsPerPart;
+        const uint32_t end =
+            std::min(start + _elementsPerPart, (uint32_t)_source->size());
+
+        for (uint32_t i = start; i < end; ++i)
+        {
+          const Entry& entry = (*_source)[i];
+          (*_destination)[offsets[(entry.key >> (_digitIdx * 8u)) & 0xFFu]++] =
+              entry;
+        }
+      }
+    };
+
+    const _INTR_FRAME_ARRAY(Entry) * _source;
+    _INTR_FRAME_ARRAY(Entry) * _destination;
+    _INTR_FRAME_ARRAY(uint32_t) * _offsets;
+    uint32_t _elementsPerPart;
+    uint32_t _digitIdx;
+  };
+
+  // Fetch the keys and compute the histograms of all digits
+  {
+    KeyTaskSet taskSet;
+    taskSet._keyFunction = &p_KeyFunction;
+    taskSet._array = &p_Array;
+    taskSet._entries = &entries;
+    taskSet._histograms = &histograms;
+    taskSet._elementsPerPart = elementsPerPart;
+    taskSet._histogramSize = histogramSize;
+    taskSet.m_SetSize = partitionCount;
+
+    Application::_scheduler.AddTaskSetToPipe(&taskSet);
+    Application::_scheduler.WaitforTaskSet(&taskSet);
+  }
+
+  // The histograms of the unsorted array stay valid for the first pass
+  bool histogramsValid = true;
+
+  for (uint32_t digitIdx = 0u; digitIdx < _INTR_RADIX_SORT_DIGIT_COUNT;
+       ++digitIdx)
+  {
+    const uint32_t histogramOffset = digitIdx * _INTR_RADIX_SORT_BUCKET_COUNT;
+
+    // Skip digits shared by all keys
+    {
+      bool sharedDigit = false;
+      for (uint32_t bucketIdx = 0u; bucketIdx < _INTR_RADIX_SORT_BUCKET_COUNT;
+           ++bucketIdx)
+      {
+        uint32_t bucketSize = 0u;
+        for (uint32_t partIdx = 0u; partIdx < partitionCount; ++partIdx)
+        {
+          bucketSize += histograms[partIdx * histogramSize + histogramOffset +
+                                   bucketIdx];
+        }
+
+        if (bucketSize != 0u)
+        {
+          sharedDigit = bucketSize == elementCount;
+          break;
+        }
+      }
+
+      if (sharedDigit)
+      {
+        continue;
+      }
+    }
+
+    if (!histogramsValid)
+    {
+      HistogramTaskSet taskSet;
+      taskSet._entries = &entries;
+      taskSet._histograms = &histograms;
+      taskSet._elementsPerPart = elementsPerPart;
+      taskSet._histogramSize = histogramSize;
+      taskSet._digitIdx = digitIdx;
+      taskSet.m_SetSize = partitionCount;
+
+      Application::_scheduler.AddTaskSetToPipe(&taskSet);
+      Application::_scheduler.WaitforTaskSet(&taskSet);
+    }
+
+    // Partitions write to consecutive ranges of each bucket to keep the sort
+    // stable
+    uint32_t currentOffset = 0u;
+    for (uint32_t bucketIdx = 0u; bucketIdx < _INTR_RADIX_SORT_BUCKET_COUNT;
+         ++bucketIdx)
+    {
+      for (uint32_t partIdx = 0u; partIdx < partitionCount; ++partIdx)
+      {
+        offsets[partIdx * _INTR_RADIX_SORT_BUCKET_COUNT + bucketIdx] =
+            currentOffset;
+        currentOffset += histograms[partIdx * histogramSize + histogramOffset +
+                                    bucketIdx];
+      }
+    }
+
+    {
+      ScatterTaskSet taskSet;
+      taskSet._source = &entries;
+      taskSet._destination = &scratch;
+      taskSet._offsets = &offsets;
+      taskSet._elementsPerPart = elementsPerPart;
+      taskSet._digitIdx = digitIdx;
+      taskSet.m_SetSize = partitionCount;
+
+      Application::_scheduler.AddTaskSetToPipe(&taskSet);
+      Application::_scheduler.WaitforTaskSet(&taskSet);
+    }
+
+    entries.swap(scratch);
+    histogramsValid = false;
+  }
+
+  for (uint32_t i = 0u; i < elementCount; ++i)
+  {
+    p_Array[i] = entries[i].value;
+  }
+}
 }
 }
 }
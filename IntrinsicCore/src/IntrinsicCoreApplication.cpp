@@ -40,6 +40,9 @@ bool Application::_running = true;
 
 void Application::init(void* p_PlatformHandle, void* p_PlatformWindow)
 {
+  // Memory
+  Memory::FrameAllocator::init();
+
   // Initializes physics
   Physics::System::init();
 
@@ -49,6 +52,14 @@ void Application::init(void* p_PlatformHandle, void* p_PlatformWindow)
   // Initializes managers
   initManagers();
 
+  // Frame tasks
+  TaskManager::init();
+
+  if (Settings::Manager::_runMicroBenchmarks)
+  {
+    MicroBenchmarks::runAll();
+  }
+
   // Initializes renderer
   R::RenderSystem::init(p_PlatformHandle, p_PlatformWindow);
 
@@ -142,6 +153,14 @@ void Application::initEventSystem()
   Input::System::init();
 }
 
-void Application::shutdown() { _running = false; }
+void Application::shutdown()
+{
+  _running = false;
+
+  Memory::Tlsf::MainAllocator::logStats();
+  _INTR_LOG_INFO("Frame allocator high-water mark: %.2f MB",
+                 Memory::FrameAllocator::getHighWaterMark() /
+                     (1024.0f * 1024.0f));
+}
 }
 }
@@ -31,27 +31,26 @@ typedef _INTR_ARRAY(CameraRef) CameraRefArray;
 struct CameraData : Dod::Components::ComponentDataBase
 {
   CameraData()
-      : Dod::Components::ComponentDataBase(_INTR_MAX_CAMERA_COMPONENT_COUNT)
   {
-    descFov.resize(_INTR_MAX_CAMERA_COMPONENT_COUNT);
-    descNearPlane.resize(_INTR_MAX_CAMERA_COMPONENT_COUNT);
-    descFarPlane.resize(_INTR_MAX_CAMERA_COMPONENT_COUNT);
+    registerArray(descFov);
+    registerArray(descNearPlane);
+    registerArray(descFarPlane);
 
-    frustum.resize(_INTR_MAX_CAMERA_COMPONENT_COUNT);
+    registerArray(frustum);
 
-    forward.resize(_INTR_MAX_CAMERA_COMPONENT_COUNT);
-    up.resize(_INTR_MAX_CAMERA_COMPONENT_COUNT);
+    registerArray(forward);
+    registerArray(up);
   }
 
   // Description
-  _INTR_ARRAY(float) descFov;
-  _INTR_ARRAY(float) descNearPlane;
-  _INTR_ARRAY(float) descFarPlane;
+  _INTR_PAGED_ARRAY(float) descFov;
+  _INTR_PAGED_ARRAY(float) descNearPlane;
+  _INTR_PAGED_ARRAY(float) descFarPlane;
 
   // Resources
-  _INTR_ARRAY(Resources::FrustumRef) frustum;
-  _INTR_ARRAY(glm::vec3) forward;
-  _INTR_ARRAY(glm::vec3) up;
+  _INTR_PAGED_ARRAY(Resources::FrustumRef) frustum;
+  _INTR_PAGED_ARRAY(glm::vec3) forward;
+  _INTR_PAGED_ARRAY(glm::vec3) up;
 };
 
 /**
@@ -200,7 +200,7 @@ void updateThirdPersonCamera(CameraControllerRef p_Ref, float p_DeltaT)
   camPosition =
       glm::mix(camPosition, worldCamTargetPosition, movementSpeed * p_DeltaT);
 
-  NodeManager::updateTransforms(cameraNodeRef);
+  NodeManager::markTransformsDirty(cameraNodeRef);
 
   lastTargetEulerAngles = targetEulerAngles;
 }
@@ -251,7 +251,7 @@ void updateFirstPersonCamera(CameraControllerRef p_Ref, float p_DeltaT)
       glm::slerp(NodeManager::_orientation(cameraNodeRef),
                  glm::quat(targetEulerAngles), rotationSpeed * p_DeltaT);
 
-  NodeManager::updateTransforms(cameraNodeRef);
+  NodeManager::markTransformsDirty(cameraNodeRef);
 }
 
 // <-
@@ -46,27 +46,23 @@ enum Enum
 struct CameraControllerData : Dod::Components::ComponentDataBase
 {
   CameraControllerData()
-      : Dod::Components::ComponentDataBase(
-            _INTR_MAX_CAMERA_CONTROLLER_COMPONENT_COUNT)
   {
-    descTargetObjectName.resize(_INTR_MAX_CAMERA_CONTROLLER_COMPONENT_COUNT);
-    descCameraControllerType.resize(
-        _INTR_MAX_CAMERA_CONTROLLER_COMPONENT_COUNT);
-    descTargetEulerAngles.resize(_INTR_MAX_CAMERA_CONTROLLER_COMPONENT_COUNT);
-
-    lastTargetEulerAngles.resize(_INTR_MAX_CAMERA_CONTROLLER_COMPONENT_COUNT);
-    timeSinceLastOrientationChange.resize(
-        _INTR_MAX_CAMERA_CONTROLLER_COMPONENT_COUNT);
+    registerArray(descTargetObjectName);
+    registerArray(descCameraControllerType);
+    registerArray(descTargetEulerAngles);
+
+    registerArray(lastTargetEulerAngles);
+    registerArray(timeSinceLastOrientationChange);
   }
 
   // Description
-  _INTR_ARRAY(Name) descTargetObjectName;
-  _INTR_ARRAY(CameraControllerType::Enum) descCameraControllerType;
-  _INTR_ARRAY(glm::vec3) descTargetEulerAngles;
+  _INTR_PAGED_ARRAY(Name) descTargetObjectName;
+  _INTR_PAGED_ARRAY(CameraControllerType::Enum) descCameraControllerType;
+  _INTR_PAGED_ARRAY(glm::vec3) descTargetEulerAngles;
 
   // Resources
-  _INTR_ARRAY(glm::vec3) lastTargetEulerAngles;
-  _INTR_ARRAY(float) timeSinceLastOrientationChange;
+  _INTR_PAGED_ARRAY(glm::vec3) lastTargetEulerAngles;
+  _INTR_PAGED_ARRAY(float) timeSinceLastOrientationChange;
 };
 
 /**
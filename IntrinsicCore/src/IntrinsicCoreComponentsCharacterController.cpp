@@ -197,7 +197,7 @@ void CharacterControllerManager::updateControllers(
                      glm::clamp(p_DeltaT / 0.1f, 0.0f, 1.0f));
     }
 
-    NodeManager::updateTransforms(nodeRef);
+    NodeManager::markTransformsDirty(nodeRef);
   }
 }
 
@@ -43,20 +43,18 @@ enum Flags
 struct CharacterControllerData : Dod::Components::ComponentDataBase
 {
   CharacterControllerData()
-      : Dod::Components::ComponentDataBase(
-            _INTR_MAX_CHARACTER_CONTROLLER_COMPONENT_COUNT)
   {
-    pxController.resize(_INTR_MAX_CHARACTER_CONTROLLER_COMPONENT_COUNT);
-    internalMoveVector.resize(_INTR_MAX_CHARACTER_CONTROLLER_COMPONENT_COUNT);
-    currentMoveVector.resize(_INTR_MAX_CHARACTER_CONTROLLER_COMPONENT_COUNT);
-    lastCollisionFlags.resize(_INTR_MAX_CHARACTER_CONTROLLER_COMPONENT_COUNT);
+    registerArray(pxController);
+    registerArray(internalMoveVector);
+    registerArray(currentMoveVector);
+    registerArray(lastCollisionFlags);
   }
 
   // Resources
-  _INTR_ARRAY(glm::vec3) internalMoveVector;
-  _INTR_ARRAY(glm::vec3) currentMoveVector;
-  _INTR_ARRAY(physx::PxController*) pxController;
-  _INTR_ARRAY(uint32_t) lastCollisionFlags;
+  _INTR_PAGED_ARRAY(glm::vec3) internalMoveVector;
+  _INTR_PAGED_ARRAY(glm::vec3) currentMoveVector;
+  _INTR_PAGED_ARRAY(physx::PxController*) pxController;
+  _INTR_PAGED_ARRAY(uint32_t) lastCollisionFlags;
 };
 
 struct CharacterControllerManager
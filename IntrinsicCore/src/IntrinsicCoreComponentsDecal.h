@@ -27,23 +27,22 @@ typedef _INTR_ARRAY(DecalRef) DecalRefArray;
 struct DecalData : Dod::Components::ComponentDataBase
 {
   DecalData()
-      : Dod::Components::ComponentDataBase(_INTR_MAX_DECAL_COMPONENT_COUNT)
   {
-    descAlbedoTextureName.resize(_INTR_MAX_DECAL_COMPONENT_COUNT);
-    descNormalTextureName.resize(_INTR_MAX_DECAL_COMPONENT_COUNT);
-    descPBRTextureName.resize(_INTR_MAX_DECAL_COMPONENT_COUNT);
+    registerArray(descAlbedoTextureName);
+    registerArray(descNormalTextureName);
+    registerArray(descPBRTextureName);
 
-    descUVTransform.resize(_INTR_MAX_DECAL_COMPONENT_COUNT);
-    descHalfExtent.resize(_INTR_MAX_DECAL_COMPONENT_COUNT);
+    registerArray(descUVTransform);
+    registerArray(descHalfExtent);
   }
 
   // Description
-  _INTR_ARRAY(Name) descAlbedoTextureName;
-  _INTR_ARRAY(Name) descNormalTextureName;
-  _INTR_ARRAY(Name) descPBRTextureName;
+  _INTR_PAGED_ARRAY(Name) descAlbedoTextureName;
+  _INTR_PAGED_ARRAY(Name) descNormalTextureName;
+  _INTR_PAGED_ARRAY(Name) descPBRTextureName;
 
-  _INTR_ARRAY(glm::vec4) descUVTransform;
-  _INTR_ARRAY(glm::vec3) descHalfExtent;
+  _INTR_PAGED_ARRAY(glm::vec4) descUVTransform;
+  _INTR_PAGED_ARRAY(glm::vec3) descHalfExtent;
 };
 
 struct DecalManager
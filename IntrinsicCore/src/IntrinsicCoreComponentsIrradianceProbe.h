@@ -27,23 +27,21 @@ typedef _INTR_ARRAY(IrradianceProbeRef) IrradianceProbeRefArray;
 struct IrradianceProbeData : Dod::Components::ComponentDataBase
 {
   IrradianceProbeData()
-      : Dod::Components::ComponentDataBase(
-            _INTR_MAX_IRRADIANCE_PROBE_COMPONENT_COUNT)
   {
-    descRadius.resize(_INTR_MAX_IRRADIANCE_PROBE_COMPONENT_COUNT);
-    descPriority.resize(_INTR_MAX_IRRADIANCE_PROBE_COMPONENT_COUNT);
-    descFalloffRangePerc.resize(_INTR_MAX_IRRADIANCE_PROBE_COMPONENT_COUNT);
-    descFalloffExponent.resize(_INTR_MAX_IRRADIANCE_PROBE_COMPONENT_COUNT);
+    registerArray(descRadius);
+    registerArray(descPriority);
+    registerArray(descFalloffRangePerc);
+    registerArray(descFalloffExponent);
 
-    descSHs.resize(_INTR_MAX_IRRADIANCE_PROBE_COMPONENT_COUNT);
+    registerArray(descSHs);
   }
 
-  _INTR_ARRAY(float) descRadius;
-  _INTR_ARRAY(float) descFalloffRangePerc;
-  _INTR_ARRAY(float) descFalloffExponent;
-  _INTR_ARRAY(uint32_t) descPriority;
+  _INTR_PAGED_ARRAY(float) descRadius;
+  _INTR_PAGED_ARRAY(float) descFalloffRangePerc;
+  _INTR_PAGED_ARRAY(float) descFalloffExponent;
+  _INTR_PAGED_ARRAY(uint32_t) descPriority;
 
-  _INTR_ARRAY(_INTR_ARRAY(Rendering::IBL::SH9)) descSHs;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(Rendering::IBL::SH9)) descSHs;
 };
 
 struct IrradianceProbeManager
@@ -27,19 +27,18 @@ typedef _INTR_ARRAY(LightRef) LightRefArray;
 struct LightData : Dod::Components::ComponentDataBase
 {
   LightData()
-      : Dod::Components::ComponentDataBase(_INTR_MAX_LIGHT_COMPONENT_COUNT)
   {
-    descRadius.resize(_INTR_MAX_LIGHT_COMPONENT_COUNT);
-    descColor.resize(_INTR_MAX_LIGHT_COMPONENT_COUNT);
-    descTemperature.resize(_INTR_MAX_LIGHT_COMPONENT_COUNT);
-    descIntensity.resize(_INTR_MAX_LIGHT_COMPONENT_COUNT);
+    registerArray(descRadius);
+    registerArray(descColor);
+    registerArray(descTemperature);
+    registerArray(descIntensity);
   }
 
   // Description
-  _INTR_ARRAY(float) descRadius;
-  _INTR_ARRAY(glm::vec3) descColor;
-  _INTR_ARRAY(float) descIntensity;
-  _INTR_ARRAY(float) descTemperature;
+  _INTR_PAGED_ARRAY(float) descRadius;
+  _INTR_PAGED_ARRAY(glm::vec3) descColor;
+  _INTR_PAGED_ARRAY(float) descIntensity;
+  _INTR_PAGED_ARRAY(float) descTemperature;
 };
 
 struct LightManager
@@ -36,19 +36,12 @@ struct PerInstanceDataUpdateParallelTaskSet : enki::ITaskSet
 
     Dod::Ref frustumRef =
         R::RenderProcess::Default::_activeFrustums[_frustumIdx];
-    glm::mat4& viewMatrix =
-        Resources::FrustumManager::_descViewMatrix(frustumRef);
-    glm::mat4& viewProjectionMatrix =
-        Resources::FrustumManager::_viewProjectionMatrix(frustumRef);
 
     for (uint32_t meshIdx = p_Range.start; meshIdx < p_Range.end; ++meshIdx)
     {
-      MeshRef meshCompRef =
-          R::RenderProcess::Default::_visibleMeshComponents[_frustumIdx]
-                                                           [meshIdx];
-      Entity::EntityRef entityRef = MeshManager::_entity(meshCompRef);
-      Components::NodeRef nodeRef =
-          Components::NodeManager::getComponentForEntity(entityRef);
+      MeshRef meshCompRef = R::RenderProcess::Default::_frustumVisibility
+          [_frustumIdx]->visibleMeshComponents[meshIdx];
+      Components::NodeRef nodeRef = MeshManager::_node(meshCompRef);
 
       const float distToCamera = glm::distance(
           Components::NodeManager::_worldPosition(nodeRef),
@@ -58,14 +51,8 @@ struct PerInstanceDataUpdateParallelTaskSet : enki::ITaskSet
       MeshPerInstanceDataVertex& perInstanceDataVertex =
           Components::MeshManager::_perInstanceDataVertex(meshCompRef);
       {
-        perInstanceDataVertex.worldMatrix =
-            Components::NodeManager::_worldMatrix(nodeRef);
-        perInstanceDataVertex.viewProjMatrix = viewProjectionMatrix;
-        perInstanceDataVertex.worldViewProjMatrix =
-            viewProjectionMatrix * perInstanceDataVertex.worldMatrix;
-        perInstanceDataVertex.worldViewMatrix =
-            viewMatrix * perInstanceDataVertex.worldMatrix;
-        perInstanceDataVertex.viewMatrix = viewMatrix;
+        perInstanceDataVertex.data0.x = (float)_frustumIdx;
+        perInstanceDataVertex.data0.z = (float)nodeRef._id;
         perInstanceDataVertex.data0.w = TaskManager::_totalTimePassed;
         perInstanceDataVertex.data0.y = distToCamera;
       }
@@ -107,7 +94,7 @@ struct UniformUpdateParallelTaskSet : enki::ITaskSet
   {
     _INTR_PROFILE_CPU("General", "Mesh Uniform Data Updt. Job");
 
-    DrawCallRefArray& drawCalls = *_drawCalls;
+    DrawCallRefFrameArray& drawCalls = *_drawCalls;
 
     for (uint32_t dcIdx = p_Range.start; dcIdx < p_Range.end; ++dcIdx)
     {
@@ -127,115 +114,165 @@ struct UniformUpdateParallelTaskSet : enki::ITaskSet
     }
   }
 
-  DrawCallRefArray* _drawCalls;
+  DrawCallRefFrameArray* _drawCalls;
 };
 
 // <-
 
-struct DrawCallCollectionParallelTaskSet : enki::ITaskSet
+struct VisibleNodeCollectionParallelTaskSet : enki::ITaskSet
 {
-  virtual ~DrawCallCollectionParallelTaskSet() {}
+  virtual ~VisibleNodeCollectionParallelTaskSet() {}
 
   void ExecuteRange(enki::TaskSetPartition p_Range,
                     uint32_t p_ThreadNum) override
   {
     _INTR_PROFILE_CPU("General", "Collect Visible Mesh Draw Calls Job");
 
-    auto& drawCallsPerMaterialPass =
-        DrawCallManager::_drawCallsPerMaterialPass[_materialPassIdx];
-    const uint32_t activeFrustumCount =
-        (uint32_t)R::RenderProcess::Default::_activeFrustums.size();
+    const Dod::RefArray& visibleNodes =
+        Resources::FrustumManager::_visibleNodesPerFrustum[_frustumIdx];
+    Resources::FrustumRef frustumRef =
+        R::RenderProcess::Default::_activeFrustums[_frustumIdx];
+    R::RenderProcess::FrustumVisibility& frustumVisibility =
+        *R::RenderProcess::Default::_frustumVisibility[_frustumIdx];
+
+    uint32_t culledDrawCallCount[_INTR_MAX_MATERIAL_PASS_COUNT] = {};
 
-    for (uint32_t frustIdx = 0u; frustIdx < activeFrustumCount; ++frustIdx)
+    for (uint32_t nodeIdx = p_Range.start; nodeIdx < p_Range.end; ++nodeIdx)
     {
-      auto& visibleDrawCallsPerMaterialPass = R::RenderProcess::Default::
-          _visibleDrawCallsPerMaterialPass[frustIdx][_materialPassIdx];
+      Components::MeshRef meshComponentRef =
+          Components::MeshManager::getComponentForEntity(
+              Components::NodeManager::_entity(visibleNodes[nodeIdx]));
 
-      for (uint32_t drawCallIdx = p_Range.start; drawCallIdx < p_Range.end;
-           ++drawCallIdx)
+      if (!meshComponentRef.isValid())
       {
-        DrawCallRef drawCallRef = drawCallsPerMaterialPass[drawCallIdx];
-        Components::MeshRef meshComponentRef =
-            DrawCallManager::_descMeshComponent(drawCallRef);
+        continue;
+      }
+
+      frustumVisibility.visibleMeshComponents.push_back(meshComponentRef);
+
+      const float distToCamera =
+          Components::MeshManager::_perInstanceDataVertex(meshComponentRef)
+              .data0.y;
+      const DrawCallArray& drawCallsPerMaterialPass =
+          Components::MeshManager::_drawCalls(meshComponentRef);
 
-        if (meshComponentRef.isValid())
+      const float screenSize = Resources::FrustumManager::calcScreenSize(
+          frustumRef,
+          Components::NodeManager::_worldBoundingSphere(visibleNodes[nodeIdx]));
+
+      // Select the LOD from the projected size and the LOD used in the
+      // previous frame. The index ranges of the draw calls are switched to it
+      // by selectLods() when rendering this frustum
+      const Resources::MeshRef meshRef =
+          Components::NodeManager::_mesh(visibleNodes[nodeIdx]);
+      if (meshRef.isValid() && Resources::MeshManager::_lodCount(meshRef) > 1u)
+      {
+        _INTR_ARRAY(uint8_t)& lodIdxPerFrustum =
+            Components::MeshManager::_lodIdxPerFrustum(meshComponentRef);
+        if (lodIdxPerFrustum.size() <= _frustumIdx)
         {
-          Components::NodeRef nodeComponentRef =
-              Components::MeshManager::_node(meshComponentRef);
+          lodIdxPerFrustum.resize(_frustumIdx + 1u);
+        }
 
-          if ((Components::NodeManager::_visibilityMask(nodeComponentRef) &
-               (1u << frustIdx)) > 0u)
-          {
-            DrawCallManager::updateSortingHash(
-                drawCallRef, Components::MeshManager::_perInstanceDataVertex(
-                                 meshComponentRef)
-                                 .data0.y);
+        lodIdxPerFrustum[_frustumIdx] = Resources::MeshManager::selectLod(
+            meshRef, screenSize, lodIdxPerFrustum[_frustumIdx]);
+      }
 
-            visibleDrawCallsPerMaterialPass.push_back(drawCallRef);
+      for (uint32_t matPassIdx = 0u;
+           matPassIdx < drawCallsPerMaterialPass.size(); ++matPassIdx)
+      {
+        const DrawCallRefArray& drawCalls =
+            drawCallsPerMaterialPass[matPassIdx];
+        const MaterialPass::MaterialPass& matPass =
+            MaterialManager::_materialPasses[matPassIdx];
+        const bool tooSmall = screenSize < matPass.minScreenSize;
+
+        for (uint32_t dcIdx = 0u; dcIdx < drawCalls.size(); ++dcIdx)
+        {
+          DrawCallRef drawCallRef = drawCalls[dcIdx];
+
+          if (tooSmall)
+          {
+            ++culledDrawCallCount[matPassIdx];
+            continue;
           }
+
+          DrawCallManager::updateSortingHash(drawCallRef, distToCamera);
+          frustumVisibility.visibleDrawCallsPerMaterialPass[matPassIdx]
+              .push_back(drawCallRef);
         }
       }
     }
+
+    for (uint32_t matPassIdx = 0u;
+         matPassIdx < MaterialManager::_materialPasses.size(); ++matPassIdx)
+    {
+      if (culledDrawCallCount[matPassIdx] > 0u)
+      {
+        _culledDrawCallCountPerMaterialPass[matPassIdx].fetch_add(
+            culledDrawCallCount[matPassIdx], std::memory_order_relaxed);
+      }
+    }
   }
 
-  uint8_t _materialPassIdx;
+  uint32_t _frustumIdx;
+
+  // Draw calls dropped by the minimum screen size of each material pass
+  std::atomic<uint32_t>
+      _culledDrawCallCountPerMaterialPass[_INTR_MAX_MATERIAL_PASS_COUNT];
 };
 
 // <-
 
-struct MeshCollectionParallelTaskSet : enki::ITaskSet
-{
-  virtual ~MeshCollectionParallelTaskSet() {}
+_INTR_ARRAY(_INTR_PROFILE_COUNTER_TOKEN) _culledDrawCallCounters;
 
-  void ExecuteRange(enki::TaskSetPartition p_Range,
-                    uint32_t p_ThreadNum) override
+// <-
+
+_INTR_INLINE bool isStaticShadowCaster(MeshRef p_MeshCompRef)
+{
+  const ShadowCasterMode::Enum mode =
+      MeshManager::_descShadowCasterMode(p_MeshCompRef);
+  if (mode != ShadowCasterMode::kAutomatic)
   {
-    _INTR_PROFILE_CPU("General", "Collect Visible Mesh Components Job");
+    return mode == ShadowCasterMode::kStatic;
+  }
 
-    uint32_t activeFrustumsCount =
-        (uint32_t)R::RenderProcess::Default::_activeFrustums.size();
+  Entity::EntityRef entityRef = MeshManager::_entity(p_MeshCompRef);
 
-    for (uint32_t meshCompId = p_Range.start; meshCompId < p_Range.end;
-         ++meshCompId)
+  RigidBodyRef rigidBodyRef =
+      RigidBodyManager::getComponentForEntity(entityRef);
+  if (rigidBodyRef.isValid())
+  {
+    const RigidBodyType::Enum rigidBodyType =
+        RigidBodyManager::_descRigidBodyType(rigidBodyRef);
+    if (rigidBodyType != RigidBodyType::kTriangleMeshStatic &&
+        rigidBodyType != RigidBodyType::kConvexMeshStatic)
     {
-      Components::MeshRef meshComponentRef =
-          Components::MeshManager::getActiveResourceAtIndex(meshCompId);
-      Components::NodeRef nodeComponentRef =
-          Components::MeshManager::_node(meshComponentRef);
-
-      for (uint32_t frustIdx = 0u; frustIdx < activeFrustumsCount; ++frustIdx)
-      {
-
-        if ((Components::NodeManager::_visibilityMask(nodeComponentRef) &
-             (1u << frustIdx)) > 0u)
-        {
-          auto& visibleMeshComponents =
-              R::RenderProcess::Default::_visibleMeshComponents[frustIdx];
-          visibleMeshComponents.push_back(meshComponentRef);
-        }
-      }
+      return false;
     }
   }
-};
+
+  return !CharacterControllerManager::getComponentForEntity(entityRef)
+              .isValid() &&
+         !ScriptManager::getComponentForEntity(entityRef).isValid();
+}
 }
 
 // <-
 
 MeshData::MeshData()
-    : Dod::Components::ComponentDataBase(_INTR_MAX_MESH_COMPONENT_COUNT)
 {
-  descMeshName.resize(_INTR_MAX_MESH_COMPONENT_COUNT);
-  descColorTint.resize(_INTR_MAX_MESH_COMPONENT_COUNT);
-
-  perInstanceDataVertex.resize(_INTR_MAX_MESH_COMPONENT_COUNT);
-  perInstanceDataFragment.resize(_INTR_MAX_MESH_COMPONENT_COUNT);
-  drawCalls.resize(_INTR_MAX_MESH_COMPONENT_COUNT);
-  node.resize(_INTR_MAX_MESH_COMPONENT_COUNT);
-
-  for (uint32_t i = 0u; i < _INTR_MAX_MESH_COMPONENT_COUNT; ++i)
-  {
-    drawCalls[i].resize(MaterialManager::_materialPasses.size());
-  }
+  registerArray(descMeshName);
+  registerArray(descColorTint);
+  registerArray(descOccluderMode);
+  registerArray(descShadowCasterMode);
+
+  registerArray(perInstanceDataVertex);
+  registerArray(perInstanceDataFragment);
+  registerArray(drawCalls);
+  registerArray(node);
+  registerArray(lodIdxPerFrustum);
+  registerArray(staticShadowCaster);
 }
 
 // <-
@@ -244,6 +281,8 @@ void MeshManager::resetToDefault(MeshRef p_Mesh)
 {
   _descMeshName(p_Mesh) = "";
   _descColorTint(p_Mesh) = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+  _descOccluderMode(p_Mesh) = OccluderMode::kAutomatic;
+  _descShadowCasterMode(p_Mesh) = ShadowCasterMode::kAutomatic;
 }
 
 void MeshManager::init()
@@ -284,7 +323,7 @@ void MeshManager::init()
 
 void MeshManager::createResources(const MeshRefArray& p_Meshes)
 {
-  DrawCallRefArray drawCallsToCreate;
+  DrawCallRefFrameArray drawCallsToCreate;
 
   for (uint32_t meshIdx = 0u; meshIdx < p_Meshes.size(); ++meshIdx)
   {
@@ -298,6 +337,7 @@ void MeshManager::createResources(const MeshRefArray& p_Meshes)
     const uint32_t subMeshCount =
         (uint32_t)Resources::MeshManager::_descIndicesPerSubMesh(meshRef)
             .size();
+    _lodIdxPerFrustum(meshCompRef).clear();
 
     for (uint32_t subMeshIdx = 0u; subMeshIdx < subMeshCount; ++subMeshIdx)
     {
@@ -315,6 +355,12 @@ void MeshManager::createResources(const MeshRefArray& p_Meshes)
           continue;
         }
 
+        if (drawCalls.size() < matPassIdx + 1u)
+        {
+          drawCalls.resize(matPassIdx + 1u);
+        }
+
+        // The draw call covers all LODs, see selectLods()
         DrawCallRef drawCallMesh = DrawCallManager::createDrawCallForMesh(
             _N(_MeshComponent), meshRef, matToUse, matPassIdx,
             sizeof(MeshPerInstanceDataVertex),
@@ -323,15 +369,27 @@ void MeshManager::createResources(const MeshRefArray& p_Meshes)
         DrawCallManager::_descMeshComponent(drawCallMesh) = meshCompRef;
 
         drawCallsToCreate.push_back(drawCallMesh);
-
-        if (drawCalls.size() < matPassIdx + 1u)
-        {
-          drawCalls.resize(matPassIdx + 1u);
-        }
         drawCalls[matPassIdx].push_back(drawCallMesh);
       }
     }
 
+    // Cache the mesh and the merged AABB of all sub meshes on the node
+    {
+      Math::AABB& localAABB = NodeManager::_localAABB(nodeRef);
+      Math::initAABB(localAABB);
+
+      const Resources::AABBPerSubMeshArray& aabbPerSubMesh =
+          Resources::MeshManager::_aabbPerSubMesh(meshRef);
+      for (uint32_t subMeshIdx = 0u; subMeshIdx < aabbPerSubMesh.size();
+           ++subMeshIdx)
+      {
+        Math::mergeAABBToAABB(localAABB, aabbPerSubMesh[subMeshIdx]);
+      }
+
+      NodeManager::_mesh(nodeRef) =
+          subMeshCount > 0u ? meshRef : Resources::MeshRef();
+    }
+
     // Update transform since the AABB most probably changed
     NodeManager::updateTransforms(nodeRef);
 
@@ -340,6 +398,8 @@ void MeshManager::createResources(const MeshRefArray& p_Meshes)
       _node(meshCompRef) = nodeRef;
     }
 
+    _staticShadowCaster(meshCompRef) = isStaticShadowCaster(meshCompRef);
+
     // Update dependent resources/components
     if ((World::_flags & WorldFlags::kLoadingUnloading) == 0u)
     {
@@ -357,7 +417,8 @@ void MeshManager::createResources(const MeshRefArray& p_Meshes)
     }
   }
 
-  DrawCallManager::createResources(drawCallsToCreate);
+  DrawCallManager::createResources(drawCallsToCreate.data(),
+                                   (uint32_t)drawCallsToCreate.size());
 }
 
 // <-
@@ -371,6 +432,12 @@ void MeshManager::destroyResources(const MeshRefArray& p_Meshes)
     MeshRef meshRef = p_Meshes[mIdx];
     DrawCallArray& drawCallsPerMaterialPass = _drawCalls(meshRef);
 
+    NodeRef nodeRef = _node(meshRef);
+    if (nodeRef.isValid() && NodeManager::isAlive(nodeRef))
+    {
+      NodeManager::_mesh(nodeRef) = Resources::MeshRef();
+      NodeManager::updateTransform(nodeRef);
+    }
     _node(meshRef) = Dod::Ref();
 
     for (uint32_t matPassIdx = 0u; matPassIdx < drawCallsPerMaterialPass.size();
@@ -400,8 +467,8 @@ void MeshManager::updatePerInstanceData(Dod::Ref p_CameraRef,
   const uint32_t frustumId =
       R::RenderProcess::Default::_cameraToIdMapping[p_CameraRef] + p_FrustumIdx;
   _perInstanceDataUpdateTaskSet.m_SetSize =
-      (uint32_t)R::RenderProcess::Default::_visibleMeshComponents[frustumId]
-          .size();
+      (uint32_t)R::RenderProcess::Default::_frustumVisibility[frustumId]
+          ->visibleMeshComponents.size();
   _perInstanceDataUpdateTaskSet._frustumIdx = frustumId;
   _perInstanceDataUpdateTaskSet._camRef = p_CameraRef;
 
@@ -411,7 +478,43 @@ void MeshManager::updatePerInstanceData(Dod::Ref p_CameraRef,
 
 // <-
 
-void MeshManager::updateUniformData(Dod::RefArray& p_DrawCalls)
+void MeshManager::selectLods(Dod::RefFrameArray& p_DrawCalls,
+                             Dod::Ref p_CameraRef, uint32_t p_FrustumIdx)
+{
+  _INTR_PROFILE_CPU("General", "Select Mesh LODs");
+
+  const uint32_t frustumId =
+      R::RenderProcess::Default::_cameraToIdMapping[p_CameraRef] + p_FrustumIdx;
+
+  for (uint32_t dcIdx = 0u; dcIdx < p_DrawCalls.size(); ++dcIdx)
+  {
+    DrawCallRef drawCallRef = p_DrawCalls[dcIdx];
+    const uint32_t lodCount =
+        (uint32_t)DrawCallManager::_descLodIndexRanges(drawCallRef).size();
+    MeshRef meshCompRef = DrawCallManager::_descMeshComponent(drawCallRef);
+
+    if (lodCount <= 1u || !meshCompRef.isValid())
+    {
+      continue;
+    }
+
+    const _INTR_ARRAY(uint8_t)& lodIdxPerFrustum =
+        _lodIdxPerFrustum(meshCompRef);
+    const uint32_t lodIdx = frustumId < lodIdxPerFrustum.size()
+                                ? lodIdxPerFrustum[frustumId]
+                                : 0u;
+    const MaterialPass::MaterialPass& matPass =
+        MaterialManager::_materialPasses[DrawCallManager::_descMaterialPass(
+            drawCallRef)];
+
+    DrawCallManager::selectLod(
+        drawCallRef, glm::min(lodIdx + matPass.lodBias, lodCount - 1u));
+  }
+}
+
+// <-
+
+void MeshManager::updateUniformData(Dod::RefFrameArray& p_DrawCalls)
 {
   static UniformUpdateParallelTaskSet uniformUpdateTaskSet;
 
@@ -428,69 +531,77 @@ void MeshManager::updateUniformData(Dod::RefArray& p_DrawCalls)
 
 void MeshManager::collectDrawCallsAndMeshComponents()
 {
-  static MeshCollectionParallelTaskSet meshCollectionTaskSet;
-  static _INTR_ARRAY(DrawCallCollectionParallelTaskSet)
-      drawCallCollectionTaskSets;
+  static VisibleNodeCollectionParallelTaskSet visibleNodeCollectionTaskSet;
 
   _INTR_PROFILE_CPU("General",
                     "Collect Visible Mesh Components And Draw Calls");
 
   using namespace Renderer;
 
-  drawCallCollectionTaskSets.resize(
-      Renderer::Resources::MaterialManager::_materialPasses.size());
+  const uint32_t activeFrustumCount =
+      (uint32_t)RenderProcess::Default::_activeFrustums.size();
+  RenderProcess::Default::prepareFrustumVisibility(activeFrustumCount);
+
+  const uint32_t materialPassCount =
+      (uint32_t)Renderer::Resources::MaterialManager::_materialPasses.size();
+  for (uint32_t matPassIdx = 0u; matPassIdx < materialPassCount; ++matPassIdx)
+  {
+    visibleNodeCollectionTaskSet._culledDrawCallCountPerMaterialPass[matPassIdx]
+        .store(0u, std::memory_order_relaxed);
+  }
 
-  for (uint32_t frustIdx = 0u;
-       frustIdx < RenderProcess::Default::_activeFrustums.size(); ++frustIdx)
+  // Frustums are processed one after another since Nodes visible in multiple
+  // frustums update the same draw calls
+  for (uint32_t frustIdx = 0u; frustIdx < activeFrustumCount; ++frustIdx)
   {
+    RenderProcess::FrustumVisibility& frustumVisibility =
+        *RenderProcess::Default::_frustumVisibility[frustIdx];
+
     for (uint32_t materialPassIdx = 0u;
          materialPassIdx <
          Renderer::Resources::MaterialManager::_materialPasses.size();
          ++materialPassIdx)
     {
-      RenderProcess::Default::_visibleDrawCallsPerMaterialPass[frustIdx]
-                                                              [materialPassIdx]
-                                                                  .clear();
+      frustumVisibility.visibleDrawCallsPerMaterialPass[materialPassIdx]
+          .clear();
     }
+    frustumVisibility.visibleMeshComponents.clear();
 
-    RenderProcess::Default::_visibleMeshComponents[frustIdx].clear();
-  }
+    visibleNodeCollectionTaskSet._frustumIdx = frustIdx;
+    visibleNodeCollectionTaskSet.m_SetSize =
+        (uint32_t)Core::Resources::FrustumManager::_visibleNodesPerFrustum
+            [frustIdx]
+                .size();
 
-  meshCollectionTaskSet.m_SetSize =
-      Components::MeshManager::getActiveResourceCount();
-  Application::_scheduler.AddTaskSetToPipe(&meshCollectionTaskSet);
+    Application::_scheduler.AddTaskSetToPipe(&visibleNodeCollectionTaskSet);
+    Application::_scheduler.WaitforTaskSet(&visibleNodeCollectionTaskSet);
+  }
 
-  uint32_t currentJobIdx = 0u;
-  for (uint32_t matPassIdx = 0u;
-       matPassIdx <
-       Renderer::Resources::MaterialManager::_materialPasses.size();
-       ++matPassIdx)
+  // Publish the small object culling results of each material pass
+  if (_culledDrawCallCounters.size() != materialPassCount)
   {
-    if (!Renderer::Resources::DrawCallManager::_drawCallsPerMaterialPass
-             [matPassIdx]
-                 .empty())
+    _culledDrawCallCounters.resize(materialPassCount);
+    for (uint32_t matPassIdx = 0u; matPassIdx < materialPassCount;
+         ++matPassIdx)
     {
-      DrawCallCollectionParallelTaskSet& drawCallTaskSet =
-          drawCallCollectionTaskSets[currentJobIdx];
-      drawCallTaskSet._materialPassIdx = matPassIdx;
-      drawCallTaskSet.m_SetSize =
-          (uint32_t)Renderer::Resources::DrawCallManager::
-              _drawCallsPerMaterialPass[matPassIdx]
-                  .size();
-
-      Application::_scheduler.AddTaskSetToPipe(&drawCallTaskSet);
+      const _INTR_STRING counterName =
+          "Culled Small Draw Calls/" +
+          _INTR_STRING(Renderer::Resources::MaterialManager::_materialPasses
+                           [matPassIdx]
+                               .name.getString());
+      _culledDrawCallCounters[matPassIdx] =
+          _INTR_PROFILE_GET_COUNTER_TOKEN(counterName.c_str());
     }
-
-    ++currentJobIdx;
   }
 
-  // Wait for all
-  for (uint32_t i = 0u; i < currentJobIdx; ++i)
+  for (uint32_t matPassIdx = 0u; matPassIdx < materialPassCount; ++matPassIdx)
   {
-    Application::_scheduler.WaitforTaskSet(&drawCallCollectionTaskSets[i]);
+    _INTR_PROFILE_COUNTER_TOKEN_SET(
+        _culledDrawCallCounters[matPassIdx],
+        visibleNodeCollectionTaskSet
+            ._culledDrawCallCountPerMaterialPass[matPassIdx]
+            .load(std::memory_order_relaxed));
   }
-
-  Application::_scheduler.WaitforTaskSet(&meshCollectionTaskSet);
 }
 }
 }
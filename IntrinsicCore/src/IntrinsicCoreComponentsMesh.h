@@ -26,14 +26,33 @@ typedef _INTR_ARRAY(MeshRef) MeshRefArray;
 
 typedef _INTR_ARRAY(_INTR_ARRAY(Dod::Ref)) DrawCallArray;
 
-struct MeshPerInstanceDataVertex
+namespace OccluderMode
+{
+enum Enum
+{
+  // Used as an occluder if large enough on screen and simple enough
+  kAutomatic,
+  kAlways,
+  kNever
+};
+}
+
+namespace ShadowCasterMode
+{
+enum Enum
 {
-  glm::mat4 worldMatrix;
-  glm::mat4 worldViewProjMatrix;
-  glm::mat4 worldViewMatrix;
-  glm::mat4 viewProjMatrix;
-  glm::mat4 viewMatrix;
+  // Static unless moved by physics or scripts
+  kAutomatic,
+  kStatic,
+  kDynamic
+};
+}
 
+struct MeshPerInstanceDataVertex
+{
+  // x: frustum id, y: distance to camera, z: node id, w: time
+  // The view and projection matrices of the frustum are part of the per frame
+  // data, the world matrix of the node is read from the transform buffer
   glm::vec4 data0;
 };
 
@@ -49,14 +68,18 @@ struct MeshData : Dod::Components::ComponentDataBase
   MeshData();
 
   // Description
-  _INTR_ARRAY(Name) descMeshName;
-  _INTR_ARRAY(glm::vec4) descColorTint;
+  _INTR_PAGED_ARRAY(Name) descMeshName;
+  _INTR_PAGED_ARRAY(glm::vec4) descColorTint;
+  _INTR_PAGED_ARRAY(OccluderMode::Enum) descOccluderMode;
+  _INTR_PAGED_ARRAY(ShadowCasterMode::Enum) descShadowCasterMode;
 
   // Resources
-  _INTR_ARRAY(MeshPerInstanceDataVertex) perInstanceDataVertex;
-  _INTR_ARRAY(MeshPerInstanceDataFragment) perInstanceDataFragment;
-  _INTR_ARRAY(DrawCallArray) drawCalls;
-  _INTR_ARRAY(Components::NodeRef) node;
+  _INTR_PAGED_ARRAY(MeshPerInstanceDataVertex) perInstanceDataVertex;
+  _INTR_PAGED_ARRAY(MeshPerInstanceDataFragment) perInstanceDataFragment;
+  _INTR_PAGED_ARRAY(DrawCallArray) drawCalls;
+  _INTR_PAGED_ARRAY(Components::NodeRef) node;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(uint8_t)) lodIdxPerFrustum;
+  _INTR_PAGED_ARRAY(uint8_t) staticShadowCaster;
 };
 
 struct MeshManager
@@ -103,6 +126,18 @@ struct MeshManager
         _INTR_CREATE_PROP(p_Document, p_GenerateDesc, _N(Mesh), _N(color),
                           _descColorTint(p_Ref), false, false),
         p_Document.GetAllocator());
+    p_Properties.AddMember(
+        "occluderMode",
+        _INTR_CREATE_PROP_ENUM(p_Document, p_GenerateDesc, _N(Mesh), _N(enum),
+                               _descOccluderMode(p_Ref),
+                               "Automatic,Always,Never", false, false),
+        p_Document.GetAllocator());
+    p_Properties.AddMember(
+        "shadowCasterMode",
+        _INTR_CREATE_PROP_ENUM(p_Document, p_GenerateDesc, _N(Mesh), _N(enum),
+                               _descShadowCasterMode(p_Ref),
+                               "Automatic,Static,Dynamic", false, false),
+        p_Document.GetAllocator());
   }
 
   // <-
@@ -121,6 +156,18 @@ struct MeshManager
       _descColorTint(p_Ref) =
           JsonHelper::readPropertyVec4(p_Properties["colorTint"]);
     }
+    if (p_Properties.HasMember("occluderMode"))
+    {
+      _descOccluderMode(p_Ref) =
+          (OccluderMode::Enum)JsonHelper::readPropertyEnumUint(
+              p_Properties["occluderMode"]);
+    }
+    if (p_Properties.HasMember("shadowCasterMode"))
+    {
+      _descShadowCasterMode(p_Ref) =
+          (ShadowCasterMode::Enum)JsonHelper::readPropertyEnumUint(
+              p_Properties["shadowCasterMode"]);
+    }
   }
 
   // <-
@@ -146,7 +193,15 @@ struct MeshManager
 
   // <-
 
-  static void updateUniformData(Dod::RefArray& p_Meshes);
+  /**
+   * Switches the given mesh draw calls to the LOD selected for the frustum
+   * during collection, including the LOD bias of their material pass. Draw
+   * calls are shared by all frustums, so this has to be called by each render
+   * pass before recording the draw calls of a frustum.
+   */
+  static void selectLods(Dod::RefFrameArray& p_DrawCalls, Dod::Ref p_CameraRef,
+                         uint32_t p_FrustumIdx);
+  static void updateUniformData(Dod::RefFrameArray& p_Meshes);
   static void updatePerInstanceData(Dod::Ref p_CameraRef,
                                     uint32_t p_FrustumIdx);
 
@@ -171,6 +226,15 @@ struct MeshManager
   {
     return _data.descColorTint[p_Ref._id];
   }
+  _INTR_INLINE static OccluderMode::Enum& _descOccluderMode(MeshRef p_Ref)
+  {
+    return _data.descOccluderMode[p_Ref._id];
+  }
+  _INTR_INLINE static ShadowCasterMode::Enum&
+  _descShadowCasterMode(MeshRef p_Ref)
+  {
+    return _data.descShadowCasterMode[p_Ref._id];
+  }
 
   // Resources
   _INTR_INLINE static MeshPerInstanceDataVertex&
@@ -191,6 +255,14 @@ struct MeshManager
   {
     return _data.node[p_Ref._id];
   }
+  _INTR_INLINE static _INTR_ARRAY(uint8_t) & _lodIdxPerFrustum(MeshRef p_Ref)
+  {
+    return _data.lodIdxPerFrustum[p_Ref._id];
+  }
+  _INTR_INLINE static uint8_t& _staticShadowCaster(MeshRef p_Ref)
+  {
+    return _data.staticShadowCaster[p_Ref._id];
+  }
 
   // <-
 };
@@ -21,9 +21,142 @@ namespace Core
 {
 namespace Components
 {
+namespace
+{
+// Depths with fewer nodes are updated on the calling thread
+const uint32_t _minNodeCountForParallelUpdate = 256u;
+
+// Computes the world position, orientation and size of the node and adds it
+// to the batch. The world transformation of the parent has to be up to date
+_INTR_INLINE void addToBatch(TransformKernel::Batch& p_Batch, NodeRef p_Node)
+{
+  const NodeRef parentNodeRef = NodeManager::_parent(p_Node);
+
+  if (!parentNodeRef.isValid())
+  {
+    NodeManager::_worldPosition(p_Node) = NodeManager::_position(p_Node);
+    NodeManager::_worldOrientation(p_Node) = NodeManager::_orientation(p_Node);
+    NodeManager::_worldSize(p_Node) = NodeManager::_size(p_Node);
+  }
+  else
+  {
+    const glm::vec3& parentPos = NodeManager::_worldPosition(parentNodeRef);
+    const glm::quat& parentOrient =
+        NodeManager::_worldOrientation(parentNodeRef);
+    const glm::vec3& parentSize = NodeManager::_worldSize(parentNodeRef);
+
+    const glm::vec3& localPos = NodeManager::_position(p_Node);
+    const glm::quat& localOrient = NodeManager::_orientation(p_Node);
+    const glm::vec3& localSize = NodeManager::_size(p_Node);
+
+    NodeManager::_worldPosition(p_Node) = parentPos + (parentOrient * localPos);
+    NodeManager::_worldOrientation(p_Node) = parentOrient * localOrient;
+    NodeManager::_worldSize(p_Node) = parentSize * localSize;
+  }
+
+  const glm::vec3& worldPos = NodeManager::_worldPosition(p_Node);
+  const Math::AABB* localAABB = nullptr;
+
+  if (NodeManager::_mesh(p_Node).isValid())
+  {
+    localAABB = &NodeManager::_localAABB(p_Node);
+  }
+  else
+  {
+    NodeManager::_worldAABB(p_Node) = Math::AABB(worldPos - glm::vec3(0.5f),
+                                                 worldPos + glm::vec3(0.5f));
+  }
+
+  p_Batch.add(worldPos, NodeManager::_worldOrientation(p_Node),
+              NodeManager::_worldSize(p_Node), localAABB,
+              &NodeManager::_worldMatrix(p_Node),
+              &NodeManager::_inverseWorldMatrix(p_Node),
+              &NodeManager::_worldAABB(p_Node),
+              &NodeManager::_worldBoundingSphere(p_Node));
+}
+
+// <-
+
+// Updates the nodes in batches using the SIMD transform kernel. Parents have
+// to be located before their children
+_INTR_INLINE void updateTransformsBatched(const NodeRef* p_Nodes,
+                                          uint32_t p_Count)
+{
+  TransformKernel::Batch batch;
+
+  for (uint32_t i = 0u; i < p_Count; ++i)
+  {
+    addToBatch(batch, p_Nodes[i]);
+
+    if (batch.count == TransformKernel::kMaxBatchSize)
+    {
+      TransformKernel::computeAndReset(batch);
+    }
+  }
+
+  if (batch.count > 0u)
+  {
+    TransformKernel::computeAndReset(batch);
+  }
+}
+
+// <-
+
+struct TransformUpdateParallelTaskSet : enki::ITaskSet
+{
+  virtual ~TransformUpdateParallelTaskSet() {}
+
+  void ExecuteRange(enki::TaskSetPartition p_Range,
+                    uint32_t p_ThreadNum) override
+  {
+    _INTR_PROFILE_CPU("Components", "Update Transforms Job");
+
+    updateTransformsBatched(&(*_nodes)[_firstNodeIdx + p_Range.start],
+                            p_Range.end - p_Range.start);
+  }
+
+  const NodeRefArray* _nodes;
+  uint32_t _firstNodeIdx;
+} _transformUpdateTaskSet;
+
+// <-
+
+_INTR_INLINE void updateTransformsPerDepth(const NodeRefArray& p_Nodes,
+                                           const _INTR_ARRAY(uint32_t) &
+                                               p_DepthOffsets)
+{
+  for (uint32_t depth = 0u; depth + 1u < p_DepthOffsets.size(); ++depth)
+  {
+    const uint32_t firstNodeIdx = p_DepthOffsets[depth];
+    const uint32_t nodeCount = p_DepthOffsets[depth + 1u] - firstNodeIdx;
+
+    if (nodeCount < _minNodeCountForParallelUpdate)
+    {
+      updateTransformsBatched(&p_Nodes[firstNodeIdx], nodeCount);
+    }
+    else
+    {
+      // All nodes of the previous depth are up to date at this point
+      _transformUpdateTaskSet._nodes = &p_Nodes;
+      _transformUpdateTaskSet._firstNodeIdx = firstNodeIdx;
+      _transformUpdateTaskSet.m_SetSize = nodeCount;
+
+      Application::_scheduler.AddTaskSetToPipe(&_transformUpdateTaskSet);
+      Application::_scheduler.WaitforTaskSet(&_transformUpdateTaskSet);
+    }
+  }
+}
+}
+
 // Static members
 NodeRefArray NodeManager::_rootNodes;
 NodeRefArray NodeManager::_sortedNodes;
+_INTR_ARRAY(uint32_t) NodeManager::_sortedNodesDepthOffsets;
+NodeRefArray NodeManager::_dirtyNodes;
+std::mutex NodeManager::_dirtyNodesMutex;
+NodeRefArray NodeManager::_changedNodes;
+std::mutex NodeManager::_changedNodesMutex;
+Containers::DynamicAabbTree NodeManager::_spatialIndex;
 
 void NodeManager::init()
 {
@@ -34,6 +167,8 @@ void NodeManager::init()
 
   _sortedNodes.reserve(_INTR_MAX_NODE_COMPONENT_COUNT);
   _rootNodes.reserve(_INTR_MAX_NODE_COMPONENT_COUNT);
+  _dirtyNodes.reserve(_INTR_MAX_NODE_COMPONENT_COUNT);
+  _changedNodes.reserve(_INTR_MAX_NODE_COMPONENT_COUNT);
 
   Dod::Components::ComponentManagerEntry nodeEntry;
   {
@@ -61,82 +196,217 @@ void NodeManager::init()
   }
 }
 
-void NodeManager::updateTransforms(const NodeRefArray& p_Nodes)
+// <-
+
+void NodeManager::rebuildTree()
 {
-  for (uint32_t nodeIdx = 0u; nodeIdx < p_Nodes.size(); ++nodeIdx)
+  _sortedNodes.clear();
+  _sortedNodesDepthOffsets.clear();
+
+  // Add the nodes depth by depth starting with the root nodes
+  _sortedNodes.insert(_sortedNodes.end(), _rootNodes.begin(), _rootNodes.end());
+
+  uint32_t firstNodeIdx = 0u;
+  while (firstNodeIdx < _sortedNodes.size())
   {
-    NodeRef nodeRef = p_Nodes[nodeIdx];
-    NodeRef parentNodeRef = _parent(nodeRef);
+    const uint32_t lastNodeIdx = (uint32_t)_sortedNodes.size();
+    _sortedNodesDepthOffsets.push_back(firstNodeIdx);
 
-    if (!parentNodeRef.isValid())
+    for (uint32_t i = firstNodeIdx; i < lastNodeIdx; ++i)
     {
-      _worldPosition(nodeRef) = _position(nodeRef);
-      _worldOrientation(nodeRef) = _orientation(nodeRef);
-      _worldSize(nodeRef) = _size(nodeRef);
+      for (NodeRef child = _firstChild(_sortedNodes[i]); child.isValid();
+           child = _nextSibling(child))
+      {
+        _sortedNodes.push_back(child);
+      }
     }
-    else
-    {
-      const glm::vec3& parentPos = _worldPosition(parentNodeRef);
-      const glm::quat& parentOrient = _worldOrientation(parentNodeRef);
-      const glm::vec3& parentSize = _worldSize(parentNodeRef);
 
-      const glm::vec3& localPos = _position(nodeRef);
-      const glm::quat& localOrient = _orientation(nodeRef);
-      const glm::vec3& localSize = _size(nodeRef);
+    firstNodeIdx = lastNodeIdx;
+  }
+
+  _sortedNodesDepthOffsets.push_back((uint32_t)_sortedNodes.size());
+}
+
+// <-
+
+void NodeManager::updateTransforms()
+{
+  _INTR_PROFILE_CPU("Components", "Update Transforms");
+
+  updateTransformsPerDepth(_sortedNodes, _sortedNodesDepthOffsets);
+  updateSpatialIndex(_sortedNodes.data(), (uint32_t)_sortedNodes.size());
+  internalMarkTransformsChanged(_sortedNodes.data(),
+                                (uint32_t)_sortedNodes.size());
+}
+
+// <-
+
+void NodeManager::updateTransforms(const NodeRefArray& p_Nodes)
+{
+  if (!p_Nodes.empty())
+  {
+    updateTransformsBatched(p_Nodes.data(), (uint32_t)p_Nodes.size());
+    updateSpatialIndex(p_Nodes.data(), (uint32_t)p_Nodes.size());
+    internalMarkTransformsChanged(p_Nodes.data(), (uint32_t)p_Nodes.size());
+  }
+}
+
+// <-
+
+void NodeManager::updateDirtyTransforms()
+{
+  _INTR_PROFILE_CPU("Components", "Update Dirty Transforms");
+
+  if (_dirtyNodes.empty())
+  {
+    return;
+  }
+
+  static _INTR_ARRAY(NodeRefArray) nodesPerDepth;
+  static _INTR_ARRAY(std::pair<NodeRef, uint32_t>) nodeStack;
+  static NodeRefArray nodesToUpdate;
+  static _INTR_ARRAY(uint32_t) depthOffsets;
+
+  for (uint32_t depth = 0u; depth < nodesPerDepth.size(); ++depth)
+  {
+    nodesPerDepth[depth].clear();
+  }
 
-      const glm::vec3 worldPos = parentPos + (parentOrient * localPos);
-      const glm::quat worldOrient = parentOrient * localOrient;
-      const glm::vec3 worldSize = parentSize * localSize;
+  // Collect the sub trees of all dirty nodes without a dirty ancestor
+  for (uint32_t dirtyIdx = 0u; dirtyIdx < _dirtyNodes.size(); ++dirtyIdx)
+  {
+    NodeRef dirtyNodeRef = _dirtyNodes[dirtyIdx];
+    if (!isAlive(dirtyNodeRef))
+    {
+      continue;
+    }
 
-      _worldPosition(nodeRef) = worldPos;
-      _worldOrientation(nodeRef) = worldOrient;
-      _worldSize(nodeRef) = worldSize;
+    uint32_t depth = 0u;
+    bool ancestorDirty = false;
+    for (NodeRef parentNodeRef = _parent(dirtyNodeRef);
+         parentNodeRef.isValid(); parentNodeRef = _parent(parentNodeRef))
+    {
+      if ((_flags(parentNodeRef) & NodeFlags::kTransformDirty) != 0u)
+      {
+        ancestorDirty = true;
+        break;
+      }
+      ++depth;
     }
 
-    glm::mat4 rot = glm::mat4_cast(NodeManager::_worldOrientation(nodeRef));
-    glm::mat4 trans =
-        glm::translate(glm::mat4(1.0f), NodeManager::_worldPosition(nodeRef));
-    glm::mat4 scale =
-        glm::scale(glm::mat4(1.0f), NodeManager::_worldSize(nodeRef));
+    if (ancestorDirty)
+    {
+      continue;
+    }
 
-    _worldMatrix(nodeRef) = trans * rot * scale;
-    _inverseWorldMatrix(nodeRef) = glm::inverse(_worldMatrix(nodeRef));
+    nodeStack.clear();
+    nodeStack.push_back(std::make_pair(dirtyNodeRef, depth));
 
-    // Update AABB
-    // TODO: Merge sub meshes
-    Components::MeshRef meshCompRef =
-        Components::MeshManager::getComponentForEntity(_entity(nodeRef));
-    if (meshCompRef.isValid())
+    while (!nodeStack.empty())
     {
-      Name& meshName = Components::MeshManager::_descMeshName(meshCompRef);
-      Resources::MeshRef meshRef =
-          Resources::MeshManager::_getResourceByName(meshName);
+      const NodeRef nodeRef = nodeStack.back().first;
+      const uint32_t nodeDepth = nodeStack.back().second;
+      nodeStack.pop_back();
+
+      if (nodesPerDepth.size() <= nodeDepth)
+      {
+        nodesPerDepth.resize(nodeDepth + 1u);
+      }
+      nodesPerDepth[nodeDepth].push_back(nodeRef);
 
-      if (meshRef.isValid())
+      for (NodeRef child = _firstChild(nodeRef); child.isValid();
+           child = _nextSibling(child))
       {
-        const uint32_t aabbCount =
-            (uint32_t)Resources::MeshManager::_aabbPerSubMesh(meshRef).size();
-
-        if (aabbCount > 0u)
-        {
-          _localAABB(nodeRef) =
-              Resources::MeshManager::_aabbPerSubMesh(meshRef)[0u];
-          _worldAABB(nodeRef) = _localAABB(nodeRef);
-          Math::transformAABBAffine(_worldAABB(nodeRef), _worldMatrix(nodeRef));
-
-          _worldBoundingSphere(nodeRef) = {
-              Math::calcAABBCenter(_worldAABB(nodeRef)),
-              glm::length(Math::calcAABBHalfExtent(_worldAABB(nodeRef)))};
-        }
+        nodeStack.push_back(std::make_pair(child, nodeDepth + 1u));
       }
     }
-    else
+  }
+
+  for (uint32_t dirtyIdx = 0u; dirtyIdx < _dirtyNodes.size(); ++dirtyIdx)
+  {
+    NodeRef dirtyNodeRef = _dirtyNodes[dirtyIdx];
+    if (isAlive(dirtyNodeRef))
     {
-      _worldAABB(nodeRef) =
-          Math::AABB(_worldPosition(nodeRef) - glm::vec3(0.5f),
-                     _worldPosition(nodeRef) + glm::vec3(0.5f));
+      _flags(dirtyNodeRef) &= ~NodeFlags::kTransformDirty;
     }
   }
+  _dirtyNodes.clear();
+
+  // Flatten the nodes and update them depth by depth
+  nodesToUpdate.clear();
+  depthOffsets.clear();
+
+  for (uint32_t depth = 0u; depth < nodesPerDepth.size(); ++depth)
+  {
+    depthOffsets.push_back((uint32_t)nodesToUpdate.size());
+    nodesToUpdate.insert(nodesToUpdate.end(), nodesPerDepth[depth].begin(),
+                         nodesPerDepth[depth].end());
+  }
+  depthOffsets.push_back((uint32_t)nodesToUpdate.size());
+
+  _INTR_PROFILE_COUNTER_SET("Transform Updates", nodesToUpdate.size());
+
+  updateTransformsPerDepth(nodesToUpdate, depthOffsets);
+  updateSpatialIndex(nodesToUpdate.data(), (uint32_t)nodesToUpdate.size());
+  internalMarkTransformsChanged(nodesToUpdate.data(),
+                                (uint32_t)nodesToUpdate.size());
+}
+
+// <-
+
+void NodeManager::takeChangedTransforms(NodeRefArray& p_ChangedNodes)
+{
+  p_ChangedNodes.clear();
+
+  // The flags are reset with the lock held so no change gets lost in between
+  std::lock_guard<std::mutex> lock(_changedNodesMutex);
+  p_ChangedNodes.swap(_changedNodes);
+
+  for (uint32_t i = 0u; i < p_ChangedNodes.size(); ++i)
+  {
+    NodeRef changedNodeRef = p_ChangedNodes[i];
+    if (isAlive(changedNodeRef))
+    {
+      Threading::interlockedAnd(_flags(changedNodeRef),
+                                ~NodeFlags::kTransformChanged);
+    }
+  }
+}
+
+// <-
+
+void NodeManager::updateTransform(NodeRef p_Node)
+{
+  updateTransformsBatched(&p_Node, 1u);
+  updateSpatialIndex(&p_Node, 1u);
+  internalMarkTransformsChanged(&p_Node, 1u);
+}
+
+// <-
+
+void NodeManager::updateSpatialIndex(const NodeRef* p_Nodes, uint32_t p_Count)
+{
+  _INTR_PROFILE_CPU("Components", "Update Spatial Index");
+
+  uint32_t reinsertionCount = 0u;
+
+  for (uint32_t i = 0u; i < p_Count; ++i)
+  {
+    const NodeRef nodeRef = p_Nodes[i];
+    uint32_t& proxyId = _spatialIndexProxy(nodeRef);
+
+    if (proxyId == Containers::DynamicAabbTree::kInvalidProxyId)
+    {
+      proxyId = _spatialIndex.createProxy(_worldAABB(nodeRef), nodeRef);
+      ++reinsertionCount;
+    }
+    else if (_spatialIndex.moveProxy(proxyId, _worldAABB(nodeRef)))
+    {
+      ++reinsertionCount;
+    }
+  }
+
+  _INTR_PROFILE_COUNTER_SET("Spatial Index Reinsertions", reinsertionCount);
 }
 }
 }
@@ -29,6 +29,8 @@ namespace NodeFlags
 enum Flags
 {
   kSpawned = 0x01u,
+  kTransformDirty = 0x02u,
+  kTransformChanged = 0x04u
 };
 }
 
@@ -38,55 +40,54 @@ enum Flags
 struct NodeData : Dod::Components::ComponentDataBase
 {
   NodeData()
-      : Dod::Components::ComponentDataBase(_INTR_MAX_NODE_COMPONENT_COUNT)
   {
-    flags.resize(_INTR_MAX_NODE_COMPONENT_COUNT);
+    registerArray(flags);
 
-    position.resize(_INTR_MAX_NODE_COMPONENT_COUNT);
-    orientation.resize(_INTR_MAX_NODE_COMPONENT_COUNT);
-    size.resize(_INTR_MAX_NODE_COMPONENT_COUNT);
+    registerArray(position);
+    registerArray(orientation);
+    registerArray(size);
 
-    worldPosition.resize(_INTR_MAX_NODE_COMPONENT_COUNT);
-    worldOrientation.resize(_INTR_MAX_NODE_COMPONENT_COUNT);
-    worldSize.resize(_INTR_MAX_NODE_COMPONENT_COUNT);
-    worldMatrix.resize(_INTR_MAX_NODE_COMPONENT_COUNT);
-    inverseWorldMatrix.resize(_INTR_MAX_NODE_COMPONENT_COUNT);
+    registerArray(worldPosition);
+    registerArray(worldOrientation);
+    registerArray(worldSize);
+    registerArray(worldMatrix);
+    registerArray(inverseWorldMatrix);
 
-    localAABB.resize(_INTR_MAX_NODE_COMPONENT_COUNT);
-    worldAABB.resize(_INTR_MAX_NODE_COMPONENT_COUNT);
-    worldBoundingSphere.resize(_INTR_MAX_NODE_COMPONENT_COUNT);
+    registerArray(mesh);
+    registerArray(localAABB);
+    registerArray(worldAABB);
+    registerArray(worldBoundingSphere);
+    registerArray(spatialIndexProxy);
 
-    visibilityMask.resize(_INTR_MAX_NODE_COMPONENT_COUNT);
-
-    parent.resize(_INTR_MAX_NODE_COMPONENT_COUNT);
-    firstChild.resize(_INTR_MAX_NODE_COMPONENT_COUNT);
-    prevSibling.resize(_INTR_MAX_NODE_COMPONENT_COUNT);
-    nextSibling.resize(_INTR_MAX_NODE_COMPONENT_COUNT);
+    registerArray(parent);
+    registerArray(firstChild);
+    registerArray(prevSibling);
+    registerArray(nextSibling);
   }
 
   // Resources
-  _INTR_ARRAY(uint32_t) flags;
-
-  _INTR_ARRAY(glm::vec3) position;
-  _INTR_ARRAY(glm::quat) orientation;
-  _INTR_ARRAY(glm::vec3) size;
-
-  _INTR_ARRAY(glm::vec3) worldPosition;
-  _INTR_ARRAY(glm::quat) worldOrientation;
-  _INTR_ARRAY(glm::vec3) worldSize;
-  _INTR_ARRAY(glm::mat4x4) worldMatrix;
-  _INTR_ARRAY(glm::mat4x4) inverseWorldMatrix;
-
-  _INTR_ARRAY(Math::AABB) localAABB;
-  _INTR_ARRAY(Math::AABB) worldAABB;
-  _INTR_ARRAY(Math::Sphere) worldBoundingSphere;
-
-  _INTR_ARRAY(uint32_t) visibilityMask;
-
-  _INTR_ARRAY(NodeRef) parent;
-  _INTR_ARRAY(NodeRef) firstChild;
-  _INTR_ARRAY(NodeRef) prevSibling;
-  _INTR_ARRAY(NodeRef) nextSibling;
+  _INTR_PAGED_ARRAY(uint32_t) flags;
+
+  _INTR_PAGED_ARRAY(glm::vec3) position;
+  _INTR_PAGED_ARRAY(glm::quat) orientation;
+  _INTR_PAGED_ARRAY(glm::vec3) size;
+
+  _INTR_PAGED_ARRAY(glm::vec3) worldPosition;
+  _INTR_PAGED_ARRAY(glm::quat) worldOrientation;
+  _INTR_PAGED_ARRAY(glm::vec3) worldSize;
+  _INTR_PAGED_ARRAY(glm::mat4x4) worldMatrix;
+  _INTR_PAGED_ARRAY(glm::mat4x4) inverseWorldMatrix;
+
+  _INTR_PAGED_ARRAY(Resources::MeshRef) mesh;
+  _INTR_PAGED_ARRAY(Math::AABB) localAABB;
+  _INTR_PAGED_ARRAY(Math::AABB) worldAABB;
+  _INTR_PAGED_ARRAY(Math::Sphere) worldBoundingSphere;
+  _INTR_PAGED_ARRAY(uint32_t) spatialIndexProxy;
+
+  _INTR_PAGED_ARRAY(NodeRef) parent;
+  _INTR_PAGED_ARRAY(NodeRef) firstChild;
+  _INTR_PAGED_ARRAY(NodeRef) prevSibling;
+  _INTR_PAGED_ARRAY(NodeRef) nextSibling;
 };
 
 /**
@@ -118,6 +119,8 @@ struct NodeManager
     _orientation(p_Ref) = _worldOrientation(p_Ref) =
         glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
     _size(p_Ref) = _worldSize(p_Ref) = glm::vec3(1.0f, 1.0f, 1.0f);
+    _mesh(p_Ref) = Resources::MeshRef();
+    _spatialIndexProxy(p_Ref) = Containers::DynamicAabbTree::kInvalidProxyId;
     Math::setAABBZero(_worldAABB(p_Ref));
     Math::setAABBZero(_localAABB(p_Ref));
   }
@@ -219,6 +222,7 @@ struct NodeManager
       }
 
       internalRemoveFromRootNodeArray(currentNode);
+      internalRemoveFromSpatialIndex(currentNode);
 
       // Destroy the actual resource
       Dod::Components::ComponentManagerBase<
@@ -232,25 +236,24 @@ struct NodeManager
   // <-
 
   /**
-   * Rebuilds the internal sorted node array.
+   * Rebuilds the internal sorted node array. The nodes are sorted by their
+   * depth in the hierarchy.
    */
-  _INTR_INLINE static void rebuildTree()
-  {
-    _sortedNodes.clear();
+  static void rebuildTree();
 
-    for (uint32_t i = 0; i < _rootNodes.size(); ++i)
-    {
-      NodeRef currentRootNode = _rootNodes[i];
+  // <-
 
-      NodeRefArray nodes;
-      collectNodes(currentRootNode, _sortedNodes);
-    }
-  }
+  /**
+   * Updates the transformation of a single Node. The transformation of the
+   * parent Node has to be up to date.
+   */
+  static void updateTransform(NodeRef p_Node);
 
   // <-
 
   /**
-   * Updates the transformations for the provided Nodes.
+   * Updates the transformations for the provided Nodes. Parents have to be
+   * located before their children in the array.
    */
   static void updateTransforms(const NodeRefArray& p_Nodes);
 
@@ -259,13 +262,57 @@ struct NodeManager
   /**
    * Updates all transformation for all trees in the manager.
    */
-  _INTR_INLINE static void updateTransforms()
+  static void updateTransforms();
+
+  // <-
+
+  /**
+   * Inserts, moves or removes the proxies of the provided Nodes in the
+   * spatial index. Only Nodes with a mesh attached are part of the index.
+   * Called after the world bounds of the Nodes changed.
+   */
+  static void updateSpatialIndex(const NodeRef* p_Nodes, uint32_t p_Count);
+
+  // <-
+
+  /**
+   * Marks the transformation of the given Node and thus of all its children
+   * dirty. Dirty transformations are updated in the next call to
+   * updateDirtyTransforms(). Can be called from any thread, but only from
+   * frame tasks writing FrameData::kNodeTransforms.
+   */
+  _INTR_INLINE static void markTransformsDirty(NodeRef p_Node)
   {
-    updateTransforms(_sortedNodes);
+    const uint32_t oldFlags =
+        Threading::interlockedOr(_flags(p_Node), NodeFlags::kTransformDirty);
+
+    // Only the thread setting the flag adds the Node
+    if ((oldFlags & NodeFlags::kTransformDirty) == 0u)
+    {
+      std::lock_guard<std::mutex> lock(_dirtyNodesMutex);
+      _dirtyNodes.push_back(p_Node);
+    }
   }
 
   // <-
 
+  /**
+   * Updates the transformations of all dirty Nodes and their children in one
+   * batch. Nodes at the same depth are updated in parallel.
+   */
+  static void updateDirtyTransforms();
+
+  // <-
+
+  /**
+   * Moves the Nodes whose world transformation changed since the last call to
+   * the given array and resets their changed flags. Called by the consumer of
+   * the changed transformations, e.g. when uploading them to the GPU.
+   */
+  static void takeChangedTransforms(NodeRefArray& p_ChangedNodes);
+
+  // <-
+
   /**
    * Updates the transformations recursively starting at the given Node.
    */
@@ -486,6 +533,8 @@ struct NodeManager
     {
       _orientation(p_Ref) = p_WorldOrientation;
     }
+
+    markTransformsDirty(p_Ref);
   }
 
   /**
@@ -506,6 +555,8 @@ struct NodeManager
     {
       _position(p_Ref) = p_WorldPosition;
     }
+
+    markTransformsDirty(p_Ref);
   }
 
   // Scripting interface
@@ -541,6 +592,7 @@ struct NodeManager
                                        const glm::vec3& p_Position)
   {
     _data.position[p_Ref._id] = p_Position;
+    markTransformsDirty(p_Ref);
   }
 
   /**
@@ -558,6 +610,7 @@ struct NodeManager
                                           const glm::quat& p_Orientation)
   {
     _data.orientation[p_Ref._id] = p_Orientation;
+    markTransformsDirty(p_Ref);
   }
 
   /**
@@ -574,6 +627,7 @@ struct NodeManager
   _INTR_INLINE static void setSize(NodeRef p_Ref, const glm::vec3& p_Size)
   {
     _data.size[p_Ref._id] = p_Size;
+    markTransformsDirty(p_Ref);
   }
 
   // Resources
@@ -695,7 +749,18 @@ struct NodeManager
   }
 
   /**
-   * The (local) axis aligned bounding box (AABB).
+   * The mesh resource of the Mesh Component attached to this Node (if any).
+   * Set and reset by the Mesh Component when creating/destroying its
+   * resources.
+   */
+  _INTR_INLINE static Resources::MeshRef& _mesh(NodeRef p_Ref)
+  {
+    return _data.mesh[p_Ref._id];
+  }
+
+  /**
+   * The (local) axis aligned bounding box (AABB). Merged from the AABBs of
+   * all sub meshes if a mesh is attached.
    */
   _INTR_INLINE static Math::AABB& _localAABB(NodeRef p_Ref)
   {
@@ -710,19 +775,50 @@ struct NodeManager
     return _data.worldBoundingSphere[p_Ref._id];
   }
 
-  /** The visibility mask for each node.
-   * Stores the current visibility/culling information where each bit represents
-   * the visibility for an active Frustum in the scene. This is updated during
-   * culling.
+  /**
+   * The id of the proxy in the spatial index or kInvalidProxyId if the Node
+   * is not part of the spatial index.
    */
-  _INTR_INLINE static uint32_t& _visibilityMask(NodeRef p_Ref)
+  _INTR_INLINE static uint32_t& _spatialIndexProxy(NodeRef p_Ref)
   {
-    return _data.visibilityMask[p_Ref._id];
+    return _data.spatialIndexProxy[p_Ref._id];
   }
 
   // <-
 
+  /**
+   * Bounding volume hierarchy over the world AABBs of all Nodes. Nodes
+   * without a mesh use a unit sized AABB around their world position so they
+   * stay part of the per frustum visibility. Kept up to date by the transform
+   * updates and used for culling.
+   */
+  static Containers::DynamicAabbTree _spatialIndex;
+
+  // <-
+
 private:
+  /**
+   * Adds the given Nodes to the changed Node array after their world
+   * transformation has been updated. Called from the worker threads updating
+   * the transformations, so the array is only accessed with the lock held.
+   */
+  _INTR_INLINE static void internalMarkTransformsChanged(const NodeRef* p_Nodes,
+                                                         uint32_t p_Count)
+  {
+    std::lock_guard<std::mutex> lock(_changedNodesMutex);
+
+    for (uint32_t i = 0u; i < p_Count; ++i)
+    {
+      const uint32_t oldFlags = Threading::interlockedOr(
+          _flags(p_Nodes[i]), NodeFlags::kTransformChanged);
+
+      if ((oldFlags & NodeFlags::kTransformChanged) == 0u)
+      {
+        _changedNodes.push_back(p_Nodes[i]);
+      }
+    }
+  }
+
   /**
    * Adds the given Node to the root node array.
    */
@@ -731,6 +827,20 @@ private:
     _rootNodes.push_back(p_Ref);
   }
 
+  /**
+   * Removes the given Node from the spatial index (if contained).
+   */
+  _INTR_INLINE static void internalRemoveFromSpatialIndex(NodeRef p_Ref)
+  {
+    uint32_t& proxyId = _spatialIndexProxy(p_Ref);
+
+    if (proxyId != Containers::DynamicAabbTree::kInvalidProxyId)
+    {
+      _spatialIndex.destroyProxy(proxyId);
+      proxyId = Containers::DynamicAabbTree::kInvalidProxyId;
+    }
+  }
+
   /**
    * Removes the given Node from the root node array.
    */
@@ -760,6 +870,21 @@ private:
    * The sorted nodes of all trees.
    */
   static NodeRefArray _sortedNodes;
+  /**
+   * The offsets to the first Node of each depth in the sorted node array.
+   */
+  static _INTR_ARRAY(uint32_t) _sortedNodesDepthOffsets;
+  /**
+   * The Nodes marked dirty since the last update.
+   */
+  static NodeRefArray _dirtyNodes;
+  static std::mutex _dirtyNodesMutex;
+  /**
+   * The Nodes whose world transformation changed since the last call to
+   * takeChangedTransforms().
+   */
+  static NodeRefArray _changedNodes;
+  static std::mutex _changedNodesMutex;
 };
 }
 }
@@ -27,13 +27,12 @@ typedef _INTR_ARRAY(PlayerRef) PlayerRefArray;
 struct PlayerData : Dod::Components::ComponentDataBase
 {
   PlayerData()
-      : Dod::Components::ComponentDataBase(_INTR_MAX_PLAYER_COMPONENT_COUNT)
   {
-    descPlayerId.resize(_INTR_MAX_PLAYER_COMPONENT_COUNT);
+    registerArray(descPlayerId);
   }
 
   // Description
-  _INTR_ARRAY(uint32_t) descPlayerId;
+  _INTR_PAGED_ARRAY(uint32_t) descPlayerId;
 };
 
 struct PlayerManager
@@ -27,17 +27,15 @@ typedef _INTR_ARRAY(PostEffectVolumeRef) PostEffectVolumeRefArray;
 struct PostEffectVolumeData : Dod::Components::ComponentDataBase
 {
   PostEffectVolumeData()
-      : Dod::Components::ComponentDataBase(
-            _INTR_MAX_POST_EFFECT_CONTROLLER_COMPONENT_COUNT)
   {
-    descPostEffectName.resize(_INTR_MAX_POST_EFFECT_CONTROLLER_COMPONENT_COUNT);
-    descRadius.resize(_INTR_MAX_POST_EFFECT_CONTROLLER_COMPONENT_COUNT);
-    descBlendRange.resize(_INTR_MAX_POST_EFFECT_CONTROLLER_COMPONENT_COUNT);
+    registerArray(descPostEffectName);
+    registerArray(descRadius);
+    registerArray(descBlendRange);
   }
 
-  _INTR_ARRAY(Name) descPostEffectName;
-  _INTR_ARRAY(float) descRadius;
-  _INTR_ARRAY(float) descBlendRange;
+  _INTR_PAGED_ARRAY(Name) descPostEffectName;
+  _INTR_PAGED_ARRAY(float) descRadius;
+  _INTR_PAGED_ARRAY(float) descBlendRange;
 };
 
 struct PostEffectVolumeManager
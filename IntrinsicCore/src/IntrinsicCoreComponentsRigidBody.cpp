@@ -37,14 +37,13 @@ physx::PxMaterial* RigidBodyManager::_defaultMaterial;
 // <-
 
 RigidBodyData::RigidBodyData()
-    : Dod::Components::ComponentDataBase(_INTR_MAX_RIGID_BODY_COMPONENT_COUNT)
 {
   // Description
-  descRigidBodyType.resize(_INTR_MAX_RIGID_BODY_COMPONENT_COUNT);
-  descDensity.resize(_INTR_MAX_RIGID_BODY_COMPONENT_COUNT);
+  registerArray(descRigidBodyType);
+  registerArray(descDensity);
 
   // Resources
-  pxRigidActor.resize(_INTR_MAX_RIGID_BODY_COMPONENT_COUNT);
+  registerArray(pxRigidActor);
 }
 
 // <-
@@ -207,7 +206,7 @@ physx::PxRigidActor* createTriangleMeshStaticKinematic(RigidBodyRef p_Ref,
   {
     _INTR_LOG_WARNING(
         "No physics triangle mesh available for mesh \"%s\"!",
-        Resources::MeshManager::_name(meshRef).getString().c_str());
+        Resources::MeshManager::_name(meshRef).c_str());
     return nullptr;
   }
 
@@ -275,7 +274,7 @@ physx::PxRigidActor* createConvexMeshDynamicKinematic(RigidBodyRef p_Ref,
   {
     _INTR_LOG_WARNING(
         "No physics convex mesh available for mesh \"%s\"!",
-        Resources::MeshManager::_name(meshRef).getString().c_str());
+        Resources::MeshManager::_name(meshRef).c_str());
     return nullptr;
   }
 
@@ -328,7 +327,7 @@ physx::PxRigidActor* createConvexMeshStatic(RigidBodyRef p_Ref)
   {
     _INTR_LOG_WARNING(
         "No physics convex mesh available for mesh \"%s\"!",
-        Resources::MeshManager::_name(meshRef).getString().c_str());
+        Resources::MeshManager::_name(meshRef).c_str());
     return nullptr;
   }
 
@@ -448,8 +447,6 @@ void RigidBodyManager::updateNodesFromActors(
 
       NodeManager::updateFromWorldPosition(nodeCompRef, worldPosition);
       NodeManager::updateFromWorldOrientation(nodeCompRef, worldOrientation);
-
-      NodeManager::updateTransforms(nodeCompRef);
     }
   }
 }
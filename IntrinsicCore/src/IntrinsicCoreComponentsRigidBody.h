@@ -51,11 +51,11 @@ struct RigidBodyData : Dod::Components::ComponentDataBase
   RigidBodyData();
 
   // Description
-  _INTR_ARRAY(RigidBodyType::Enum) descRigidBodyType;
-  _INTR_ARRAY(float) descDensity;
+  _INTR_PAGED_ARRAY(RigidBodyType::Enum) descRigidBodyType;
+  _INTR_PAGED_ARRAY(float) descDensity;
 
   // Resources
-  _INTR_ARRAY(physx::PxRigidActor*) pxRigidActor;
+  _INTR_PAGED_ARRAY(physx::PxRigidActor*) pxRigidActor;
 };
 
 struct RigidBodyManager
@@ -27,18 +27,17 @@ typedef _INTR_ARRAY(ScriptRef) ScriptRefArray;
 struct ScriptData : Dod::Components::ComponentDataBase
 {
   ScriptData()
-      : Dod::Components::ComponentDataBase(_INTR_MAX_SCRIPT_COMPONENT_COUNT)
   {
-    descScriptName.resize(_INTR_MAX_SCRIPT_COMPONENT_COUNT);
+    registerArray(descScriptName);
 
-    script.resize(_INTR_MAX_SCRIPT_COMPONENT_COUNT);
+    registerArray(script);
   }
 
   // Description
-  _INTR_ARRAY(Name) descScriptName;
+  _INTR_PAGED_ARRAY(Name) descScriptName;
 
   // Resources
-  _INTR_ARRAY(Dod::Ref) script;
+  _INTR_PAGED_ARRAY(Dod::Ref) script;
 };
 
 struct ScriptManager
@@ -87,7 +87,7 @@ void SpecularProbeManager::createResources(
             imageToCreate, Dod::Resources::ResourceFlags::kResourceVolatile);
 
         ImageManager::_descFileName(imageToCreate) =
-            specularTextureName.getString();
+            _INTR_STRING(specularTextureName.getString());
         ImageManager::_descDirPath(imageToCreate) = "media/specular_probes/";
         ImageManager::_descImageType(imageToCreate) =
             R::ImageType::kTextureFromFile;
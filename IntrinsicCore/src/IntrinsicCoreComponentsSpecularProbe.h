@@ -36,31 +36,29 @@ typedef _INTR_ARRAY(SpecularProbeRef) SpecularProbeRefArray;
 struct SpecularProbeData : Dod::Components::ComponentDataBase
 {
   SpecularProbeData()
-      : Dod::Components::ComponentDataBase(
-            _INTR_MAX_IRRADIANCE_PROBE_COMPONENT_COUNT)
   {
-    descRadius.resize(_INTR_MAX_IRRADIANCE_PROBE_COMPONENT_COUNT);
-    descPriority.resize(_INTR_MAX_IRRADIANCE_PROBE_COMPONENT_COUNT);
-    descFalloffRangePerc.resize(_INTR_MAX_IRRADIANCE_PROBE_COMPONENT_COUNT);
-    descFalloffExponent.resize(_INTR_MAX_IRRADIANCE_PROBE_COMPONENT_COUNT);
-    descMinExtent.resize(_INTR_MAX_IRRADIANCE_PROBE_COMPONENT_COUNT);
-    descMaxExtent.resize(_INTR_MAX_IRRADIANCE_PROBE_COMPONENT_COUNT);
-    descFlags.resize(_INTR_MAX_IRRADIANCE_PROBE_COMPONENT_COUNT);
-    descSpecularTextureNames.resize(_INTR_MAX_IRRADIANCE_PROBE_COMPONENT_COUNT);
-
-    flags.resize(_INTR_MAX_IRRADIANCE_PROBE_COMPONENT_COUNT);
+    registerArray(descRadius);
+    registerArray(descPriority);
+    registerArray(descFalloffRangePerc);
+    registerArray(descFalloffExponent);
+    registerArray(descMinExtent);
+    registerArray(descMaxExtent);
+    registerArray(descFlags);
+    registerArray(descSpecularTextureNames);
+
+    registerArray(flags);
   }
 
-  _INTR_ARRAY(float) descRadius;
-  _INTR_ARRAY(float) descFalloffRangePerc;
-  _INTR_ARRAY(float) descFalloffExponent;
-  _INTR_ARRAY(glm::vec3) descMinExtent;
-  _INTR_ARRAY(glm::vec3) descMaxExtent;
-  _INTR_ARRAY(_INTR_ARRAY(Name)) descFlags;
-  _INTR_ARRAY(uint32_t) descPriority;
-  _INTR_ARRAY(_INTR_ARRAY(Name)) descSpecularTextureNames;
+  _INTR_PAGED_ARRAY(float) descRadius;
+  _INTR_PAGED_ARRAY(float) descFalloffRangePerc;
+  _INTR_PAGED_ARRAY(float) descFalloffExponent;
+  _INTR_PAGED_ARRAY(glm::vec3) descMinExtent;
+  _INTR_PAGED_ARRAY(glm::vec3) descMaxExtent;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(Name)) descFlags;
+  _INTR_PAGED_ARRAY(uint32_t) descPriority;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(Name)) descSpecularTextureNames;
 
-  _INTR_ARRAY(uint32_t) flags;
+  _INTR_PAGED_ARRAY(uint32_t) flags;
 };
 
 struct SpecularProbeManager
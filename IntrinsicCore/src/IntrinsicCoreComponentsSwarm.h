@@ -41,30 +41,29 @@ struct SwarmData : Dod::Components::ComponentDataBase
   };
 
   SwarmData()
-      : Dod::Components::ComponentDataBase(_INTR_MAX_SWARM_COMPONENT_COUNT)
   {
-    descBoidMeshName.resize(_INTR_MAX_SWARM_COMPONENT_COUNT);
+    registerArray(descBoidMeshName);
 
-    boids.resize(_INTR_MAX_SWARM_COMPONENT_COUNT);
-    nodes.resize(_INTR_MAX_SWARM_COMPONENT_COUNT);
-    lights.resize(_INTR_MAX_SWARM_COMPONENT_COUNT);
-    meshes.resize(_INTR_MAX_SWARM_COMPONENT_COUNT);
+    registerArray(boids);
+    registerArray(nodes);
+    registerArray(lights);
+    registerArray(meshes);
 
-    currentAverageVelocity.resize(_INTR_MAX_SWARM_COMPONENT_COUNT);
-    currentCenterOfMass.resize(_INTR_MAX_SWARM_COMPONENT_COUNT);
+    registerArray(currentAverageVelocity);
+    registerArray(currentCenterOfMass);
   }
 
   // Description
-  _INTR_ARRAY(Name) descBoidMeshName;
+  _INTR_PAGED_ARRAY(Name) descBoidMeshName;
 
   // Resources
-  _INTR_ARRAY(_INTR_ARRAY(Boid)) boids;
-  _INTR_ARRAY(_INTR_ARRAY(NodeRef)) nodes;
-  _INTR_ARRAY(_INTR_ARRAY(Dod::Ref)) lights;
-  _INTR_ARRAY(_INTR_ARRAY(Dod::Ref)) meshes;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(Boid)) boids;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(NodeRef)) nodes;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(Dod::Ref)) lights;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(Dod::Ref)) meshes;
 
-  _INTR_ARRAY(glm::vec3) currentAverageVelocity;
-  _INTR_ARRAY(glm::vec3) currentCenterOfMass;
+  _INTR_PAGED_ARRAY(glm::vec3) currentAverageVelocity;
+  _INTR_PAGED_ARRAY(glm::vec3) currentCenterOfMass;
 };
 
 /**
@@ -0,0 +1,207 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Precompiled header file
+#include "stdafx.h"
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace CullingKernel
+{
+namespace
+{
+_INTR_INLINE uint32_t cullSingle(const Math::FrustumPlanes* p_FrustumPlanes,
+                                 uint32_t p_FrustumCount,
+                                 const SphereSet& p_Spheres, uint32_t p_Idx)
+{
+  const glm::vec3 p =
+      glm::vec3(p_Spheres.x[p_Idx], p_Spheres.y[p_Idx], p_Spheres.z[p_Idx]);
+  const float r = p_Spheres.r[p_Idx];
+
+  uint32_t visibilityMask = 0u;
+  for (uint32_t frustIdx = 0u; frustIdx < p_FrustumCount; ++frustIdx)
+  {
+    const Math::FrustumPlanes& frustumPlanes = p_FrustumPlanes[frustIdx];
+
+    bool culled = false;
+    for (uint32_t i = 0u; i < Math::FrustumPlane::kCount; ++i)
+    {
+      if (glm::dot(frustumPlanes.n[i], p) + frustumPlanes.d[i] < -r)
+      {
+        culled = true;
+        break;
+      }
+    }
+
+    if (!culled)
+    {
+      visibilityMask |= 1u << frustIdx;
+    }
+  }
+
+  return visibilityMask;
+}
+
+// <-
+
+KernelFunction selectKernel()
+{
+  if (Simd::isAvx2Supported())
+  {
+    _INTR_LOG_INFO("Using AVX2 culling kernel...");
+    return cullAvx2;
+  }
+
+  _INTR_LOG_INFO("Using SSE culling kernel...");
+  return cullSse;
+}
+}
+
+// <-
+
+void cullScalar(const Math::FrustumPlanes* p_FrustumPlanes,
+                uint32_t p_FrustumCount, const SphereSet& p_Spheres,
+                uint32_t p_FirstSphere, uint32_t p_EndSphere,
+                uint32_t* p_VisibilityMasks)
+{
+  _INTR_ASSERT(p_FrustumCount <= kMaxFrustumCount);
+
+  for (uint32_t i = p_FirstSphere; i < p_EndSphere; ++i)
+  {
+    p_VisibilityMasks[i] =
+        cullSingle(p_FrustumPlanes, p_FrustumCount, p_Spheres, i);
+  }
+}
+
+// <-
+
+void cullSse(const Math::FrustumPlanes* p_FrustumPlanes,
+             uint32_t p_FrustumCount, const SphereSet& p_Spheres,
+             uint32_t p_FirstSphere, uint32_t p_EndSphere,
+             uint32_t* p_VisibilityMasks)
+{
+  _INTR_ASSERT(p_FrustumCount <= kMaxFrustumCount);
+
+  const __m128 zero = _mm_setzero_ps();
+
+  uint32_t i = p_FirstSphere;
+  for (; i + 4u <= p_EndSphere; i += 4u)
+  {
+    const __m128 x = _mm_loadu_ps(&p_Spheres.x[i]);
+    const __m128 y = _mm_loadu_ps(&p_Spheres.y[i]);
+    const __m128 z = _mm_loadu_ps(&p_Spheres.z[i]);
+    const __m128 negR = _mm_sub_ps(zero, _mm_loadu_ps(&p_Spheres.r[i]));
+
+    __m128i visibilityMasks = _mm_setzero_si128();
+    for (uint32_t frustIdx = 0u; frustIdx < p_FrustumCount; ++frustIdx)
+    {
+      const Math::FrustumPlanes& frustumPlanes = p_FrustumPlanes[frustIdx];
+
+      __m128 culled = _mm_setzero_ps();
+      for (uint32_t planeIdx = 0u; planeIdx < Math::FrustumPlane::kCount;
+           ++planeIdx)
+      {
+        const glm::vec3& n = frustumPlanes.n[planeIdx];
+
+        __m128 dist = Simd::simdMadd(
+            _mm_set1_ps(n.z), z, _mm_set1_ps(frustumPlanes.d[planeIdx]));
+        dist = Simd::simdMadd(_mm_set1_ps(n.y), y, dist);
+        dist = Simd::simdMadd(_mm_set1_ps(n.x), x, dist);
+
+        culled = _mm_or_ps(culled, _mm_cmplt_ps(dist, negR));
+      }
+
+      visibilityMasks = _mm_or_si128(
+          visibilityMasks,
+          _mm_andnot_si128(_mm_castps_si128(culled),
+                           _mm_set1_epi32((int32_t)(1u << frustIdx))));
+    }
+
+    _mm_storeu_si128((__m128i*)&p_VisibilityMasks[i], visibilityMasks);
+  }
+
+  for (; i < p_EndSphere; ++i)
+  {
+    p_VisibilityMasks[i] =
+        cullSingle(p_FrustumPlanes, p_FrustumCount, p_Spheres, i);
+  }
+}
+
+// <-
+
+_INTR_TARGET_AVX2 void cullAvx2(const Math::FrustumPlanes* p_FrustumPlanes,
+                                uint32_t p_FrustumCount,
+                                const SphereSet& p_Spheres,
+                                uint32_t p_FirstSphere, uint32_t p_EndSphere,
+                                uint32_t* p_VisibilityMasks)
+{
+  _INTR_ASSERT(p_FrustumCount <= kMaxFrustumCount);
+
+  const __m256 zero = _mm256_setzero_ps();
+
+  uint32_t i = p_FirstSphere;
+  for (; i + 8u <= p_EndSphere; i += 8u)
+  {
+    const __m256 x = _mm256_loadu_ps(&p_Spheres.x[i]);
+    const __m256 y = _mm256_loadu_ps(&p_Spheres.y[i]);
+    const __m256 z = _mm256_loadu_ps(&p_Spheres.z[i]);
+    const __m256 negR = _mm256_sub_ps(zero, _mm256_loadu_ps(&p_Spheres.r[i]));
+
+    __m256i visibilityMasks = _mm256_setzero_si256();
+    for (uint32_t frustIdx = 0u; frustIdx < p_FrustumCount; ++frustIdx)
+    {
+      const Math::FrustumPlanes& frustumPlanes = p_FrustumPlanes[frustIdx];
+
+      __m256 culled = _mm256_setzero_ps();
+      for (uint32_t planeIdx = 0u; planeIdx < Math::FrustumPlane::kCount;
+           ++planeIdx)
+      {
+        const glm::vec3& n = frustumPlanes.n[planeIdx];
+
+        __m256 dist = _mm256_fmadd_ps(
+            _mm256_set1_ps(n.z), z, _mm256_set1_ps(frustumPlanes.d[planeIdx]));
+        dist = _mm256_fmadd_ps(_mm256_set1_ps(n.y), y, dist);
+        dist = _mm256_fmadd_ps(_mm256_set1_ps(n.x), x, dist);
+
+        culled = _mm256_or_ps(culled, _mm256_cmp_ps(dist, negR, _CMP_LT_OQ));
+      }
+
+      visibilityMasks = _mm256_or_si256(
+          visibilityMasks,
+          _mm256_andnot_si256(_mm256_castps_si256(culled),
+                              _mm256_set1_epi32((int32_t)(1u << frustIdx))));
+    }
+
+    _mm256_storeu_si256((__m256i*)&p_VisibilityMasks[i], visibilityMasks);
+  }
+
+  for (; i < p_EndSphere; ++i)
+  {
+    p_VisibilityMasks[i] =
+        cullSingle(p_FrustumPlanes, p_FrustumCount, p_Spheres, i);
+  }
+}
+
+// <-
+
+KernelFunction getKernel()
+{
+  static const KernelFunction kernel = selectKernel();
+  return kernel;
+}
+}
+}
+}
@@ -0,0 +1,131 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace CullingKernel
+{
+enum
+{
+  // Limited by the bits available in the visibility masks
+  kMaxFrustumCount = 32u
+};
+
+// <-
+
+/**
+ * A set of bounding spheres stored as SoA so multiple spheres can be tested
+ * against the frustum planes with a single instruction.
+ */
+struct SphereSet
+{
+  _INTR_INLINE void add(const Math::Sphere& p_Sphere)
+  {
+    x.push_back(p_Sphere.p.x);
+    y.push_back(p_Sphere.p.y);
+    z.push_back(p_Sphere.p.z);
+    r.push_back(p_Sphere.r);
+  }
+
+  _INTR_INLINE void clear()
+  {
+    x.clear();
+    y.clear();
+    z.clear();
+    r.clear();
+  }
+
+  _INTR_INLINE void reserve(uint32_t p_Count)
+  {
+    x.reserve(p_Count);
+    y.reserve(p_Count);
+    z.reserve(p_Count);
+    r.reserve(p_Count);
+  }
+
+  _INTR_INLINE uint32_t size() const { return (uint32_t)x.size(); }
+
+  // Sphere sets are rebuilt every frame
+  _INTR_FRAME_ARRAY(float) x;
+  _INTR_FRAME_ARRAY(float) y;
+  _INTR_FRAME_ARRAY(float) z;
+  _INTR_FRAME_ARRAY(float) r;
+};
+
+// <-
+
+typedef void (*KernelFunction)(const Math::FrustumPlanes* p_FrustumPlanes,
+                               uint32_t p_FrustumCount,
+                               const SphereSet& p_Spheres,
+                               uint32_t p_FirstSphere, uint32_t p_EndSphere,
+                               uint32_t* p_VisibilityMasks);
+
+/**
+ * Reference implementation testing a single sphere against a single plane at
+ * a time.
+ */
+void cullScalar(const Math::FrustumPlanes* p_FrustumPlanes,
+                uint32_t p_FrustumCount, const SphereSet& p_Spheres,
+                uint32_t p_FirstSphere, uint32_t p_EndSphere,
+                uint32_t* p_VisibilityMasks);
+
+/**
+ * Tests four spheres at a time using SSE.
+ */
+void cullSse(const Math::FrustumPlanes* p_FrustumPlanes,
+             uint32_t p_FrustumCount, const SphereSet& p_Spheres,
+             uint32_t p_FirstSphere, uint32_t p_EndSphere,
+             uint32_t* p_VisibilityMasks);
+
+/**
+ * Tests eight spheres at a time using AVX2. Only call this if
+ * Simd::isAvx2Supported() returns true.
+ */
+void cullAvx2(const Math::FrustumPlanes* p_FrustumPlanes,
+              uint32_t p_FrustumCount, const SphereSet& p_Spheres,
+              uint32_t p_FirstSphere, uint32_t p_EndSphere,
+              uint32_t* p_VisibilityMasks);
+
+// <-
+
+/**
+ * Returns the fastest kernel supported by the CPU. The kernel is selected
+ * once on the first call.
+ */
+KernelFunction getKernel();
+
+// <-
+
+/**
+ * Tests the spheres in the range [p_FirstSphere, p_EndSphere) against all
+ * given frustums in a single pass. Bit i of the resulting visibility mask of
+ * each sphere is set if the sphere intersects frustum i.
+ */
+_INTR_INLINE void cull(const Math::FrustumPlanes* p_FrustumPlanes,
+                       uint32_t p_FrustumCount, const SphereSet& p_Spheres,
+                       uint32_t p_FirstSphere, uint32_t p_EndSphere,
+                       uint32_t* p_VisibilityMasks)
+{
+  static const KernelFunction kernel = getKernel();
+
+  kernel(p_FrustumPlanes, p_FrustumCount, p_Spheres, p_FirstSphere,
+         p_EndSphere, p_VisibilityMasks);
+}
+}
+}
+}
@@ -64,6 +64,7 @@ struct Ref
 
 // Typedefs
 typedef _INTR_ARRAY(Ref) RefArray;
+typedef _INTR_FRAME_ARRAY(Ref) RefFrameArray;
 
 // <-
 
@@ -124,7 +125,37 @@ struct PropertyCompilerEntry
 
 // <-
 
-// Base for all date oriented manager classes
+// Base for all SoA data structs of the managers. Each array has to be
+// registered so the storage can grow in pages when new ids are required
+struct ManagerDataBase
+{
+  template <class T>
+  _INTR_INLINE void registerArray(_INTR_PAGED_ARRAY(T) & p_Array)
+  {
+    _arrays.push_back(&p_Array);
+  }
+
+  _INTR_INLINE void resize(uint32_t p_Size)
+  {
+    for (uint32_t i = 0u; i < _arrays.size(); ++i)
+    {
+      _arrays[i]->resize(p_Size);
+    }
+  }
+
+  _INTR_ARRAY(Containers::PagedArrayBase*) _arrays;
+};
+
+// <-
+
+// Base for all date oriented manager classes. The id count is used as the
+// initial capacity; ids and storage are added in pages on demand.
+//
+// Threading: allocate() and release() may only be called from the main thread
+// while no tasks of the task graph are running - the free id and active ref
+// arrays are plain arrays which can be reallocated. The generations, the
+// dense indices and the registered SoA arrays are paged and never move, so
+// isAlive() and lookups of existing ids stay valid while the storage grows
 template <uint32_t IdCount, class DataType> struct ManagerBase
 {
   _INTR_INLINE static bool isAlive(Ref p_Ref)
@@ -143,24 +174,66 @@ template <uint32_t IdCount, class DataType> struct ManagerBase
     return _activeRefs[p_Idx];
   }
 
+  // Number of ids the storage currently provides, grows in pages
+  _INTR_INLINE static uint32_t getCapacity() { return _generations.size(); }
+
+  // Returns the index of the given ref in the dense active ref array
+  _INTR_INLINE static uint32_t getActiveResourceIndex(Ref p_Ref)
+  {
+    _INTR_ASSERT(isAlive(p_Ref));
+    return _denseIndices[p_Ref._id];
+  }
+
   static _INTR_ARRAY(Ref) _activeRefs;
 
 protected:
-  _INTR_INLINE static void _initManager()
+  _INTR_INLINE static void _initManager(ManagerDataBase* p_Data)
   {
+    _managerData = p_Data;
+
     _freeIds.reserve(IdCount);
     _activeRefs.reserve(IdCount);
-    _generations.resize(IdCount);
+  }
+
+  // <-
+
+  _INTR_INLINE static void _growPage()
+  {
+    const uint32_t pageSize = 1u << _INTR_PAGED_ARRAY_PAGE_SIZE_LOG2;
+    const uint32_t maxCapacity =
+        std::min(maxIdValue + 1u, _INTR_PAGED_ARRAY_MAX_PAGE_COUNT * pageSize);
+    const uint32_t capacity = _generations.size();
+    _INTR_FATAL_CHECK(capacity < maxCapacity, "Resource pool exhausted");
 
-    for (uint32_t i = 0u; i < IdCount; ++i)
+    const uint32_t newCapacity = std::min(capacity + pageSize, maxCapacity);
+
+    _generations.resize(newCapacity);
+    _denseIndices.resize(newCapacity);
+    for (uint32_t id = capacity; id < newCapacity; ++id)
     {
-      _freeIds.push_back(IdCount - i - 1u);
+      _denseIndices[id] = kInvalidId;
+    }
+
+    if (_managerData != nullptr)
+    {
+      _managerData->resize(newCapacity);
+    }
+
+    for (uint32_t id = newCapacity; id > capacity; --id)
+    {
+      _freeIds.push_back(id - 1u);
     }
   }
 
+  // <-
+
   _INTR_INLINE static Ref allocate()
   {
-    _INTR_ASSERT(!_freeIds.empty() && "Resource pool exhausted");
+    if (_freeIds.empty())
+    {
+      _growPage();
+    }
+
     uint32_t id = _freeIds.back();
     _freeIds.pop_back();
 
@@ -168,6 +241,7 @@ protected:
     ref._id = id;
     ref._generation = _generations[id];
 
+    _denseIndices[id] = (uint32_t)_activeRefs.size();
     _activeRefs.push_back(ref);
 
     return ref;
@@ -177,17 +251,17 @@ protected:
   {
     _INTR_ASSERT(p_Ref.isValid() && isAlive(p_Ref));
 
-    // Erase an swap
-    for (uint32_t i = 0; i < _activeRefs.size(); ++i)
-    {
-      if (_activeRefs[i] == p_Ref)
-      {
-        _activeRefs[i] = _activeRefs[_activeRefs.size() - 1u];
-        _activeRefs.resize(_activeRefs.size() - 1u);
-        break;
-      }
-    }
+    // Erase and swap using the sparse set
+    const uint32_t denseIdx = _denseIndices[p_Ref._id];
+    _INTR_ASSERT(denseIdx < _activeRefs.size() &&
+                 _activeRefs[denseIdx] == p_Ref);
+
+    const Ref lastRef = _activeRefs.back();
+    _activeRefs[denseIdx] = lastRef;
+    _denseIndices[lastRef._id] = denseIdx;
+    _activeRefs.pop_back();
 
+    _denseIndices[p_Ref._id] = kInvalidId;
     _freeIds.push_back(p_Ref._id);
 
     const GenerationType currentGenId = _generations[p_Ref._id];
@@ -195,7 +269,12 @@ protected:
   }
 
   static _INTR_ARRAY(IdType) _freeIds;
-  static _INTR_ARRAY(GenerationType) _generations;
+  static _INTR_PAGED_ARRAY(GenerationType) _generations;
+  // Sparse set mapping ids to indices in the dense active ref array
+  static _INTR_PAGED_ARRAY(uint32_t) _denseIndices;
+
+private:
+  static ManagerDataBase* _managerData;
 };
 
 // <-
@@ -207,8 +286,13 @@ template <uint32_t IdCount, class DataType>
 _INTR_ARRAY(Ref)
 ManagerBase<IdCount, DataType>::_activeRefs;
 template <uint32_t IdCount, class DataType>
-_INTR_ARRAY(GenerationType)
+_INTR_PAGED_ARRAY(GenerationType)
 ManagerBase<IdCount, DataType>::_generations;
+template <uint32_t IdCount, class DataType>
+_INTR_PAGED_ARRAY(uint32_t)
+ManagerBase<IdCount, DataType>::_denseIndices;
+template <uint32_t IdCount, class DataType>
+ManagerDataBase* ManagerBase<IdCount, DataType>::_managerData = nullptr;
 }
 }
 }
@@ -26,11 +26,11 @@ typedef Ref (*ManagerGetComponentForEntityFunction)(Ref);
 
 // <-
 
-struct ComponentDataBase
+struct ComponentDataBase : Dod::ManagerDataBase
 {
-  ComponentDataBase(uint32_t p_Size) { entity.resize(p_Size); }
+  ComponentDataBase() { registerArray(entity); }
 
-  _INTR_ARRAY(Entity::EntityRef) entity;
+  _INTR_PAGED_ARRAY(Entity::EntityRef) entity;
 };
 
 // <-
@@ -47,21 +47,139 @@ struct ComponentManagerEntry : ManagerEntry
 
 // <-
 
-template <class DataType, uint32_t IdCount>
-struct ComponentManagerBase : Dod::ManagerBase<IdCount, DataType>
+// Maps entity ids to component refs. Entity ids are dense indices so the
+// lookup is a single load from a flat array. If
+// _INTR_PAGED_ENTITY_COMPONENT_TABLES is defined, the table is split into
+// pages which are only allocated once they hold a component
+struct EntityComponentTable
 {
-  typedef _INTR_HASH_MAP(uint32_t, Ref) EntityComponentMap;
+#if defined(_INTR_PAGED_ENTITY_COMPONENT_TABLES)
+  enum
+  {
+    kPageSizeLog2 = _INTR_PAGED_ARRAY_PAGE_SIZE_LOG2,
+    kPageSize = 1u << kPageSizeLog2,
+    kPageMask = kPageSize - 1u
+  };
 
-  _INTR_INLINE static Ref getComponentForEntity(Entity::EntityRef p_Entity)
+  ~EntityComponentTable()
+  {
+    for (uint32_t i = 0u; i < _pages.size(); ++i)
+    {
+      if (_pages[i] != nullptr)
+      {
+        Memory::Tlsf::MainAllocator::free(_pages[i]);
+      }
+    }
+  }
+
+  // <-
+
+  _INTR_INLINE void reserve(uint32_t p_EntityCount)
+  {
+    _pages.reserve((p_EntityCount + kPageMask) >> kPageSizeLog2);
+  }
+
+  // <-
+
+  _INTR_INLINE Ref get(uint32_t p_EntityId) const
+  {
+    const uint32_t pageIdx = p_EntityId >> kPageSizeLog2;
+
+    if (pageIdx >= _pages.size() || _pages[pageIdx] == nullptr)
+    {
+      return Ref();
+    }
+
+    return _pages[pageIdx][p_EntityId & kPageMask];
+  }
+
+  // <-
+
+  _INTR_INLINE void set(uint32_t p_EntityId, Ref p_Ref)
+  {
+    const uint32_t pageIdx = p_EntityId >> kPageSizeLog2;
+
+    if (pageIdx >= _pages.size())
+    {
+      _pages.resize(pageIdx + 1u, nullptr);
+    }
+
+    if (_pages[pageIdx] == nullptr)
+    {
+      Ref* page = (Ref*)Memory::Tlsf::MainAllocator::allocate(kPageSize *
+                                                              sizeof(Ref));
+      for (uint32_t i = 0u; i < kPageSize; ++i)
+      {
+        new (&page[i]) Ref();
+      }
+      _pages[pageIdx] = page;
+    }
+
+    _pages[pageIdx][p_EntityId & kPageMask] = p_Ref;
+  }
+
+  // <-
+
+  _INTR_INLINE void reset(uint32_t p_EntityId)
+  {
+    const uint32_t pageIdx = p_EntityId >> kPageSizeLog2;
+
+    if (pageIdx < _pages.size() && _pages[pageIdx] != nullptr)
+    {
+      _pages[pageIdx][p_EntityId & kPageMask] = Ref();
+    }
+  }
+
+private:
+  _INTR_ARRAY(Ref*) _pages;
+#else
+  _INTR_INLINE void reserve(uint32_t p_EntityCount)
+  {
+    _refs.reserve(p_EntityCount);
+  }
+
+  // <-
+
+  _INTR_INLINE Ref get(uint32_t p_EntityId) const
+  {
+    return p_EntityId < _refs.size() ? _refs[p_EntityId] : Ref();
+  }
+
+  // <-
+
+  _INTR_INLINE void set(uint32_t p_EntityId, Ref p_Ref)
   {
-    auto componentIt = _entityComponentMap.find(p_Entity._id);
+    if (p_EntityId >= _refs.size())
+    {
+      _refs.resize(p_EntityId + 1u);
+    }
+
+    _refs[p_EntityId] = p_Ref;
+  }
 
-    if (componentIt == _entityComponentMap.end())
+  // <-
+
+  _INTR_INLINE void reset(uint32_t p_EntityId)
+  {
+    if (p_EntityId < _refs.size())
     {
-      return Dod::Ref();
+      _refs[p_EntityId] = Ref();
     }
+  }
 
-    return componentIt->second;
+private:
+  _INTR_ARRAY(Ref) _refs;
+#endif // _INTR_PAGED_ENTITY_COMPONENT_TABLES
+};
+
+// <-
+
+template <class DataType, uint32_t IdCount>
+struct ComponentManagerBase : Dod::ManagerBase<IdCount, DataType>
+{
+  _INTR_INLINE static Ref getComponentForEntity(Entity::EntityRef p_Entity)
+  {
+    return _entityComponentTable.get(p_Entity._id);
   }
 
   _INTR_INLINE static Entity::EntityRef& _entity(Ref p_Ref)
@@ -72,35 +190,100 @@ struct ComponentManagerBase : Dod::ManagerBase<IdCount, DataType>
 protected:
   _INTR_INLINE static void _initComponentManager()
   {
-    Dod::ManagerBase<IdCount, DataType>::_initManager();
-    _entityComponentMap.reserve(IdCount);
+    Dod::ManagerBase<IdCount, DataType>::_initManager(&_data);
+    _entityComponentTable.reserve(_INTR_MAX_ENTITY_COUNT);
   }
 
   _INTR_INLINE static Ref _createComponent(Entity::EntityRef p_ParentEntity)
   {
     Ref ref = Dod::ManagerBase<IdCount, DataType>::allocate();
     _data.entity[ref._id] = p_ParentEntity;
-    _entityComponentMap[p_ParentEntity._id] = ref;
+    _entityComponentTable.set(p_ParentEntity._id, ref);
     return ref;
   }
 
   _INTR_INLINE static void _destroyComponent(Ref p_Ref)
   {
     Entity::EntityRef entity = _entity(p_Ref);
-    _entityComponentMap.erase(entity._id);
+    _entityComponentTable.reset(entity._id);
 
     Dod::ManagerBase<IdCount, DataType>::release(p_Ref);
   }
 
-  static EntityComponentMap _entityComponentMap;
+  static EntityComponentTable _entityComponentTable;
   static DataType _data;
 };
 
 template <class DataType, uint32_t IdCount>
 DataType ComponentManagerBase<DataType, IdCount>::_data;
 template <class DataType, uint32_t IdCount>
-_INTR_HASH_MAP(uint32_t, Ref)
-ComponentManagerBase<DataType, IdCount>::_entityComponentMap;
+EntityComponentTable
+    ComponentManagerBase<DataType, IdCount>::_entityComponentTable;
+
+// <-
+
+// Walks all components of the first manager whose entity also holds a
+// component of the second manager, e.g. all Mesh Components with a Node:
+//
+// for (ComponentJoin<MeshManager, NodeManager> join; join.isValid();
+//      join.next())
+//
+// The components of the first manager are visited in the order of its active
+// refs, the components of the second manager are fetched from the entity to
+// component table
+template <class FirstManager, class SecondManager> struct ComponentJoin
+{
+  ComponentJoin() : _idx(0u), _endIdx(FirstManager::getActiveResourceCount())
+  {
+    advance();
+  }
+
+  // Only joins the active components of the first manager in the range
+  // [p_FirstIdx, p_EndIdx), e.g. for splitting a join across multiple jobs
+  ComponentJoin(uint32_t p_FirstIdx, uint32_t p_EndIdx)
+      : _idx(p_FirstIdx), _endIdx(p_EndIdx)
+  {
+    advance();
+  }
+
+  // <-
+
+  _INTR_INLINE bool isValid() const { return _idx < _endIdx; }
+
+  // <-
+
+  _INTR_INLINE void next()
+  {
+    ++_idx;
+    advance();
+  }
+
+  // <-
+
+  _INTR_INLINE Ref first() const { return _first; }
+  _INTR_INLINE Ref second() const { return _second; }
+
+private:
+  _INTR_INLINE void advance()
+  {
+    for (; _idx < _endIdx; ++_idx)
+    {
+      _first = FirstManager::getActiveResourceAtIndex(_idx);
+      _second =
+          SecondManager::getComponentForEntity(FirstManager::_entity(_first));
+
+      if (_second.isValid())
+      {
+        return;
+      }
+    }
+  }
+
+  uint32_t _idx;
+  uint32_t _endIdx;
+  Ref _first;
+  Ref _second;
+};
 }
 }
 }
@@ -42,16 +42,16 @@ enum Flags
 
 // <-
 
-struct ResourceDataBase
+struct ResourceDataBase : Dod::ManagerDataBase
 {
-  ResourceDataBase(uint32_t p_Size)
+  ResourceDataBase()
   {
-    name.resize(p_Size);
-    resourceFlags.resize(p_Size);
+    registerArray(name);
+    registerArray(resourceFlags);
   }
 
-  _INTR_ARRAY(Name) name;
-  _INTR_ARRAY(uint8_t) resourceFlags;
+  _INTR_PAGED_ARRAY(Name) name;
+  _INTR_PAGED_ARRAY(uint8_t) resourceFlags;
 };
 
 // <-
@@ -90,8 +90,8 @@ struct ResourceManagerBase : Dod::ManagerBase<IdCount, DataType>
     {
       _INTR_LOG_WARNING("Resource '%s' not found - falling back to default "
                         "resource '%s'...",
-                        p_Name.getString().c_str(),
-                        _defaultResourceName.getString().c_str());
+                        p_Name.c_str(),
+                        _defaultResourceName.c_str());
       resourceIt = _nameResourceMap.find(_defaultResourceName);
     }
 
@@ -141,7 +141,7 @@ struct ResourceManagerBase : Dod::ManagerBase<IdCount, DataType>
 protected:
   _INTR_INLINE static void _initResourceManager()
   {
-    Dod::ManagerBase<IdCount, DataType>::_initManager();
+    Dod::ManagerBase<IdCount, DataType>::_initManager(&_data);
   }
 
   // <-
@@ -224,7 +224,7 @@ protected:
 
       rapidjson::Value resource = rapidjson::Value(rapidjson::kObjectType);
       rapidjson::Value nameValue;
-      nameValue.SetString(name.getString().c_str(), resources.GetAllocator());
+      nameValue.SetString(name.c_str(), resources.GetAllocator());
 
       resource.AddMember("name", nameValue, resources.GetAllocator());
 
@@ -331,7 +331,7 @@ protected:
 
     rapidjson::Document resource = rapidjson::Document(rapidjson::kObjectType);
     rapidjson::Value nameValue;
-    nameValue.SetString(name.getString().c_str(), resource.GetAllocator());
+    nameValue.SetString(name.c_str(), resource.GetAllocator());
 
     resource.AddMember("name", nameValue, resource.GetAllocator());
 
@@ -341,7 +341,8 @@ protected:
     resource.AddMember("properties", properties, resource.GetAllocator());
 
     _INTR_STRING fileName =
-        _INTR_STRING(p_Path) + name.getString() + _INTR_STRING(p_Extension);
+        _INTR_STRING(p_Path) + _INTR_STRING(name.getString()) +
+        _INTR_STRING(p_Extension);
 
     FILE* fp = fopen(fileName.c_str(), "wb");
 
@@ -0,0 +1,514 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Precompiled header file
+#include "stdafx.h"
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace Containers
+{
+namespace
+{
+// Fattened AABBs are enlarged by this fraction of their extent plus a
+// constant margin so small movements don't require reinsertions
+const float _fatAABBRelativeMargin = 0.1f;
+const float _fatAABBMinMargin = 0.1f;
+
+// Proxies are reinserted if their fattened AABB grows this much larger than
+// the one computed from the current AABB (e.g. after shrinking)
+const float _fatAABBMaxOversize = 2.0f;
+
+const uint32_t _maxTraversalStackSize = 128u;
+const uint32_t _allFrustumPlanesMask = (1u << Math::FrustumPlane::kCount) - 1u;
+
+_INTR_INLINE Math::AABB calcFatAABB(const Math::AABB& p_AABB)
+{
+  const glm::vec3 margin =
+      (p_AABB.max - p_AABB.min) * _fatAABBRelativeMargin +
+      _fatAABBMinMargin;
+  return Math::AABB(p_AABB.min - margin, p_AABB.max + margin);
+}
+
+// <-
+
+_INTR_INLINE Math::AABB mergeAABBs(const Math::AABB& p_AABB0,
+                                   const Math::AABB& p_AABB1)
+{
+  return Math::AABB(Math::calcVecMin(p_AABB0.min, p_AABB1.min),
+                    Math::calcVecMax(p_AABB0.max, p_AABB1.max));
+}
+
+// <-
+
+// Tests the AABB against the planes in p_PlaneMask and returns the mask of
+// the planes the AABB is intersecting. Returns (uint32_t)-1 if the AABB is
+// fully outside
+_INTR_INLINE uint32_t cullAABB(const Math::FrustumPlanes& p_FrustumPlanes,
+                               const Math::AABB& p_AABB, uint32_t p_PlaneMask)
+{
+  const glm::vec3 center = Math::calcAABBCenter(p_AABB);
+  const glm::vec3 halfExtent = Math::calcAABBHalfExtent(p_AABB);
+
+  uint32_t intersectingPlaneMask = 0u;
+  for (uint32_t planeIdx = 0u; planeIdx < Math::FrustumPlane::kCount;
+       ++planeIdx)
+  {
+    const uint32_t planeBit = 1u << planeIdx;
+    if ((p_PlaneMask & planeBit) == 0u)
+    {
+      continue;
+    }
+
+    const glm::vec3& n = p_FrustumPlanes.n[planeIdx];
+    const float dist = glm::dot(n, center) + p_FrustumPlanes.d[planeIdx];
+    const float radius = glm::dot(glm::abs(n), halfExtent);
+
+    if (dist < -radius)
+    {
+      return (uint32_t)-1;
+    }
+    if (dist < radius)
+    {
+      intersectingPlaneMask |= planeBit;
+    }
+  }
+
+  return intersectingPlaneMask;
+}
+}
+
+// <-
+
+DynamicAabbTree::DynamicAabbTree()
+    : _rootIdx(kInvalidProxyId), _freeListIdx(kInvalidProxyId),
+      _proxyCount(0u)
+{
+}
+
+// <-
+
+uint32_t DynamicAabbTree::createProxy(const Math::AABB& p_AABB,
+                                      Dod::Ref p_Ref)
+{
+  const uint32_t proxyId = allocateNode();
+
+  TreeNode& node = _nodes[proxyId];
+  node.aabb = calcFatAABB(p_AABB);
+  node.ref = p_Ref;
+  node.height = 0u;
+
+  insertLeaf(proxyId);
+  ++_proxyCount;
+
+  return proxyId;
+}
+
+// <-
+
+void DynamicAabbTree::destroyProxy(uint32_t p_ProxyId)
+{
+  _INTR_ASSERT(p_ProxyId < _nodes.size() && _nodes[p_ProxyId].isLeaf());
+
+  removeLeaf(p_ProxyId);
+  freeNode(p_ProxyId);
+  --_proxyCount;
+}
+
+// <-
+
+bool DynamicAabbTree::moveProxy(uint32_t p_ProxyId, const Math::AABB& p_AABB)
+{
+  _INTR_ASSERT(p_ProxyId < _nodes.size() && _nodes[p_ProxyId].isLeaf());
+
+  const Math::AABB& fatAABB = _nodes[p_ProxyId].aabb;
+  if (Math::isAABBContained(fatAABB, p_AABB))
+  {
+    const Math::AABB newFatAABB = calcFatAABB(p_AABB);
+    if (Math::calcAABBSurfaceArea(fatAABB) <=
+        Math::calcAABBSurfaceArea(newFatAABB) * _fatAABBMaxOversize)
+    {
+      return false;
+    }
+  }
+
+  removeLeaf(p_ProxyId);
+  _nodes[p_ProxyId].aabb = calcFatAABB(p_AABB);
+  insertLeaf(p_ProxyId);
+
+  return true;
+}
+
+// <-
+
+void DynamicAabbTree::cullFrustum(const Math::FrustumPlanes& p_FrustumPlanes,
+                                  _INTR_ARRAY(Dod::Ref) & p_Inside,
+                                  _INTR_ARRAY(Dod::Ref) &
+                                      p_Intersecting) const
+{
+  if (_rootIdx == kInvalidProxyId)
+  {
+    return;
+  }
+
+  // Stores the node index and the mask of the planes which still have to be
+  // tested for the sub tree. A mask of zero marks sub trees which are fully
+  // inside the frustum
+  uint32_t stack[_maxTraversalStackSize][2];
+  uint32_t stackSize = 0u;
+
+  stack[stackSize][0] = _rootIdx;
+  stack[stackSize][1] = _allFrustumPlanesMask;
+  ++stackSize;
+
+  while (stackSize > 0u)
+  {
+    --stackSize;
+    const TreeNode& node = _nodes[stack[stackSize][0]];
+    uint32_t planeMask = stack[stackSize][1];
+
+    if (planeMask != 0u)
+    {
+      planeMask = cullAABB(p_FrustumPlanes, node.aabb, planeMask);
+
+      if (planeMask == (uint32_t)-1)
+      {
+        continue;
+      }
+    }
+
+    if (node.isLeaf())
+    {
+      if (planeMask == 0u)
+      {
+        p_Inside.push_back(node.ref);
+      }
+      else
+      {
+        p_Intersecting.push_back(node.ref);
+      }
+      continue;
+    }
+
+    _INTR_ASSERT(stackSize + 2u <= _maxTraversalStackSize &&
+                 "Traversal stack overflow");
+
+    stack[stackSize][0] = node.child0;
+    stack[stackSize][1] = planeMask;
+    ++stackSize;
+    stack[stackSize][0] = node.child1;
+    stack[stackSize][1] = planeMask;
+    ++stackSize;
+  }
+}
+
+// <-
+
+uint32_t DynamicAabbTree::allocateNode()
+{
+  uint32_t nodeIdx;
+
+  if (_freeListIdx != kInvalidProxyId)
+  {
+    nodeIdx = _freeListIdx;
+    _freeListIdx = _nodes[nodeIdx].parent;
+  }
+  else
+  {
+    nodeIdx = (uint32_t)_nodes.size();
+    _nodes.push_back(TreeNode());
+  }
+
+  TreeNode& node = _nodes[nodeIdx];
+  node.parent = kInvalidProxyId;
+  node.child0 = kInvalidProxyId;
+  node.child1 = kInvalidProxyId;
+  node.height = 0u;
+  node.ref = Dod::Ref();
+
+  return nodeIdx;
+}
+
+// <-
+
+void DynamicAabbTree::freeNode(uint32_t p_NodeIdx)
+{
+  _nodes[p_NodeIdx].parent = _freeListIdx;
+  _freeListIdx = p_NodeIdx;
+}
+
+// <-
+
+void DynamicAabbTree::insertLeaf(uint32_t p_LeafIdx)
+{
+  if (_rootIdx == kInvalidProxyId)
+  {
+    _rootIdx = p_LeafIdx;
+    _nodes[_rootIdx].parent = kInvalidProxyId;
+    return;
+  }
+
+  // Descend to the sibling with the lowest surface area cost
+  const Math::AABB leafAABB = _nodes[p_LeafIdx].aabb;
+  uint32_t nodeIdx = _rootIdx;
+
+  while (!_nodes[nodeIdx].isLeaf())
+  {
+    const TreeNode& node = _nodes[nodeIdx];
+
+    const float area = Math::calcAABBSurfaceArea(node.aabb);
+    const float combinedArea =
+        Math::calcAABBSurfaceArea(mergeAABBs(node.aabb, leafAABB));
+
+    // Cost of creating a new parent for this node and the new leaf
+    const float cost = 2.0f * combinedArea;
+
+    // Minimum cost of pushing the leaf further down the tree
+    const float inheritanceCost = 2.0f * (combinedArea - area);
+
+    float childCosts[2];
+    const uint32_t children[2] = {node.child0, node.child1};
+    for (uint32_t i = 0u; i < 2u; ++i)
+    {
+      const TreeNode& child = _nodes[children[i]];
+      const float mergedArea =
+          Math::calcAABBSurfaceArea(mergeAABBs(child.aabb, leafAABB));
+
+      childCosts[i] = inheritanceCost +
+                      (child.isLeaf() ? mergedArea
+                                      : mergedArea - Math::calcAABBSurfaceArea(
+                                                         child.aabb));
+    }
+
+    if (cost < childCosts[0] && cost < childCosts[1])
+    {
+      break;
+    }
+
+    nodeIdx = childCosts[0] < childCosts[1] ? children[0] : children[1];
+  }
+
+  // Create a new parent for the sibling and the leaf
+  const uint32_t siblingIdx = nodeIdx;
+  const uint32_t oldParentIdx = _nodes[siblingIdx].parent;
+  const uint32_t newParentIdx = allocateNode();
+
+  TreeNode& newParent = _nodes[newParentIdx];
+  newParent.parent = oldParentIdx;
+  newParent.aabb = mergeAABBs(leafAABB, _nodes[siblingIdx].aabb);
+  newParent.height = _nodes[siblingIdx].height + 1u;
+  newParent.child0 = siblingIdx;
+  newParent.child1 = p_LeafIdx;
+
+  if (oldParentIdx != kInvalidProxyId)
+  {
+    TreeNode& oldParent = _nodes[oldParentIdx];
+    if (oldParent.child0 == siblingIdx)
+    {
+      oldParent.child0 = newParentIdx;
+    }
+    else
+    {
+      oldParent.child1 = newParentIdx;
+    }
+  }
+  else
+  {
+    _rootIdx = newParentIdx;
+  }
+
+  _nodes[siblingIdx].parent = newParentIdx;
+  _nodes[p_LeafIdx].parent = newParentIdx;
+
+  refitAncestors(newParentIdx);
+}
+
+// <-
+
+void DynamicAabbTree::removeLeaf(uint32_t p_LeafIdx)
+{
+  if (p_LeafIdx == _rootIdx)
+  {
+    _rootIdx = kInvalidProxyId;
+    return;
+  }
+
+  const uint32_t parentIdx = _nodes[p_LeafIdx].parent;
+  const uint32_t grandParentIdx = _nodes[parentIdx].parent;
+  const uint32_t siblingIdx = _nodes[parentIdx].child0 == p_LeafIdx
+                                  ? _nodes[parentIdx].child1
+                                  : _nodes[parentIdx].child0;
+
+  // Replace the parent with the sibling
+  if (grandParentIdx != kInvalidProxyId)
+  {
+    TreeNode& grandParent = _nodes[grandParentIdx];
+    if (grandParent.child0 == parentIdx)
+    {
+      grandParent.child0 = siblingIdx;
+    }
+    else
+    {
+      grandParent.child1 = siblingIdx;
+    }
+    _nodes[siblingIdx].parent = grandParentIdx;
+    freeNode(parentIdx);
+
+    refitAncestors(grandParentIdx);
+  }
+  else
+  {
+    _rootIdx = siblingIdx;
+    _nodes[siblingIdx].parent = kInvalidProxyId;
+    freeNode(parentIdx);
+  }
+}
+
+// <-
+
+void DynamicAabbTree::refitAncestors(uint32_t p_NodeIdx)
+{
+  for (uint32_t nodeIdx = p_NodeIdx; nodeIdx != kInvalidProxyId;)
+  {
+    nodeIdx = balance(nodeIdx);
+
+    TreeNode& node = _nodes[nodeIdx];
+    const TreeNode& child0 = _nodes[node.child0];
+    const TreeNode& child1 = _nodes[node.child1];
+
+    node.height = 1u + std::max(child0.height, child1.height);
+    node.aabb = mergeAABBs(child0.aabb, child1.aabb);
+
+    nodeIdx = node.parent;
+  }
+}
+
+// <-
+
+uint32_t DynamicAabbTree::balance(uint32_t p_NodeIdx)
+{
+  TreeNode& a = _nodes[p_NodeIdx];
+  if (a.isLeaf() || a.height < 2u)
+  {
+    return p_NodeIdx;
+  }
+
+  const uint32_t bIdx = a.child0;
+  const uint32_t cIdx = a.child1;
+  TreeNode& b = _nodes[bIdx];
+  TreeNode& c = _nodes[cIdx];
+
+  const int32_t heightDiff = (int32_t)c.height - (int32_t)b.height;
+
+  if (heightDiff > 1)
+  {
+    // Rotate C up
+    const uint32_t fIdx = c.child0;
+    const uint32_t gIdx = c.child1;
+    TreeNode& f = _nodes[fIdx];
+    TreeNode& g = _nodes[gIdx];
+
+    c.child0 = p_NodeIdx;
+    c.parent = a.parent;
+    a.parent = cIdx;
+
+    if (c.parent != kInvalidProxyId)
+    {
+      TreeNode& cParent = _nodes[c.parent];
+      if (cParent.child0 == p_NodeIdx)
+      {
+        cParent.child0 = cIdx;
+      }
+      else
+      {
+        cParent.child1 = cIdx;
+      }
+    }
+    else
+    {
+      _rootIdx = cIdx;
+    }
+
+    // Keep the higher child of C and move the lower one to A
+    const uint32_t keptIdx = f.height > g.height ? fIdx : gIdx;
+    const uint32_t movedIdx = f.height > g.height ? gIdx : fIdx;
+    TreeNode& kept = _nodes[keptIdx];
+    TreeNode& moved = _nodes[movedIdx];
+
+    c.child1 = keptIdx;
+    a.child1 = movedIdx;
+    moved.parent = p_NodeIdx;
+
+    a.aabb = mergeAABBs(b.aabb, moved.aabb);
+    c.aabb = mergeAABBs(a.aabb, kept.aabb);
+    a.height = 1u + std::max(b.height, moved.height);
+    c.height = 1u + std::max(a.height, kept.height);
+
+    return cIdx;
+  }
+
+  if (heightDiff < -1)
+  {
+    // Rotate B up
+    const uint32_t dIdx = b.child0;
+    const uint32_t eIdx = b.child1;
+    TreeNode& d = _nodes[dIdx];
+    TreeNode& e = _nodes[eIdx];
+
+    b.child0 = p_NodeIdx;
+    b.parent = a.parent;
+    a.parent = bIdx;
+
+    if (b.parent != kInvalidProxyId)
+    {
+      TreeNode& bParent = _nodes[b.parent];
+      if (bParent.child0 == p_NodeIdx)
+      {
+        bParent.child0 = bIdx;
+      }
+      else
+      {
+        bParent.child1 = bIdx;
+      }
+    }
+    else
+    {
+      _rootIdx = bIdx;
+    }
+
+    // Keep the higher child of B and move the lower one to A
+    const uint32_t keptIdx = d.height > e.height ? dIdx : eIdx;
+    const uint32_t movedIdx = d.height > e.height ? eIdx : dIdx;
+    TreeNode& kept = _nodes[keptIdx];
+    TreeNode& moved = _nodes[movedIdx];
+
+    b.child1 = keptIdx;
+    a.child0 = movedIdx;
+    moved.parent = p_NodeIdx;
+
+    a.aabb = mergeAABBs(c.aabb, moved.aabb);
+    b.aabb = mergeAABBs(a.aabb, kept.aabb);
+    a.height = 1u + std::max(c.height, moved.height);
+    b.height = 1u + std::max(a.height, kept.height);
+
+    return bIdx;
+  }
+
+  return p_NodeIdx;
+}
+}
+}
+}
@@ -0,0 +1,112 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace Containers
+{
+/**
+ * Bounding volume hierarchy of fattened AABBs which is updated incrementally.
+ * Each leaf (proxy) references a Dod resource. Moving a proxy only touches
+ * the tree if its new AABB leaves the fattened AABB stored in the tree.
+ * Rotations keep the tree balanced during insertions and removals.
+ */
+struct DynamicAabbTree
+{
+  static const uint32_t kInvalidProxyId = (uint32_t)-1;
+
+  DynamicAabbTree();
+
+  // <-
+
+  /**
+   * Inserts a new proxy and returns its id.
+   */
+  uint32_t createProxy(const Math::AABB& p_AABB, Dod::Ref p_Ref);
+
+  // <-
+
+  /**
+   * Removes the given proxy from the tree.
+   */
+  void destroyProxy(uint32_t p_ProxyId);
+
+  // <-
+
+  /**
+   * Updates the AABB of the given proxy. Returns true if the proxy had to be
+   * reinserted.
+   */
+  bool moveProxy(uint32_t p_ProxyId, const Math::AABB& p_AABB);
+
+  // <-
+
+  /**
+   * Collects the refs of all proxies which are potentially visible in the
+   * given frustum. Proxies located in sub trees which are fully inside the
+   * frustum end up in p_Inside, all others in p_Intersecting and require a
+   * more precise test.
+   */
+  void cullFrustum(const Math::FrustumPlanes& p_FrustumPlanes,
+                   _INTR_ARRAY(Dod::Ref) & p_Inside,
+                   _INTR_ARRAY(Dod::Ref) & p_Intersecting) const;
+
+  // <-
+
+  _INTR_INLINE uint32_t getProxyCount() const { return _proxyCount; }
+
+  // <-
+
+  _INTR_INLINE uint32_t getHeight() const
+  {
+    return _rootIdx != kInvalidProxyId ? _nodes[_rootIdx].height : 0u;
+  }
+
+  // <-
+
+private:
+  struct TreeNode
+  {
+    _INTR_INLINE bool isLeaf() const { return child0 == kInvalidProxyId; }
+
+    Math::AABB aabb;
+    Dod::Ref ref;
+
+    // Next free node if the node is not in use
+    uint32_t parent;
+    uint32_t child0;
+    uint32_t child1;
+    uint32_t height;
+  };
+
+  uint32_t allocateNode();
+  void freeNode(uint32_t p_NodeIdx);
+
+  void insertLeaf(uint32_t p_LeafIdx);
+  void removeLeaf(uint32_t p_LeafIdx);
+  void refitAncestors(uint32_t p_NodeIdx);
+  uint32_t balance(uint32_t p_NodeIdx);
+
+  _INTR_ARRAY(TreeNode) _nodes;
+  uint32_t _rootIdx;
+  uint32_t _freeListIdx;
+  uint32_t _proxyCount;
+};
+}
+}
+}
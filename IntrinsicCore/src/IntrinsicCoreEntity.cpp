@@ -31,7 +31,7 @@ void EntityManager::init()
 {
   _INTR_LOG_INFO("Inititializing Entity Manager...");
 
-  Dod::ManagerBase<_INTR_MAX_ENTITY_COUNT, EntityData>::_initManager();
+  Dod::ManagerBase<_INTR_MAX_ENTITY_COUNT, EntityData>::_initManager(&_data);
 
   Dod::PropertyCompilerEntry propCompilerEntity;
   {
@@ -24,19 +24,19 @@ namespace Entity
 typedef Dod::Ref EntityRef;
 typedef _INTR_ARRAY(EntityRef) EntityRefArray;
 
-struct EntityData
+struct EntityData : Dod::ManagerDataBase
 {
-  EntityData() { name.resize(_INTR_MAX_ENTITY_COUNT); }
+  EntityData() { registerArray(name); }
 
   // Resources
-  _INTR_ARRAY(Name) name;
+  _INTR_PAGED_ARRAY(Name) name;
 };
 
 struct EntityManager : Dod::ManagerBase<_INTR_MAX_ENTITY_COUNT, EntityData>
 {
   static void init();
 
-  _INTR_INLINE static EntityRef createEntity(const Name& p_Name = 0u)
+  _INTR_INLINE static EntityRef createEntity(const Name& p_Name = Name())
   {
     EntityRef ref = allocate();
     rename(ref, p_Name);
@@ -113,7 +113,7 @@ struct EntityManager : Dod::ManagerBase<_INTR_MAX_ENTITY_COUNT, EntityData>
     }
 
     // Find a unique name
-    _data.name[p_Ref._id] = makeNameUnique(p_NewName.getString().c_str());
+    _data.name[p_Ref._id] = makeNameUnique(p_NewName.c_str());
     // ... and finally update the name => entity mapping and the actual name
     _nameResourceMap[_data.name[p_Ref._id]] = p_Ref;
   }
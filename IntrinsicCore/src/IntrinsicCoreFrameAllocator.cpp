@@ -0,0 +1,100 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Precompiled header file
+#include "stdafx.h"
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace Memory
+{
+// Static members
+uint8_t* FrameAllocator::_buffers[2u] = {};
+uint32_t FrameAllocator::_currentBufferIdx = 0u;
+uint32_t FrameAllocator::_sizeInBytes = 0u;
+std::atomic<uint32_t> FrameAllocator::_currentOffset;
+uint32_t FrameAllocator::_highWaterMark = 0u;
+std::mutex FrameAllocator::_overflowMutex;
+_INTR_ARRAY(void*) FrameAllocator::_overflowAllocations[2u];
+uint64_t FrameAllocator::_overflowBytes[2u] = {};
+
+// <-
+
+void FrameAllocator::init()
+{
+  _sizeInBytes = _INTR_FRAME_ALLOCATOR_SIZE_IN_MB * 1024u * 1024u;
+
+  for (uint32_t i = 0u; i < 2u; ++i)
+  {
+    _buffers[i] = (uint8_t*)Tlsf::MainAllocator::allocateAligned(
+        _sizeInBytes, _INTR_PAGED_ARRAY_PAGE_ALIGNMENT);
+  }
+
+  _currentBufferIdx = 0u;
+  _currentOffset = 0u;
+}
+
+// <-
+
+void* FrameAllocator::allocateOverflow(uint32_t p_Size, uint32_t p_Alignment)
+{
+  void* mem = Tlsf::MainAllocator::allocateAligned(p_Size, p_Alignment);
+  _INTR_FATAL_CHECK(mem != nullptr, "Frame allocator overflow failed");
+
+  std::lock_guard<std::mutex> lock(_overflowMutex);
+  _overflowAllocations[_currentBufferIdx].push_back(mem);
+  _overflowBytes[_currentBufferIdx] += p_Size;
+
+  return mem;
+}
+
+// <-
+
+void FrameAllocator::beginFrame()
+{
+  _highWaterMark = std::max(_highWaterMark, getAllocatedBytes());
+
+  _INTR_PROFILE_COUNTER_SET("Frame Allocator Usage (KB)",
+                            getAllocatedBytes() / 1024u);
+  _INTR_PROFILE_COUNTER_SET("Frame Allocator High-Water Mark (KB)",
+                            _highWaterMark / 1024u);
+  _INTR_PROFILE_COUNTER_SET("Frame Allocator Overflow (KB)",
+                            getOverflowBytes() / 1024u);
+
+  if (getOverflowBytes() > 0u)
+  {
+    _INTR_LOG_WARNING("Frame allocator exhausted, %.2f MB allocated from the "
+                      "main allocator",
+                      getOverflowBytes() / (1024.0f * 1024.0f));
+  }
+
+  // The buffer used in the previous frame stays untouched
+  _currentBufferIdx = (_currentBufferIdx + 1u) % 2u;
+  _currentOffset.store(0u, std::memory_order_relaxed);
+
+  // Overflow allocations of the reused buffer are no longer referenced
+  _INTR_ARRAY(void*)& overflowAllocations =
+      _overflowAllocations[_currentBufferIdx];
+  for (uint32_t i = 0u; i < overflowAllocations.size(); ++i)
+  {
+    Tlsf::MainAllocator::free(overflowAllocations[i]);
+  }
+  overflowAllocations.clear();
+  _overflowBytes[_currentBufferIdx] = 0u;
+}
+}
+}
+}
@@ -0,0 +1,131 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// Size of each of the two frame buffers
+#define _INTR_FRAME_ALLOCATOR_SIZE_IN_MB 16u
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace Memory
+{
+// Double buffered linear allocator for transient per-frame data. Memory
+// allocated during a frame stays valid until the end of the next frame and
+// is never freed explicitly. Allocating is lock-free and safe from any thread.
+// Allocations which do not fit into the current buffer fall back to the main
+// allocator and are freed when the buffer is reused
+struct FrameAllocator
+{
+  _INTR_INLINE static void* allocate(uint32_t p_Size,
+                                     uint32_t p_Alignment = 16u)
+  {
+    _INTR_ASSERT(_buffers[_currentBufferIdx] != nullptr &&
+                 "Frame allocator not initialized");
+
+    const uint32_t offset =
+        _currentOffset.fetch_add(p_Size + p_Alignment - 1u,
+                                 std::memory_order_relaxed);
+    const uint32_t alignedOffset =
+        (offset + p_Alignment - 1u) & ~(p_Alignment - 1u);
+
+    if (alignedOffset + p_Size > _sizeInBytes)
+    {
+      return allocateOverflow(p_Size, p_Alignment);
+    }
+
+    return &_buffers[_currentBufferIdx][alignedOffset];
+  }
+
+  // <-
+
+  static void init();
+  static void beginFrame();
+
+  // <-
+
+  // Amount of memory allocated from the frame buffer during the current frame
+  _INTR_INLINE static uint32_t getAllocatedBytes()
+  {
+    return std::min(_currentOffset.load(std::memory_order_relaxed),
+                    _sizeInBytes);
+  }
+
+  // <-
+
+  // Amount of memory allocated from the main allocator during the current
+  // frame because the frame buffer was exhausted
+  _INTR_INLINE static uint64_t getOverflowBytes()
+  {
+    return _overflowBytes[_currentBufferIdx];
+  }
+
+  // <-
+
+  // Peak amount of memory allocated during a single frame
+  _INTR_INLINE static uint32_t getHighWaterMark() { return _highWaterMark; }
+
+private:
+  static void* allocateOverflow(uint32_t p_Size, uint32_t p_Alignment);
+
+  static uint8_t* _buffers[2u];
+  static uint32_t _currentBufferIdx;
+  static uint32_t _sizeInBytes;
+  static std::atomic<uint32_t> _currentOffset;
+  static uint32_t _highWaterMark;
+
+  static std::mutex _overflowMutex;
+  static _INTR_ARRAY(void*) _overflowAllocations[2u];
+  static uint64_t _overflowBytes[2u];
+};
+
+// <-
+
+// STL allocator for transient arrays allocated from the frame allocator
+template <class T> class FrameStlAllocator
+{
+public:
+  typedef T value_type;
+
+  FrameStlAllocator() throw() {}
+  template <class U> FrameStlAllocator(const FrameStlAllocator<U>&) throw() {}
+
+  T* allocate(std::size_t num)
+  {
+    return (T*)FrameAllocator::allocate(
+        (uint32_t)(num * sizeof(T)),
+        (uint32_t)std::max<std::size_t>(alignof(T), 16u));
+  }
+
+  // Memory is reclaimed when the frame buffer is reused
+  void deallocate(T* p, std::size_t num) {}
+};
+
+template <class T1, class T2>
+bool operator==(const FrameStlAllocator<T1>&,
+                const FrameStlAllocator<T2>&) throw()
+{
+  return true;
+}
+template <class T1, class T2>
+bool operator!=(const FrameStlAllocator<T1>&,
+                const FrameStlAllocator<T2>&) throw()
+{
+  return false;
+}
+}
+}
+}
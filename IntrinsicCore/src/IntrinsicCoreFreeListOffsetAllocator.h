@@ -0,0 +1,140 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#define _INTR_FREE_LIST_INVALID_OFFSET ((uint32_t)-1)
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace Memory
+{
+// Hands out ranges of an externally managed resource using a first fit
+// strategy. The free ranges are kept sorted by offset so freed ranges can be
+// merged with their neighbours
+struct FreeListOffsetAllocator
+{
+  FreeListOffsetAllocator() : _size(0u) {}
+
+  // <-
+
+  _INTR_INLINE void init(uint32_t p_Size)
+  {
+    _size = p_Size;
+    _freeRanges.clear();
+    _freeRanges.push_back({0u, p_Size});
+  }
+
+  // <-
+
+  // Returns _INTR_FREE_LIST_INVALID_OFFSET if no free range is large enough
+  _INTR_INLINE uint32_t allocate(uint32_t p_Size)
+  {
+    _INTR_ASSERT(p_Size > 0u);
+
+    for (uint32_t i = 0u; i < _freeRanges.size(); ++i)
+    {
+      FreeRange& range = _freeRanges[i];
+
+      if (range.size >= p_Size)
+      {
+        const uint32_t offset = range.offset;
+        range.offset += p_Size;
+        range.size -= p_Size;
+
+        if (range.size == 0u)
+        {
+          _freeRanges.erase(_freeRanges.begin() + i);
+        }
+
+        return offset;
+      }
+    }
+
+    return _INTR_FREE_LIST_INVALID_OFFSET;
+  }
+
+  // <-
+
+  _INTR_INLINE void free(uint32_t p_Offset, uint32_t p_Size)
+  {
+    _INTR_ASSERT(p_Size > 0u && p_Offset + p_Size <= _size);
+
+    auto next = std::lower_bound(
+        _freeRanges.begin(), _freeRanges.end(), p_Offset,
+        [](const FreeRange& p_Range, uint32_t p_Value) {
+          return p_Range.offset < p_Value;
+        });
+    _INTR_ASSERT((next == _freeRanges.end() ||
+                  p_Offset + p_Size <= next->offset) &&
+                 "Range is already free");
+
+    const bool mergeWithNext =
+        next != _freeRanges.end() && p_Offset + p_Size == next->offset;
+    const bool mergeWithPrev =
+        next != _freeRanges.begin() &&
+        (next - 1)->offset + (next - 1)->size == p_Offset;
+
+    if (mergeWithPrev && mergeWithNext)
+    {
+      (next - 1)->size += p_Size + next->size;
+      _freeRanges.erase(next);
+    }
+    else if (mergeWithPrev)
+    {
+      (next - 1)->size += p_Size;
+    }
+    else if (mergeWithNext)
+    {
+      next->offset = p_Offset;
+      next->size += p_Size;
+    }
+    else
+    {
+      _freeRanges.insert(next, {p_Offset, p_Size});
+    }
+  }
+
+  // <-
+
+  _INTR_INLINE uint32_t size() const { return _size; }
+
+  // <-
+
+  _INTR_INLINE uint32_t calcAvailableSize() const
+  {
+    uint32_t availableSize = 0u;
+    for (uint32_t i = 0u; i < _freeRanges.size(); ++i)
+    {
+      availableSize += _freeRanges[i].size;
+    }
+
+    return availableSize;
+  }
+
+private:
+  struct FreeRange
+  {
+    uint32_t offset;
+    uint32_t size;
+  };
+
+  _INTR_ARRAY(FreeRange) _freeRanges;
+  uint32_t _size;
+};
+}
+}
+}
@@ -35,6 +35,34 @@ _INTR_ARRAY(Benchmark::Data) _benchmarkData;
 uint32_t _pathIdx = 0u;
 float _pathPos = 0.0f;
 rapidjson::Document _benchmarkDesc;
+
+// Totals of the shadow pass at the start of the current path
+uint32_t _recordedStaticShadowCmdBufferCountAtStart = 0u;
+uint32_t _reusedStaticShadowCmdBufferCountAtStart = 0u;
+uint32_t _invalidatedStaticShadowCmdBufferCountAtStart = 0u;
+
+// <-
+
+_INTR_INLINE void captureStaticShadowCmdBufferCounts()
+{
+  _recordedStaticShadowCmdBufferCountAtStart =
+      R::RenderPass::Shadow::_recordedStaticCasterCmdBufferCount;
+  _reusedStaticShadowCmdBufferCountAtStart =
+      R::RenderPass::Shadow::_reusedStaticCasterCmdBufferCount;
+  _invalidatedStaticShadowCmdBufferCountAtStart =
+      R::RenderPass::Shadow::_invalidatedStaticCasterCmdBufferCount;
+}
+
+// <-
+
+_INTR_INLINE void logStaticShadowCmdBufferCounts(uint32_t p_RecordedCount,
+                                                 uint32_t p_ReusedCount,
+                                                 uint32_t p_InvalidatedCount)
+{
+  _INTR_LOG_INFO("Static shadow command buffers: %u recorded, %u reused, %u "
+                 "invalidated",
+                 p_RecordedCount, p_ReusedCount, p_InvalidatedCount);
+}
 }
 
 void Benchmark::init() {}
@@ -65,6 +93,7 @@ void Benchmark::activate()
   parseBenchmark(_benchmarkDesc);
   assembleBenchmarkPaths(_benchmarkDesc, _paths);
   _benchmarkData.resize(_paths.size());
+  captureStaticShadowCmdBufferCounts();
 
   _INTR_LOG_INFO("Starting benchmark...\n---");
   if (!_paths.empty())
@@ -174,12 +203,21 @@ void Benchmark::update(float p_DeltaT)
   Components::NodeManager::_position(camNodeRef) = newCamPos;
   Components::NodeManager::_orientation(camNodeRef) =
       glm::quat_cast(glm::mat3(camRight, camUp, camForward));
-  Components::NodeManager::updateTransforms(camNodeRef);
+  Components::NodeManager::markTransformsDirty(camNodeRef);
 
   World::_currentTime = currentPath.currentTime;
 
   _pathPos += p_DeltaT * currentPath.camSpeed;
   data.meanFps = 1.0f / TaskManager::_lastActualFrameDuration;
+  data.recordedStaticShadowCmdBufferCount =
+      R::RenderPass::Shadow::_recordedStaticCasterCmdBufferCount -
+      _recordedStaticShadowCmdBufferCountAtStart;
+  data.reusedStaticShadowCmdBufferCount =
+      R::RenderPass::Shadow::_reusedStaticCasterCmdBufferCount -
+      _reusedStaticShadowCmdBufferCountAtStart;
+  data.invalidatedStaticShadowCmdBufferCount =
+      R::RenderPass::Shadow::_invalidatedStaticCasterCmdBufferCount -
+      _invalidatedStaticShadowCmdBufferCountAtStart;
 
   if (_pathPos >= 1.0f)
   {
@@ -191,10 +229,21 @@ void Benchmark::update(float p_DeltaT)
       // Calc. total score
       {
         float totalScore = 0.0f;
+        uint32_t recordedCount = 0u;
+        uint32_t reusedCount = 0u;
+        uint32_t invalidatedCount = 0u;
         for (uint32_t i = 0u; i < _benchmarkData.size(); ++i)
+        {
           totalScore += _benchmarkData[i].calcScore();
+          recordedCount += _benchmarkData[i].recordedStaticShadowCmdBufferCount;
+          reusedCount += _benchmarkData[i].reusedStaticShadowCmdBufferCount;
+          invalidatedCount +=
+              _benchmarkData[i].invalidatedStaticShadowCmdBufferCount;
+        }
         totalScore /= _benchmarkData.size();
 
+        logStaticShadowCmdBufferCounts(recordedCount, reusedCount,
+                                       invalidatedCount);
         _INTR_LOG_INFO("Finished benchmarking, total score: %u\n---",
                        (uint32_t)totalScore);
       }
@@ -211,10 +260,15 @@ void Benchmark::update(float p_DeltaT)
     else
     {
       _INTR_LOG_INFO("Score: %u", data.calcScore());
+      logStaticShadowCmdBufferCounts(
+          data.recordedStaticShadowCmdBufferCount,
+          data.reusedStaticShadowCmdBufferCount,
+          data.invalidatedStaticShadowCmdBufferCount);
     }
 
     _INTR_LOG_INFO("Benchmarking path '%s'...", _paths[_pathIdx].name.c_str());
     _pathPos = 0.0f;
+    captureStaticShadowCmdBufferCounts();
   }
 }
 }
@@ -32,10 +32,21 @@ struct Benchmark
 
   struct Data
   {
-    Data() { meanFps = 0.0f; }
+    Data()
+    {
+      meanFps = 0.0f;
+      recordedStaticShadowCmdBufferCount = 0u;
+      reusedStaticShadowCmdBufferCount = 0u;
+      invalidatedStaticShadowCmdBufferCount = 0u;
+    }
 
     _INTR_INLINE uint32_t calcScore() { return (uint32_t)(meanFps * 1337.0f); }
     float meanFps;
+
+    // Command buffers of static shadow casters handled along the path
+    uint32_t recordedStaticShadowCmdBufferCount;
+    uint32_t reusedStaticShadowCmdBufferCount;
+    uint32_t invalidatedStaticShadowCmdBufferCount;
   };
 
   static void init();
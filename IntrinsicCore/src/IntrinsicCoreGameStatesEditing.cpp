@@ -473,7 +473,7 @@ _INTR_INLINE void updateCameraOrbit(float p_DeltaT)
   Components::NodeManager::_orientation(camNodeRef) = _eulerAngles;
   Components::NodeManager::_position(camNodeRef) =
       _orbitCamCenter + camRot * glm::vec3(0.0f, 0.0f, -_orbitRadius);
-  Components::NodeManager::updateTransforms(camNodeRef);
+  Components::NodeManager::markTransformsDirty(camNodeRef);
 
   Math::dampSimple(_camAngVel, damping, p_DeltaT);
 }
@@ -562,7 +562,7 @@ _INTR_INLINE void updateCameraFreeFlight(float p_DeltaT)
 
   Components::NodeManager::_orientation(camNodeRef) = _eulerAngles;
   Components::NodeManager::_position(camNodeRef) += _camVel * p_DeltaT;
-  Components::NodeManager::updateTransforms(camNodeRef);
+  Components::NodeManager::markTransformsDirty(camNodeRef);
 
   Math::dampSimple(_camVel, damping, p_DeltaT);
   Math::dampSimple(_camAngVel, damping, p_DeltaT);
@@ -1049,7 +1049,7 @@ void Editing::updatePerInstanceData()
 
 // <-
 
-void Editing::findVisibleEditingDrawCalls(Dod::RefArray& p_DrawCalls)
+void Editing::findVisibleEditingDrawCalls(Dod::RefFrameArray& p_DrawCalls)
 {
   if (isCurrentlySelectedEntityValid())
   {
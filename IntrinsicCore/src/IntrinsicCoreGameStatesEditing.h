@@ -54,7 +54,7 @@ struct Editing
   static void update(float p_DeltaT);
 
   static void updatePerInstanceData();
-  static void findVisibleEditingDrawCalls(Dod::RefArray& p_DrawCalls);
+  static void findVisibleEditingDrawCalls(Dod::RefFrameArray& p_DrawCalls);
 
   // <-
 
@@ -0,0 +1,132 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace Containers
+{
+// Bounded multi producer, single consumer ring buffer. Each slot carries a
+// sequence number telling producers and the consumer whether the slot is
+// free or holds a fully written element
+template <class T, uint32_t Capacity> struct LockFreeMpscQueue
+{
+  static_assert((Capacity & (Capacity - 1u)) == 0u,
+                "Capacity has to be a power of two");
+
+  LockFreeMpscQueue() : _enqueuePos(0u), _dequeuePos(0u)
+  {
+    _slots = (Slot*)Memory::Tlsf::MainAllocator::allocate(Capacity *
+                                                           sizeof(Slot));
+
+    for (uint32_t i = 0u; i < Capacity; ++i)
+    {
+      new (&_slots[i]) Slot();
+      _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // <-
+
+  ~LockFreeMpscQueue()
+  {
+    for (uint32_t i = 0u; i < Capacity; ++i)
+    {
+      _slots[i].~Slot();
+    }
+
+    Memory::Tlsf::MainAllocator::free(_slots);
+    _slots = nullptr;
+  }
+
+  // <-
+
+  // Can be called from any thread. Returns false if the queue is full
+  _INTR_INLINE bool enqueue(const T& p_Element)
+  {
+    uint32_t pos = _enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot;
+
+    while (true)
+    {
+      slot = &_slots[pos & (Capacity - 1u)];
+      const uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+      const int32_t diff = (int32_t)(sequence - pos);
+
+      if (diff == 0)
+      {
+        if (_enqueuePos.compare_exchange_weak(pos, pos + 1u,
+                                              std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      else if (diff < 0)
+      {
+        return false;
+      }
+      else
+      {
+        pos = _enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->element = p_Element;
+    slot->sequence.store(pos + 1u, std::memory_order_release);
+    return true;
+  }
+
+  // <-
+
+  // Must only be called from the consuming thread. Returns false if the queue
+  // is empty or the next element is still being written
+  _INTR_INLINE bool dequeue(T& p_Element)
+  {
+    Slot& slot = _slots[_dequeuePos & (Capacity - 1u)];
+    const uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+
+    if (sequence != _dequeuePos + 1u)
+    {
+      return false;
+    }
+
+    p_Element = slot.element;
+    slot.sequence.store(_dequeuePos + Capacity, std::memory_order_release);
+    ++_dequeuePos;
+    return true;
+  }
+
+  // <-
+
+  _INTR_INLINE static uint32_t capacity() { return Capacity; }
+
+private:
+  struct Slot
+  {
+    std::atomic<uint32_t> sequence;
+    T element;
+  };
+
+  Slot* _slots;
+
+  // Producers and the consumer write to different cache lines
+  alignas(64) std::atomic<uint32_t> _enqueuePos;
+  alignas(64) uint32_t _dequeuePos;
+};
+}
+}
+}
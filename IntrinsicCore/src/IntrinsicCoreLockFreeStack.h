@@ -20,6 +20,8 @@ namespace Core
 {
 namespace Containers
 {
+// The capacity is the initial capacity of the stack, reserve() can be used to
+// grow the stack while no other thread is accessing it
 template <class T, uint64_t Capacity> struct LockFreeStack
 {
   LockFreeStack()
@@ -42,7 +44,7 @@ template <class T, uint64_t Capacity> struct LockFreeStack
   _INTR_INLINE void push_back(const T& p_Element)
   {
     const Threading::Atomic oldSize = Threading::interlockedAdd(_size, 1);
-    _INTR_ASSERT(oldSize + 1u <= Capacity && "Stack overflow");
+    _INTR_ASSERT(oldSize + 1u <= _capacity && "Stack overflow");
     _data[oldSize] = p_Element;
   }
 
@@ -50,8 +52,9 @@ template <class T, uint64_t Capacity> struct LockFreeStack
 
   _INTR_INLINE T pop_back()
   {
-    const uint64_t oldSize = Threading::interlockedSub(_size, 1);
-    _INTR_ASSERT(oldSize - 1u <= Capacity && "Stack underflow");
+    // Exhausted fixed block allocators end up here
+    const Threading::Atomic oldSize = Threading::interlockedSub(_size, 1);
+    _INTR_FATAL_CHECK(oldSize > 0, "Stack underflow");
     return _data[oldSize - 1u];
   }
 
@@ -61,6 +64,23 @@ template <class T, uint64_t Capacity> struct LockFreeStack
 
   // <-
 
+  _INTR_INLINE void reserve(uint64_t p_Capacity)
+  {
+    if (p_Capacity <= _capacity)
+    {
+      return;
+    }
+
+    T* data = (T*)Memory::Tlsf::MainAllocator::allocate(p_Capacity * sizeof(T));
+    memcpy(data, _data, _size * sizeof(T));
+    Memory::Tlsf::MainAllocator::free(_data);
+
+    _data = data;
+    _capacity = p_Capacity;
+  }
+
+  // <-
+
   _INTR_INLINE void clear() { resize(0u); }
 
   // <-
@@ -111,7 +131,7 @@ template <class T, uint64_t Capacity> struct LockFreeStack
 
   // <-
 
-  _INTR_INLINE void copy(_INTR_ARRAY(T) & p_Array) const
+  template <class ArrayType> _INTR_INLINE void copy(ArrayType& p_Array) const
   {
     const uint32_t startIdx = (uint32_t)p_Array.size();
     p_Array.resize(p_Array.size() + _size);
@@ -136,6 +136,22 @@ _INTR_INLINE uint32_t hash(const char* p_Data, std::size_t p_Size)
 
 // <-
 
+// 64-bit FNV-1a hash function which can be evaluated at compile time
+_INTR_INLINE constexpr uint64_t hash64(const char* p_Data, std::size_t p_Size)
+{
+  uint64_t hash = 0xcbf29ce484222325ull;
+
+  for (std::size_t i = 0u; i < p_Size; ++i)
+  {
+    hash ^= (uint8_t)p_Data[i];
+    hash *= 0x100000001b3ull;
+  }
+
+  return hash;
+}
+
+// <-
+
 _INTR_INLINE uint32_t calcRandomNumber()
 {
   static uint32_t y = 2463534242u;
@@ -287,6 +303,24 @@ _INTR_INLINE glm::vec3 calcAABBCenter(const AABB& p_AABB)
 
 // <-
 
+_INTR_INLINE float calcAABBSurfaceArea(const AABB& p_AABB)
+{
+  const glm::vec3 extent = p_AABB.max - p_AABB.min;
+  return 2.0f * (extent.x * extent.y + extent.y * extent.z +
+                 extent.z * extent.x);
+}
+
+// <-
+
+_INTR_INLINE bool isAABBContained(const AABB& p_Outer, const AABB& p_Inner)
+{
+  return p_Outer.min.x <= p_Inner.min.x && p_Outer.min.y <= p_Inner.min.y &&
+         p_Outer.min.z <= p_Inner.min.z && p_Outer.max.x >= p_Inner.max.x &&
+         p_Outer.max.y >= p_Inner.max.y && p_Outer.max.z >= p_Inner.max.z;
+}
+
+// <-
+
 _INTR_INLINE bool calcIntersectSphereAABB(const Sphere& p_Sphere,
                                           const AABB2& p_AABB)
 {
@@ -441,6 +475,14 @@ _INTR_INLINE void mergePointToAABB(AABB& p_AABB, const glm::vec3& p_Point)
 
 // <-
 
+_INTR_INLINE void mergeAABBToAABB(AABB& p_AABB, const AABB& p_Other)
+{
+  p_AABB.min = calcVecMin(p_Other.min, p_AABB.min);
+  p_AABB.max = calcVecMax(p_Other.max, p_AABB.max);
+}
+
+// <-
+
 _INTR_INLINE void transformAABBAffine(AABB& p_AABB,
                                       const glm::mat4& p_Transform)
 {
@@ -451,13 +493,13 @@ _INTR_INLINE void transformAABBAffine(AABB& p_AABB,
 
   glm::vec3 newHalfSize =
       glm::vec3(glm::abs(p_Transform[0][0]) * halfSize.x +
-                    glm::abs(p_Transform[0][1]) * halfSize.y +
-                    glm::abs(p_Transform[0][2]) * halfSize.z,
-                glm::abs(p_Transform[1][0]) * halfSize.x +
+                    glm::abs(p_Transform[1][0]) * halfSize.y +
+                    glm::abs(p_Transform[2][0]) * halfSize.z,
+                glm::abs(p_Transform[0][1]) * halfSize.x +
                     glm::abs(p_Transform[1][1]) * halfSize.y +
-                    glm::abs(p_Transform[1][2]) * halfSize.z,
-                glm::abs(p_Transform[2][0]) * halfSize.x +
-                    glm::abs(p_Transform[2][1]) * halfSize.y +
+                    glm::abs(p_Transform[2][1]) * halfSize.z,
+                glm::abs(p_Transform[0][2]) * halfSize.x +
+                    glm::abs(p_Transform[1][2]) * halfSize.y +
                     glm::abs(p_Transform[2][2]) * halfSize.z);
 
   p_AABB.min = newCentre - newHalfSize;
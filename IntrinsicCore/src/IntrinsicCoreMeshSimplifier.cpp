@@ -0,0 +1,410 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Precompiled header file
+#include "stdafx.h"
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace MeshSimplifier
+{
+// based on
+// Garland and Heckbert, "Surface Simplification Using Quadric Error Metrics"
+namespace
+{
+// Triangles whose normal would be rotated by more than ~75 degrees by a
+// collapse are considered flipped
+const float _minNormalCosAfterCollapse = 0.25f;
+
+// Symmetric 4x4 matrix storing the sum of the squared distances to a set of
+// planes
+struct Quadric
+{
+  float a00, a11, a22;
+  float a10, a20, a21;
+  float b0, b1, b2;
+  float c;
+};
+
+// <-
+
+_INTR_INLINE void addPlane(Quadric& p_Q, const glm::vec3& p_N, float p_D,
+                           float p_Weight)
+{
+  p_Q.a00 += p_Weight * p_N.x * p_N.x;
+  p_Q.a11 += p_Weight * p_N.y * p_N.y;
+  p_Q.a22 += p_Weight * p_N.z * p_N.z;
+  p_Q.a10 += p_Weight * p_N.y * p_N.x;
+  p_Q.a20 += p_Weight * p_N.z * p_N.x;
+  p_Q.a21 += p_Weight * p_N.z * p_N.y;
+  p_Q.b0 += p_Weight * p_N.x * p_D;
+  p_Q.b1 += p_Weight * p_N.y * p_D;
+  p_Q.b2 += p_Weight * p_N.z * p_D;
+  p_Q.c += p_Weight * p_D * p_D;
+}
+
+// <-
+
+_INTR_INLINE void addQuadric(Quadric& p_Q, const Quadric& p_R)
+{
+  p_Q.a00 += p_R.a00;
+  p_Q.a11 += p_R.a11;
+  p_Q.a22 += p_R.a22;
+  p_Q.a10 += p_R.a10;
+  p_Q.a20 += p_R.a20;
+  p_Q.a21 += p_R.a21;
+  p_Q.b0 += p_R.b0;
+  p_Q.b1 += p_R.b1;
+  p_Q.b2 += p_R.b2;
+  p_Q.c += p_R.c;
+}
+
+// <-
+
+_INTR_INLINE float evalQuadric(const Quadric& p_Q, const glm::vec3& p_P)
+{
+  const float rx = p_Q.b0 + p_Q.a00 * p_P.x + p_Q.a10 * p_P.y +
+                   p_Q.a20 * p_P.z;
+  const float ry = p_Q.b1 + p_Q.a10 * p_P.x + p_Q.a11 * p_P.y +
+                   p_Q.a21 * p_P.z;
+  const float rz = p_Q.b2 + p_Q.a20 * p_P.x + p_Q.a21 * p_P.y +
+                   p_Q.a22 * p_P.z;
+
+  const float error = p_P.x * rx + p_P.y * ry + p_P.z * rz + p_Q.b0 * p_P.x +
+                      p_Q.b1 * p_P.y + p_Q.b2 * p_P.z + p_Q.c;
+  return glm::abs(error);
+}
+
+// <-
+
+struct Collapse
+{
+  _INTR_INLINE bool operator<(const Collapse& p_Rhs) const
+  {
+    return error < p_Rhs.error;
+  }
+
+  uint32_t from;
+  uint32_t to;
+  float error;
+};
+
+// <-
+
+// Returns true if moving p_From onto p_To flips or degenerates any of the
+// triangles adjacent to p_From which are not removed by the collapse
+_INTR_INLINE bool
+collapseFlipsTriangles(const _INTR_ARRAY(glm::vec3) & p_Positions,
+                       const uint32_t* p_Indices,
+                       const _INTR_ARRAY(uint32_t) & p_AdjacencyOffsets,
+                       const _INTR_ARRAY(uint32_t) & p_Adjacency,
+                       uint32_t p_From, uint32_t p_To)
+{
+  for (uint32_t i = p_AdjacencyOffsets[p_From];
+       i < p_AdjacencyOffsets[p_From + 1u]; ++i)
+  {
+    const uint32_t* tri = &p_Indices[p_Adjacency[i] * 3u];
+
+    if (tri[0] == p_To || tri[1] == p_To || tri[2] == p_To)
+    {
+      continue;
+    }
+
+    const glm::vec3& p0 = p_Positions[tri[0]];
+    const glm::vec3& p1 = p_Positions[tri[1]];
+    const glm::vec3& p2 = p_Positions[tri[2]];
+
+    const glm::vec3& q0 = tri[0] == p_From ? p_Positions[p_To] : p0;
+    const glm::vec3& q1 = tri[1] == p_From ? p_Positions[p_To] : p1;
+    const glm::vec3& q2 = tri[2] == p_From ? p_Positions[p_To] : p2;
+
+    const glm::vec3 n0 = glm::cross(p1 - p0, p2 - p0);
+    const glm::vec3 n1 = glm::cross(q1 - q0, q2 - q0);
+
+    const float len0 = glm::length(n0);
+    const float len1 = glm::length(n1);
+
+    if (len1 <= FLT_EPSILON ||
+        glm::dot(n0, n1) < _minNormalCosAfterCollapse * len0 * len1)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+}
+
+// <-
+
+uint32_t simplify(const glm::vec3* p_Positions, uint32_t p_VertexCount,
+                  const uint32_t* p_Indices, uint32_t p_IndexCount,
+                  uint32_t p_TargetIndexCount, float p_MaxError,
+                  uint32_t* p_Destination, float* p_ResultError)
+{
+  _INTR_ASSERT(p_IndexCount % 3u == 0u);
+
+  memcpy(p_Destination, p_Indices, p_IndexCount * sizeof(uint32_t));
+  uint32_t indexCount = p_IndexCount;
+
+  if (p_ResultError != nullptr)
+  {
+    *p_ResultError = 0.0f;
+  }
+
+  if (p_VertexCount == 0u || indexCount <= p_TargetIndexCount)
+  {
+    return indexCount;
+  }
+
+  // Normalize the positions so the error is independent of the mesh scale
+  _INTR_ARRAY(glm::vec3) positions;
+  positions.resize(p_VertexCount);
+  {
+    Math::AABB aabb;
+    Math::initAABB(aabb);
+    for (uint32_t i = 0u; i < p_VertexCount; ++i)
+    {
+      Math::mergePointToAABB(aabb, p_Positions[i]);
+    }
+
+    const glm::vec3 extent = aabb.max - aabb.min;
+    const float maxExtent = glm::max(extent.x, glm::max(extent.y, extent.z));
+    const float scale = maxExtent > 0.0f ? 1.0f / maxExtent : 1.0f;
+
+    for (uint32_t i = 0u; i < p_VertexCount; ++i)
+    {
+      positions[i] = (p_Positions[i] - aabb.min) * scale;
+    }
+  }
+
+  // Accumulate the area weighted planes of all triangles adjacent to each
+  // vertex
+  _INTR_ARRAY(Quadric) quadrics;
+  quadrics.resize(p_VertexCount);
+  memset(quadrics.data(), 0x00, quadrics.size() * sizeof(Quadric));
+
+  for (uint32_t i = 0u; i < indexCount; i += 3u)
+  {
+    const glm::vec3& p0 = positions[p_Destination[i]];
+    const glm::vec3& p1 = positions[p_Destination[i + 1u]];
+    const glm::vec3& p2 = positions[p_Destination[i + 2u]];
+
+    glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+    const float area = glm::length(n);
+
+    if (area <= FLT_EPSILON)
+    {
+      continue;
+    }
+
+    n /= area;
+    const float d = -glm::dot(n, p0);
+
+    for (uint32_t j = 0u; j < 3u; ++j)
+    {
+      addPlane(quadrics[p_Destination[i + j]], n, d, area);
+    }
+  }
+
+  // Lock all vertices on edges which are not shared by exactly two triangles
+  _INTR_ARRAY(uint8_t) locked;
+  locked.resize(p_VertexCount);
+  memset(locked.data(), 0x00, locked.size());
+  {
+    _INTR_ARRAY(uint64_t) edges;
+    edges.reserve(indexCount);
+
+    for (uint32_t i = 0u; i < indexCount; i += 3u)
+    {
+      for (uint32_t j = 0u; j < 3u; ++j)
+      {
+        const uint32_t v0 = p_Destination[i + j];
+        const uint32_t v1 = p_Destination[i + (j + 1u) % 3u];
+        edges.push_back(((uint64_t)glm::min(v0, v1) << 32u) |
+                        glm::max(v0, v1));
+      }
+    }
+
+    std::sort(edges.begin(), edges.end());
+
+    for (uint32_t i = 0u; i < edges.size();)
+    {
+      uint32_t j = i + 1u;
+      while (j < edges.size() && edges[j] == edges[i])
+      {
+        ++j;
+      }
+
+      if (j - i != 2u)
+      {
+        locked[(uint32_t)(edges[i] >> 32u)] = 1u;
+        locked[(uint32_t)edges[i]] = 1u;
+      }
+
+      i = j;
+    }
+  }
+
+  const float maxError = p_MaxError * p_MaxError;
+  float resultError = 0.0f;
+
+  _INTR_ARRAY(Collapse) collapses;
+  _INTR_ARRAY(uint32_t) remap;
+  _INTR_ARRAY(uint8_t) touched;
+  _INTR_ARRAY(uint32_t) adjacencyOffsets;
+  _INTR_ARRAY(uint32_t) adjacency;
+
+  remap.resize(p_VertexCount);
+  touched.resize(p_VertexCount);
+  adjacencyOffsets.resize(p_VertexCount + 1u);
+
+  // Collapse a batch of independent edges per pass until the target is reached
+  while (indexCount > p_TargetIndexCount)
+  {
+    const uint32_t triangleCount = indexCount / 3u;
+
+    // Build vertex to triangle adjacency
+    {
+      memset(adjacencyOffsets.data(), 0x00,
+             adjacencyOffsets.size() * sizeof(uint32_t));
+      for (uint32_t i = 0u; i < indexCount; ++i)
+      {
+        ++adjacencyOffsets[p_Destination[i] + 1u];
+      }
+      for (uint32_t i = 0u; i < p_VertexCount; ++i)
+      {
+        adjacencyOffsets[i + 1u] += adjacencyOffsets[i];
+      }
+
+      adjacency.resize(indexCount);
+      _INTR_ARRAY(uint32_t) fill = adjacencyOffsets;
+      for (uint32_t i = 0u; i < indexCount; ++i)
+      {
+        adjacency[fill[p_Destination[i]]++] = i / 3u;
+      }
+    }
+
+    // Gather all possible collapses sorted by their error
+    collapses.clear();
+    for (uint32_t i = 0u; i < indexCount; i += 3u)
+    {
+      for (uint32_t j = 0u; j < 3u; ++j)
+      {
+        const uint32_t v0 = p_Destination[i + j];
+        const uint32_t v1 = p_Destination[i + (j + 1u) % 3u];
+
+        Quadric q = quadrics[v0];
+        addQuadric(q, quadrics[v1]);
+
+        if (!locked[v0])
+        {
+          Collapse collapse = {v0, v1, evalQuadric(q, positions[v1])};
+          collapses.push_back(collapse);
+        }
+        if (!locked[v1])
+        {
+          Collapse collapse = {v1, v0, evalQuadric(q, positions[v0])};
+          collapses.push_back(collapse);
+        }
+      }
+    }
+
+    std::sort(collapses.begin(), collapses.end());
+
+    for (uint32_t i = 0u; i < p_VertexCount; ++i)
+    {
+      remap[i] = i;
+    }
+    memset(touched.data(), 0x00, touched.size());
+
+    // Each collapse removes two triangles on closed surfaces
+    const uint32_t targetCollapseCount =
+        (triangleCount - p_TargetIndexCount / 3u) / 2u + 1u;
+    uint32_t collapseCount = 0u;
+
+    for (uint32_t i = 0u; i < collapses.size(); ++i)
+    {
+      const Collapse& collapse = collapses[i];
+
+      if (collapse.error > maxError)
+      {
+        break;
+      }
+
+      if (touched[collapse.from] || touched[collapse.to] ||
+          collapseFlipsTriangles(positions, p_Destination, adjacencyOffsets,
+                                 adjacency, collapse.from, collapse.to))
+      {
+        continue;
+      }
+
+      remap[collapse.from] = collapse.to;
+      resultError = glm::max(resultError, collapse.error);
+      addQuadric(quadrics[collapse.to], quadrics[collapse.from]);
+
+      // Keep the neighborhood fixed for the remainder of the pass so the flip
+      // test of the following collapses stays valid
+      for (uint32_t j = adjacencyOffsets[collapse.from];
+           j < adjacencyOffsets[collapse.from + 1u]; ++j)
+      {
+        const uint32_t* tri = &p_Destination[adjacency[j] * 3u];
+        touched[tri[0]] = 1u;
+        touched[tri[1]] = 1u;
+        touched[tri[2]] = 1u;
+      }
+
+      if (++collapseCount >= targetCollapseCount)
+      {
+        break;
+      }
+    }
+
+    if (collapseCount == 0u)
+    {
+      break;
+    }
+
+    // Apply the collapses and remove degenerate triangles
+    uint32_t writeIdx = 0u;
+    for (uint32_t i = 0u; i < indexCount; i += 3u)
+    {
+      const uint32_t v0 = remap[p_Destination[i]];
+      const uint32_t v1 = remap[p_Destination[i + 1u]];
+      const uint32_t v2 = remap[p_Destination[i + 2u]];
+
+      if (v0 != v1 && v0 != v2 && v1 != v2)
+      {
+        p_Destination[writeIdx] = v0;
+        p_Destination[writeIdx + 1u] = v1;
+        p_Destination[writeIdx + 2u] = v2;
+        writeIdx += 3u;
+      }
+    }
+
+    indexCount = writeIdx;
+  }
+
+  if (p_ResultError != nullptr)
+  {
+    *p_ResultError = glm::sqrt(resultError);
+  }
+
+  return indexCount;
+}
+}
+}
+}
@@ -0,0 +1,41 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace MeshSimplifier
+{
+/**
+ * Reduces the triangle count of an indexed triangle list by collapsing edges
+ * in the order of the quadric error they introduce. Vertices are only ever
+ * collapsed onto other existing vertices, so the simplified index list can be
+ * drawn using the original vertex buffers. Vertices on open edges (mesh
+ * borders and attribute seams) are never moved.
+ *
+ * p_MaxError is the maximum allowed error relative to the extent of the mesh.
+ * Returns the amount of indices written to p_Destination, which has to be
+ * able to hold p_IndexCount indices. The largest error of all applied
+ * collapses is written to p_ResultError if provided.
+ */
+uint32_t simplify(const glm::vec3* p_Positions, uint32_t p_VertexCount,
+                  const uint32_t* p_Indices, uint32_t p_IndexCount,
+                  uint32_t p_TargetIndexCount, float p_MaxError,
+                  uint32_t* p_Destination, float* p_ResultError = nullptr);
+}
+}
+}
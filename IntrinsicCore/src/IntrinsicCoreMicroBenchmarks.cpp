@@ -0,0 +1,1048 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Precompiled header file
+#include "stdafx.h"
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace MicroBenchmarks
+{
+namespace
+{
+const uint32_t _churnHandleCount = 100000u;
+const uint32_t _churnRoundCount = 8u;
+
+const uint32_t _transformBatchCount = 100000u / TransformKernel::kMaxBatchSize;
+const uint32_t _transformRoundCount = 16u;
+const uint32_t _transformCount =
+    _transformBatchCount * TransformKernel::kMaxBatchSize;
+
+const uint32_t _cullingNodeCounts[] = {10000u, 100000u, 1000000u};
+const uint32_t _cullingRoundCount = 16u;
+// Nodes per square meter
+const float _cullingNodeDensity = 0.01f;
+// Fraction of the nodes moved per round
+const float _cullingMovedNodeFraction = 0.01f;
+
+const uint32_t _sphereCullingSphereCount = 100000u;
+const uint32_t _sphereCullingFrustumCount = 4u;
+const uint32_t _sphereCullingRoundCount = 16u;
+// The SIMD kernels might use FMA, so spheres touching a plane can end up on
+// either side of it
+const float _sphereCullingEpsilon = 0.001f;
+
+const uint32_t _occlusionBoxCount = 100000u;
+const uint32_t _occlusionRoundCount = 16u;
+// Distance of the occluding wall to the camera
+const float _occlusionWallDistance = 30.0f;
+const glm::vec2 _occlusionWallHalfExtent = glm::vec2(20.0f, 10.0f);
+const uint32_t _occlusionWallQuadCountX = 32u;
+const uint32_t _occlusionWallQuadCountY = 16u;
+
+const uint32_t _sortElementCounts[] = {10000u, 50000u, 100000u, 200000u};
+const uint32_t _sortRoundCount = 16u;
+
+// Quads per side of the simplified height field
+const uint32_t _simplificationGridSize = 256u;
+const uint32_t _simplificationRoundCount = 4u;
+const float _simplificationMaxError = 0.05f;
+
+struct ChurnData
+{
+};
+
+struct ChurnManager : Dod::ManagerBase<_churnHandleCount, ChurnData>
+{
+  _INTR_INLINE static void init()
+  {
+    static bool initialized = false;
+    if (!initialized)
+    {
+      _initManager(nullptr);
+      initialized = true;
+    }
+  }
+
+  _INTR_INLINE static Dod::Ref create() { return allocate(); }
+  _INTR_INLINE static void destroy(Dod::Ref p_Ref) { release(p_Ref); }
+};
+
+// <-
+
+_INTR_INLINE void logResult(const char* p_Name, uint64_t p_Microseconds,
+                            uint32_t p_OperationCount)
+{
+  _INTR_LOG_INFO("%s: %.3f ms total, %.1f ns/op", p_Name,
+                 p_Microseconds / 1000.0f,
+                 (p_Microseconds * 1000.0f) / p_OperationCount);
+}
+
+// <-
+
+struct TransformOutput
+{
+  glm::mat4 worldMatrix;
+  glm::mat4 inverseWorldMatrix;
+  Math::AABB worldAABB;
+  Math::Sphere worldBoundingSphere;
+};
+
+// <-
+
+uint64_t runTransformKernel(TransformKernel::KernelFunction p_Kernel,
+                            const TransformKernel::Batch* p_Batches)
+{
+  const uint64_t startTime = TimingHelper::getMicroseconds();
+  for (uint32_t round = 0u; round < _transformRoundCount; ++round)
+  {
+    for (uint32_t i = 0u; i < _transformBatchCount; ++i)
+    {
+      p_Kernel(p_Batches[i]);
+    }
+  }
+  return TimingHelper::getMicroseconds() - startTime;
+}
+
+// <-
+
+_INTR_INLINE float calcMaxDifference(const float* p_A, const float* p_B,
+                                     uint32_t p_Count)
+{
+  float maxDiff = 0.0f;
+  for (uint32_t i = 0u; i < p_Count; ++i)
+  {
+    maxDiff = glm::max(maxDiff, glm::abs(p_A[i] - p_B[i]));
+  }
+  return maxDiff;
+}
+
+// <-
+
+float calcMaxDifference(const TransformOutput* p_Outputs,
+                        const TransformOutput* p_Reference)
+{
+  float maxDiff = 0.0f;
+  for (uint32_t i = 0u; i < _transformCount; ++i)
+  {
+    maxDiff = glm::max(maxDiff, calcMaxDifference(
+                                    &p_Outputs[i].worldMatrix[0][0],
+                                    &p_Reference[i].worldMatrix[0][0], 16u));
+    maxDiff = glm::max(
+        maxDiff, calcMaxDifference(&p_Outputs[i].inverseWorldMatrix[0][0],
+                                   &p_Reference[i].inverseWorldMatrix[0][0],
+                                   16u));
+    maxDiff = glm::max(maxDiff, calcMaxDifference(
+                                    &p_Outputs[i].worldAABB.min[0],
+                                    &p_Reference[i].worldAABB.min[0], 3u));
+    maxDiff = glm::max(maxDiff, calcMaxDifference(
+                                    &p_Outputs[i].worldAABB.max[0],
+                                    &p_Reference[i].worldAABB.max[0], 3u));
+    maxDiff = glm::max(maxDiff,
+                       glm::abs(p_Outputs[i].worldBoundingSphere.r -
+                                p_Reference[i].worldBoundingSphere.r));
+  }
+  return maxDiff;
+}
+
+// <-
+
+// Points the outputs of all batches to the given output array
+void redirectOutputs(TransformKernel::Batch* p_Batches,
+                     TransformOutput* p_Outputs)
+{
+  for (uint32_t batchIdx = 0u; batchIdx < _transformBatchCount; ++batchIdx)
+  {
+    TransformKernel::Batch& batch = p_Batches[batchIdx];
+    for (uint32_t i = 0u; i < batch.count; ++i)
+    {
+      TransformOutput& output =
+          p_Outputs[batchIdx * TransformKernel::kMaxBatchSize + i];
+
+      batch.worldMatrix[i] = &output.worldMatrix;
+      batch.inverseWorldMatrix[i] = &output.inverseWorldMatrix;
+      batch.worldAABB[i] = &output.worldAABB;
+      batch.worldBoundingSphere[i] = &output.worldBoundingSphere;
+    }
+  }
+}
+
+// <-
+
+_INTR_INLINE bool isSphereVisible(const Math::FrustumPlanes& p_FrustumPlanes,
+                                  const Math::Sphere& p_Sphere)
+{
+  for (uint32_t i = 0u; i < Math::FrustumPlane::kCount; ++i)
+  {
+    if (glm::dot(p_FrustumPlanes.n[i], p_Sphere.p) + p_FrustumPlanes.d[i] <
+        -p_Sphere.r)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// <-
+
+_INTR_INLINE Math::AABB calcRandomCullingAABB(float p_WorldExtent)
+{
+  const glm::vec3 center =
+      glm::vec3(Math::calcRandomFloatMinMax(-p_WorldExtent, p_WorldExtent),
+                Math::calcRandomFloatMinMax(0.0f, 20.0f),
+                Math::calcRandomFloatMinMax(-p_WorldExtent, p_WorldExtent));
+  const glm::vec3 halfExtent =
+      glm::vec3(Math::calcRandomFloatMinMax(0.5f, 4.0f));
+
+  return Math::AABB(center - halfExtent, center + halfExtent);
+}
+
+// <-
+
+uint64_t runCullingKernel(CullingKernel::KernelFunction p_Kernel,
+                          const Math::FrustumPlanes* p_FrustumPlanes,
+                          const CullingKernel::SphereSet& p_Spheres,
+                          uint32_t* p_VisibilityMasks)
+{
+  const uint64_t startTime = TimingHelper::getMicroseconds();
+  for (uint32_t round = 0u; round < _sphereCullingRoundCount; ++round)
+  {
+    p_Kernel(p_FrustumPlanes, _sphereCullingFrustumCount, p_Spheres, 0u,
+             p_Spheres.size(), p_VisibilityMasks);
+  }
+  return TimingHelper::getMicroseconds() - startTime;
+}
+
+// <-
+
+// Returns true if the sphere touches one of the planes of the frustum within
+// the tolerated band
+_INTR_INLINE bool
+isNearFrustumPlane(const Math::FrustumPlanes& p_FrustumPlanes,
+                   const glm::vec3& p_Position, float p_Radius)
+{
+  for (uint32_t i = 0u; i < Math::FrustumPlane::kCount; ++i)
+  {
+    const float dist =
+        glm::dot(p_FrustumPlanes.n[i], p_Position) + p_FrustumPlanes.d[i];
+    if (glm::abs(dist + p_Radius) <= _sphereCullingEpsilon)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// <-
+
+// Counts the spheres with a visibility differing from the reference that can't
+// be explained by rounding near one of the frustum planes
+uint32_t calcMismatchCount(const Math::FrustumPlanes* p_FrustumPlanes,
+                           const CullingKernel::SphereSet& p_Spheres,
+                           const _INTR_ARRAY(uint32_t) & p_Masks,
+                           const _INTR_ARRAY(uint32_t) & p_ReferenceMasks)
+{
+  uint32_t mismatchCount = 0u;
+  for (uint32_t i = 0u; i < p_Masks.size(); ++i)
+  {
+    const uint32_t differingFrustums = p_Masks[i] ^ p_ReferenceMasks[i];
+    if (differingFrustums == 0u)
+    {
+      continue;
+    }
+
+    const glm::vec3 p =
+        glm::vec3(p_Spheres.x[i], p_Spheres.y[i], p_Spheres.z[i]);
+    for (uint32_t frustIdx = 0u; frustIdx < _sphereCullingFrustumCount;
+         ++frustIdx)
+    {
+      if ((differingFrustums & (1u << frustIdx)) != 0u &&
+          !isNearFrustumPlane(p_FrustumPlanes[frustIdx], p, p_Spheres.r[i]))
+      {
+        ++mismatchCount;
+        break;
+      }
+    }
+  }
+  return mismatchCount;
+}
+
+// <-
+
+// Builds a key like the draw call sorting hash using a few passes, pipelines
+// and materials, many meshes and random depths
+_INTR_INLINE uint64_t calcRandomSortKey()
+{
+  return (uint64_t)(Math::calcRandomNumber() % 8u) << 56u |
+         (uint64_t)(Math::calcRandomNumber() % 64u) << 46u |
+         (uint64_t)(Math::calcRandomNumber() % 256u) << 36u |
+         (uint64_t)(Math::calcRandomNumber() % 1024u) << 24u |
+         (uint64_t)(Math::calcRandomNumber() & 0xFFFFFFu);
+}
+
+// <-
+
+struct SortKeyComparator
+{
+  bool operator()(uint32_t p_A, uint32_t p_B) const
+  {
+    return _keys[p_A] < _keys[p_B];
+  }
+
+  const uint64_t* _keys;
+};
+
+// <-
+
+struct SortKeyFunction
+{
+  uint64_t operator()(uint32_t p_Idx) const { return _keys[p_Idx]; }
+
+  const uint64_t* _keys;
+};
+
+// <-
+
+void runSort(uint32_t p_ElementCount)
+{
+  // Sorts indices by looking up their keys as done for draw calls
+  _INTR_ARRAY(uint64_t) keys;
+  keys.resize(p_ElementCount);
+  _INTR_ARRAY(uint32_t) unsortedIndices;
+  unsortedIndices.resize(p_ElementCount);
+
+  for (uint32_t i = 0u; i < p_ElementCount; ++i)
+  {
+    keys[i] = calcRandomSortKey();
+    unsortedIndices[i] = i;
+  }
+
+  SortKeyComparator comparator;
+  comparator._keys = keys.data();
+  SortKeyFunction keyFunction;
+  keyFunction._keys = keys.data();
+
+  _INTR_ARRAY(uint32_t) comparisonIndices;
+  _INTR_ARRAY(uint32_t) radixIndices;
+
+  uint64_t comparisonTime = 0u;
+  uint64_t radixTime = 0u;
+
+  for (uint32_t round = 0u; round < _sortRoundCount; ++round)
+  {
+    comparisonIndices = unsortedIndices;
+    uint64_t startTime = TimingHelper::getMicroseconds();
+    Algorithm::parallelSort<uint32_t, SortKeyComparator>(comparisonIndices,
+                                                         comparator);
+    comparisonTime += TimingHelper::getMicroseconds() - startTime;
+
+    radixIndices = unsortedIndices;
+    startTime = TimingHelper::getMicroseconds();
+    Algorithm::parallelRadixSort(radixIndices, keyFunction);
+    radixTime += TimingHelper::getMicroseconds() - startTime;
+  }
+
+  // Equal keys might be ordered differently, so compare the keys
+  uint32_t mismatchCount = 0u;
+  for (uint32_t i = 0u; i < p_ElementCount; ++i)
+  {
+    mismatchCount +=
+        keys[comparisonIndices[i]] != keys[radixIndices[i]] ? 1u : 0u;
+  }
+
+  _INTR_LOG_INFO("%u elements:", p_ElementCount);
+  _INTR_LOG_PUSH();
+  logResult("Comparison sort", comparisonTime,
+            p_ElementCount * _sortRoundCount);
+  logResult("Radix sort", radixTime, p_ElementCount * _sortRoundCount);
+  _INTR_LOG_INFO("Radix sort mismatches to comparison sort: %u",
+                 mismatchCount);
+  _INTR_LOG_POP();
+}
+
+// <-
+
+struct SortHashEntry
+{
+  uint8_t materialPassIdx;
+  uint32_t state;
+  float distToCamera;
+  uint64_t hash;
+};
+
+struct SortHashKeyFunction
+{
+  uint64_t operator()(const SortHashEntry& p_Entry) const
+  {
+    return p_Entry.hash;
+  }
+};
+
+// <-
+
+// Returns the number of neighbours sorted in the wrong order according to the
+// render order of their material passes
+uint32_t checkSortingHashOrder(uint8_t p_RenderOrder)
+{
+  _INTR_ARRAY(SortHashEntry) entries;
+  entries.resize(_sortElementCounts[0]);
+
+  // Integral distances keep the depth exact after the quantization
+  for (uint32_t i = 0u; i < entries.size(); ++i)
+  {
+    SortHashEntry& entry = entries[i];
+    entry.materialPassIdx = (uint8_t)(Math::calcRandomNumber() % 4u);
+    entry.state = Math::calcRandomNumber() % 64u;
+    entry.distToCamera = (float)(Math::calcRandomNumber() % 1000u);
+    entry.hash = R::Resources::DrawCallManager::calcSortingHash(
+        entry.materialPassIdx, p_RenderOrder, entry.state,
+        entry.distToCamera);
+  }
+
+  SortHashKeyFunction keyFunction;
+  Algorithm::parallelRadixSort(entries, keyFunction);
+
+  const bool backToFront = p_RenderOrder == R::RenderOrder::kBackToFront;
+
+  uint32_t mismatchCount = 0u;
+  for (uint32_t i = 1u; i < entries.size(); ++i)
+  {
+    const SortHashEntry& prev = entries[i - 1u];
+    const SortHashEntry& curr = entries[i];
+
+    // Back to front passes are drawn starting with the highest pass index
+    if (prev.materialPassIdx != curr.materialPassIdx)
+    {
+      mismatchCount += (backToFront
+                            ? prev.materialPassIdx < curr.materialPassIdx
+                            : prev.materialPassIdx > curr.materialPassIdx)
+                           ? 1u
+                           : 0u;
+    }
+    else if (backToFront)
+    {
+      mismatchCount += prev.distToCamera < curr.distToCamera ? 1u : 0u;
+    }
+    else if (prev.state != curr.state)
+    {
+      mismatchCount += prev.state > curr.state ? 1u : 0u;
+    }
+    else
+    {
+      mismatchCount += prev.distToCamera > curr.distToCamera ? 1u : 0u;
+    }
+  }
+
+  return mismatchCount;
+}
+
+// <-
+
+_INTR_INLINE bool isHiddenByOcclusionWall(const Math::AABB& p_AABB)
+{
+  if (p_AABB.min.z <= _occlusionWallDistance)
+  {
+    return false;
+  }
+
+  glm::vec3 corners[8];
+  Math::calcAABBCorners(p_AABB, corners);
+
+  // Project all corners onto the wall as seen from the camera at the origin
+  for (uint32_t i = 0u; i < 8u; ++i)
+  {
+    const glm::vec2 wallPos =
+        glm::vec2(corners[i]) * (_occlusionWallDistance / corners[i].z);
+
+    if (glm::abs(wallPos.x) > _occlusionWallHalfExtent.x ||
+        glm::abs(wallPos.y) > _occlusionWallHalfExtent.y)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// <-
+
+void runCulling(uint32_t p_NodeCount)
+{
+  const float worldExtent =
+      glm::sqrt(p_NodeCount / _cullingNodeDensity) * 0.5f;
+
+  Math::FrustumPlanes frustumPlanes;
+  Math::extractFrustumPlanes(
+      frustumPlanes,
+      glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 1.0f, 500.0f) *
+          glm::lookAt(glm::vec3(0.0f, 10.0f, 0.0f),
+                      glm::vec3(0.0f, 10.0f, 1.0f),
+                      glm::vec3(0.0f, 1.0f, 0.0f)));
+
+  _INTR_ARRAY(Math::AABB) aabbs;
+  _INTR_ARRAY(Math::Sphere) spheres;
+  _INTR_ARRAY(uint32_t) proxyIds;
+  aabbs.resize(p_NodeCount);
+  spheres.resize(p_NodeCount);
+  proxyIds.resize(p_NodeCount);
+
+  Containers::DynamicAabbTree tree;
+
+  uint64_t startTime = TimingHelper::getMicroseconds();
+  for (uint32_t i = 0u; i < p_NodeCount; ++i)
+  {
+    aabbs[i] = calcRandomCullingAABB(worldExtent);
+    spheres[i].p = Math::calcAABBCenter(aabbs[i]);
+    spheres[i].r = glm::length(Math::calcAABBHalfExtent(aabbs[i]));
+    proxyIds[i] = tree.createProxy(aabbs[i], Dod::Ref(i, 0u));
+  }
+  const uint64_t buildTime = TimingHelper::getMicroseconds() - startTime;
+
+  // Move a fraction of the nodes slightly as a typical frame would
+  const uint32_t movedNodeCount =
+      (uint32_t)(p_NodeCount * _cullingMovedNodeFraction);
+  uint64_t updateTime = 0u;
+  uint32_t reinsertionCount = 0u;
+
+  _INTR_ARRAY(Dod::Ref) inside;
+  _INTR_ARRAY(Dod::Ref) intersecting;
+  uint64_t treeTime = 0u;
+  uint32_t treeVisibleCount = 0u;
+
+  uint64_t bruteForceTime = 0u;
+  uint32_t bruteForceVisibleCount = 0u;
+
+  for (uint32_t round = 0u; round < _cullingRoundCount; ++round)
+  {
+    startTime = TimingHelper::getMicroseconds();
+    for (uint32_t i = 0u; i < movedNodeCount; ++i)
+    {
+      const uint32_t nodeIdx = Math::calcRandomNumber() % p_NodeCount;
+      const glm::vec3 offset =
+          glm::vec3(Math::calcRandomFloatMinMax(-0.5f, 0.5f), 0.0f,
+                    Math::calcRandomFloatMinMax(-0.5f, 0.5f));
+
+      aabbs[nodeIdx].min += offset;
+      aabbs[nodeIdx].max += offset;
+      spheres[nodeIdx].p += offset;
+
+      if (tree.moveProxy(proxyIds[nodeIdx], aabbs[nodeIdx]))
+      {
+        ++reinsertionCount;
+      }
+    }
+    updateTime += TimingHelper::getMicroseconds() - startTime;
+
+    startTime = TimingHelper::getMicroseconds();
+    inside.clear();
+    intersecting.clear();
+    tree.cullFrustum(frustumPlanes, inside, intersecting);
+
+    treeVisibleCount = (uint32_t)inside.size();
+    for (uint32_t i = 0u; i < intersecting.size(); ++i)
+    {
+      if (isSphereVisible(frustumPlanes, spheres[intersecting[i]._id]))
+      {
+        ++treeVisibleCount;
+      }
+    }
+    treeTime += TimingHelper::getMicroseconds() - startTime;
+
+    startTime = TimingHelper::getMicroseconds();
+    bruteForceVisibleCount = 0u;
+    for (uint32_t i = 0u; i < p_NodeCount; ++i)
+    {
+      if (isSphereVisible(frustumPlanes, spheres[i]))
+      {
+        ++bruteForceVisibleCount;
+      }
+    }
+    bruteForceTime += TimingHelper::getMicroseconds() - startTime;
+  }
+
+  _INTR_LOG_INFO("%u nodes (tree height %u):", p_NodeCount, tree.getHeight());
+  _INTR_LOG_PUSH();
+  logResult("Spatial index build", buildTime, p_NodeCount);
+  logResult("Spatial index update", updateTime,
+            movedNodeCount * _cullingRoundCount);
+  _INTR_LOG_INFO("Spatial index reinsertions: %u of %u moves",
+                 reinsertionCount, movedNodeCount * _cullingRoundCount);
+  logResult("Spatial index culling", treeTime,
+            p_NodeCount * _cullingRoundCount);
+  logResult("Brute force culling", bruteForceTime,
+            p_NodeCount * _cullingRoundCount);
+  _INTR_LOG_INFO("Visible nodes: %u (spatial index), %u (brute force)",
+                 treeVisibleCount, bruteForceVisibleCount);
+  _INTR_LOG_POP();
+}
+}
+}
+
+// <-
+
+void runAll()
+{
+  _INTR_LOG_INFO("Running micro benchmarks...");
+  _INTR_LOG_PUSH();
+
+  runDodHandleChurn();
+  runTransformKernels();
+  runSpatialIndexCulling();
+  runCullingKernels();
+  runOcclusionCulling();
+  runDrawCallSorting();
+  runMeshSimplification();
+
+  _INTR_LOG_POP();
+}
+
+// <-
+
+void runDodHandleChurn()
+{
+  ChurnManager::init();
+
+  Dod::RefArray refs;
+  refs.reserve(_churnHandleCount);
+
+  uint64_t allocTime = 0u;
+  uint64_t releaseTime = 0u;
+
+  for (uint32_t round = 0u; round < _churnRoundCount; ++round)
+  {
+    uint64_t startTime = TimingHelper::getMicroseconds();
+    for (uint32_t i = 0u; i < _churnHandleCount; ++i)
+    {
+      refs.push_back(ChurnManager::create());
+    }
+    allocTime += TimingHelper::getMicroseconds() - startTime;
+
+    // Release in random order so arbitrary slots of the dense array are hit
+    for (uint32_t i = _churnHandleCount - 1u; i > 0u; --i)
+    {
+      std::swap(refs[i], refs[Math::calcRandomNumber() % (i + 1u)]);
+    }
+
+    startTime = TimingHelper::getMicroseconds();
+    for (uint32_t i = 0u; i < _churnHandleCount; ++i)
+    {
+      ChurnManager::destroy(refs[i]);
+    }
+    releaseTime += TimingHelper::getMicroseconds() - startTime;
+
+    _INTR_ASSERT(ChurnManager::getActiveResourceCount() == 0u);
+    refs.clear();
+  }
+
+  logResult("Dod handle churn (allocate)", allocTime,
+            _churnHandleCount * _churnRoundCount);
+  logResult("Dod handle churn (release)", releaseTime,
+            _churnHandleCount * _churnRoundCount);
+}
+
+// <-
+
+void runTransformKernels()
+{
+  const uint32_t batchesSize =
+      _transformBatchCount * sizeof(TransformKernel::Batch);
+  const uint32_t outputsSize = _transformCount * sizeof(TransformOutput);
+
+  TransformKernel::Batch* batches =
+      (TransformKernel::Batch*)Memory::Tlsf::MainAllocator::allocateAligned(
+          batchesSize, alignof(TransformKernel::Batch));
+  TransformOutput* outputs[3];
+  for (uint32_t i = 0u; i < 3u; ++i)
+  {
+    outputs[i] =
+        (TransformOutput*)Memory::Tlsf::MainAllocator::allocate(outputsSize);
+  }
+
+  for (uint32_t batchIdx = 0u; batchIdx < _transformBatchCount; ++batchIdx)
+  {
+    TransformKernel::Batch& batch = *new (&batches[batchIdx])
+        TransformKernel::Batch();
+
+    for (uint32_t i = 0u; i < TransformKernel::kMaxBatchSize; ++i)
+    {
+      const glm::vec3 pos =
+          glm::vec3(Math::calcRandomFloatMinMax(-100.0f, 100.0f),
+                    Math::calcRandomFloatMinMax(-100.0f, 100.0f),
+                    Math::calcRandomFloatMinMax(-100.0f, 100.0f));
+      const glm::quat orient = glm::normalize(
+          glm::quat(Math::calcRandomFloatMinMax(-1.0f, 1.0f),
+                    Math::calcRandomFloatMinMax(-1.0f, 1.0f),
+                    Math::calcRandomFloatMinMax(-1.0f, 1.0f),
+                    Math::calcRandomFloatMinMax(-1.0f, 1.0f)));
+      const glm::vec3 size =
+          glm::vec3(Math::calcRandomFloatMinMax(0.5f, 2.0f));
+      const Math::AABB localAABB =
+          Math::AABB(glm::vec3(-Math::calcRandomFloatMinMax(0.1f, 1.0f)),
+                     glm::vec3(Math::calcRandomFloatMinMax(0.1f, 1.0f)));
+
+      TransformOutput& output =
+          outputs[0][batchIdx * TransformKernel::kMaxBatchSize + i];
+      batch.add(pos, orient, size, &localAABB, &output.worldMatrix,
+                &output.inverseWorldMatrix, &output.worldAABB,
+                &output.worldBoundingSphere);
+    }
+  }
+
+  const uint64_t scalarTime =
+      runTransformKernel(TransformKernel::computeScalar, batches);
+  logResult("Transform kernel (scalar)", scalarTime,
+            _transformCount * _transformRoundCount);
+
+  redirectOutputs(batches, outputs[1]);
+  const uint64_t sseTime =
+      runTransformKernel(TransformKernel::computeSse, batches);
+  logResult("Transform kernel (SSE)", sseTime,
+            _transformCount * _transformRoundCount);
+  _INTR_LOG_INFO("SSE max. difference to scalar: %f",
+                 calcMaxDifference(outputs[1], outputs[0]));
+
+  if (Simd::isAvx2Supported())
+  {
+    redirectOutputs(batches, outputs[2]);
+
+    const uint64_t avx2Time =
+        runTransformKernel(TransformKernel::computeAvx2, batches);
+    logResult("Transform kernel (AVX2)", avx2Time,
+              _transformCount * _transformRoundCount);
+    _INTR_LOG_INFO("AVX2 max. difference to scalar: %f",
+                   calcMaxDifference(outputs[2], outputs[0]));
+  }
+  else
+  {
+    _INTR_LOG_INFO("AVX2 not supported, skipping AVX2 transform kernel...");
+  }
+
+  for (uint32_t i = 0u; i < 3u; ++i)
+  {
+    Memory::Tlsf::MainAllocator::free(outputs[i]);
+  }
+  Memory::Tlsf::MainAllocator::free(batches);
+}
+
+// <-
+
+void runSpatialIndexCulling()
+{
+  for (uint32_t i = 0u; i < sizeof(_cullingNodeCounts) / sizeof(uint32_t); ++i)
+  {
+    runCulling(_cullingNodeCounts[i]);
+  }
+}
+
+// <-
+
+void runCullingKernels()
+{
+  // A main view and cascade like views looking into different directions
+  Math::FrustumPlanes frustumPlanes[_sphereCullingFrustumCount];
+  for (uint32_t i = 0u; i < _sphereCullingFrustumCount; ++i)
+  {
+    const float angle = glm::radians(90.0f) * i;
+    Math::extractFrustumPlanes(
+        frustumPlanes[i],
+        glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 1.0f,
+                         100.0f * (i + 1u)) *
+            glm::lookAt(glm::vec3(0.0f),
+                        glm::vec3(glm::sin(angle), 0.0f, glm::cos(angle)),
+                        glm::vec3(0.0f, 1.0f, 0.0f)));
+  }
+
+  CullingKernel::SphereSet spheres;
+  for (uint32_t i = 0u; i < _sphereCullingSphereCount; ++i)
+  {
+    Math::Sphere sphere;
+    sphere.p = glm::vec3(Math::calcRandomFloatMinMax(-500.0f, 500.0f),
+                         Math::calcRandomFloatMinMax(-50.0f, 50.0f),
+                         Math::calcRandomFloatMinMax(-500.0f, 500.0f));
+    sphere.r = Math::calcRandomFloatMinMax(0.5f, 4.0f);
+    spheres.add(sphere);
+  }
+
+  _INTR_ARRAY(uint32_t) visibilityMasks[3];
+  for (uint32_t i = 0u; i < 3u; ++i)
+  {
+    visibilityMasks[i].resize(_sphereCullingSphereCount);
+  }
+
+  const uint64_t scalarTime =
+      runCullingKernel(CullingKernel::cullScalar, frustumPlanes, spheres,
+                       visibilityMasks[0].data());
+  logResult("Culling kernel (scalar)", scalarTime,
+            _sphereCullingSphereCount * _sphereCullingRoundCount);
+
+  const uint64_t sseTime =
+      runCullingKernel(CullingKernel::cullSse, frustumPlanes, spheres,
+                       visibilityMasks[1].data());
+  logResult("Culling kernel (SSE)", sseTime,
+            _sphereCullingSphereCount * _sphereCullingRoundCount);
+  const uint32_t sseMismatchCount = calcMismatchCount(
+      frustumPlanes, spheres, visibilityMasks[1], visibilityMasks[0]);
+  _INTR_LOG_INFO("SSE mismatches to scalar: %u", sseMismatchCount);
+  _INTR_FATAL_CHECK(sseMismatchCount == 0u,
+                    "SSE culling kernel differs from the scalar kernel");
+
+  if (Simd::isAvx2Supported())
+  {
+    const uint64_t avx2Time =
+        runCullingKernel(CullingKernel::cullAvx2, frustumPlanes, spheres,
+                         visibilityMasks[2].data());
+    logResult("Culling kernel (AVX2)", avx2Time,
+              _sphereCullingSphereCount * _sphereCullingRoundCount);
+    const uint32_t avx2MismatchCount = calcMismatchCount(
+        frustumPlanes, spheres, visibilityMasks[2], visibilityMasks[0]);
+    _INTR_LOG_INFO("AVX2 mismatches to scalar: %u", avx2MismatchCount);
+    _INTR_FATAL_CHECK(avx2MismatchCount == 0u,
+                      "AVX2 culling kernel differs from the scalar kernel");
+  }
+  else
+  {
+    _INTR_LOG_INFO("AVX2 not supported, skipping AVX2 culling kernel...");
+  }
+}
+
+// <-
+
+void runOcclusionCulling()
+{
+  using namespace OcclusionCulling;
+
+  const float nearPlane = 1.0f;
+  const glm::mat4 viewProjMatrix =
+      glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, nearPlane, 500.0f) *
+      glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f),
+                  glm::vec3(0.0f, 1.0f, 0.0f));
+
+  // Build a tessellated wall facing the camera
+  _INTR_ARRAY(glm::vec3) positions;
+  _INTR_ARRAY(uint32_t) indices;
+  for (uint32_t y = 0u; y <= _occlusionWallQuadCountY; ++y)
+  {
+    for (uint32_t x = 0u; x <= _occlusionWallQuadCountX; ++x)
+    {
+      const glm::vec2 uv = glm::vec2(x / (float)_occlusionWallQuadCountX,
+                                     y / (float)_occlusionWallQuadCountY);
+      positions.push_back(glm::vec3(
+          (uv * 2.0f - 1.0f) * _occlusionWallHalfExtent,
+          _occlusionWallDistance));
+    }
+  }
+  for (uint32_t y = 0u; y < _occlusionWallQuadCountY; ++y)
+  {
+    for (uint32_t x = 0u; x < _occlusionWallQuadCountX; ++x)
+    {
+      const uint32_t i0 = y * (_occlusionWallQuadCountX + 1u) + x;
+      const uint32_t i1 = i0 + _occlusionWallQuadCountX + 1u;
+      const uint32_t quadIndices[] = {i0, i0 + 1u, i1 + 1u,
+                                      i0, i1 + 1u, i1};
+      indices.insert(indices.end(), quadIndices, quadIndices + 6u);
+    }
+  }
+
+  _INTR_ARRAY(Math::AABB) aabbs;
+  aabbs.resize(_occlusionBoxCount);
+  for (uint32_t i = 0u; i < _occlusionBoxCount; ++i)
+  {
+    const glm::vec3 center =
+        glm::vec3(Math::calcRandomFloatMinMax(-40.0f, 40.0f),
+                  Math::calcRandomFloatMinMax(-20.0f, 20.0f),
+                  Math::calcRandomFloatMinMax(5.0f, 100.0f));
+    const glm::vec3 halfExtent =
+        glm::vec3(Math::calcRandomFloatMinMax(0.2f, 3.0f),
+                  Math::calcRandomFloatMinMax(0.2f, 3.0f),
+                  Math::calcRandomFloatMinMax(0.2f, 3.0f));
+    aabbs[i] = Math::AABB(center - halfExtent, center + halfExtent);
+  }
+
+  DepthBuffer depthBuffer;
+  _INTR_ARRAY(ScreenTriangle) triangles;
+
+  uint64_t rasterizationTime = 0u;
+  uint64_t testTime = 0u;
+  uint32_t occludedCount = 0u;
+
+  for (uint32_t round = 0u; round < _occlusionRoundCount; ++round)
+  {
+    uint64_t startTime = TimingHelper::getMicroseconds();
+    triangles.clear();
+    DepthBuffer::setupTriangles(viewProjMatrix, nearPlane, positions.data(),
+                                indices.data(), (uint32_t)indices.size(),
+                                triangles);
+    depthBuffer.clear();
+    depthBuffer.rasterizeTriangles(triangles.data(), (uint32_t)triangles.size(),
+                                   0u, kTileCountY);
+    depthBuffer.updateTileDepths(0u, kTileCountY);
+    rasterizationTime += TimingHelper::getMicroseconds() - startTime;
+
+    startTime = TimingHelper::getMicroseconds();
+    occludedCount = 0u;
+    for (uint32_t i = 0u; i < _occlusionBoxCount; ++i)
+    {
+      if (!depthBuffer.isAABBVisible(aabbs[i], viewProjMatrix, nearPlane))
+      {
+        ++occludedCount;
+      }
+    }
+    testTime += TimingHelper::getMicroseconds() - startTime;
+  }
+
+  // Boxes reported as occluded have to be hidden behind the wall
+  uint32_t expectedOccludedCount = 0u;
+  uint32_t wronglyOccludedCount = 0u;
+  for (uint32_t i = 0u; i < _occlusionBoxCount; ++i)
+  {
+    const bool hidden = isHiddenByOcclusionWall(aabbs[i]);
+    expectedOccludedCount += hidden ? 1u : 0u;
+
+    if (!hidden &&
+        !depthBuffer.isAABBVisible(aabbs[i], viewProjMatrix, nearPlane))
+    {
+      ++wronglyOccludedCount;
+    }
+  }
+
+  logResult("Occluder rasterization", rasterizationTime,
+            (uint32_t)triangles.size() * _occlusionRoundCount);
+  logResult("Occlusion tests", testTime,
+            _occlusionBoxCount * _occlusionRoundCount);
+  _INTR_LOG_INFO("Occluded boxes: %u of %u hidden (%u wrongly occluded)",
+                 occludedCount, expectedOccludedCount, wronglyOccludedCount);
+  _INTR_FATAL_CHECK(wronglyOccludedCount == 0u,
+                    "Occlusion culling hides visible boxes");
+}
+
+// <-
+
+void runDrawCallSorting()
+{
+  for (uint32_t i = 0u; i < sizeof(_sortElementCounts) / sizeof(uint32_t); ++i)
+  {
+    runSort(_sortElementCounts[i]);
+  }
+
+  const uint32_t frontToBackMismatchCount =
+      checkSortingHashOrder(R::RenderOrder::kFrontToBack);
+  const uint32_t backToFrontMismatchCount =
+      checkSortingHashOrder(R::RenderOrder::kBackToFront);
+  _INTR_LOG_INFO("Sorting hash order mismatches: %u front to back, %u back to "
+                 "front",
+                 frontToBackMismatchCount, backToFrontMismatchCount);
+  _INTR_FATAL_CHECK(frontToBackMismatchCount == 0u &&
+                        backToFrontMismatchCount == 0u,
+                    "Draw calls sorted in the wrong order");
+}
+
+// <-
+
+void runMeshSimplification()
+{
+  // A gently curved height field in the unit square
+  _INTR_ARRAY(glm::vec3) positions;
+  _INTR_ARRAY(uint32_t) indices;
+  for (uint32_t y = 0u; y <= _simplificationGridSize; ++y)
+  {
+    for (uint32_t x = 0u; x <= _simplificationGridSize; ++x)
+    {
+      const glm::vec2 uv = glm::vec2(x, y) / (float)_simplificationGridSize;
+      positions.push_back(glm::vec3(
+          uv.x,
+          0.05f * glm::sin(uv.x * glm::two_pi<float>()) *
+              glm::cos(uv.y * glm::two_pi<float>()),
+          uv.y));
+    }
+  }
+  for (uint32_t y = 0u; y < _simplificationGridSize; ++y)
+  {
+    for (uint32_t x = 0u; x < _simplificationGridSize; ++x)
+    {
+      const uint32_t i0 = y * (_simplificationGridSize + 1u) + x;
+      const uint32_t i1 = i0 + _simplificationGridSize + 1u;
+      const uint32_t quadIndices[] = {i0, i1, i0 + 1u, i0 + 1u, i1, i1 + 1u};
+      indices.insert(indices.end(), quadIndices, quadIndices + 6u);
+    }
+  }
+
+  const uint32_t vertexCount = (uint32_t)positions.size();
+  const uint32_t sourceIndexCount = (uint32_t)indices.size();
+  const uint32_t targetIndexCount = sourceIndexCount / 6u * 3u;
+
+  _INTR_ARRAY(uint32_t) simplifiedIndices;
+  simplifiedIndices.resize(sourceIndexCount);
+  uint32_t indexCount = 0u;
+  float resultError = 0.0f;
+
+  const uint64_t startTime = TimingHelper::getMicroseconds();
+  for (uint32_t round = 0u; round < _simplificationRoundCount; ++round)
+  {
+    indexCount = MeshSimplifier::simplify(
+        positions.data(), vertexCount, indices.data(), sourceIndexCount,
+        targetIndexCount, _simplificationMaxError, simplifiedIndices.data(),
+        &resultError);
+  }
+  const uint64_t simplificationTime =
+      TimingHelper::getMicroseconds() - startTime;
+
+  // The borders are locked, so the projected area has to stay the same if no
+  // holes or overlaps were introduced
+  uint32_t degenerateTriangleCount = 0u;
+  float projectedArea = 0.0f;
+  for (uint32_t i = 0u; i < indexCount; i += 3u)
+  {
+    const uint32_t* tri = &simplifiedIndices[i];
+    if (tri[0] >= vertexCount || tri[1] >= vertexCount ||
+        tri[2] >= vertexCount || tri[0] == tri[1] || tri[0] == tri[2] ||
+        tri[1] == tri[2])
+    {
+      ++degenerateTriangleCount;
+      continue;
+    }
+
+    const glm::vec3& p0 = positions[tri[0]];
+    const glm::vec3& p1 = positions[tri[1]];
+    const glm::vec3& p2 = positions[tri[2]];
+    const glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+    if (glm::length(n) <= FLT_EPSILON)
+    {
+      ++degenerateTriangleCount;
+    }
+    projectedArea += 0.5f * n.y;
+  }
+
+  logResult("Mesh simplification", simplificationTime,
+            sourceIndexCount / 3u * _simplificationRoundCount);
+  _INTR_LOG_INFO("Simplified %u to %u triangles (target %u, error %f, %u "
+                 "degenerate, projected area %f)",
+                 sourceIndexCount / 3u, indexCount / 3u,
+                 targetIndexCount / 3u, resultError, degenerateTriangleCount,
+                 projectedArea);
+
+  _INTR_FATAL_CHECK(indexCount % 3u == 0u && indexCount <= targetIndexCount,
+                    "Mesh simplification missed the target triangle count");
+  _INTR_FATAL_CHECK(resultError <= _simplificationMaxError,
+                    "Mesh simplification exceeded the maximum error");
+  _INTR_FATAL_CHECK(degenerateTriangleCount == 0u,
+                    "Mesh simplification produced degenerate triangles");
+  _INTR_FATAL_CHECK(glm::abs(projectedArea - 1.0f) < 0.001f,
+                    "Mesh simplification changed the surface area");
+}
+}
+}
+}
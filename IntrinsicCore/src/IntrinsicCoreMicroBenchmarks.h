@@ -0,0 +1,88 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace MicroBenchmarks
+{
+/**
+ * Runs all available micro benchmarks and logs the results.
+ */
+void runAll();
+
+// <-
+
+/**
+ * Allocates and releases 100k handles of a Dod manager in random order.
+ */
+void runDodHandleChurn();
+
+// <-
+
+/**
+ * Computes world matrices and bounds for 100k random transformations using
+ * the scalar, SSE and AVX2 transform kernels and validates the results.
+ */
+void runTransformKernels();
+
+// <-
+
+/**
+ * Culls 10k to 1M randomly placed bounding volumes against a camera frustum
+ * using the spatial index and a brute force loop. The node density stays
+ * constant, so the spatial index should scale sub-linearly.
+ */
+void runSpatialIndexCulling();
+
+// <-
+
+/**
+ * Tests 100k random bounding spheres against four frustums using the scalar,
+ * SSE and AVX2 culling kernels and validates the results against the scalar
+ * reference.
+ */
+void runCullingKernels();
+
+// <-
+
+/**
+ * Rasterizes a tessellated wall into the software occlusion depth buffer and
+ * tests 100k random bounding boxes against it. Boxes reported as occluded
+ * are validated against the exact wall projection.
+ */
+void runOcclusionCulling();
+
+// <-
+
+/**
+ * Sorts 10k to 200k random draw call like 64-bit keys using the comparison
+ * based parallel sort and the parallel radix sort and validates the results.
+ */
+void runDrawCallSorting();
+
+// <-
+
+/**
+ * Simplifies a tessellated height field with 131k triangles to half of its
+ * triangles and validates the triangle count, the error and the topology of
+ * the result.
+ */
+void runMeshSimplification();
+}
+}
+}
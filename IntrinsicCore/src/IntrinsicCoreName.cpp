@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+
 // Precompiled header file
 #include "stdafx.h"
 
@@ -19,6 +20,173 @@ namespace Intrinsic
 {
 namespace Core
 {
-_INTR_HASH_MAP(uint32_t, _INTR_STRING) Name::_stringMap;
+namespace
+{
+struct InternedString
+{
+  uint64_t hash;
+  const char* string;
+  uint32_t length;
+};
+
+// Open addressing table of the interned strings. Lookups probe the table
+// without taking a lock, inserts are serialized using a mutex and publish new
+// entries and grown tables using release stores. Neither entries nor replaced
+// tables are ever freed, so readers can keep probing a table while it is being
+// replaced
+struct InternTable
+{
+  std::atomic<const InternedString*>* slots;
+  uint32_t slotMask;
+};
+
+enum
+{
+  kInitialInternTableSlotCount = 4096u
+};
+
+std::atomic<InternTable*> _internTable;
+std::mutex _internMutex;
+uint32_t _internedStringCount = 0u;
+
+// <-
+
+_INTR_INLINE InternTable* createInternTable(uint32_t p_SlotCount)
+{
+  InternTable* table = (InternTable*)Memory::Tlsf::MainAllocator::allocate(
+      sizeof(InternTable));
+  table->slots = (std::atomic<const InternedString*>*)
+      Memory::Tlsf::MainAllocator::allocate(
+          p_SlotCount * sizeof(std::atomic<const InternedString*>));
+  table->slotMask = p_SlotCount - 1u;
+
+  for (uint32_t i = 0u; i < p_SlotCount; ++i)
+  {
+    new (&table->slots[i]) std::atomic<const InternedString*>(nullptr);
+  }
+
+  return table;
+}
+
+// <-
+
+_INTR_INLINE const InternedString*
+findInternedString(const InternTable* p_Table, uint64_t p_Hash)
+{
+  for (uint32_t slotIdx = (uint32_t)p_Hash & p_Table->slotMask;;
+       slotIdx = (slotIdx + 1u) & p_Table->slotMask)
+  {
+    const InternedString* entry =
+        p_Table->slots[slotIdx].load(std::memory_order_acquire);
+
+    if (entry == nullptr || entry->hash == p_Hash)
+    {
+      return entry;
+    }
+  }
+}
+
+// <-
+
+_INTR_INLINE void insertInternedString(InternTable* p_Table,
+                                       const InternedString* p_Entry)
+{
+  uint32_t slotIdx = (uint32_t)p_Entry->hash & p_Table->slotMask;
+  while (p_Table->slots[slotIdx].load(std::memory_order_relaxed) != nullptr)
+  {
+    slotIdx = (slotIdx + 1u) & p_Table->slotMask;
+  }
+
+  p_Table->slots[slotIdx].store(p_Entry, std::memory_order_release);
+}
+}
+
+// <-
+
+void Name::intern(uint64_t p_Hash, const char* p_String, uint32_t p_Length)
+{
+  const InternTable* table = _internTable.load(std::memory_order_acquire);
+  const InternedString* existing =
+      table != nullptr ? findInternedString(table, p_Hash) : nullptr;
+
+  if (existing == nullptr)
+  {
+    std::lock_guard<std::mutex> lock(_internMutex);
+
+    InternTable* currentTable = _internTable.load(std::memory_order_relaxed);
+    if (currentTable == nullptr)
+    {
+      currentTable = createInternTable(kInitialInternTableSlotCount);
+      _internTable.store(currentTable, std::memory_order_release);
+    }
+
+    // Might have been added while waiting for the lock
+    existing = findInternedString(currentTable, p_Hash);
+    if (existing == nullptr)
+    {
+      // Keep the load factor below 50%
+      const uint32_t slotCount = currentTable->slotMask + 1u;
+      if ((_internedStringCount + 1u) * 2u > slotCount)
+      {
+        InternTable* grownTable = createInternTable(slotCount * 2u);
+        for (uint32_t i = 0u; i < slotCount; ++i)
+        {
+          const InternedString* entry =
+              currentTable->slots[i].load(std::memory_order_relaxed);
+          if (entry != nullptr)
+          {
+            insertInternedString(grownTable, entry);
+          }
+        }
+
+        _internTable.store(grownTable, std::memory_order_release);
+        currentTable = grownTable;
+      }
+
+      // Interned strings are never freed so views to them stay valid
+      char* string =
+          (char*)Memory::Tlsf::MainAllocator::allocate(p_Length + 1u);
+      memcpy(string, p_String, p_Length);
+      string[p_Length] = '\0';
+
+      InternedString* entry =
+          (InternedString*)Memory::Tlsf::MainAllocator::allocate(
+              sizeof(InternedString));
+      *entry = {p_Hash, string, p_Length};
+
+      insertInternedString(currentTable, entry);
+      ++_internedStringCount;
+      return;
+    }
+  }
+
+  if (existing->length != p_Length ||
+      memcmp(existing->string, p_String, p_Length) != 0)
+  {
+    _INTR_LOG_ERROR("Name hash collision between '%s' and '%.*s'",
+                    existing->string, p_Length, p_String);
+    _INTR_ASSERT(false && "Name hash collision");
+  }
+}
+
+// <-
+
+_INTR_STRING_VIEW Name::getString() const
+{
+  if (_hash == 0u)
+  {
+    return _INTR_STRING_VIEW("", 0u);
+  }
+
+  const InternTable* table = _internTable.load(std::memory_order_acquire);
+  const InternedString* entry =
+      table != nullptr ? findInternedString(table, _hash) : nullptr;
+  if (entry == nullptr)
+  {
+    return _INTR_STRING_VIEW("", 0u);
+  }
+
+  return _INTR_STRING_VIEW(entry->string, entry->length);
+}
 }
 }
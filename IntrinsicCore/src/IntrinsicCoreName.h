@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+
 #pragma once
 
 namespace Intrinsic
@@ -20,34 +21,66 @@ namespace Core
 {
 struct Name
 {
-  _INTR_INLINE Name() : _hash(0u) {}
-  _INTR_INLINE Name(const _INTR_STRING& p_String) { setName(p_String.c_str()); }
-  _INTR_INLINE Name(const char* p_String) { setName(p_String); }
-  _INTR_INLINE Name(uint32_t p_Hash) : _hash(p_Hash) {}
+  _INTR_INLINE constexpr Name() : _hash(0u) {}
+  _INTR_INLINE constexpr Name(uint64_t p_Hash) : _hash(p_Hash) {}
+  _INTR_INLINE Name(const _INTR_STRING& p_String)
+  {
+    setName(p_String.c_str(), p_String.size());
+  }
+  _INTR_INLINE Name(_INTR_STRING_VIEW p_String)
+  {
+    setName(p_String.data(), p_String.size());
+  }
+  _INTR_INLINE Name(const char* p_String)
+  {
+    setName(p_String, strlen(p_String));
+  }
+
+  // Used by _N(x): the hash is evaluated at compile time and the string is
+  // only interned once per distinct literal
+  template <uint64_t Hash>
+  _INTR_INLINE static Name fromLiteral(const char* p_String, uint32_t p_Length)
+  {
+    static const bool interned = (intern(Hash, p_String, p_Length), true);
+    (void)interned;
+    return Name(Hash);
+  }
 
-  _INTR_INLINE void setName(const char* p_String)
+  _INTR_INLINE void setName(const char* p_String, std::size_t p_Length)
   {
-    _hash = Math::hash(p_String, strlen(p_String));
-    if (_stringMap.find(_hash) == _stringMap.end())
-      _stringMap[_hash] = p_String;
+    // Empty strings map to the invalid name
+    _hash = p_Length > 0u ? Math::hash64(p_String, p_Length) : 0u;
+
+    if (_hash != 0u)
+    {
+      intern(_hash, p_String, (uint32_t)p_Length);
+    }
   }
 
   _INTR_INLINE bool isValid() const { return _hash != 0u; }
 
-  _INTR_INLINE _INTR_STRING getString() const { return _stringMap[_hash]; }
+  // Returns a view of the interned string. The view stays valid for the
+  // lifetime of the application and is always null terminated
+  _INTR_STRING_VIEW getString() const;
+  _INTR_INLINE const char* c_str() const { return getString().data(); }
 
-  _INTR_INLINE bool operator==(const Name& p_Rhs) const
+  _INTR_INLINE constexpr bool operator==(const Name& p_Rhs) const
   {
     return _hash == p_Rhs._hash;
   }
 
-  _INTR_INLINE bool operator!=(const Name& p_Rhs) const
+  _INTR_INLINE constexpr bool operator!=(const Name& p_Rhs) const
   {
     return !(*this == p_Rhs);
   }
 
-  uint32_t _hash;
-  static _INTR_HASH_MAP(uint32_t, _INTR_STRING) _stringMap;
+  // Adds the string to the global intern table. Safe to call from multiple
+  // threads, reports an error if two different strings share the same hash.
+  // Only inserting new strings takes a lock, lookups of strings already
+  // interned (and getString()) are lock free
+  static void intern(uint64_t p_Hash, const char* p_String, uint32_t p_Length);
+
+  uint64_t _hash;
 };
 }
 }
@@ -57,6 +90,6 @@ namespace std
 template <> class hash<Name>
 {
 public:
-  size_t operator()(const Name& p_Name) const { return p_Name._hash; }
+  size_t operator()(const Name& p_Name) const { return (size_t)p_Name._hash; }
 };
 };
@@ -0,0 +1,639 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Precompiled header file
+#include "stdafx.h"
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace OcclusionCulling
+{
+namespace
+{
+// Occluders are selected by their screen size (bounding sphere radius divided
+// by the distance to the camera) within the given budgets
+const float _minOccluderScreenSize = 0.1f;
+const uint32_t _maxAutomaticOccluderTriangleCount = 4096u;
+const uint32_t _maxOccluderCount = 64u;
+const uint32_t _maxOccluderTriangleCount = 65536u;
+
+struct OccluderCandidate
+{
+  _INTR_INLINE bool operator<(const OccluderCandidate& p_Rhs) const
+  {
+    return priority > p_Rhs.priority;
+  }
+
+  Components::NodeRef node;
+  Resources::MeshRef mesh;
+  float priority;
+  uint32_t triangleCount;
+};
+
+DepthBuffer _depthBuffer;
+_INTR_ARRAY(OccluderCandidate) _occluders;
+_INTR_ARRAY(_INTR_ARRAY(ScreenTriangle)) _trianglesPerOccluder;
+
+glm::mat4 _viewProjMatrix;
+float _nearPlane;
+// The visible Nodes of the frustum to cull
+Dod::RefArray* _visibleNodes;
+
+// <-
+
+_INTR_INLINE glm::vec3 projectToScreen(const glm::vec4& p_ClipPos)
+{
+  const float invW = 1.0f / p_ClipPos.w;
+  return glm::vec3(
+      (p_ClipPos.x * invW * 0.5f + 0.5f) * kDepthBufferWidth,
+      (p_ClipPos.y * invW * 0.5f + 0.5f) * kDepthBufferHeight, invW);
+}
+
+// <-
+
+_INTR_INLINE void addTriangle(const glm::vec4& p_V0, const glm::vec4& p_V1,
+                              const glm::vec4& p_V2,
+                              _INTR_ARRAY(ScreenTriangle) & p_Triangles)
+{
+  ScreenTriangle triangle;
+  triangle.v[0] = projectToScreen(p_V0);
+  triangle.v[1] = projectToScreen(p_V1);
+  triangle.v[2] = projectToScreen(p_V2);
+  p_Triangles.push_back(triangle);
+}
+
+// <-
+
+struct OccluderSetupParallelTaskSet : enki::ITaskSet
+{
+  virtual ~OccluderSetupParallelTaskSet() {}
+
+  void ExecuteRange(enki::TaskSetPartition p_Range,
+                    uint32_t p_ThreadNum) override
+  {
+    _INTR_PROFILE_CPU("Occlusion Culling", "Setup Occluders Job");
+
+    for (uint32_t occluderIdx = p_Range.start; occluderIdx < p_Range.end;
+         ++occluderIdx)
+    {
+      const OccluderCandidate& occluder = _occluders[occluderIdx];
+      _INTR_ARRAY(ScreenTriangle)& triangles =
+          _trianglesPerOccluder[occluderIdx];
+      triangles.clear();
+
+      const glm::mat4 worldViewProjMatrix =
+          _viewProjMatrix *
+          Components::NodeManager::_worldMatrix(occluder.node);
+      const Resources::PositionsPerSubMeshArray& positionsPerSubMesh =
+          Resources::MeshManager::_descPositionsPerSubMesh(occluder.mesh);
+      const Resources::IndicesPerSubMeshArray& indicesPerSubMesh =
+          Resources::MeshManager::_descIndicesPerSubMesh(occluder.mesh);
+
+      for (uint32_t subMeshIdx = 0u; subMeshIdx < indicesPerSubMesh.size();
+           ++subMeshIdx)
+      {
+        DepthBuffer::setupTriangles(
+            worldViewProjMatrix, _nearPlane,
+            positionsPerSubMesh[subMeshIdx].data(),
+            indicesPerSubMesh[subMeshIdx].data(),
+            (uint32_t)indicesPerSubMesh[subMeshIdx].size(), triangles);
+      }
+    }
+  }
+} _occluderSetupTaskSet;
+
+// <-
+
+struct OccluderRasterizationParallelTaskSet : enki::ITaskSet
+{
+  virtual ~OccluderRasterizationParallelTaskSet() {}
+
+  void ExecuteRange(enki::TaskSetPartition p_Range,
+                    uint32_t p_ThreadNum) override
+  {
+    _INTR_PROFILE_CPU("Occlusion Culling", "Rasterize Occluders Job");
+
+    // Each job owns a range of tile rows, so no synchronization is needed
+    for (uint32_t occluderIdx = 0u; occluderIdx < _occluders.size();
+         ++occluderIdx)
+    {
+      const _INTR_ARRAY(ScreenTriangle)& triangles =
+          _trianglesPerOccluder[occluderIdx];
+      _depthBuffer.rasterizeTriangles(triangles.data(),
+                                      (uint32_t)triangles.size(),
+                                      p_Range.start, p_Range.end);
+    }
+
+    _depthBuffer.updateTileDepths(p_Range.start, p_Range.end);
+  }
+} _occluderRasterizationTaskSet;
+
+// <-
+
+struct OcclusionTestParallelTaskSet : enki::ITaskSet
+{
+  virtual ~OcclusionTestParallelTaskSet() {}
+
+  void ExecuteRange(enki::TaskSetPartition p_Range,
+                    uint32_t p_ThreadNum) override
+  {
+    _INTR_PROFILE_CPU("Occlusion Culling", "Test Occludees Job");
+
+    uint32_t occludedNodeCount = 0u;
+
+    for (uint32_t i = p_Range.start; i < p_Range.end; ++i)
+    {
+      Components::NodeRef& nodeRef = (*_visibleNodes)[i];
+
+      // Occluded Nodes are invalidated and removed after all tests are done
+      if (!_depthBuffer.isAABBVisible(
+              Components::NodeManager::_worldAABB(nodeRef), _viewProjMatrix,
+              _nearPlane))
+      {
+        nodeRef = Components::NodeRef();
+        ++occludedNodeCount;
+      }
+    }
+
+    _occludedNodeCount.fetch_add(occludedNodeCount, std::memory_order_relaxed);
+  }
+
+  std::atomic<uint32_t> _occludedNodeCount;
+} _occlusionTestTaskSet;
+
+// <-
+
+void collectOccluders(const glm::vec3& p_CameraPosition)
+{
+  _INTR_PROFILE_CPU("Occlusion Culling", "Collect Occluders");
+
+  _occluders.clear();
+
+  for (uint32_t i = 0u; i < _visibleNodes->size(); ++i)
+  {
+    Components::NodeRef nodeRef = (*_visibleNodes)[i];
+    const Resources::MeshRef meshRef = Components::NodeManager::_mesh(nodeRef);
+
+    if (!meshRef.isValid())
+    {
+      continue;
+    }
+
+    Components::MeshRef meshCompRef =
+        Components::MeshManager::getComponentForEntity(
+            Components::NodeManager::_entity(nodeRef));
+    const Components::OccluderMode::Enum occluderMode =
+        Components::MeshManager::_descOccluderMode(meshCompRef);
+
+    if (occluderMode == Components::OccluderMode::kNever)
+    {
+      continue;
+    }
+
+    const Resources::IndicesPerSubMeshArray& indicesPerSubMesh =
+        Resources::MeshManager::_descIndicesPerSubMesh(meshRef);
+    uint32_t triangleCount = 0u;
+    for (uint32_t subMeshIdx = 0u; subMeshIdx < indicesPerSubMesh.size();
+         ++subMeshIdx)
+    {
+      triangleCount += (uint32_t)indicesPerSubMesh[subMeshIdx].size() / 3u;
+    }
+
+    const Math::Sphere& boundingSphere =
+        Components::NodeManager::_worldBoundingSphere(nodeRef);
+    const float screenSize =
+        boundingSphere.r /
+        glm::max(glm::length(boundingSphere.p - p_CameraPosition), _nearPlane);
+
+    if (occluderMode == Components::OccluderMode::kAutomatic &&
+        (screenSize < _minOccluderScreenSize ||
+         triangleCount > _maxAutomaticOccluderTriangleCount))
+    {
+      continue;
+    }
+
+    OccluderCandidate candidate;
+    candidate.node = nodeRef;
+    candidate.mesh = meshRef;
+    candidate.triangleCount = triangleCount;
+    // Prefer occluders picked by artists
+    candidate.priority = occluderMode == Components::OccluderMode::kAlways
+                             ? FLT_MAX
+                             : screenSize;
+    _occluders.push_back(candidate);
+  }
+
+  std::sort(_occluders.begin(), _occluders.end());
+
+  // Apply the budgets
+  uint32_t occluderCount = 0u;
+  uint32_t totalTriangleCount = 0u;
+  for (; occluderCount < _occluders.size() &&
+         occluderCount < _maxOccluderCount;
+       ++occluderCount)
+  {
+    totalTriangleCount += _occluders[occluderCount].triangleCount;
+    if (totalTriangleCount > _maxOccluderTriangleCount)
+    {
+      break;
+    }
+  }
+  _occluders.resize(occluderCount);
+
+  if (_trianglesPerOccluder.size() < occluderCount)
+  {
+    _trianglesPerOccluder.resize(occluderCount);
+  }
+
+  _INTR_PROFILE_COUNTER_SET("Occluders", occluderCount);
+}
+}
+
+// <-
+
+DepthBuffer::DepthBuffer()
+{
+  _depth = (float*)Memory::Tlsf::MainAllocator::allocateAligned(
+      kDepthBufferWidth * kDepthBufferHeight * sizeof(float), 16u);
+  clear();
+}
+
+// <-
+
+DepthBuffer::~DepthBuffer()
+{
+  Memory::Tlsf::MainAllocator::free(_depth);
+  _depth = nullptr;
+}
+
+// <-
+
+void DepthBuffer::clear()
+{
+  // An inverse depth of zero is infinitely far away
+  memset(_depth, 0x00, kDepthBufferWidth * kDepthBufferHeight * sizeof(float));
+  memset(_tileDepth, 0x00, sizeof(_tileDepth));
+}
+
+// <-
+
+void DepthBuffer::setupTriangles(const glm::mat4& p_WorldViewProjMatrix,
+                                 float p_NearPlane,
+                                 const glm::vec3* p_Positions,
+                                 const uint32_t* p_Indices,
+                                 uint32_t p_IndexCount,
+                                 _INTR_ARRAY(ScreenTriangle) & p_Triangles)
+{
+  for (uint32_t i = 0u; i + 2u < p_IndexCount; i += 3u)
+  {
+    const glm::vec4 v[3] = {
+        p_WorldViewProjMatrix * glm::vec4(p_Positions[p_Indices[i]], 1.0f),
+        p_WorldViewProjMatrix * glm::vec4(p_Positions[p_Indices[i + 1u]], 1.0f),
+        p_WorldViewProjMatrix *
+            glm::vec4(p_Positions[p_Indices[i + 2u]], 1.0f)};
+
+    // Reject triangles fully outside one of the side planes
+    if ((v[0].x > v[0].w && v[1].x > v[1].w && v[2].x > v[2].w) ||
+        (v[0].x < -v[0].w && v[1].x < -v[1].w && v[2].x < -v[2].w) ||
+        (v[0].y > v[0].w && v[1].y > v[1].w && v[2].y > v[2].w) ||
+        (v[0].y < -v[0].w && v[1].y < -v[1].w && v[2].y < -v[2].w))
+    {
+      continue;
+    }
+
+    const bool inside[3] = {v[0].w >= p_NearPlane, v[1].w >= p_NearPlane,
+                            v[2].w >= p_NearPlane};
+    const uint32_t insideCount =
+        (uint32_t)inside[0] + (uint32_t)inside[1] + (uint32_t)inside[2];
+
+    if (insideCount == 3u)
+    {
+      addTriangle(v[0], v[1], v[2], p_Triangles);
+    }
+    else if (insideCount > 0u)
+    {
+      // Clip against the near plane and triangulate the resulting polygon
+      glm::vec4 polygon[4];
+      uint32_t polygonSize = 0u;
+
+      for (uint32_t j = 0u; j < 3u; ++j)
+      {
+        const uint32_t k = (j + 1u) % 3u;
+
+        if (inside[j])
+        {
+          polygon[polygonSize++] = v[j];
+        }
+        if (inside[j] != inside[k])
+        {
+          const float t = (p_NearPlane - v[j].w) / (v[k].w - v[j].w);
+          polygon[polygonSize++] = v[j] + (v[k] - v[j]) * t;
+        }
+      }
+
+      for (uint32_t j = 1u; j + 1u < polygonSize; ++j)
+      {
+        addTriangle(polygon[0], polygon[j], polygon[j + 1u], p_Triangles);
+      }
+    }
+  }
+}
+
+// <-
+
+void DepthBuffer::rasterizeTriangles(const ScreenTriangle* p_Triangles,
+                                     uint32_t p_Count,
+                                     uint32_t p_FirstTileRow,
+                                     uint32_t p_EndTileRow)
+{
+  const float firstRow = (float)(p_FirstTileRow * kTileSize);
+  const float endRow = (float)(p_EndTileRow * kTileSize);
+  const __m128 pixelCenterOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+  const __m128 zero = _mm_setzero_ps();
+
+  for (uint32_t triIdx = 0u; triIdx < p_Count; ++triIdx)
+  {
+    glm::vec3 v0 = p_Triangles[triIdx].v[0];
+    glm::vec3 v1 = p_Triangles[triIdx].v[1];
+    glm::vec3 v2 = p_Triangles[triIdx].v[2];
+
+    // Clamp the bounds to the screen and the row range
+    const float minX = glm::max(glm::min(v0.x, glm::min(v1.x, v2.x)), 0.0f);
+    const float maxX = glm::min(glm::max(v0.x, glm::max(v1.x, v2.x)),
+                                (float)kDepthBufferWidth);
+    const float minY = glm::max(glm::min(v0.y, glm::min(v1.y, v2.y)), firstRow);
+    const float maxY = glm::min(glm::max(v0.y, glm::max(v1.y, v2.y)), endRow);
+
+    if (minX >= maxX || minY >= maxY)
+    {
+      continue;
+    }
+
+    float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+    if (glm::abs(area) < _INTR_EPSILON)
+    {
+      continue;
+    }
+
+    // Occluders are rasterized two sided
+    if (area < 0.0f)
+    {
+      std::swap(v1, v2);
+      area = -area;
+    }
+
+    // Edge functions (positive inside) and the depth plane
+    const float a0 = v0.y - v1.y, b0 = v1.x - v0.x;
+    const float a1 = v1.y - v2.y, b1 = v2.x - v1.x;
+    const float a2 = v2.y - v0.y, b2 = v0.x - v2.x;
+    const float c0 = -(a0 * v0.x + b0 * v0.y);
+    const float c1 = -(a1 * v1.x + b1 * v1.y);
+    const float c2 = -(a2 * v2.x + b2 * v2.y);
+
+    const float invArea = 1.0f / area;
+    const float dzdx =
+        ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) *
+        invArea;
+    const float dzdy =
+        ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) *
+        invArea;
+    const float cz = v0.z - dzdx * v0.x - dzdy * v0.y;
+
+    const __m128 a0s = _mm_set1_ps(a0);
+    const __m128 a1s = _mm_set1_ps(a1);
+    const __m128 a2s = _mm_set1_ps(a2);
+    const __m128 dzdxs = _mm_set1_ps(dzdx);
+
+    // Blocks of four pixels starting at a multiple of four
+    const uint32_t firstX = (uint32_t)minX & ~3u;
+    const uint32_t endX = (uint32_t)glm::ceil(maxX);
+    const uint32_t firstY = (uint32_t)minY;
+    const uint32_t endY = (uint32_t)glm::ceil(maxY);
+
+    for (uint32_t y = firstY; y < endY; ++y)
+    {
+      const float py = y + 0.5f;
+      const __m128 e0Row = _mm_set1_ps(b0 * py + c0);
+      const __m128 e1Row = _mm_set1_ps(b1 * py + c1);
+      const __m128 e2Row = _mm_set1_ps(b2 * py + c2);
+      const __m128 zRow = _mm_set1_ps(dzdy * py + cz);
+
+      float* row = &_depth[y * kDepthBufferWidth];
+
+      for (uint32_t x = firstX; x < endX; x += 4u)
+      {
+        const __m128 px =
+            _mm_add_ps(_mm_set1_ps((float)x), pixelCenterOffsets);
+
+        const __m128 e0 = Simd::simdMadd(a0s, px, e0Row);
+        const __m128 e1 = Simd::simdMadd(a1s, px, e1Row);
+        const __m128 e2 = Simd::simdMadd(a2s, px, e2Row);
+
+        const __m128 mask = _mm_and_ps(
+            _mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)),
+            _mm_cmpge_ps(e2, zero));
+
+        if (_mm_movemask_ps(mask) == 0)
+        {
+          continue;
+        }
+
+        // Keep the closest occluder (largest inverse depth) per pixel
+        const __m128 z = Simd::simdMadd(dzdxs, px, zRow);
+        const __m128 depth = _mm_load_ps(&row[x]);
+        const __m128 closestDepth = _mm_max_ps(depth, z);
+        _mm_store_ps(&row[x], _mm_or_ps(_mm_and_ps(mask, closestDepth),
+                                        _mm_andnot_ps(mask, depth)));
+      }
+    }
+  }
+}
+
+// <-
+
+void DepthBuffer::updateTileDepths(uint32_t p_FirstTileRow,
+                                   uint32_t p_EndTileRow)
+{
+  for (uint32_t tileY = p_FirstTileRow; tileY < p_EndTileRow; ++tileY)
+  {
+    for (uint32_t tileX = 0u; tileX < kTileCountX; ++tileX)
+    {
+      const float* tile =
+          &_depth[tileY * kTileSize * kDepthBufferWidth + tileX * kTileSize];
+
+      __m128 farthestDepth = _mm_load_ps(tile);
+      for (uint32_t y = 0u; y < kTileSize; ++y)
+      {
+        const float* row = &tile[y * kDepthBufferWidth];
+        for (uint32_t x = 0u; x < kTileSize; x += 4u)
+        {
+          farthestDepth = _mm_min_ps(farthestDepth, _mm_load_ps(&row[x]));
+        }
+      }
+
+      farthestDepth = _mm_min_ps(farthestDepth,
+                                 _mm_movehl_ps(farthestDepth, farthestDepth));
+      farthestDepth =
+          _mm_min_ps(farthestDepth, Simd::simdSplatY(farthestDepth));
+      _mm_store_ss(&_tileDepth[tileY * kTileCountX + tileX], farthestDepth);
+    }
+  }
+}
+
+// <-
+
+bool DepthBuffer::isAABBVisible(const Math::AABB& p_WorldAABB,
+                                const glm::mat4& p_ViewProjMatrix,
+                                float p_NearPlane) const
+{
+  glm::vec3 corners[8];
+  Math::calcAABBCorners(p_WorldAABB, corners);
+
+  glm::vec2 screenMin = glm::vec2(FLT_MAX);
+  glm::vec2 screenMax = glm::vec2(-FLT_MAX);
+  float minW = FLT_MAX;
+
+  for (uint32_t i = 0u; i < 8u; ++i)
+  {
+    const glm::vec4 clipPos = p_ViewProjMatrix * glm::vec4(corners[i], 1.0f);
+
+    // Conservatively treat boxes intersecting the near plane as visible
+    if (clipPos.w < p_NearPlane)
+    {
+      return true;
+    }
+
+    const glm::vec3 screenPos = projectToScreen(clipPos);
+    screenMin = glm::min(screenMin, glm::vec2(screenPos));
+    screenMax = glm::max(screenMax, glm::vec2(screenPos));
+    minW = glm::min(minW, clipPos.w);
+  }
+
+  // Pad by a pixel since occluders cover pixels by their centers only
+  const int32_t firstX = glm::max((int32_t)glm::floor(screenMin.x) - 1, 0);
+  const int32_t firstY = glm::max((int32_t)glm::floor(screenMin.y) - 1, 0);
+  const int32_t endX = glm::min((int32_t)glm::ceil(screenMax.x) + 1,
+                                (int32_t)kDepthBufferWidth);
+  const int32_t endY = glm::min((int32_t)glm::ceil(screenMax.y) + 1,
+                                (int32_t)kDepthBufferHeight);
+
+  // Leave boxes outside the screen to frustum culling
+  if (firstX >= endX || firstY >= endY)
+  {
+    return true;
+  }
+
+  // The box is hidden if the occluders are closer on all covered pixels
+  const float closestDepth = 1.0f / minW;
+
+  for (int32_t tileY = firstY / kTileSize;
+       tileY <= (endY - 1) / (int32_t)kTileSize; ++tileY)
+  {
+    for (int32_t tileX = firstX / kTileSize;
+         tileX <= (endX - 1) / (int32_t)kTileSize; ++tileX)
+    {
+      if (_tileDepth[tileY * kTileCountX + tileX] > closestDepth)
+      {
+        continue;
+      }
+
+      const int32_t tileFirstX = glm::max(tileX * (int32_t)kTileSize, firstX);
+      const int32_t tileFirstY = glm::max(tileY * (int32_t)kTileSize, firstY);
+      const int32_t tileEndX =
+          glm::min((tileX + 1) * (int32_t)kTileSize, endX);
+      const int32_t tileEndY =
+          glm::min((tileY + 1) * (int32_t)kTileSize, endY);
+
+      for (int32_t y = tileFirstY; y < tileEndY; ++y)
+      {
+        for (int32_t x = tileFirstX; x < tileEndX; ++x)
+        {
+          if (_depth[y * kDepthBufferWidth + x] <= closestDepth)
+          {
+            return true;
+          }
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+// <-
+
+void cullNodes(Resources::FrustumRef p_Frustum, uint32_t p_FrustumIdx)
+{
+  _INTR_PROFILE_CPU("Occlusion Culling", "Occlusion Culling");
+
+  // Inverse depths are only linear in screen space for perspective
+  // projections
+  if (Resources::FrustumManager::_descProjectionType(p_Frustum) !=
+      Resources::ProjectionType::kPerspective)
+  {
+    return;
+  }
+
+  _viewProjMatrix = Resources::FrustumManager::_viewProjectionMatrix(p_Frustum);
+  _nearPlane =
+      Resources::FrustumManager::_descNearFarPlaneDistances(p_Frustum).x;
+  _visibleNodes =
+      &Resources::FrustumManager::_visibleNodesPerFrustum[p_FrustumIdx];
+
+  collectOccluders(glm::vec3(
+      Resources::FrustumManager::_invViewMatrix(p_Frustum)[3]));
+
+  _depthBuffer.clear();
+
+  if (_occluders.empty())
+  {
+    _INTR_PROFILE_COUNTER_SET("Occluded Nodes", 0u);
+    return;
+  }
+
+  _occluderSetupTaskSet.m_SetSize = (uint32_t)_occluders.size();
+  Application::_scheduler.AddTaskSetToPipe(&_occluderSetupTaskSet);
+  Application::_scheduler.WaitforTaskSet(&_occluderSetupTaskSet);
+
+  _occluderRasterizationTaskSet.m_SetSize = kTileCountY;
+  Application::_scheduler.AddTaskSetToPipe(&_occluderRasterizationTaskSet);
+  Application::_scheduler.WaitforTaskSet(&_occluderRasterizationTaskSet);
+
+  _occlusionTestTaskSet._occludedNodeCount.store(0u,
+                                                 std::memory_order_relaxed);
+  _occlusionTestTaskSet.m_SetSize =
+      (uint32_t)_visibleNodes->size();
+  Application::_scheduler.AddTaskSetToPipe(&_occlusionTestTaskSet);
+  Application::_scheduler.WaitforTaskSet(&_occlusionTestTaskSet);
+
+  // Compact the visible Nodes
+  uint32_t visibleNodeCount = 0u;
+  for (uint32_t i = 0u; i < _visibleNodes->size(); ++i)
+  {
+    if ((*_visibleNodes)[i].isValid())
+    {
+      (*_visibleNodes)[visibleNodeCount++] = (*_visibleNodes)[i];
+    }
+  }
+  _visibleNodes->resize(visibleNodeCount);
+
+  _INTR_PROFILE_COUNTER_SET(
+      "Occluded Nodes",
+      _occlusionTestTaskSet._occludedNodeCount.load(std::memory_order_relaxed));
+}
+}
+}
+}
@@ -0,0 +1,110 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace OcclusionCulling
+{
+// Resolution of the software depth buffer. The width has to be a multiple of
+// four and both dimensions have to be multiples of the tile size
+const uint32_t kDepthBufferWidth = 320u;
+const uint32_t kDepthBufferHeight = 192u;
+const uint32_t kTileSize = 8u;
+const uint32_t kTileCountX = kDepthBufferWidth / kTileSize;
+const uint32_t kTileCountY = kDepthBufferHeight / kTileSize;
+
+/**
+ * Occluder triangle in screen space. Stores the pixel coordinates and the
+ * inverse view depth (1/w) of each vertex.
+ */
+struct ScreenTriangle
+{
+  glm::vec3 v[3];
+};
+
+/**
+ * Low resolution depth buffer storing the inverse view depth of the closest
+ * occluder per pixel. A coarse level stores the farthest occluder depth per
+ * tile so most tests can be resolved without touching single pixels.
+ */
+struct DepthBuffer
+{
+  DepthBuffer();
+  ~DepthBuffer();
+
+  // <-
+
+  void clear();
+
+  // <-
+
+  /**
+   * Transforms the given indexed triangles to screen space, clips them
+   * against the near plane and appends them to p_Triangles.
+   */
+  static void setupTriangles(const glm::mat4& p_WorldViewProjMatrix,
+                             float p_NearPlane, const glm::vec3* p_Positions,
+                             const uint32_t* p_Indices, uint32_t p_IndexCount,
+                             _INTR_ARRAY(ScreenTriangle) & p_Triangles);
+
+  // <-
+
+  /**
+   * Rasterizes the given triangles into the rows of tiles in the range
+   * [p_FirstTileRow, p_EndTileRow). Different row ranges can be rasterized
+   * concurrently.
+   */
+  void rasterizeTriangles(const ScreenTriangle* p_Triangles, uint32_t p_Count,
+                          uint32_t p_FirstTileRow, uint32_t p_EndTileRow);
+
+  // <-
+
+  /**
+   * Updates the coarse tile depths for the rows of tiles in the range
+   * [p_FirstTileRow, p_EndTileRow). Has to be called after rasterizing.
+   */
+  void updateTileDepths(uint32_t p_FirstTileRow, uint32_t p_EndTileRow);
+
+  // <-
+
+  /**
+   * Returns false if the given AABB is fully hidden behind the rasterized
+   * occluders.
+   */
+  bool isAABBVisible(const Math::AABB& p_WorldAABB,
+                     const glm::mat4& p_ViewProjMatrix,
+                     float p_NearPlane) const;
+
+  // <-
+
+  float* _depth;
+  float _tileDepth[kTileCountX * kTileCountY];
+};
+
+// <-
+
+/**
+ * Rasterizes the most important occluders visible in the given frustum and
+ * removes all Nodes fully hidden behind them from the frustum's visible
+ * Nodes. p_FrustumIdx is the index of the frustum passed to
+ * FrustumManager::cullNodes().
+ */
+void cullNodes(Resources::FrustumRef p_Frustum, uint32_t p_FrustumIdx);
+}
+}
+}
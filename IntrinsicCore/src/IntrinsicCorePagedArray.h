@@ -0,0 +1,154 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace Containers
+{
+// Type erased interface used to grow all arrays of a SoA data struct at once
+struct PagedArrayBase
+{
+  virtual ~PagedArrayBase() {}
+  virtual void resize(uint32_t p_Size) = 0;
+};
+
+// <-
+
+// Array storing its elements in fixed size pages which are allocated on
+// demand. Elements never move after they've been constructed and each page
+// is a contiguous, aligned block of memory. The page table is allocated for
+// _INTR_PAGED_ARRAY_MAX_PAGE_COUNT pages on the first resize and never
+// reallocated, so existing elements can be read by other threads while
+// resize() is adding pages
+template <class T, uint32_t PageSizeLog2 = _INTR_PAGED_ARRAY_PAGE_SIZE_LOG2>
+struct PagedArray : PagedArrayBase
+{
+  enum
+  {
+    kPageSize = 1u << PageSizeLog2,
+    kPageMask = kPageSize - 1u
+  };
+
+  PagedArray() : _size(0u) {}
+
+  // <-
+
+  ~PagedArray() { clear(); }
+
+  // <-
+
+  PagedArray(const PagedArray&) = delete;
+  PagedArray& operator=(const PagedArray&) = delete;
+
+  // <-
+
+  void resize(uint32_t p_Size) override
+  {
+    if (_pages.capacity() < _INTR_PAGED_ARRAY_MAX_PAGE_COUNT)
+    {
+      _pages.reserve(_INTR_PAGED_ARRAY_MAX_PAGE_COUNT);
+    }
+
+    while (capacity() < p_Size)
+    {
+      _INTR_FATAL_CHECK(_pages.size() < _INTR_PAGED_ARRAY_MAX_PAGE_COUNT,
+                        "Paged array exceeds the maximum page count");
+
+      T* page = (T*)Memory::Tlsf::MainAllocator::allocateAligned(
+          kPageSize * sizeof(T), _INTR_PAGED_ARRAY_PAGE_ALIGNMENT);
+      _pages.push_back(page);
+    }
+
+    for (uint32_t i = _size; i < p_Size; ++i)
+    {
+      new (&_pages[i >> PageSizeLog2][i & kPageMask]) T();
+    }
+    for (uint32_t i = p_Size; i < _size; ++i)
+    {
+      _pages[i >> PageSizeLog2][i & kPageMask].~T();
+    }
+
+    _size = p_Size;
+  }
+
+  // <-
+
+  _INTR_INLINE void clear()
+  {
+    resize(0u);
+
+    for (uint32_t i = 0u; i < _pages.size(); ++i)
+    {
+      Memory::Tlsf::MainAllocator::free(_pages[i]);
+    }
+    _pages.clear();
+  }
+
+  // <-
+
+  _INTR_INLINE T& operator[](uint32_t p_Idx)
+  {
+    _INTR_ASSERT(p_Idx < _size);
+    return _pages[p_Idx >> PageSizeLog2][p_Idx & kPageMask];
+  }
+
+  // <-
+
+  _INTR_INLINE const T& operator[](uint32_t p_Idx) const
+  {
+    _INTR_ASSERT(p_Idx < _size);
+    return _pages[p_Idx >> PageSizeLog2][p_Idx & kPageMask];
+  }
+
+  // <-
+
+  _INTR_INLINE uint32_t size() const { return _size; }
+
+  // <-
+
+  _INTR_INLINE uint32_t capacity() const
+  {
+    return (uint32_t)_pages.size() * kPageSize;
+  }
+
+  // <-
+
+  _INTR_INLINE uint32_t pageCount() const { return (uint32_t)_pages.size(); }
+
+  // <-
+
+  _INTR_INLINE static uint32_t pageSize() { return kPageSize; }
+
+  // <-
+
+  _INTR_INLINE T* page(uint32_t p_PageIdx) { return _pages[p_PageIdx]; }
+
+  // <-
+
+  _INTR_INLINE const T* page(uint32_t p_PageIdx) const
+  {
+    return _pages[p_PageIdx];
+  }
+
+private:
+  _INTR_ARRAY(T*) _pages;
+  uint32_t _size;
+};
+}
+}
+}
@@ -17,6 +17,10 @@
 // Settings
 #define _INTR_MAX_PLAYER_COUNT 4u
 
+// Initial capacities of the Dod managers - the SoA storage of the managers is
+// paged and grows on demand up to _INTR_PAGED_ARRAY_MAX_PAGE_COUNT pages. The
+// renderer side GPU resources are sized independently of these values
+
 // Components
 #define _INTR_MAX_ENTITY_COUNT 10240u
 #define _INTR_MAX_NODE_COMPONENT_COUNT 10240u
@@ -53,6 +57,13 @@
 #define _INTR_MAX_EVENT_LISTENER_COUNT 1024u
 #define _INTR_MAX_MATERIAL_PASS_COUNT 256u
 
+// Paged SoA storage
+#define _INTR_PAGED_ARRAY_PAGE_SIZE_LOG2 10u
+#define _INTR_PAGED_ARRAY_PAGE_ALIGNMENT 64u
+// The page tables are allocated up front so they never move while growing
+// (2048 pages of 1024 elements, ~2M elements per array)
+#define _INTR_PAGED_ARRAY_MAX_PAGE_COUNT 2048u
+
 // Various
 #define _INTR_CONCAT_(x, y) x##y
 #define _INTR_CONCAT(x, y) _INTR_CONCAT_(x, y)
@@ -79,7 +90,9 @@
 #endif // _INTR_LOGGING_ENABLED
 
 // Names
-#define _N(x) Name(#x)
+#define _N(x)                                                                  \
+  Intrinsic::Core::Name::fromLiteral<Intrinsic::Core::Math::hash64(            \
+      #x, sizeof(#x) - 1u)>(#x, sizeof(#x) - 1u)
 
 // Memory management
 #define _INTR_NEW(x, y)                                                        \
@@ -102,11 +115,15 @@
 #define _INTR_STRING                                                           \
   std::basic_string<char, std::char_traits<char>,                              \
                     Intrinsic::Core::Memory::StlAllocator<char>>
+#define _INTR_STRING_VIEW std::string_view
 #define _INTR_STRING_STREAM                                                    \
   std::basic_stringstream<char, std::char_traits<char>,                        \
                           Intrinsic::Core::Memory::StlAllocator<char>>
 #define _INTR_ARRAY(a) std::vector<a, Intrinsic::Core::Memory::StlAllocator<a>>
 #define _INTR_STACK_ARRAY(a, b) std::array<a, b>
+#define _INTR_PAGED_ARRAY(a) Intrinsic::Core::Containers::PagedArray<a>
+#define _INTR_FRAME_ARRAY(a)                                                   \
+  std::vector<a, Intrinsic::Core::Memory::FrameStlAllocator<a>>
 #define _INTR_HASH_MAP(a, b)                                                   \
   spp::sparse_hash_map<a, b, spp::spp_hash<a>, std::equal_to<a>>
 #define _INTR_FSTREAM std::fstream
@@ -194,6 +211,20 @@
 #define _INTR_DBG_BREAK()
 #endif // _INTR_ASSERTS_ENABLED
 
+// Checks which stay active in all builds and terminate the application on
+// failure, used for exhausted resources which can't be recovered from
+#define _INTR_FATAL_CHECK(_expr, _msg)                                         \
+  do                                                                           \
+  {                                                                            \
+    if (!(_expr))                                                              \
+    {                                                                          \
+      _INTR_LOG_ERROR("Fatal: %s (\"%s\" Line: %d File: \"%s\")", _msg,        \
+                      #_expr, __LINE__, __FILE__);                             \
+      _INTR_ERROR_DIALOG_SIMPLE(_msg);                                         \
+      abort();                                                                 \
+    }                                                                          \
+  } while (0)
+
 // Allocation related macros
 #define _INTR_MALLOC(a) malloc(a)
 #define _INTR_FREE(a) free(a)
@@ -246,6 +277,12 @@
 #define _INTR_PROFILE_COUNTER_SUB(_name, _count)                               \
   MICROPROFILE_COUNTER_SUB(_name, _count)
 
+// Counters with names only known at runtime
+#define _INTR_PROFILE_COUNTER_TOKEN MicroProfileToken
+#define _INTR_PROFILE_GET_COUNTER_TOKEN(_name) MicroProfileGetCounterToken(_name)
+#define _INTR_PROFILE_COUNTER_TOKEN_SET(_token, _count)                        \
+  MicroProfileCounterSet(_token, _count)
+
 #define _INTR_PROFILE_DEFINE_LOCAL_COUNTER(_var, _name)                        \
   MICROPROFILE_DEFINE_LOCAL_COUNTER(_var, _name)
 #define _INTR_PROFILE_COUNTER_LOCAL_ADD(_var, _count)                          \
@@ -265,6 +302,10 @@
 #define _INTR_PROFILE_COUNTER_SET(_name, _count)
 #define _INTR_PROFILE_COUNTER_SUB(_name, _count)
 
+#define _INTR_PROFILE_COUNTER_TOKEN uint64_t
+#define _INTR_PROFILE_GET_COUNTER_TOKEN(_name) 0u
+#define _INTR_PROFILE_COUNTER_TOKEN_SET(_token, _count)
+
 #define _INTR_PROFILE_DEFINE_LOCAL_COUNTER(_var, _name)
 #define _INTR_PROFILE_COUNTER_LOCAL_ADD(_var, _count)
 #define _INTR_PROFILE_COUNTER_LOCAL_SET(_var, _count)
@@ -284,3 +325,11 @@
 #else
 #define _INTR_INLINE inline
 #endif // _WIN32
+
+// Enables AVX2 code generation for a single function. Only call functions
+// using this after checking Simd::isAvx2Supported()
+#if defined(_WIN32)
+#define _INTR_TARGET_AVX2
+#else
+#define _INTR_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif // _WIN32
@@ -470,7 +470,8 @@ void captureProbes(const Dod::RefArray& p_NodeRefs, bool p_Clear,
         _INTR_STRING timeString = StringUtil::toString(p_Time);
         StringUtil::replace(timeString, ".", "-");
         const _INTR_STRING fileName =
-            Entity::EntityManager::_name(currentEntity).getString() +
+            _INTR_STRING(
+                Entity::EntityManager::_name(currentEntity).getString()) +
             timeString + ".dds";
         const _INTR_STRING filePath = "media/specular_probes/" + fileName;
         const _INTR_STRING tempFilePath = "media/specular_probes/_" + fileName;
@@ -0,0 +1,217 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Precompiled header file
+#include "stdafx.h"
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace Resources
+{
+namespace
+{
+Containers::LockFreeMpscQueue<QueuedEvent, _INTR_MAX_EVENT_COUNT> _eventQueue;
+
+// Events which did not fit into the ring buffer. Once an event has been
+// spilled, all events are spilled until the next call to fireEvents() to keep
+// the order
+std::mutex _spillMutex;
+_INTR_ARRAY(QueuedEvent) _spilledEvents;
+std::atomic<bool> _spilling;
+
+// Name hashes of the events queued since the events have been fired the last
+// time. Open addressing with linear probing, zero marks a free slot
+const uint32_t _queuedEventNameSlotCount = 2u * _INTR_MAX_EVENT_COUNT;
+std::atomic<uint64_t> _queuedEventNames[_queuedEventNameSlotCount];
+std::atomic<uint32_t> _queuedEventNameCount;
+// Name hashes which did not fit into the table, guarded by _spillMutex
+_INTR_ARRAY(uint64_t) _spilledEventNames;
+
+// <-
+
+// Returns false if the name has already been added
+_INTR_INLINE bool addSpilledEventName(uint64_t p_NameHash)
+{
+  std::lock_guard<std::mutex> lock(_spillMutex);
+
+  if (std::find(_spilledEventNames.begin(), _spilledEventNames.end(),
+                p_NameHash) != _spilledEventNames.end())
+  {
+    return false;
+  }
+
+  _spilledEventNames.push_back(p_NameHash);
+  return true;
+}
+
+// <-
+
+// Returns false if the name has already been added
+_INTR_INLINE bool addQueuedEventName(uint64_t p_NameHash)
+{
+  uint32_t slotIdx = (uint32_t)p_NameHash & (_queuedEventNameSlotCount - 1u);
+
+  for (uint32_t i = 0u; i < _queuedEventNameSlotCount; ++i)
+  {
+    uint64_t currentHash =
+        _queuedEventNames[slotIdx].load(std::memory_order_acquire);
+
+    if (currentHash == 0u &&
+        _queuedEventNames[slotIdx].compare_exchange_strong(
+            currentHash, p_NameHash, std::memory_order_acq_rel))
+    {
+      _queuedEventNameCount.fetch_add(1u, std::memory_order_relaxed);
+      return true;
+    }
+
+    // Either already set or set by another thread in the meantime
+    if (currentHash == p_NameHash)
+    {
+      return false;
+    }
+
+    slotIdx = (slotIdx + 1u) & (_queuedEventNameSlotCount - 1u);
+  }
+
+  return addSpilledEventName(p_NameHash);
+}
+
+// <-
+
+_INTR_INLINE void resetQueuedEventNames()
+{
+  if (_queuedEventNameCount.load(std::memory_order_relaxed) == 0u)
+  {
+    return;
+  }
+
+  for (uint32_t i = 0u; i < _queuedEventNameSlotCount; ++i)
+  {
+    _queuedEventNames[i].store(0u, std::memory_order_relaxed);
+  }
+  _queuedEventNameCount.store(0u, std::memory_order_release);
+
+  std::lock_guard<std::mutex> lock(_spillMutex);
+  _spilledEventNames.clear();
+}
+
+// <-
+
+_INTR_INLINE void enqueueEvent(const QueuedEvent& p_Event)
+{
+  if (!_spilling.load(std::memory_order_acquire) &&
+      _eventQueue.enqueue(p_Event))
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(_spillMutex);
+  _spilling.store(true, std::memory_order_release);
+  _spilledEvents.push_back(p_Event);
+}
+}
+
+// Static members
+_INTR_ARRAY(QueuedEvent) EventManager::_firedEvents;
+
+// <-
+
+void EventManager::init()
+{
+  _INTR_LOG_INFO("Inititializing Event Manager...");
+
+  _firedEvents.reserve(_INTR_MAX_EVENT_COUNT);
+}
+
+// <-
+
+bool EventManager::queueEventIfNotExisting(const Name& p_EventName,
+                                           const QueuedEventData& p_EventData)
+{
+  if (p_EventName.isValid() && !addQueuedEventName(p_EventName._hash))
+  {
+    return false;
+  }
+
+  enqueueEvent({p_EventName, p_EventData});
+  return true;
+}
+
+// <-
+
+void EventManager::queueEvent(const Name& p_EventName,
+                              const QueuedEventData& p_EventData)
+{
+  // Registered so queueEventIfNotExisting() skips events queued here
+  if (p_EventName.isValid())
+  {
+    addQueuedEventName(p_EventName._hash);
+  }
+
+  enqueueEvent({p_EventName, p_EventData});
+}
+
+// <-
+
+void EventManager::fireEvents()
+{
+  _INTR_PROFILE_CPU("General", "Fire Events");
+
+  // Events queued from here on are fired in the next frame
+  resetQueuedEventNames();
+
+  _firedEvents.clear();
+  QueuedEvent event;
+  while (_eventQueue.dequeue(event))
+  {
+    _firedEvents.push_back(event);
+  }
+
+  // Spilled events have been queued after the events in the ring buffer
+  if (_spilling.load(std::memory_order_acquire))
+  {
+    std::lock_guard<std::mutex> lock(_spillMutex);
+
+    _INTR_LOG_WARNING("Event queue overflowed, %u events spilled...",
+                      (uint32_t)_spilledEvents.size());
+    _firedEvents.insert(_firedEvents.end(), _spilledEvents.begin(),
+                        _spilledEvents.end());
+    _spilledEvents.clear();
+    _spilling.store(false, std::memory_order_release);
+  }
+
+  const _INTR_ARRAY(EventListenerEntry)& eventListeners =
+      EventListenerManager::_eventListeners;
+
+  for (uint32_t eventIdx = 0u; eventIdx < _firedEvents.size(); ++eventIdx)
+  {
+    const EventRef eventRef = EventRef(eventIdx, 0u);
+    const Name eventName = _firedEvents[eventIdx].name;
+
+    for (uint32_t listenerIdx =
+             EventListenerManager::findFirstEventListener(eventName);
+         listenerIdx < eventListeners.size() &&
+         eventListeners[listenerIdx].eventNameHash == eventName._hash;
+         ++listenerIdx)
+    {
+      EventListenerManager::_descEventCallbackFunction(
+          eventListeners[listenerIdx].listener)(eventRef);
+    }
+  }
+}
+}
+}
+}
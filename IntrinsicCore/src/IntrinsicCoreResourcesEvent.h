@@ -48,103 +48,58 @@ struct QueuedEventData
   };
 };
 
-struct EventData : Dod::Resources::ResourceDataBase
+struct QueuedEvent
 {
-  EventData() : Dod::Resources::ResourceDataBase(_INTR_MAX_EVENT_COUNT)
-  {
-    queuedEventData.resize(_INTR_MAX_EVENT_COUNT);
-  }
-
-  // Resources
-  _INTR_ARRAY(QueuedEventData) queuedEventData;
+  Name name;
+  QueuedEventData data;
 };
 
+/**
+ * Events are queued in a lock-free ring buffer and can be queued from any
+ * thread. Events which do not fit into the ring buffer are spilled to a locked
+ * array instead of being dropped. All queued events are fired on the main
+ * thread once per frame.
+ */
 struct EventManager
-    : Dod::Resources::ResourceManagerBase<EventData, _INTR_MAX_EVENT_COUNT>
 {
-  static void init()
-  {
-    _INTR_LOG_INFO("Inititializing Event Manager...");
-
-    Dod::Resources::ResourceManagerBase<
-        EventData, _INTR_MAX_EVENT_COUNT>::_initResourceManager();
-  }
+  static void init();
 
   // <-
 
-  _INTR_INLINE static EventRef queueEventIfNotExisting(const Name& p_EventName)
-  {
-    for (uint32_t i = 0u; i < _activeRefs.size(); ++i)
-    {
-      if (_name(_activeRefs[i]) == p_EventName)
-      {
-        return Dod::Ref();
-      }
-    }
-
-    return queueEvent(p_EventName);
-  }
+  /**
+   * Queues the event if no event with the same name has been queued since
+   * the events have been fired the last time, using either of the two queue
+   * functions. Returns true if the event has been queued.
+   */
+  static bool queueEventIfNotExisting(const Name& p_EventName,
+                                      const QueuedEventData& p_EventData);
 
-  _INTR_INLINE static EventRef
-  queueEventIfNotExisting(const Name& p_EventName,
-                          const QueuedEventData& p_EventData)
+  _INTR_INLINE static bool queueEventIfNotExisting(const Name& p_EventName)
   {
-    EventRef eventRef = queueEventIfNotExisting(p_EventName);
-    _queuedEventData(eventRef) = p_EventData;
-    return eventRef;
+    return queueEventIfNotExisting(p_EventName, QueuedEventData());
   }
 
   // <-
 
-  _INTR_INLINE static EventRef queueEvent(const Name& p_EventName)
-  {
-    return Dod::Resources::ResourceManagerBase<
-        EventData, _INTR_MAX_EVENT_COUNT>::_createResource(p_EventName);
-  }
+  /**
+   * Queues the event, even if an event with the same name has already been
+   * queued.
+   */
+  static void queueEvent(const Name& p_EventName,
+                         const QueuedEventData& p_EventData);
 
-  // <-
-
-  _INTR_INLINE static EventRef queueEvent(const Name& p_EventName,
-                                          const QueuedEventData& p_EventData)
+  _INTR_INLINE static void queueEvent(const Name& p_EventName)
   {
-    EventRef eventRef = queueEvent(p_EventName);
-    _queuedEventData(eventRef) = p_EventData;
-    return eventRef;
+    queueEvent(p_EventName, QueuedEventData());
   }
 
   // <-
 
-  _INTR_INLINE static void fireEvents()
-  {
-    // Fire events in order (oldest event gets fired first)
-    for (int32_t eventIdx = 0u; eventIdx < (int32_t)_activeRefs.size();
-         ++eventIdx)
-    {
-      EventRef eventRef = _activeRefs[eventIdx];
-
-      EventListenerRefArray& eventListeners =
-          EventListenerManager::_eventListenerMapping[_name(eventRef)];
-
-      for (uint32_t eventListIdx = 0u; eventListIdx < eventListeners.size();
-           ++eventListIdx)
-      {
-        EventListenerRef eventListenerRef = eventListeners[eventListIdx];
-
-        if (EventListenerManager::_name(eventListenerRef) == _name(eventRef))
-        {
-          EventListenerManager::_descEventCallbackFunction(eventListenerRef)(
-              eventRef);
-        }
-      }
-    }
-
-    for (int32_t eventIdx = (uint32_t)_activeRefs.size() - 1u; eventIdx >= 0;
-         --eventIdx)
-    {
-      Dod::Resources::ResourceManagerBase<EventData, _INTR_MAX_EVENT_COUNT>::
-          _destroyResource(_activeRefs[eventIdx]);
-    }
-  }
+  /**
+   * Fires all queued events in order (oldest event gets fired first). Must be
+   * called from the main thread.
+   */
+  static void fireEvents();
 
   // <-
 
@@ -165,11 +120,21 @@ struct EventManager
     EventListenerManager::destroyEventListener(p_EventListener);
   }
 
-  // Resources
+  // <-
+
+  // Only valid for the event currently being fired
+  _INTR_INLINE static const Name& _name(EventRef p_EventRef)
+  {
+    return _firedEvents[p_EventRef._id].name;
+  }
   _INTR_INLINE static QueuedEventData& _queuedEventData(EventRef p_EventRef)
   {
-    return _data.queuedEventData[p_EventRef._id];
+    return _firedEvents[p_EventRef._id].data;
   }
+
+  // <-
+
+  static _INTR_ARRAY(QueuedEvent) _firedEvents;
 };
 }
 }
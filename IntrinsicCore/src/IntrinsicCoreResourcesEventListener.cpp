@@ -21,8 +21,7 @@ namespace Core
 {
 namespace Resources
 {
-_INTR_HASH_MAP(Name, _INTR_ARRAY(EventListenerRef))
-EventListenerManager::_eventListenerMapping;
+_INTR_ARRAY(EventListenerEntry) EventListenerManager::_eventListeners;
 }
 }
 }
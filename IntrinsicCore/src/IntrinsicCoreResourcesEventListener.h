@@ -26,17 +26,27 @@ typedef _INTR_ARRAY(EventListenerRef) EventListenerRefArray;
 
 typedef std::function<void(Dod::Ref)> EventCallbackFunction;
 
+struct EventListenerEntry
+{
+  _INTR_INLINE bool operator<(const EventListenerEntry& p_Rhs) const
+  {
+    return eventNameHash < p_Rhs.eventNameHash;
+  }
+
+  uint64_t eventNameHash;
+  EventListenerRef listener;
+};
+
 struct EventListenerData : Dod::Resources::ResourceDataBase
 {
   EventListenerData()
-      : Dod::Resources::ResourceDataBase(_INTR_MAX_EVENT_LISTENER_COUNT)
   {
-    descEventCallbackFunction.resize(_INTR_MAX_EVENT_LISTENER_COUNT);
+    registerArray(descEventCallbackFunction);
   }
 
   // <-
 
-  _INTR_ARRAY(EventCallbackFunction) descEventCallbackFunction;
+  _INTR_PAGED_ARRAY(EventCallbackFunction) descEventCallbackFunction;
 };
 
 struct EventListenerManager
@@ -60,7 +70,11 @@ struct EventListenerManager
         EventListenerData,
         _INTR_MAX_EVENT_LISTENER_COUNT>::_createResource(p_Name);
 
-    _eventListenerMapping[p_Name].push_back(ref);
+    // Keep the listeners sorted by event name
+    const EventListenerEntry entry = {p_Name._hash, ref};
+    _eventListeners.insert(std::upper_bound(_eventListeners.begin(),
+                                            _eventListeners.end(), entry),
+                           entry);
     return ref;
   }
 
@@ -72,16 +86,12 @@ struct EventListenerManager
 
   _INTR_INLINE static void destroyEventListener(EventListenerRef p_Ref)
   {
-    EventListenerRefArray& eventListeners = _eventListenerMapping[_name(p_Ref)];
-
-    for (auto it = eventListeners.begin(); it != eventListeners.end();)
+    for (auto it = _eventListeners.begin(); it != _eventListeners.end(); ++it)
     {
-      if (*it == p_Ref)
+      if (it->listener == p_Ref)
       {
-        it = eventListeners.erase(it);
-      }
-      {
-        ++it;
+        _eventListeners.erase(it);
+        break;
       }
     }
 
@@ -90,6 +100,20 @@ struct EventListenerManager
         _INTR_MAX_EVENT_LISTENER_COUNT>::_destroyResource(p_Ref);
   }
 
+  // <-
+
+  /**
+   * Returns the index of the first listener for the given event name in
+   * _eventListeners. All listeners of the event are stored consecutively.
+   */
+  _INTR_INLINE static uint32_t findFirstEventListener(const Name& p_EventName)
+  {
+    const EventListenerEntry entry = {p_EventName._hash, EventListenerRef()};
+    return (uint32_t)(std::lower_bound(_eventListeners.begin(),
+                                       _eventListeners.end(), entry) -
+                      _eventListeners.begin());
+  }
+
   // Resources
   _INTR_INLINE static EventCallbackFunction&
   _descEventCallbackFunction(EventListenerRef p_Ref)
@@ -99,7 +123,8 @@ struct EventListenerManager
 
   // ->
 
-  static _INTR_HASH_MAP(Name, EventListenerRefArray) _eventListenerMapping;
+  // Flat table of all listeners sorted by the hash of their event name
+  static _INTR_ARRAY(EventListenerEntry) _eventListeners;
 };
 }
 }
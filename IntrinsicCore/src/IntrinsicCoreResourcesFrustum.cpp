@@ -23,6 +23,57 @@ namespace Core
 {
 namespace Resources
 {
+namespace
+{
+// Number of spheres tested per culling kernel job
+const uint32_t _sphereCullingBatchSize = 1024u;
+
+_INTR_ARRAY(Components::NodeRefArray) _intersectingNodesPerFrustum;
+// Maps Node ids to indices in the candidate arrays; entries are validated
+// against the candidate Nodes so the array never has to be cleared
+_INTR_ARRAY(uint32_t) _candidateIndexPerNodeId;
+
+// Transient culling data of the current frame
+struct CullingScratch
+{
+  _INTR_FRAME_ARRAY(Math::FrustumPlanes) frustumPlanes;
+
+  // Nodes intersecting at least one frustum of the current group of frustums
+  // which require a sphere test
+  Dod::RefFrameArray candidateNodes;
+  CullingKernel::SphereSet candidateSpheres;
+  // Frustums the spatial index reported the candidates as intersecting with
+  _INTR_FRAME_ARRAY(uint32_t) candidateFrustumMasks;
+  _INTR_FRAME_ARRAY(uint32_t) candidateVisibilityMasks;
+};
+
+// <-
+
+_INTR_INLINE void addCandidate(CullingScratch& p_Scratch,
+                               Components::NodeRef p_NodeRef,
+                               uint32_t p_FrustumMask)
+{
+  if (p_NodeRef._id >= _candidateIndexPerNodeId.size())
+  {
+    _candidateIndexPerNodeId.resize(p_NodeRef._id + 1u, (uint32_t)-1);
+  }
+
+  uint32_t& candidateIdx = _candidateIndexPerNodeId[p_NodeRef._id];
+  if (candidateIdx >= p_Scratch.candidateNodes.size() ||
+      !(p_Scratch.candidateNodes[candidateIdx] == p_NodeRef))
+  {
+    candidateIdx = (uint32_t)p_Scratch.candidateNodes.size();
+    p_Scratch.candidateNodes.push_back(p_NodeRef);
+    p_Scratch.candidateSpheres.add(
+        Components::NodeManager::_worldBoundingSphere(p_NodeRef));
+    p_Scratch.candidateFrustumMasks.push_back(0u);
+  }
+
+  p_Scratch.candidateFrustumMasks[candidateIdx] |= p_FrustumMask;
+}
+
+// <-
+
 struct CullingParallelTaskSet : enki::ITaskSet
 {
   virtual ~CullingParallelTaskSet() {}
@@ -32,112 +83,135 @@ struct CullingParallelTaskSet : enki::ITaskSet
   {
     _INTR_PROFILE_CPU("Culling", "Culling Job");
 
-    for (uint32_t frustIdx = 0u; frustIdx < _frustums.size(); ++frustIdx)
+    for (uint32_t frustIdx = p_Range.start; frustIdx < p_Range.end;
+         ++frustIdx)
     {
-      Resources::FrustumRef frustumRef = _frustums[frustIdx];
-      const uint32_t frustumMask = 1u << frustIdx;
+      Components::NodeRefArray& visibleNodes =
+          FrustumManager::_visibleNodesPerFrustum[frustIdx];
+      Components::NodeRefArray& intersectingNodes =
+          _intersectingNodesPerFrustum[frustIdx];
+      visibleNodes.clear();
+      intersectingNodes.clear();
 
-      const Math::FrustumPlanes& frustumPlanes =
-          Resources::FrustumManager::_frustumPlanesViewSpace(frustumRef);
+      // Nodes in sub trees fully inside the frustum are visible right away
+      Components::NodeManager::_spatialIndex.cullFrustum(
+          _scratch->frustumPlanes[frustIdx], visibleNodes, intersectingNodes);
+    }
+  }
 
-#if !defined(USE_NAIVE_CULLING)
-      const __m128 simdFrustumPlanes[] = {
-          Simd::simdSet(-frustumPlanes.n[Math::FrustumPlane::kNear].x,
-                        -frustumPlanes.n[Math::FrustumPlane::kFar].x,
-                        -frustumPlanes.n[Math::FrustumPlane::kLeft].x,
-                        -frustumPlanes.n[Math::FrustumPlane::kRight].x),
-          Simd::simdSet(-frustumPlanes.n[Math::FrustumPlane::kNear].y,
-                        -frustumPlanes.n[Math::FrustumPlane::kFar].y,
-                        -frustumPlanes.n[Math::FrustumPlane::kLeft].y,
-                        -frustumPlanes.n[Math::FrustumPlane::kRight].y),
-          Simd::simdSet(-frustumPlanes.n[Math::FrustumPlane::kNear].z,
-                        -frustumPlanes.n[Math::FrustumPlane::kFar].z,
-                        -frustumPlanes.n[Math::FrustumPlane::kLeft].z,
-                        -frustumPlanes.n[Math::FrustumPlane::kRight].z),
-          Simd::simdSet(-frustumPlanes.d[Math::FrustumPlane::kNear],
-                        -frustumPlanes.d[Math::FrustumPlane::kFar],
-                        -frustumPlanes.d[Math::FrustumPlane::kLeft],
-                        -frustumPlanes.d[Math::FrustumPlane::kRight]),
-          Simd::simdSet(-frustumPlanes.n[Math::FrustumPlane::kTop].x,
-                        -frustumPlanes.n[Math::FrustumPlane::kBottom].x,
-                        -frustumPlanes.n[Math::FrustumPlane::kTop].x,
-                        -frustumPlanes.n[Math::FrustumPlane::kBottom].x),
-          Simd::simdSet(-frustumPlanes.n[Math::FrustumPlane::kTop].y,
-                        -frustumPlanes.n[Math::FrustumPlane::kBottom].y,
-                        -frustumPlanes.n[Math::FrustumPlane::kTop].y,
-                        -frustumPlanes.n[Math::FrustumPlane::kBottom].y),
-          Simd::simdSet(-frustumPlanes.n[Math::FrustumPlane::kTop].z,
-                        -frustumPlanes.n[Math::FrustumPlane::kBottom].z,
-                        -frustumPlanes.n[Math::FrustumPlane::kTop].z,
-                        -frustumPlanes.n[Math::FrustumPlane::kBottom].z),
-          Simd::simdSet(-frustumPlanes.d[Math::FrustumPlane::kTop],
-                        -frustumPlanes.d[Math::FrustumPlane::kBottom],
-                        -frustumPlanes.d[Math::FrustumPlane::kTop],
-                        -frustumPlanes.d[Math::FrustumPlane::kBottom])};
-#endif // USE_NAIVE_CULLING
+  const CullingScratch* _scratch;
+} _cullingParallelTaskSet;
 
-      for (uint32_t nodeIdx = p_Range.start; nodeIdx < p_Range.end; ++nodeIdx)
-      {
-        Components::NodeRef nodeRef =
-            Components::NodeManager::getActiveResourceAtIndex(nodeIdx);
-        const Math::Sphere& cullingSphere =
-            Components::NodeManager::_worldBoundingSphere(nodeRef);
-        uint32_t& visibilityMask =
-            Components::NodeManager::_visibilityMask(nodeRef);
+// <-
+
+struct SphereCullingParallelTaskSet : enki::ITaskSet
+{
+  virtual ~SphereCullingParallelTaskSet() {}
+
+  void ExecuteRange(enki::TaskSetPartition p_Range,
+                    uint32_t p_ThreadNum) override
+  {
+    _INTR_PROFILE_CPU("Culling", "Sphere Culling Job");
+
+    const CullingKernel::SphereSet& spheres = _scratch->candidateSpheres;
+    const uint32_t candidateCount = spheres.size();
+    const Math::FrustumPlanes* frustumPlanes =
+        &_scratch->frustumPlanes[_firstFrustum];
+    uint32_t* visibilityMasks = _scratch->candidateVisibilityMasks.data();
+
+    for (uint32_t batchIdx = p_Range.start; batchIdx < p_Range.end;
+         ++batchIdx)
+    {
+      const uint32_t firstSphere = batchIdx * _sphereCullingBatchSize;
+      const uint32_t endSphere =
+          std::min(firstSphere + _sphereCullingBatchSize, candidateCount);
 
 #if !defined(USE_NAIVE_CULLING)
-        const __m128 s = Simd::simdSet(cullingSphere.p.x, cullingSphere.p.y,
-                                       cullingSphere.p.z, cullingSphere.r);
-        const __m128 xxxx = Simd::simdSplatX(s);
-        const __m128 yyyy = Simd::simdSplatY(s);
-        const __m128 zzzz = Simd::simdSplatZ(s);
-        const __m128 rrrr = Simd::simdSplatW(s);
-
-        __m128 v, r;
-        v = Simd::simdMadd(xxxx, simdFrustumPlanes[0], simdFrustumPlanes[3]);
-        v = Simd::simdMadd(yyyy, simdFrustumPlanes[1], v);
-        v = Simd::simdMadd(zzzz, simdFrustumPlanes[2], v);
-
-        r = _mm_cmpgt_ps(v, rrrr);
-
-        v = Simd::simdMadd(xxxx, simdFrustumPlanes[4], simdFrustumPlanes[7]);
-        v = Simd::simdMadd(yyyy, simdFrustumPlanes[5], v);
-        v = Simd::simdMadd(zzzz, simdFrustumPlanes[6], v);
-
-        r = _mm_or_ps(r, _mm_cmpgt_ps(v, rrrr));
-        r = _mm_or_ps(r, _mm_movehl_ps(r, r));
-        r = _mm_or_ps(r, Simd::simdSplatY(r));
-
-        uint32_t result;
-        _mm_store_ss((float*)&result, r);
+      CullingKernel::cull(frustumPlanes, _frustumCount, spheres, firstSphere,
+                          endSphere, visibilityMasks);
 #else
-        uint32_t result = (uint32_t)-1;
-        for (int i = 0; i < Math::FrustumPlane::kCount; ++i)
-        {
-          if (glm::dot(frustumPlanes.n[i], cullingSphere.p) +
-                  frustumPlanes.d[i] <
-              -cullingSphere.r)
-          {
-            result = 0x0;
-            break;
-          }
-        }
+      CullingKernel::cullScalar(frustumPlanes, _frustumCount, spheres,
+                                firstSphere, endSphere, visibilityMasks);
 #endif // USE_NAIVE_CULLING
+    }
+  }
+
+  CullingScratch* _scratch;
+  uint32_t _firstFrustum;
+  uint32_t _frustumCount;
+} _sphereCullingParallelTaskSet;
+
+// <-
+
+void cullCandidates(uint32_t p_FirstFrustum, uint32_t p_FrustumCount)
+{
+  CullingScratch& scratch = *_sphereCullingParallelTaskSet._scratch;
+  scratch.candidateNodes.clear();
+  scratch.candidateSpheres.clear();
+  scratch.candidateFrustumMasks.clear();
+
+  uint32_t intersectingNodeCount = 0u;
+  for (uint32_t i = 0u; i < p_FrustumCount; ++i)
+  {
+    intersectingNodeCount +=
+        (uint32_t)_intersectingNodesPerFrustum[p_FirstFrustum + i].size();
+  }
+  scratch.candidateNodes.reserve(intersectingNodeCount);
+  scratch.candidateSpheres.reserve(intersectingNodeCount);
+  scratch.candidateFrustumMasks.reserve(intersectingNodeCount);
+
+  // Gather the intersecting Nodes once so their spheres can be tested
+  // against all frustums of the group in a single pass
+  for (uint32_t i = 0u; i < p_FrustumCount; ++i)
+  {
+    const Components::NodeRefArray& intersectingNodes =
+        _intersectingNodesPerFrustum[p_FirstFrustum + i];
+
+    for (uint32_t nodeIdx = 0u; nodeIdx < intersectingNodes.size(); ++nodeIdx)
+    {
+      addCandidate(scratch, intersectingNodes[nodeIdx], 1u << i);
+    }
+  }
+
+  const uint32_t candidateCount = (uint32_t)scratch.candidateNodes.size();
+  if (candidateCount == 0u)
+  {
+    return;
+  }
+
+  scratch.candidateVisibilityMasks.resize(candidateCount);
+
+  _sphereCullingParallelTaskSet._firstFrustum = p_FirstFrustum;
+  _sphereCullingParallelTaskSet._frustumCount = p_FrustumCount;
+  _sphereCullingParallelTaskSet.m_SetSize =
+      (candidateCount + _sphereCullingBatchSize - 1u) / _sphereCullingBatchSize;
+
+  Application::_scheduler.AddTaskSetToPipe(&_sphereCullingParallelTaskSet);
+  Application::_scheduler.WaitforTaskSet(&_sphereCullingParallelTaskSet);
+
+  for (uint32_t candidateIdx = 0u; candidateIdx < candidateCount;
+       ++candidateIdx)
+  {
+    // Spheres can reach into frustums the spatial index already rejected
+    uint32_t frustumMask = scratch.candidateVisibilityMasks[candidateIdx] &
+                           scratch.candidateFrustumMasks[candidateIdx];
 
-        if ((result & 1u) > 0u)
-        {
-          visibilityMask &= ~frustumMask;
-        }
-        else
-        {
-          visibilityMask |= frustumMask;
-        }
+    for (uint32_t i = 0u; frustumMask != 0u; ++i, frustumMask >>= 1u)
+    {
+      if ((frustumMask & 1u) != 0u)
+      {
+        FrustumManager::_visibleNodesPerFrustum[p_FirstFrustum + i].push_back(
+            scratch.candidateNodes[candidateIdx]);
       }
     }
   }
+}
+}
 
-  FrustumRefArray _frustums;
-} _cullingParallelTaskSet;
+// Static members
+_INTR_ARRAY(Dod::RefArray) FrustumManager::_visibleNodesPerFrustum;
+
+// <-
 
 void FrustumManager::init()
 {
@@ -153,12 +227,44 @@ void FrustumManager::cullNodes(const FrustumRefArray& p_ActiveFrustums)
 {
   _INTR_PROFILE_CPU("Culling", "Culling");
 
-  _cullingParallelTaskSet._frustums = p_ActiveFrustums;
-  _cullingParallelTaskSet.m_SetSize =
-      Components::NodeManager::getActiveResourceCount();
+  const uint32_t frustumCount = (uint32_t)p_ActiveFrustums.size();
+
+  CullingScratch scratch;
+  scratch.frustumPlanes.resize(frustumCount);
+  for (uint32_t frustIdx = 0u; frustIdx < frustumCount; ++frustIdx)
+  {
+    scratch.frustumPlanes[frustIdx] =
+        _frustumPlanesViewSpace(p_ActiveFrustums[frustIdx]);
+  }
+  _cullingParallelTaskSet._scratch = &scratch;
+  _sphereCullingParallelTaskSet._scratch = &scratch;
+
+  _visibleNodesPerFrustum.resize(frustumCount);
+  _intersectingNodesPerFrustum.resize(frustumCount);
+
+  // Traverse the spatial index for all frustums in parallel
+  _cullingParallelTaskSet.m_SetSize = frustumCount;
 
   Application::_scheduler.AddTaskSetToPipe(&_cullingParallelTaskSet);
   Application::_scheduler.WaitforTaskSet(&_cullingParallelTaskSet);
+
+  // The sphere tests write one bit per frustum, so frustums are processed in
+  // groups fitting into the culling kernel's visibility masks
+  for (uint32_t firstFrustum = 0u; firstFrustum < frustumCount;
+       firstFrustum += CullingKernel::kMaxFrustumCount)
+  {
+    cullCandidates(firstFrustum,
+                   std::min(frustumCount - firstFrustum,
+                            (uint32_t)CullingKernel::kMaxFrustumCount));
+  }
+
+  uint32_t visibleNodeCount = 0u;
+  for (uint32_t frustIdx = 0u; frustIdx < frustumCount; ++frustIdx)
+  {
+    visibleNodeCount += (uint32_t)_visibleNodesPerFrustum[frustIdx].size();
+  }
+
+  _INTR_PROFILE_COUNTER_SET("Visible Nodes", visibleNodeCount);
 }
 }
 }
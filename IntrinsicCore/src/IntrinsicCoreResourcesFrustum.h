@@ -35,44 +35,44 @@ enum Enum
 
 struct FrustumData : Dod::Resources::ResourceDataBase
 {
-  FrustumData() : Dod::Resources::ResourceDataBase(_INTR_MAX_FRUSTUM_COUNT)
+  FrustumData()
   {
-    descProjectionType.resize(_INTR_MAX_FRUSTUM_COUNT);
-    descNearFarPlaneDistances.resize(_INTR_MAX_FRUSTUM_COUNT);
+    registerArray(descProjectionType);
+    registerArray(descNearFarPlaneDistances);
 
-    descViewMatrix.resize(_INTR_MAX_FRUSTUM_COUNT);
-    descPrevViewMatrix.resize(_INTR_MAX_FRUSTUM_COUNT);
-    invViewMatrix.resize(_INTR_MAX_FRUSTUM_COUNT);
+    registerArray(descViewMatrix);
+    registerArray(descPrevViewMatrix);
+    registerArray(invViewMatrix);
 
-    descProjectionMatrix.resize(_INTR_MAX_FRUSTUM_COUNT);
-    invProjectionMatrix.resize(_INTR_MAX_FRUSTUM_COUNT);
+    registerArray(descProjectionMatrix);
+    registerArray(invProjectionMatrix);
 
-    viewProjectionMatrix.resize(_INTR_MAX_FRUSTUM_COUNT);
-    invViewProjectionMatrix.resize(_INTR_MAX_FRUSTUM_COUNT);
+    registerArray(viewProjectionMatrix);
+    registerArray(invViewProjectionMatrix);
 
-    frustumWorldPosition.resize(_INTR_MAX_FRUSTUM_COUNT);
-    frustumPlanesViewSpace.resize(_INTR_MAX_FRUSTUM_COUNT);
-    frustumCornersViewSpace.resize(_INTR_MAX_FRUSTUM_COUNT);
-    frustumCornersWorldSpace.resize(_INTR_MAX_FRUSTUM_COUNT);
+    registerArray(frustumWorldPosition);
+    registerArray(frustumPlanesViewSpace);
+    registerArray(frustumCornersViewSpace);
+    registerArray(frustumCornersWorldSpace);
   }
 
   // Description
-  _INTR_ARRAY(uint8_t) descProjectionType;
-  _INTR_ARRAY(glm::vec2) descNearFarPlaneDistances;
-  _INTR_ARRAY(glm::mat4) descViewMatrix;
-  _INTR_ARRAY(glm::mat4) descPrevViewMatrix;
-  _INTR_ARRAY(glm::mat4) descProjectionMatrix;
+  _INTR_PAGED_ARRAY(uint8_t) descProjectionType;
+  _INTR_PAGED_ARRAY(glm::vec2) descNearFarPlaneDistances;
+  _INTR_PAGED_ARRAY(glm::mat4) descViewMatrix;
+  _INTR_PAGED_ARRAY(glm::mat4) descPrevViewMatrix;
+  _INTR_PAGED_ARRAY(glm::mat4) descProjectionMatrix;
 
   // Resources
-  _INTR_ARRAY(glm::mat4) invProjectionMatrix;
-  _INTR_ARRAY(glm::mat4) invViewMatrix;
-  _INTR_ARRAY(glm::mat4) viewProjectionMatrix;
-  _INTR_ARRAY(glm::mat4) invViewProjectionMatrix;
-
-  _INTR_ARRAY(glm::vec3) frustumWorldPosition;
-  _INTR_ARRAY(Math::FrustumPlanes) frustumPlanesViewSpace;
-  _INTR_ARRAY(Math::FrustumCorners) frustumCornersViewSpace;
-  _INTR_ARRAY(Math::FrustumCorners) frustumCornersWorldSpace;
+  _INTR_PAGED_ARRAY(glm::mat4) invProjectionMatrix;
+  _INTR_PAGED_ARRAY(glm::mat4) invViewMatrix;
+  _INTR_PAGED_ARRAY(glm::mat4) viewProjectionMatrix;
+  _INTR_PAGED_ARRAY(glm::mat4) invViewProjectionMatrix;
+
+  _INTR_PAGED_ARRAY(glm::vec3) frustumWorldPosition;
+  _INTR_PAGED_ARRAY(Math::FrustumPlanes) frustumPlanesViewSpace;
+  _INTR_PAGED_ARRAY(Math::FrustumCorners) frustumCornersViewSpace;
+  _INTR_PAGED_ARRAY(Math::FrustumCorners) frustumCornersWorldSpace;
 };
 
 struct FrustumManager
@@ -132,6 +132,45 @@ struct FrustumManager
 
   // <-
 
+  /**
+   * Returns the fraction of the viewport covered by the projection of the
+   * given sphere. Spheres intersecting the view plane cover the whole
+   * viewport.
+   */
+  _INTR_INLINE static float calcScreenSize(FrustumRef p_Ref,
+                                           const Math::Sphere& p_Sphere)
+  {
+    const glm::mat4& projMatrix = _descProjectionMatrix(p_Ref);
+
+    if (_descProjectionType(p_Ref) == ProjectionType::kOrthographic)
+    {
+      return 0.25f * glm::pi<float>() * p_Sphere.r * p_Sphere.r *
+             glm::abs(projMatrix[0][0] * projMatrix[1][1]);
+    }
+
+    const float viewZ =
+        (_descViewMatrix(p_Ref) * glm::vec4(p_Sphere.p, 1.0f)).z;
+    if (viewZ * viewZ <= p_Sphere.r * p_Sphere.r)
+    {
+      return 1.0f;
+    }
+
+    const float focalLength = glm::abs(projMatrix[1][1]);
+    return 0.25f *
+           Math::projectSphere(p_Sphere, _descViewMatrix(p_Ref), focalLength) *
+           glm::abs(projMatrix[0][0]) / focalLength;
+  }
+
+  // <-
+
+  /**
+   * The Nodes visible in each frustum after the last culling pass. Indexed
+   * like the frustums passed to cullNodes().
+   */
+  static _INTR_ARRAY(Dod::RefArray) _visibleNodesPerFrustum;
+
+  // <-
+
   // Description
   _INTR_INLINE static uint8_t& _descProjectionType(FrustumRef p_Ref)
   {
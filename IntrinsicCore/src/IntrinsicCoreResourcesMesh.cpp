@@ -38,7 +38,8 @@ _INTR_INLINE void createOrLoadPhysicsMeshes(MeshRef p_MeshRef)
 {
   const _INTR_STRING meshFilePath =
       "media/physics_meshes/" +
-      CResources::MeshManager::_name(p_MeshRef).getString() + ".pm";
+      _INTR_STRING(CResources::MeshManager::_name(p_MeshRef).getString()) +
+      ".pm";
 
   if (Util::fileExists(meshFilePath.c_str()))
   {
@@ -50,7 +51,8 @@ _INTR_INLINE void createOrLoadPhysicsMeshes(MeshRef p_MeshRef)
 
   const _INTR_STRING convexMeshFilePath =
       "media/physics_meshes/" +
-      CResources::MeshManager::_name(p_MeshRef).getString() + ".pcm";
+      _INTR_STRING(CResources::MeshManager::_name(p_MeshRef).getString()) +
+      ".pcm";
 
   if (Util::fileExists(convexMeshFilePath.c_str()))
   {
@@ -60,8 +62,81 @@ _INTR_INLINE void createOrLoadPhysicsMeshes(MeshRef p_MeshRef)
         Physics::System::_pxPhysics->createConvexMesh(fileInput);
   }
 }
+
+// <-
+
+_INTR_INLINE MeshBufferRange
+allocateAndUploadIndices(const _INTR_ARRAY(uint32_t) & p_Indices,
+                         uint32_t p_VertexCount)
+{
+  const uint32_t indexCount = (uint32_t)p_Indices.size();
+
+  // Indices are relative to the vertex range of the sub mesh
+  if (p_VertexCount > 0xFFFF)
+  {
+    const MeshBufferRange range =
+        R::MeshBufferPool::allocateIndices(R::BufferType::kIndex32, indexCount);
+    R::MeshBufferPool::uploadIndices(range, p_Indices.data());
+
+    return range;
+  }
+
+  const MeshBufferRange range =
+      R::MeshBufferPool::allocateIndices(R::BufferType::kIndex16, indexCount);
+  if (indexCount > 0u)
+  {
+    uint16_t* tempIndexBuffer =
+        (uint16_t*)Memory::Tlsf::MainAllocator::allocate(indexCount *
+                                                         sizeof(uint16_t));
+
+    for (uint32_t i = 0u; i < indexCount; ++i)
+    {
+      tempIndexBuffer[i] = (uint16_t)p_Indices[i];
+    }
+
+    R::MeshBufferPool::uploadIndices(range, tempIndexBuffer);
+    Memory::Tlsf::MainAllocator::free(tempIndexBuffer);
+  }
+
+  return range;
+}
+
+// <-
+
+_INTR_INLINE void uploadHalf3Vertices(const MeshBufferRange& p_Range,
+                                      R::MeshVertexStream::Enum p_Stream,
+                                      const _INTR_ARRAY(glm::vec3) & p_Values)
+{
+  const uint32_t vertexCount = (uint32_t)p_Values.size();
+  if (vertexCount == 0u)
+  {
+    return;
+  }
+
+  // Convert to half
+  uint16_t* tempBuffer = (uint16_t*)Memory::Tlsf::MainAllocator::allocate(
+      vertexCount * sizeof(uint16_t) * 3u);
+
+  for (uint32_t i = 0u; i < vertexCount; ++i)
+  {
+    uint32_t packed0 =
+        glm::packHalf2x16(glm::vec2(p_Values[i].x, p_Values[i].y));
+    uint32_t packed1 = glm::packHalf2x16(glm::vec2(p_Values[i].z, 0.0f));
+
+    tempBuffer[i * 3u] = packed0;
+    tempBuffer[i * 3u + 1u] = packed0 >> 16u;
+    tempBuffer[i * 3u + 2u] = packed1;
+  }
+
+  R::MeshBufferPool::uploadVertices(p_Range, p_Stream, tempBuffer,
+                                    vertexCount);
+  Memory::Tlsf::MainAllocator::free(tempBuffer);
+}
 }
 
+// Static members
+float MeshManager::_lodHysteresis = 0.1f;
+
 void MeshManager::init()
 {
   _INTR_LOG_INFO("Inititializing Mesh Manager...");
@@ -127,11 +202,8 @@ _INTR_INLINE void MeshManager::updateDependentResources(MeshRef p_Ref)
 
 void MeshManager::createResources(const MeshRefArray& p_Meshes)
 {
-  // Create vertex/index buffers - we're using a separate buffer for each vertex
-  // attribute
-  BufferRefArray buffersToCreate;
-  _INTR_ARRAY(void*) tempBuffersToRelease;
-
+  // Sub allocate the vertex and index ranges from the shared blocks of the mesh
+  // buffer pool - we're using a separate stream for each vertex attribute
   for (uint32_t meshIdx = 0u; meshIdx < p_Meshes.size(); ++meshIdx)
   {
     MeshRef meshRef = p_Meshes[meshIdx];
@@ -145,16 +217,33 @@ void MeshManager::createResources(const MeshRefArray& p_Meshes)
         _descBinormalsPerSubMesh(meshRef);
     const VertexColorsPerSubMeshArray& vtxColors =
         _descVertexColorsPerSubMesh(meshRef);
-    VertexBuffersPerSubMeshArray& vertexBuffers =
-        _vertexBuffersPerSubMesh(meshRef);
-    IndexBufferPerSubMeshArray& indexBuffers = _indexBufferPerSubMesh(meshRef);
+    MeshBufferRangePerSubMeshArray& vertexRanges =
+        _vertexRangePerSubMesh(meshRef);
+    MeshBufferRangePerSubMeshArray& indexRanges =
+        _indexRangePerSubMesh(meshRef);
+    const LodIndicesPerSubMeshArray& lodIndices =
+        _descLodIndicesPerSubMesh(meshRef);
+    LodIndexRangesPerSubMeshArray& lodIndexRanges =
+        _lodIndexRangesPerSubMesh(meshRef);
 
-    void* tempIndexBuffer = nullptr;
     const uint32_t subMeshCount = (uint32_t)positions.size();
-    vertexBuffers.resize(subMeshCount);
-    indexBuffers.resize(subMeshCount);
+    vertexRanges.resize(subMeshCount);
+    indexRanges.resize(subMeshCount);
+    lodIndexRanges.resize(subMeshCount);
     _aabbPerSubMesh(meshRef).resize(subMeshCount);
 
+    // Only use the LODs available for all sub meshes
+    uint32_t lodCount = lodIndices.size() == subMeshCount
+                            ? (uint32_t)_descLodScreenSizes(meshRef).size() + 1u
+                            : 1u;
+    for (uint32_t subMeshIdx = 0u; subMeshIdx < lodIndices.size();
+         ++subMeshIdx)
+    {
+      lodCount = glm::min(lodCount,
+                          (uint32_t)lodIndices[subMeshIdx].size() + 1u);
+    }
+    _lodCount(meshRef) = (uint8_t)lodCount;
+
     for (uint32_t subMeshIdx = 0u; subMeshIdx < subMeshCount; ++subMeshIdx)
     {
       // Build AABB
@@ -169,290 +258,123 @@ void MeshManager::createResources(const MeshRefArray& p_Meshes)
         }
       }
 
-      BufferRef posVertexBuffer =
-          BufferManager::createBuffer(_N(MeshPositionVb));
-      {
-        BufferManager::resetToDefault(posVertexBuffer);
-
-        BufferManager::addResourceFlags(
-            posVertexBuffer, Dod::Resources::ResourceFlags::kResourceVolatile);
-        BufferManager::_descBufferType(posVertexBuffer) =
-            R::BufferType::kVertex;
-        BufferManager::_descSizeInBytes(posVertexBuffer) =
-            (uint32_t)positions[subMeshIdx].size() * sizeof(uint16_t) * 4u;
-
-        // Convert to half
-        uint16_t* tempBuffer = (uint16_t*)Memory::Tlsf::MainAllocator::allocate(
-            BufferManager::_descSizeInBytes(posVertexBuffer));
-        tempBuffersToRelease.push_back(tempBuffer);
-
-        for (uint32_t i = 0u; i < positions[subMeshIdx].size(); ++i)
-        {
-          uint32_t packedPosition0 = glm::packHalf2x16(glm::vec2(
-              positions[subMeshIdx][i].x, positions[subMeshIdx][i].y));
-          uint32_t packedPosition1 =
-              glm::packHalf2x16(glm::vec2(positions[subMeshIdx][i].z, 0.0f));
-
-          tempBuffer[i * 3u] = packedPosition0;
-          tempBuffer[i * 3u + 1u] = packedPosition0 >> 16u;
-          tempBuffer[i * 3u + 2u] = packedPosition1;
-        }
-        BufferManager::_descInitialData(posVertexBuffer) = tempBuffer;
-
-        buffersToCreate.push_back(posVertexBuffer);
-        vertexBuffers[subMeshIdx].push_back(posVertexBuffer);
-      }
-
-      BufferRef uv0VertexBuffer = BufferManager::createBuffer(_N(MeshUv0Vb));
+      const uint32_t vertexCount = (uint32_t)positions[subMeshIdx].size();
+      const MeshBufferRange vertexRange =
+          R::MeshBufferPool::allocateVertices(vertexCount);
+      vertexRanges[subMeshIdx] = vertexRange;
+
+      uploadHalf3Vertices(vertexRange, R::MeshVertexStream::kPosition,
+                          positions[subMeshIdx]);
+      uploadHalf3Vertices(vertexRange, R::MeshVertexStream::kNormal,
+                          normals[subMeshIdx]);
+      uploadHalf3Vertices(vertexRange, R::MeshVertexStream::kTangent,
+                          tangents[subMeshIdx]);
+      uploadHalf3Vertices(vertexRange, R::MeshVertexStream::kBinormal,
+                          binormals[subMeshIdx]);
+
+      if (!uv0s[subMeshIdx].empty())
       {
-        BufferManager::resetToDefault(uv0VertexBuffer);
-
-        BufferManager::addResourceFlags(
-            uv0VertexBuffer, Dod::Resources::ResourceFlags::kResourceVolatile);
-        BufferManager::_descBufferType(uv0VertexBuffer) =
-            R::BufferType::kVertex;
-        BufferManager::_descSizeInBytes(uv0VertexBuffer) =
-            (uint32_t)uv0s[subMeshIdx].size() * sizeof(uint16_t) * 2u;
-
         // Convert to half
-        uint16_t* tempBuffer = (uint16_t*)Memory::Tlsf::MainAllocator::allocate(
-            BufferManager::_descSizeInBytes(uv0VertexBuffer));
-        tempBuffersToRelease.push_back(tempBuffer);
+        uint32_t* tempBuffer = (uint32_t*)Memory::Tlsf::MainAllocator::allocate(
+            (uint32_t)uv0s[subMeshIdx].size() * sizeof(uint32_t));
 
         for (uint32_t i = 0u; i < uv0s[subMeshIdx].size(); ++i)
         {
-          uint32_t packedUv = glm::packHalf2x16(uv0s[subMeshIdx][i]);
-
-          tempBuffer[i * 2u] = packedUv;
-          tempBuffer[i * 2u + 1u] = packedUv >> 16u;
+          tempBuffer[i] = glm::packHalf2x16(uv0s[subMeshIdx][i]);
         }
-        BufferManager::_descInitialData(uv0VertexBuffer) = tempBuffer;
 
-        buffersToCreate.push_back(uv0VertexBuffer);
-        vertexBuffers[subMeshIdx].push_back(uv0VertexBuffer);
+        R::MeshBufferPool::uploadVertices(vertexRange,
+                                          R::MeshVertexStream::kUV0, tempBuffer,
+                                          (uint32_t)uv0s[subMeshIdx].size());
+        Memory::Tlsf::MainAllocator::free(tempBuffer);
       }
 
-      BufferRef normalVertexBuffer =
-          BufferManager::createBuffer(_N(MeshNormalVb));
+      if (!vtxColors[subMeshIdx].empty())
       {
-        BufferManager::resetToDefault(normalVertexBuffer);
-
-        BufferManager::addResourceFlags(
-            normalVertexBuffer,
-            Dod::Resources::ResourceFlags::kResourceVolatile);
-        BufferManager::_descBufferType(normalVertexBuffer) =
-            R::BufferType::kVertex;
-        BufferManager::_descSizeInBytes(normalVertexBuffer) =
-            (uint32_t)normals[subMeshIdx].size() * sizeof(uint16_t) * 4u;
-
-        // Convert to half
-        uint16_t* tempBuffer = (uint16_t*)Memory::Tlsf::MainAllocator::allocate(
-            BufferManager::_descSizeInBytes(normalVertexBuffer));
-        tempBuffersToRelease.push_back(tempBuffer);
-
-        for (uint32_t i = 0u; i < normals[subMeshIdx].size(); ++i)
-        {
-          uint32_t packedNormal0 = glm::packHalf2x16(
-              glm::vec2(normals[subMeshIdx][i].x, normals[subMeshIdx][i].y));
-          uint32_t packedNormal1 =
-              glm::packHalf2x16(glm::vec2(normals[subMeshIdx][i].z, 0.0f));
-
-          tempBuffer[i * 3u] = packedNormal0;
-          tempBuffer[i * 3u + 1u] = packedNormal0 >> 16u;
-          tempBuffer[i * 3u + 2u] = packedNormal1;
-        }
-        BufferManager::_descInitialData(normalVertexBuffer) = tempBuffer;
-
-        buffersToCreate.push_back(normalVertexBuffer);
-        vertexBuffers[subMeshIdx].push_back(normalVertexBuffer);
-      }
-
-      BufferRef tangentVertexBuffer =
-          BufferManager::createBuffer(_N(MeshTangentVb));
-      {
-        BufferManager::resetToDefault(tangentVertexBuffer);
-
-        BufferManager::addResourceFlags(
-            tangentVertexBuffer,
-            Dod::Resources::ResourceFlags::kResourceVolatile);
-        BufferManager::_descBufferType(tangentVertexBuffer) =
-            R::BufferType::kVertex;
-        BufferManager::_descSizeInBytes(tangentVertexBuffer) =
-            (uint32_t)tangents[subMeshIdx].size() * sizeof(uint16_t) * 4u;
-
-        // Convert to half
-        uint16_t* tempBuffer = (uint16_t*)Memory::Tlsf::MainAllocator::allocate(
-            BufferManager::_descSizeInBytes(tangentVertexBuffer));
-        tempBuffersToRelease.push_back(tempBuffer);
-
-        for (uint32_t i = 0u; i < tangents[subMeshIdx].size(); ++i)
-        {
-          uint32_t packedTangent0 = glm::packHalf2x16(
-              glm::vec2(tangents[subMeshIdx][i].x, tangents[subMeshIdx][i].y));
-          uint32_t packedTangent1 =
-              glm::packHalf2x16(glm::vec2(tangents[subMeshIdx][i].z, 0.0f));
-
-          tempBuffer[i * 3u] = packedTangent0;
-          tempBuffer[i * 3u + 1u] = packedTangent0 >> 16u;
-          tempBuffer[i * 3u + 2u] = packedTangent1;
-        }
-        BufferManager::_descInitialData(tangentVertexBuffer) = tempBuffer;
-
-        buffersToCreate.push_back(tangentVertexBuffer);
-        vertexBuffers[subMeshIdx].push_back(tangentVertexBuffer);
-      }
-
-      BufferRef binormalVertexBuffer =
-          BufferManager::createBuffer(_N(MeshBinormalVb));
-      {
-        BufferManager::resetToDefault(binormalVertexBuffer);
-
-        BufferManager::addResourceFlags(
-            binormalVertexBuffer,
-            Dod::Resources::ResourceFlags::kResourceVolatile);
-        BufferManager::_descBufferType(binormalVertexBuffer) =
-            R::BufferType::kVertex;
-        BufferManager::_descSizeInBytes(binormalVertexBuffer) =
-            (uint32_t)binormals[subMeshIdx].size() * sizeof(uint16_t) * 4u;
-
-        // Convert to half
-        uint16_t* tempBuffer = (uint16_t*)Memory::Tlsf::MainAllocator::allocate(
-            BufferManager::_descSizeInBytes(binormalVertexBuffer));
-        tempBuffersToRelease.push_back(tempBuffer);
-
-        for (uint32_t i = 0u; i < binormals[subMeshIdx].size(); ++i)
-        {
-          uint32_t packedBinormal0 = glm::packHalf2x16(glm::vec2(
-              binormals[subMeshIdx][i].x, binormals[subMeshIdx][i].y));
-          uint32_t packedBinormal1 =
-              glm::packHalf2x16(glm::vec2(binormals[subMeshIdx][i].z, 0.0f));
-
-          tempBuffer[i * 3u] = packedBinormal0;
-          tempBuffer[i * 3u + 1u] = packedBinormal0 >> 16u;
-          tempBuffer[i * 3u + 2u] = packedBinormal1;
-        }
-        BufferManager::_descInitialData(binormalVertexBuffer) = tempBuffer;
-
-        buffersToCreate.push_back(binormalVertexBuffer);
-        vertexBuffers[subMeshIdx].push_back(binormalVertexBuffer);
-      }
-
-      BufferRef vtxColorVertexBuffer =
-          BufferManager::createBuffer(_N(MeshVtxColorVb));
-      {
-        BufferManager::resetToDefault(vtxColorVertexBuffer);
-
-        BufferManager::addResourceFlags(
-            vtxColorVertexBuffer,
-            Dod::Resources::ResourceFlags::kResourceVolatile);
-        BufferManager::_descBufferType(vtxColorVertexBuffer) =
-            R::BufferType::kVertex;
-
-        BufferManager::_descSizeInBytes(vtxColorVertexBuffer) =
-            (uint32_t)vtxColors[subMeshIdx].size() * sizeof(uint32_t);
-
         // Convert color
         uint32_t* tempBuffer = (uint32_t*)Memory::Tlsf::MainAllocator::allocate(
-            BufferManager::_descSizeInBytes(vtxColorVertexBuffer));
-        tempBuffersToRelease.push_back(tempBuffer);
+            (uint32_t)vtxColors[subMeshIdx].size() * sizeof(uint32_t));
 
         for (uint32_t i = 0u; i < vtxColors[subMeshIdx].size(); ++i)
         {
           tempBuffer[i] = Math::convertColorToBGRA(vtxColors[subMeshIdx][i]);
         }
-        BufferManager::_descInitialData(vtxColorVertexBuffer) = tempBuffer;
 
-        buffersToCreate.push_back(vtxColorVertexBuffer);
-        vertexBuffers[subMeshIdx].push_back(vtxColorVertexBuffer);
+        R::MeshBufferPool::uploadVertices(
+            vertexRange, R::MeshVertexStream::kVertexColor, tempBuffer,
+            (uint32_t)vtxColors[subMeshIdx].size());
+        Memory::Tlsf::MainAllocator::free(tempBuffer);
       }
 
-      BufferRef indexBuffer = BufferManager::createBuffer(_N(MeshIb));
+      // LODs share the vertex range of the sub mesh and are stored one after
+      // another in a single index range, so a single draw call can switch
+      // between them by changing the first index and index count
+      if (lodCount > 1u)
       {
-        BufferManager::resetToDefault(indexBuffer);
-
-        BufferManager::addResourceFlags(
-            indexBuffer, Dod::Resources::ResourceFlags::kResourceVolatile);
-
-        if (indices[subMeshIdx].size() <= 0xFFFF)
+        _INTR_ARRAY(uint32_t) allLodIndices = indices[subMeshIdx];
+        for (uint32_t lodIdx = 1u; lodIdx < lodCount; ++lodIdx)
         {
-          uint32_t indexBufferSizeInBytes =
-              (uint16_t)indices[subMeshIdx].size() * sizeof(uint16_t);
-          uint16_t* tempIndexBuffer =
-              (uint16_t*)Memory::Tlsf::MainAllocator::allocate(
-                  indexBufferSizeInBytes);
-          tempBuffersToRelease.push_back(tempIndexBuffer);
-
-          for (uint32_t i = 0u; i < indices[subMeshIdx].size(); ++i)
-          {
-            tempIndexBuffer[i] = (uint16_t)indices[subMeshIdx][i];
-          }
-
-          BufferManager::_descBufferType(indexBuffer) = R::BufferType::kIndex16;
-          BufferManager::_descSizeInBytes(indexBuffer) = indexBufferSizeInBytes;
-          BufferManager::_descInitialData(indexBuffer) = tempIndexBuffer;
-        }
-        else
-        {
-          BufferManager::_descBufferType(indexBuffer) = R::BufferType::kIndex32;
-          BufferManager::_descSizeInBytes(indexBuffer) =
-              (uint32_t)indices[subMeshIdx].size() * sizeof(uint32_t);
-          BufferManager::_descInitialData(indexBuffer) =
-              (void*)indices[subMeshIdx].data();
+          const _INTR_ARRAY(uint32_t)& indicesOfLod =
+              lodIndices[subMeshIdx][lodIdx - 1u];
+          allLodIndices.insert(allLodIndices.end(), indicesOfLod.begin(),
+                               indicesOfLod.end());
         }
+        indexRanges[subMeshIdx] =
+            allocateAndUploadIndices(allLodIndices, vertexCount);
+      }
+      else
+      {
+        indexRanges[subMeshIdx] =
+            allocateAndUploadIndices(indices[subMeshIdx], vertexCount);
+      }
 
-        buffersToCreate.push_back(indexBuffer);
-        indexBuffers[subMeshIdx] = indexBuffer;
+      MeshBufferRangePerSubMeshArray& lodRanges = lodIndexRanges[subMeshIdx];
+      lodRanges.resize(lodCount);
+      lodRanges[0].blockIdx = indexRanges[subMeshIdx].blockIdx;
+      lodRanges[0].offset = indexRanges[subMeshIdx].offset;
+      lodRanges[0].count = (uint32_t)indices[subMeshIdx].size();
+      for (uint32_t lodIdx = 1u; lodIdx < lodCount; ++lodIdx)
+      {
+        lodRanges[lodIdx].blockIdx = lodRanges[lodIdx - 1u].blockIdx;
+        lodRanges[lodIdx].offset =
+            lodRanges[lodIdx - 1u].offset + lodRanges[lodIdx - 1u].count;
+        lodRanges[lodIdx].count =
+            (uint32_t)lodIndices[subMeshIdx][lodIdx - 1u].size();
       }
     }
 
     createOrLoadPhysicsMeshes(meshRef);
   }
 
-  BufferManager::createResources(buffersToCreate);
-
-  for (uint32_t i = 0u; i < tempBuffersToRelease.size(); ++i)
-  {
-    Memory::Tlsf::MainAllocator::free(tempBuffersToRelease[i]);
-  }
-  tempBuffersToRelease.clear();
+  R::MeshBufferPool::flushUploads();
 }
 
 // <-
 
 void MeshManager::destroyResources(const MeshRefArray& p_Meshes)
 {
-  BufferRefArray buffersToDestroy;
-
   for (uint32_t i = 0u; i < p_Meshes.size(); ++i)
   {
     MeshRef meshRef = p_Meshes[i];
 
-    VertexBuffersPerSubMeshArray& subMeshVtxBuffers =
-        _vertexBuffersPerSubMesh(meshRef);
-    IndexBufferPerSubMeshArray& subMeshIdxBuffers =
-        _indexBufferPerSubMesh(meshRef);
-
-    for (uint32_t i = 0u; i < subMeshVtxBuffers.size(); ++i)
+    MeshBufferRangePerSubMeshArray& vertexRanges =
+        _vertexRangePerSubMesh(meshRef);
+    for (uint32_t i = 0u; i < vertexRanges.size(); ++i)
     {
-      for (uint32_t j = 0u; j < subMeshVtxBuffers[i].size(); ++j)
-      {
-        BufferRef bufferRef = subMeshVtxBuffers[i][j];
-        _INTR_ASSERT(bufferRef.isValid());
-
-        buffersToDestroy.push_back(bufferRef);
-      }
+      R::MeshBufferPool::releaseVertices(vertexRanges[i]);
     }
 
-    for (uint32_t i = 0u; i < subMeshIdxBuffers.size(); ++i)
+    MeshBufferRangePerSubMeshArray& indexRanges =
+        _indexRangePerSubMesh(meshRef);
+    for (uint32_t i = 0u; i < indexRanges.size(); ++i)
     {
-      BufferRef bufferRef = subMeshIdxBuffers[i];
-      _INTR_ASSERT(bufferRef.isValid());
-
-      buffersToDestroy.push_back(bufferRef);
+      R::MeshBufferPool::releaseIndices(indexRanges[i]);
     }
 
-    _vertexBuffersPerSubMesh(meshRef).clear();
-    _indexBufferPerSubMesh(meshRef).clear();
+    _vertexRangePerSubMesh(meshRef).clear();
+    _indexRangePerSubMesh(meshRef).clear();
+    _lodIndexRangesPerSubMesh(meshRef).clear();
+    _lodCount(meshRef) = 1u;
 
     if (_pxTriangleMesh(meshRef) != nullptr)
     {
@@ -466,13 +388,6 @@ void MeshManager::destroyResources(const MeshRefArray& p_Meshes)
       _pxConvexMesh(meshRef) = nullptr;
     }
   }
-
-  BufferManager::destroyResources(buffersToDestroy);
-
-  for (uint32_t i = 0u; i < buffersToDestroy.size(); ++i)
-  {
-    BufferManager::destroyBuffer(buffersToDestroy[i]);
-  }
 }
 }
 }
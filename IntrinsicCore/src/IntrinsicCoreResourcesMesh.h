@@ -34,54 +34,75 @@ typedef _INTR_ARRAY(MeshRef) MeshRefArray;
 typedef _INTR_ARRAY(_INTR_ARRAY(glm::vec3)) PositionsPerSubMeshArray;
 typedef _INTR_ARRAY(_INTR_ARRAY(glm::vec2)) UVsPerSubMeshArray;
 typedef _INTR_ARRAY(_INTR_ARRAY(uint32_t)) IndicesPerSubMeshArray;
+typedef _INTR_ARRAY(IndicesPerSubMeshArray) LodIndicesPerSubMeshArray;
 typedef _INTR_ARRAY(_INTR_ARRAY(glm::vec3)) NormalsPerSubMeshArray;
 typedef _INTR_ARRAY(_INTR_ARRAY(glm::vec3)) TangentsPerSubMeshArray;
 typedef _INTR_ARRAY(_INTR_ARRAY(glm::vec3)) BinormalsPerSubMeshArray;
 typedef _INTR_ARRAY(_INTR_ARRAY(glm::vec4)) VertexColorsPerSubMeshArray;
 typedef _INTR_ARRAY(Name) MaterialNamesPerSubMeshArray;
-typedef _INTR_ARRAY(_INTR_ARRAY(Dod::Ref)) VertexBuffersPerSubMeshArray;
-typedef _INTR_ARRAY(Dod::Ref) IndexBufferPerSubMeshArray;
+
+// Range of vertices or indices in one of the blocks of the mesh buffer pool
+struct MeshBufferRange
+{
+  uint32_t blockIdx;
+  uint32_t offset;
+  uint32_t count;
+};
+typedef _INTR_ARRAY(MeshBufferRange) MeshBufferRangePerSubMeshArray;
+typedef _INTR_ARRAY(MeshBufferRangePerSubMeshArray)
+    LodIndexRangesPerSubMeshArray;
+
 typedef _INTR_ARRAY(Math::AABB) AABBPerSubMeshArray;
 
 struct MeshData : Dod::Resources::ResourceDataBase
 {
-  MeshData() : Dod::Resources::ResourceDataBase(_INTR_MAX_MESH_COUNT)
+  MeshData()
   {
-    descPositionsPerSubMesh.resize(_INTR_MAX_MESH_COUNT);
-    descUV0sPerSubMesh.resize(_INTR_MAX_MESH_COUNT);
-    descIndicesPerSubMesh.resize(_INTR_MAX_MESH_COUNT);
-    descNormalsPerSubMesh.resize(_INTR_MAX_MESH_COUNT);
-    descTangentsPerSubMesh.resize(_INTR_MAX_MESH_COUNT);
-    descBinormalsPerSubMesh.resize(_INTR_MAX_MESH_COUNT);
-    descVertexColorsPerSubMesh.resize(_INTR_MAX_MESH_COUNT);
-    descMaterialNamesPerSubMesh.resize(_INTR_MAX_MESH_COUNT);
-    vertexBuffersPerSubMesh.resize(_INTR_MAX_MESH_COUNT);
-    indexBufferPerSubMesh.resize(_INTR_MAX_MESH_COUNT);
-    aabbPerSubMesh.resize(_INTR_MAX_MESH_COUNT);
-
-    pxTriangleMesh.resize(_INTR_MAX_MESH_COUNT);
-    pxConvexMesh.resize(_INTR_MAX_MESH_COUNT);
+    registerArray(descPositionsPerSubMesh);
+    registerArray(descUV0sPerSubMesh);
+    registerArray(descIndicesPerSubMesh);
+    registerArray(descNormalsPerSubMesh);
+    registerArray(descTangentsPerSubMesh);
+    registerArray(descBinormalsPerSubMesh);
+    registerArray(descVertexColorsPerSubMesh);
+    registerArray(descMaterialNamesPerSubMesh);
+    registerArray(descLodIndicesPerSubMesh);
+    registerArray(descLodScreenSizes);
+    registerArray(vertexRangePerSubMesh);
+    registerArray(indexRangePerSubMesh);
+    registerArray(lodIndexRangesPerSubMesh);
+    registerArray(lodCount);
+    registerArray(aabbPerSubMesh);
+
+    registerArray(pxTriangleMesh);
+    registerArray(pxConvexMesh);
   }
 
   // <-
 
   // Description
-  _INTR_ARRAY(PositionsPerSubMeshArray) descPositionsPerSubMesh;
-  _INTR_ARRAY(UVsPerSubMeshArray) descUV0sPerSubMesh;
-  _INTR_ARRAY(IndicesPerSubMeshArray) descIndicesPerSubMesh;
-  _INTR_ARRAY(NormalsPerSubMeshArray) descNormalsPerSubMesh;
-  _INTR_ARRAY(TangentsPerSubMeshArray) descTangentsPerSubMesh;
-  _INTR_ARRAY(BinormalsPerSubMeshArray) descBinormalsPerSubMesh;
-  _INTR_ARRAY(VertexColorsPerSubMeshArray) descVertexColorsPerSubMesh;
-  _INTR_ARRAY(MaterialNamesPerSubMeshArray) descMaterialNamesPerSubMesh;
+  _INTR_PAGED_ARRAY(PositionsPerSubMeshArray) descPositionsPerSubMesh;
+  _INTR_PAGED_ARRAY(UVsPerSubMeshArray) descUV0sPerSubMesh;
+  _INTR_PAGED_ARRAY(IndicesPerSubMeshArray) descIndicesPerSubMesh;
+  _INTR_PAGED_ARRAY(NormalsPerSubMeshArray) descNormalsPerSubMesh;
+  _INTR_PAGED_ARRAY(TangentsPerSubMeshArray) descTangentsPerSubMesh;
+  _INTR_PAGED_ARRAY(BinormalsPerSubMeshArray) descBinormalsPerSubMesh;
+  _INTR_PAGED_ARRAY(VertexColorsPerSubMeshArray) descVertexColorsPerSubMesh;
+  _INTR_PAGED_ARRAY(MaterialNamesPerSubMeshArray) descMaterialNamesPerSubMesh;
+  _INTR_PAGED_ARRAY(LodIndicesPerSubMeshArray) descLodIndicesPerSubMesh;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(float)) descLodScreenSizes;
 
   // Resources
-  _INTR_ARRAY(VertexBuffersPerSubMeshArray) vertexBuffersPerSubMesh;
-  _INTR_ARRAY(IndexBufferPerSubMeshArray) indexBufferPerSubMesh;
-  _INTR_ARRAY(AABBPerSubMeshArray) aabbPerSubMesh;
-
-  _INTR_ARRAY(physx::PxTriangleMesh*) pxTriangleMesh;
-  _INTR_ARRAY(physx::PxConvexMesh*) pxConvexMesh;
+  _INTR_PAGED_ARRAY(MeshBufferRangePerSubMeshArray) vertexRangePerSubMesh;
+  // Contains the indices of all LODs of the sub mesh
+  _INTR_PAGED_ARRAY(MeshBufferRangePerSubMeshArray) indexRangePerSubMesh;
+  // The part of the index range used by each LOD, starting with LOD 0
+  _INTR_PAGED_ARRAY(LodIndexRangesPerSubMeshArray) lodIndexRangesPerSubMesh;
+  _INTR_PAGED_ARRAY(uint8_t) lodCount;
+  _INTR_PAGED_ARRAY(AABBPerSubMeshArray) aabbPerSubMesh;
+
+  _INTR_PAGED_ARRAY(physx::PxTriangleMesh*) pxTriangleMesh;
+  _INTR_PAGED_ARRAY(physx::PxConvexMesh*) pxConvexMesh;
 };
 
 struct MeshManager
@@ -110,6 +131,8 @@ struct MeshManager
     _descBinormalsPerSubMesh(p_Ref).clear();
     _descVertexColorsPerSubMesh(p_Ref).clear();
     _descMaterialNamesPerSubMesh(p_Ref).clear();
+    _descLodIndicesPerSubMesh(p_Ref).clear();
+    _descLodScreenSizes(p_Ref).clear();
     _aabbPerSubMesh(p_Ref).clear();
   }
 
@@ -149,6 +172,9 @@ struct MeshManager
           rapidjson::Value(rapidjson::kArrayType);
       rapidjson::Value materialNamesPerSubMesh =
           rapidjson::Value(rapidjson::kArrayType);
+      rapidjson::Value lodIndicesPerSubMesh =
+          rapidjson::Value(rapidjson::kArrayType);
+      rapidjson::Value lodScreenSizes = rapidjson::Value(rapidjson::kArrayType);
 
       for (uint32_t subMeshIdx = 0u;
            subMeshIdx < _descPositionsPerSubMesh(p_Ref).size(); ++subMeshIdx)
@@ -212,10 +238,33 @@ struct MeshManager
         indicesPerSubMesh.PushBack(indices, p_Document.GetAllocator());
 
         rapidjson::Value materialName = rapidjson::Value(
-            _descMaterialNamesPerSubMesh(p_Ref)[subMeshIdx].getString().c_str(),
+            _descMaterialNamesPerSubMesh(p_Ref)[subMeshIdx].c_str(),
             p_Document.GetAllocator());
         materialNamesPerSubMesh.PushBack(materialName,
                                          p_Document.GetAllocator());
+
+        rapidjson::Value lods = rapidjson::Value(rapidjson::kArrayType);
+        for (uint32_t lodIdx = 0u;
+             lodIdx < _descLodIndicesPerSubMesh(p_Ref)[subMeshIdx].size();
+             ++lodIdx)
+        {
+          const _INTR_ARRAY(uint32_t)& lodIndices =
+              _descLodIndicesPerSubMesh(p_Ref)[subMeshIdx][lodIdx];
+
+          rapidjson::Value lod = rapidjson::Value(rapidjson::kArrayType);
+          for (uint32_t i = 0u; i < lodIndices.size(); ++i)
+          {
+            lod.PushBack(lodIndices[i], p_Document.GetAllocator());
+          }
+          lods.PushBack(lod, p_Document.GetAllocator());
+        }
+        lodIndicesPerSubMesh.PushBack(lods, p_Document.GetAllocator());
+      }
+
+      for (uint32_t i = 0u; i < _descLodScreenSizes(p_Ref).size(); ++i)
+      {
+        lodScreenSizes.PushBack(_descLodScreenSizes(p_Ref)[i],
+                                p_Document.GetAllocator());
       }
 
       p_Properties.AddMember("positionsPerSubMesh", positionsPerSubMesh,
@@ -234,6 +283,10 @@ struct MeshManager
                              p_Document.GetAllocator());
       p_Properties.AddMember("materialNamesPerSubMesh", materialNamesPerSubMesh,
                              p_Document.GetAllocator());
+      p_Properties.AddMember("lodIndicesPerSubMesh", lodIndicesPerSubMesh,
+                             p_Document.GetAllocator());
+      p_Properties.AddMember("lodScreenSizes", lodScreenSizes,
+                             p_Document.GetAllocator());
     }
     else
     {
@@ -341,6 +394,43 @@ struct MeshManager
         _descMaterialNamesPerSubMesh(p_Ref)[subMeshIdx] =
             materialNamesPerSubMesh[subMeshIdx].GetString();
       }
+
+      // Meshes imported before LODs were introduced don't provide any
+      _descLodIndicesPerSubMesh(p_Ref).resize(subMeshCount);
+      if (p_Properties.HasMember("lodIndicesPerSubMesh"))
+      {
+        rapidjson::Value& lodIndicesPerSubMesh =
+            p_Properties["lodIndicesPerSubMesh"];
+
+        for (uint32_t subMeshIdx = 0u; subMeshIdx < subMeshCount; ++subMeshIdx)
+        {
+          rapidjson::Value& lods = lodIndicesPerSubMesh[subMeshIdx];
+          _descLodIndicesPerSubMesh(p_Ref)[subMeshIdx].resize(lods.Size());
+
+          for (uint32_t lodIdx = 0u; lodIdx < lods.Size(); ++lodIdx)
+          {
+            rapidjson::Value& lod = lods[lodIdx];
+            _INTR_ARRAY(uint32_t)& lodIndices =
+                _descLodIndicesPerSubMesh(p_Ref)[subMeshIdx][lodIdx];
+            lodIndices.resize(lod.Size());
+
+            for (uint32_t i = 0u; i < lod.Size(); ++i)
+            {
+              lodIndices[i] = lod[i].GetUint();
+            }
+          }
+        }
+      }
+
+      _descLodScreenSizes(p_Ref).clear();
+      if (p_Properties.HasMember("lodScreenSizes"))
+      {
+        rapidjson::Value& lodScreenSizes = p_Properties["lodScreenSizes"];
+        for (uint32_t i = 0u; i < lodScreenSizes.Size(); ++i)
+        {
+          _descLodScreenSizes(p_Ref).push_back(lodScreenSizes[i].GetFloat());
+        }
+      }
     }
     else
     {
@@ -412,6 +502,54 @@ struct MeshManager
 
   static void destroyResources(const MeshRefArray& p_Meshes);
 
+  // <-
+
+  /**
+   * Selects the LOD to use for the given projected screen size. Switching to a
+   * different LOD than p_PrevLodIdx requires the screen size to pass the
+   * threshold by a margin to avoid popping back and forth.
+   */
+  _INTR_INLINE static uint8_t selectLod(MeshRef p_Ref, float p_ScreenSize,
+                                        uint8_t p_PrevLodIdx)
+  {
+    uint8_t lodIdx = calcLodForScreenSize(p_Ref, p_ScreenSize);
+
+    if (lodIdx > p_PrevLodIdx)
+    {
+      lodIdx = glm::max(p_PrevLodIdx,
+                        calcLodForScreenSize(
+                            p_Ref, p_ScreenSize * (1.0f + _lodHysteresis)));
+    }
+    else if (lodIdx < p_PrevLodIdx)
+    {
+      lodIdx = glm::min(p_PrevLodIdx,
+                        calcLodForScreenSize(
+                            p_Ref, p_ScreenSize * (1.0f - _lodHysteresis)));
+    }
+
+    return lodIdx;
+  }
+
+  // <-
+
+  _INTR_INLINE static uint8_t calcLodForScreenSize(MeshRef p_Ref,
+                                                   float p_ScreenSize)
+  {
+    const _INTR_ARRAY(float)& lodScreenSizes = _descLodScreenSizes(p_Ref);
+    const uint32_t lodCount = _lodCount(p_Ref);
+
+    uint8_t lodIdx = 0u;
+    while (lodIdx + 1u < lodCount && p_ScreenSize < lodScreenSizes[lodIdx])
+    {
+      ++lodIdx;
+    }
+
+    return lodIdx;
+  }
+
+  // Static members
+  static float _lodHysteresis;
+
   // Description
   _INTR_INLINE static PositionsPerSubMeshArray&
   _descPositionsPerSubMesh(MeshRef p_Ref)
@@ -452,17 +590,35 @@ struct MeshManager
   {
     return _data.descMaterialNamesPerSubMesh[p_Ref._id];
   }
+  _INTR_INLINE static LodIndicesPerSubMeshArray&
+  _descLodIndicesPerSubMesh(MeshRef p_Ref)
+  {
+    return _data.descLodIndicesPerSubMesh[p_Ref._id];
+  }
+  _INTR_INLINE static _INTR_ARRAY(float) & _descLodScreenSizes(MeshRef p_Ref)
+  {
+    return _data.descLodScreenSizes[p_Ref._id];
+  }
 
   // Resources
-  _INTR_INLINE static VertexBuffersPerSubMeshArray&
-  _vertexBuffersPerSubMesh(MeshRef p_Ref)
+  _INTR_INLINE static MeshBufferRangePerSubMeshArray&
+  _vertexRangePerSubMesh(MeshRef p_Ref)
+  {
+    return _data.vertexRangePerSubMesh[p_Ref._id];
+  }
+  _INTR_INLINE static MeshBufferRangePerSubMeshArray&
+  _indexRangePerSubMesh(MeshRef p_Ref)
+  {
+    return _data.indexRangePerSubMesh[p_Ref._id];
+  }
+  _INTR_INLINE static LodIndexRangesPerSubMeshArray&
+  _lodIndexRangesPerSubMesh(MeshRef p_Ref)
   {
-    return _data.vertexBuffersPerSubMesh[p_Ref._id];
+    return _data.lodIndexRangesPerSubMesh[p_Ref._id];
   }
-  _INTR_INLINE static IndexBufferPerSubMeshArray&
-  _indexBufferPerSubMesh(MeshRef p_Ref)
+  _INTR_INLINE static uint8_t& _lodCount(MeshRef p_Ref)
   {
-    return _data.indexBufferPerSubMesh[p_Ref._id];
+    return _data.lodCount[p_Ref._id];
   }
   _INTR_INLINE static AABBPerSubMeshArray& _aabbPerSubMesh(MeshRef p_Ref)
   {
@@ -27,37 +27,35 @@ typedef _INTR_ARRAY(PostEffectRef) PostEffectRefArray;
 struct PostEffectData : Dod::Resources::ResourceDataBase
 {
   PostEffectData()
-      : Dod::Resources::ResourceDataBase(_INTR_MAX_POST_EFFECT_COUNT)
   {
-    descVolumetricLightingScatteringDayNight.resize(
-        _INTR_MAX_POST_EFFECT_COUNT);
+    registerArray(descVolumetricLightingScatteringDayNight);
 
-    descSunOrientation.resize(_INTR_MAX_POST_EFFECT_COUNT);
+    registerArray(descSunOrientation);
 
-    descDayNightFactor.resize(_INTR_MAX_POST_EFFECT_COUNT);
-    descSunIntensity.resize(_INTR_MAX_POST_EFFECT_COUNT);
-    descSkyAlbedo.resize(_INTR_MAX_POST_EFFECT_COUNT);
-    descSkyLightIntensity.resize(_INTR_MAX_POST_EFFECT_COUNT);
-    descSkyTurbidity.resize(_INTR_MAX_POST_EFFECT_COUNT);
-    descCloudShadowsIntensity.resize(_INTR_MAX_POST_EFFECT_COUNT);
+    registerArray(descDayNightFactor);
+    registerArray(descSunIntensity);
+    registerArray(descSkyAlbedo);
+    registerArray(descSkyLightIntensity);
+    registerArray(descSkyTurbidity);
+    registerArray(descCloudShadowsIntensity);
 
-    descDoFStartDistance.resize(_INTR_MAX_POST_EFFECT_COUNT);
+    registerArray(descDoFStartDistance);
   }
 
   // <-
 
-  _INTR_ARRAY(glm::vec2) descVolumetricLightingScatteringDayNight;
+  _INTR_PAGED_ARRAY(glm::vec2) descVolumetricLightingScatteringDayNight;
 
-  _INTR_ARRAY(glm::quat) descSunOrientation;
+  _INTR_PAGED_ARRAY(glm::quat) descSunOrientation;
 
-  _INTR_ARRAY(float) descDayNightFactor;
-  _INTR_ARRAY(float) descSunIntensity;
-  _INTR_ARRAY(float) descSkyTurbidity;
-  _INTR_ARRAY(float) descSkyAlbedo;
-  _INTR_ARRAY(float) descSkyLightIntensity;
-  _INTR_ARRAY(float) descCloudShadowsIntensity;
+  _INTR_PAGED_ARRAY(float) descDayNightFactor;
+  _INTR_PAGED_ARRAY(float) descSunIntensity;
+  _INTR_PAGED_ARRAY(float) descSkyTurbidity;
+  _INTR_PAGED_ARRAY(float) descSkyAlbedo;
+  _INTR_PAGED_ARRAY(float) descSkyLightIntensity;
+  _INTR_PAGED_ARRAY(float) descCloudShadowsIntensity;
 
-  _INTR_ARRAY(float) descDoFStartDistance;
+  _INTR_PAGED_ARRAY(float) descDoFStartDistance;
 };
 
 struct PostEffectManager
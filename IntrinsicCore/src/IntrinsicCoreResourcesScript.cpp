@@ -159,6 +159,8 @@ void setupLuaState(sol::state* p_State)
       nodeComponentTable["updateTransforms"] =
           (void (*)(Components::NodeRef)) &
           Components::NodeManager::updateTransforms;
+      nodeComponentTable["markTransformsDirty"] =
+          &Components::NodeManager::markTransformsDirty;
 
       nodeComponentTable["getPosition"] = &Components::NodeManager::getPosition;
       nodeComponentTable["setPosition"] = &Components::NodeManager::setPosition;
@@ -26,13 +26,13 @@ typedef _INTR_ARRAY(ScriptRef) ScriptRefArray;
 
 struct ScriptData : Dod::Resources::ResourceDataBase
 {
-  ScriptData() : Dod::Resources::ResourceDataBase(_INTR_MAX_SCRIPT_COUNT)
+  ScriptData()
   {
-    descScriptFileName.resize(_INTR_MAX_SCRIPT_COUNT);
+    registerArray(descScriptFileName);
   }
 
   // Description
-  _INTR_ARRAY(_INTR_STRING) descScriptFileName;
+  _INTR_PAGED_ARRAY(_INTR_STRING) descScriptFileName;
 };
 
 struct ScriptManager
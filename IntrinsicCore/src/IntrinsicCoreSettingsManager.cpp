@@ -40,6 +40,13 @@ _INTR_STRING Manager::_materialPassConfig = "material_pass_config.json";
 float Manager::_controllerDeadZone = 0.25f;
 bool Manager::_invertHorizontalCameraAxis = false;
 bool Manager::_invertVerticalCameraAxis = false;
+bool Manager::_runMicroBenchmarks = false;
+bool Manager::_dumpTaskGraph = false;
+bool Manager::_occlusionCulling = true;
+bool Manager::_gpuCulling = false;
+bool Manager::_instancing = false;
+bool Manager::_staticShadowCaching = false;
+bool Manager::_bindlessMaterials = false;
 
 namespace
 {
@@ -47,10 +54,10 @@ template <typename T>
 _INTR_INLINE void readSetting(rapidjson::Document& p_Doc, const Name& p_Name,
                               T& p_Target)
 {
-  if (p_Doc.HasMember(p_Name.getString().c_str()))
+  if (p_Doc.HasMember(p_Name.c_str()))
   {
-    p_Target = p_Doc[p_Name.getString().c_str()].Get<T>();
-    _INTR_LOG_INFO("%s = '%s'", p_Name.getString().c_str(),
+    p_Target = p_Doc[p_Name.c_str()].Get<T>();
+    _INTR_LOG_INFO("%s = '%s'", p_Name.c_str(),
                    StringUtil::toString(p_Target).c_str());
   }
 }
@@ -59,10 +66,10 @@ template <>
 _INTR_INLINE void readSetting(rapidjson::Document& p_Doc, const Name& p_Name,
                               _INTR_STRING& p_Target)
 {
-  if (p_Doc.HasMember(p_Name.getString().c_str()))
+  if (p_Doc.HasMember(p_Name.c_str()))
   {
-    p_Target = p_Doc[p_Name.getString().c_str()].GetString();
-    _INTR_LOG_INFO("%s = '%s'", p_Name.getString().c_str(), p_Target.c_str());
+    p_Target = p_Doc[p_Name.c_str()].GetString();
+    _INTR_LOG_INFO("%s = '%s'", p_Name.c_str(), p_Target.c_str());
   }
 }
 }
@@ -116,6 +123,13 @@ void Manager::loadSettings()
     readSetting(doc, _N(invertHorizontalCameraAxis),
                 _invertHorizontalCameraAxis);
     readSetting(doc, _N(invertVerticalCameraAxis), _invertVerticalCameraAxis);
+    readSetting(doc, _N(runMicroBenchmarks), _runMicroBenchmarks);
+    readSetting(doc, _N(dumpTaskGraph), _dumpTaskGraph);
+    readSetting(doc, _N(occlusionCulling), _occlusionCulling);
+    readSetting(doc, _N(gpuCulling), _gpuCulling);
+    readSetting(doc, _N(instancing), _instancing);
+    readSetting(doc, _N(staticShadowCaching), _staticShadowCaching);
+    readSetting(doc, _N(bindlessMaterials), _bindlessMaterials);
   }
 
   _INTR_LOG_POP();
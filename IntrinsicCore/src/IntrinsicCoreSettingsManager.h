@@ -72,6 +72,14 @@ struct Manager
   static bool _invertVerticalCameraAxis;
   static _INTR_STRING _rendererConfig;
   static _INTR_STRING _materialPassConfig;
+
+  static bool _runMicroBenchmarks;
+  static bool _dumpTaskGraph;
+  static bool _occlusionCulling;
+  static bool _gpuCulling;
+  static bool _instancing;
+  static bool _staticShadowCaching;
+  static bool _bindlessMaterials;
 };
 }
 }
@@ -0,0 +1,97 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Precompiled header file
+#include "stdafx.h"
+
+#if defined(_WIN32)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif // _WIN32
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace Simd
+{
+namespace
+{
+_INTR_INLINE void cpuid(uint32_t p_Leaf, uint32_t p_SubLeaf,
+                        uint32_t p_Registers[4])
+{
+#if defined(_WIN32)
+  __cpuidex((int*)p_Registers, (int)p_Leaf, (int)p_SubLeaf);
+#else
+  __cpuid_count(p_Leaf, p_SubLeaf, p_Registers[0], p_Registers[1],
+                p_Registers[2], p_Registers[3]);
+#endif // _WIN32
+}
+
+// <-
+
+_INTR_INLINE uint64_t readXcr0()
+{
+#if defined(_WIN32)
+  return _xgetbv(0);
+#else
+  uint32_t eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return ((uint64_t)edx << 32u) | eax;
+#endif // _WIN32
+}
+
+// <-
+
+bool detectAvx2Support()
+{
+  uint32_t registers[4];
+
+  cpuid(0u, 0u, registers);
+  if (registers[0] < 7u)
+  {
+    return false;
+  }
+
+  // FMA, OSXSAVE and AVX
+  cpuid(1u, 0u, registers);
+  const uint32_t ecx1Mask = (1u << 12u) | (1u << 27u) | (1u << 28u);
+  if ((registers[2] & ecx1Mask) != ecx1Mask)
+  {
+    return false;
+  }
+
+  // The OS has to save the YMM registers on context switches
+  if ((readXcr0() & 0x6u) != 0x6u)
+  {
+    return false;
+  }
+
+  // AVX2
+  cpuid(7u, 0u, registers);
+  return (registers[1] & (1u << 5u)) != 0u;
+}
+}
+
+// <-
+
+bool isAvx2Supported()
+{
+  static const bool avx2Supported = detectAvx2Support();
+  return avx2Supported;
+}
+}
+}
+}
@@ -50,6 +50,11 @@ _INTR_INLINE __m128 simdMadd(__m128 a, __m128 b, __m128 c)
 {
   return _mm_add_ps(_mm_mul_ps(a, b), c);
 }
+
+// <-
+
+// Returns true if the CPU and the OS support AVX2 and FMA
+bool isAvx2Supported();
 }
 }
 }
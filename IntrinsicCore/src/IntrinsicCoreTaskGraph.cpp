@@ -0,0 +1,357 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Precompiled header file
+#include "stdafx.h"
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace
+{
+const uint32_t _maxTaskCount = 64u;
+const uint32_t _invalidTaskIdx = (uint32_t)-1;
+
+void runTask(uint32_t p_TaskIdx);
+
+struct TaskExecutionTaskSet : enki::ITaskSet
+{
+  virtual ~TaskExecutionTaskSet() {}
+
+  void ExecuteRange(enki::TaskSetPartition p_Range,
+                    uint32_t p_ThreadNum) override
+  {
+    runTask(_taskIdx);
+  }
+
+  uint32_t _taskIdx;
+};
+
+struct Task
+{
+  Name name;
+  TaskFunction function;
+  uint32_t reads;
+  uint32_t writes;
+  uint32_t flags;
+
+  _INTR_ARRAY(uint32_t) dependencies;
+  _INTR_ARRAY(uint32_t) dependents;
+  std::atomic<uint32_t> remainingDependencyCount;
+  std::atomic<bool> scheduled;
+  std::atomic<bool> finished;
+
+  uint64_t startTime;
+  uint64_t endTime;
+
+  // Timings of the last execution
+  uint64_t durationInUs;
+  uint64_t criticalPathEndInUs;
+  uint32_t criticalPathPredecessor;
+
+  TaskExecutionTaskSet taskSet;
+};
+
+Task _tasks[_maxTaskCount];
+uint32_t _taskCount = 0u;
+
+float _deltaT = 0.0f;
+std::atomic<uint32_t> _finishedTaskCount;
+Containers::LockFreeMpscQueue<uint32_t, _maxTaskCount> _mainThreadTasks;
+
+// <-
+
+_INTR_INLINE void scheduleTask(uint32_t p_TaskIdx)
+{
+  Task& task = _tasks[p_TaskIdx];
+  task.scheduled.store(true, std::memory_order_release);
+
+  if ((task.flags & TaskFlags::kMainThread) != 0u)
+  {
+    const bool queued = _mainThreadTasks.enqueue(p_TaskIdx);
+    _INTR_ASSERT(queued);
+    (void)queued;
+  }
+  else
+  {
+    Application::_scheduler.AddTaskSetToPipe(&task.taskSet);
+  }
+}
+
+// <-
+
+void runTask(uint32_t p_TaskIdx)
+{
+  Task& task = _tasks[p_TaskIdx];
+
+  task.startTime = TimingHelper::getMicroseconds();
+  task.function(_deltaT);
+  task.endTime = TimingHelper::getMicroseconds();
+
+  for (uint32_t i = 0u; i < task.dependents.size(); ++i)
+  {
+    const uint32_t dependentIdx = task.dependents[i];
+
+    if (_tasks[dependentIdx].remainingDependencyCount.fetch_sub(
+            1u, std::memory_order_acq_rel) == 1u)
+    {
+      scheduleTask(dependentIdx);
+    }
+  }
+
+  task.finished.store(true, std::memory_order_release);
+  _finishedTaskCount.fetch_add(1u, std::memory_order_release);
+}
+
+// <-
+
+// Returns the first worker task which has been scheduled but has not finished
+// yet
+_INTR_INLINE uint32_t findRunningWorkerTask()
+{
+  for (uint32_t taskIdx = 0u; taskIdx < _taskCount; ++taskIdx)
+  {
+    const Task& task = _tasks[taskIdx];
+
+    if ((task.flags & TaskFlags::kMainThread) == 0u &&
+        task.scheduled.load(std::memory_order_acquire) &&
+        !task.finished.load(std::memory_order_acquire))
+    {
+      return taskIdx;
+    }
+  }
+
+  return _invalidTaskIdx;
+}
+
+// <-
+
+void calcCriticalPath()
+{
+  TaskGraph::_criticalPathDurationInUs = 0u;
+  TaskGraph::_totalTaskDurationInUs = 0u;
+
+  // Dependencies always point to tasks added earlier
+  for (uint32_t taskIdx = 0u; taskIdx < _taskCount; ++taskIdx)
+  {
+    Task& task = _tasks[taskIdx];
+
+    task.durationInUs = task.endTime - task.startTime;
+    task.criticalPathPredecessor = _invalidTaskIdx;
+
+    uint64_t startInUs = 0u;
+    for (uint32_t i = 0u; i < task.dependencies.size(); ++i)
+    {
+      const Task& dependency = _tasks[task.dependencies[i]];
+
+      if (dependency.criticalPathEndInUs >= startInUs)
+      {
+        startInUs = dependency.criticalPathEndInUs;
+        task.criticalPathPredecessor = task.dependencies[i];
+      }
+    }
+    task.criticalPathEndInUs = startInUs + task.durationInUs;
+
+    TaskGraph::_criticalPathDurationInUs = std::max(
+        TaskGraph::_criticalPathDurationInUs, task.criticalPathEndInUs);
+    TaskGraph::_totalTaskDurationInUs += task.durationInUs;
+  }
+}
+}
+
+// Static members
+uint64_t TaskGraph::_criticalPathDurationInUs = 0u;
+uint64_t TaskGraph::_totalTaskDurationInUs = 0u;
+
+// <-
+
+void TaskGraph::addTask(const Name& p_Name, TaskFunction p_Function,
+                        uint32_t p_Reads, uint32_t p_Writes,
+                        uint32_t p_Flags)
+{
+  _INTR_ASSERT(_taskCount < _maxTaskCount && "Too many tasks");
+
+  Task& task = _tasks[_taskCount];
+  task.name = p_Name;
+  task.function = p_Function;
+  task.reads = p_Reads;
+  task.writes = p_Writes;
+  task.flags = p_Flags;
+  task.taskSet._taskIdx = _taskCount;
+  task.taskSet.m_SetSize = 1u;
+
+  ++_taskCount;
+}
+
+// <-
+
+void TaskGraph::compile()
+{
+  for (uint32_t taskIdx = 0u; taskIdx < _taskCount; ++taskIdx)
+  {
+    _tasks[taskIdx].dependencies.clear();
+    _tasks[taskIdx].dependents.clear();
+  }
+
+  for (uint32_t taskIdx = 0u; taskIdx < _taskCount; ++taskIdx)
+  {
+    Task& task = _tasks[taskIdx];
+
+    for (uint32_t prevTaskIdx = 0u; prevTaskIdx < taskIdx; ++prevTaskIdx)
+    {
+      Task& prevTask = _tasks[prevTaskIdx];
+
+      // Read after write, write after write and write after read
+      const bool conflict =
+          (prevTask.writes & (task.reads | task.writes)) != 0u ||
+          (prevTask.reads & task.writes) != 0u;
+
+      if (conflict)
+      {
+        task.dependencies.push_back(prevTaskIdx);
+        prevTask.dependents.push_back(taskIdx);
+      }
+    }
+  }
+}
+
+// <-
+
+void TaskGraph::execute(float p_DeltaT)
+{
+  _INTR_PROFILE_CPU("TaskManager", "Execute Task Graph");
+
+  _deltaT = p_DeltaT;
+  _finishedTaskCount.store(0u, std::memory_order_relaxed);
+
+  for (uint32_t taskIdx = 0u; taskIdx < _taskCount; ++taskIdx)
+  {
+    Task& task = _tasks[taskIdx];
+    task.remainingDependencyCount.store((uint32_t)task.dependencies.size(),
+                                        std::memory_order_relaxed);
+    task.scheduled.store(false, std::memory_order_relaxed);
+    task.finished.store(false, std::memory_order_relaxed);
+  }
+
+  for (uint32_t taskIdx = 0u; taskIdx < _taskCount; ++taskIdx)
+  {
+    if (_tasks[taskIdx].dependencies.empty())
+    {
+      scheduleTask(taskIdx);
+    }
+  }
+
+  while (_finishedTaskCount.load(std::memory_order_acquire) < _taskCount)
+  {
+    uint32_t taskIdx;
+    if (_mainThreadTasks.dequeue(taskIdx))
+    {
+      runTask(taskIdx);
+      continue;
+    }
+
+    // Main thread tasks only become ready once a worker task finishes, so
+    // help out with pending tasks until the first running one is done
+    taskIdx = findRunningWorkerTask();
+    if (taskIdx != _invalidTaskIdx)
+    {
+      Application::_scheduler.WaitforTaskSet(&_tasks[taskIdx].taskSet);
+    }
+    else
+    {
+      // A finishing worker task is about to queue its dependents
+      std::this_thread::yield();
+    }
+  }
+
+  // Make sure enkiTS is done with all task sets before reusing them
+  for (uint32_t taskIdx = 0u; taskIdx < _taskCount; ++taskIdx)
+  {
+    if ((_tasks[taskIdx].flags & TaskFlags::kMainThread) == 0u)
+    {
+      Application::_scheduler.WaitforTaskSet(&_tasks[taskIdx].taskSet);
+    }
+  }
+
+  calcCriticalPath();
+
+  _INTR_PROFILE_COUNTER_SET("Task Graph Critical Path (us)",
+                            _criticalPathDurationInUs);
+  _INTR_PROFILE_COUNTER_SET("Task Graph Total Task Time (us)",
+                            _totalTaskDurationInUs);
+}
+
+// <-
+
+void TaskGraph::writeGraphviz(const char* p_FilePath)
+{
+  FILE* fp = fopen(p_FilePath, "wb");
+
+  if (fp == nullptr)
+  {
+    _INTR_LOG_WARNING("Failed to write task graph to '%s'...", p_FilePath);
+    return;
+  }
+
+  // Mark the tasks on the critical path
+  bool onCriticalPath[_maxTaskCount] = {};
+  uint32_t lastTaskIdx = _invalidTaskIdx;
+  for (uint32_t taskIdx = 0u; taskIdx < _taskCount; ++taskIdx)
+  {
+    if (_tasks[taskIdx].criticalPathEndInUs == _criticalPathDurationInUs)
+    {
+      lastTaskIdx = taskIdx;
+    }
+  }
+  for (uint32_t taskIdx = lastTaskIdx; taskIdx != _invalidTaskIdx;
+       taskIdx = _tasks[taskIdx].criticalPathPredecessor)
+  {
+    onCriticalPath[taskIdx] = true;
+  }
+
+  fprintf(fp, "digraph TaskGraph {\n");
+  fprintf(fp, "  label=\"Critical path: %.3f ms, total: %.3f ms\";\n",
+          _criticalPathDurationInUs / 1000.0f,
+          _totalTaskDurationInUs / 1000.0f);
+
+  for (uint32_t taskIdx = 0u; taskIdx < _taskCount; ++taskIdx)
+  {
+    const Task& task = _tasks[taskIdx];
+
+    fprintf(fp, "  t%u [label=\"%s\\n%.3f ms%s\"%s];\n", taskIdx,
+            task.name.c_str(), task.durationInUs / 1000.0f,
+            (task.flags & TaskFlags::kMainThread) != 0u ? "\\n(main thread)"
+                                                        : "",
+            onCriticalPath[taskIdx] ? " color=red" : "");
+
+    for (uint32_t i = 0u; i < task.dependencies.size(); ++i)
+    {
+      const uint32_t dependencyIdx = task.dependencies[i];
+      const bool criticalEdge =
+          onCriticalPath[taskIdx] &&
+          task.criticalPathPredecessor == dependencyIdx;
+
+      fprintf(fp, "  t%u -> t%u%s;\n", dependencyIdx, taskIdx,
+              criticalEdge ? " [color=red]" : "");
+    }
+  }
+
+  fprintf(fp, "}\n");
+  fclose(fp);
+
+  _INTR_LOG_INFO("Task graph written to '%s'...", p_FilePath);
+}
+}
+}
@@ -0,0 +1,101 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace Intrinsic
+{
+namespace Core
+{
+// The data a frame task can read and/or write
+namespace FrameData
+{
+enum Flags
+{
+  kInput = 0x01u,
+  kEvents = 0x02u,
+  kGameState = 0x04u,
+  kNodeTransforms = 0x08u,
+  kRigidBodies = 0x10u,
+  kPhysics = 0x20u,
+  kSwarms = 0x40u,
+  kLights = 0x80u,
+  kWorld = 0x100u,
+  kPostEffects = 0x200u,
+  kDebugGeometry = 0x400u,
+
+  // Tasks which might touch anything (e.g. scripts) have to write this
+  kAll = 0xFFFFFFFFu
+};
+}
+
+namespace TaskFlags
+{
+enum Flags
+{
+  // Executes the task on the main thread
+  kMainThread = 0x01u
+};
+}
+
+typedef void (*TaskFunction)(float p_DeltaT);
+
+/**
+ * Executes the tasks of a frame in dependency order on top of enkiTS. A task
+ * depends on all tasks added before it which write data it reads or writes
+ * or which read data it writes. Independent tasks are executed concurrently.
+ */
+struct TaskGraph
+{
+  /**
+   * Adds a new task to the graph. p_Reads and p_Writes are combinations of
+   * FrameData::Flags.
+   */
+  static void addTask(const Name& p_Name, TaskFunction p_Function,
+                      uint32_t p_Reads, uint32_t p_Writes,
+                      uint32_t p_Flags = 0u);
+
+  // <-
+
+  /**
+   * Builds the dependencies between the tasks. Has to be called after all
+   * tasks have been added.
+   */
+  static void compile();
+
+  // <-
+
+  /**
+   * Executes all tasks and blocks until all of them are finished. Must be
+   * called from the main thread.
+   */
+  static void execute(float p_DeltaT);
+
+  // <-
+
+  /**
+   * Writes the graph including the timings of the last execution to a
+   * Graphviz DOT file. Tasks on the critical path are highlighted.
+   */
+  static void writeGraphviz(const char* p_FilePath);
+
+  // <-
+
+  // Duration of the longest chain of dependent tasks in the last execution
+  static uint64_t _criticalPathDurationInUs;
+  // Sum of the durations of all tasks in the last execution
+  static uint64_t _totalTaskDurationInUs;
+};
+}
+}
@@ -49,6 +49,65 @@ struct PhysicsUpdateTaskSet : enki::ITaskSet
   };
 
 } _physicsUpdateTaskSet;
+
+// <-
+
+void pumpEvents(float p_DeltaT)
+{
+  _INTR_PROFILE_CPU("TaskManager", "Pump Events");
+
+  Input::System::reset();
+  SystemEventProvider::SDL::pumpEvents();
+}
+
+void updateGameStates(float p_DeltaT) { GameStates::Manager::update(p_DeltaT); }
+
+void tickScripts(float p_DeltaT)
+{
+  Components::ScriptManager::tickScripts(
+      Components::ScriptManager::_activeRefs, p_DeltaT);
+}
+
+void updateDirtyTransforms(float p_DeltaT)
+{
+  Components::NodeManager::updateDirtyTransforms();
+}
+
+void syncRigidBodies(float p_DeltaT)
+{
+  _INTR_PROFILE_CPU("TaskManager", "Update From Physics Results");
+
+  Components::RigidBodyManager::updateNodesFromActors(
+      Components::RigidBodyManager::_activeRefs);
+  Components::RigidBodyManager::updateActorsFromNodes(
+      Components::RigidBodyManager::_activeRefs);
+}
+
+void renderPhysicsDebugGeometry(float p_DeltaT)
+{
+  Physics::System::renderLineDebugGeometry();
+}
+
+void simulateSwarms(float p_DeltaT)
+{
+  _INTR_PROFILE_CPU("TaskManager", "Swarms");
+
+  Components::SwarmManager::simulateSwarms(
+      Components::SwarmManager::_activeRefs, p_DeltaT);
+}
+
+void updateDayNightCycle(float p_DeltaT)
+{
+  World::updateDayNightCycle(p_DeltaT);
+}
+
+void blendPostEffects(float p_DeltaT)
+{
+  Components::PostEffectVolumeManager::blendPostEffects(
+      Components::PostEffectVolumeManager::_activeRefs);
+}
+
+void fireEvents(float p_DeltaT) { Resources::EventManager::fireEvents(); }
 }
 
 // Static members
@@ -59,6 +118,55 @@ uint32_t TaskManager::_frameCounter = 0u;
 uint64_t TaskManager::_lastUpdate = 0u;
 float TaskManager::_timeModulator = 1.0f;
 
+void TaskManager::init()
+{
+  _INTR_LOG_INFO("Inititializing Task Manager...");
+
+  using namespace FrameData;
+
+  // Events and input
+  TaskGraph::addTask(_N(PumpEvents), pumpEvents, 0u, kInput | kEvents,
+                     TaskFlags::kMainThread);
+
+  // Game states and scripts might touch anything
+  TaskGraph::addTask(_N(GameStates), updateGameStates, kAll, kAll,
+                     TaskFlags::kMainThread);
+  TaskGraph::addTask(_N(Scripts), tickScripts, kAll, kAll,
+                     TaskFlags::kMainThread);
+
+  // Propagate the transforms changed so far so physics picks them up
+  TaskGraph::addTask(_N(UpdateDirtyTransforms), updateDirtyTransforms,
+                     kNodeTransforms, kNodeTransforms);
+
+  // Physics
+  TaskGraph::addTask(_N(SyncRigidBodies), syncRigidBodies,
+                     kPhysics | kRigidBodies | kNodeTransforms,
+                     kPhysics | kRigidBodies | kNodeTransforms);
+  TaskGraph::addTask(_N(PhysicsDebugGeometry), renderPhysicsDebugGeometry,
+                     kPhysics, kDebugGeometry);
+
+  // Swarms
+  TaskGraph::addTask(_N(Swarms), simulateSwarms, kNodeTransforms | kSwarms,
+                     kNodeTransforms | kSwarms | kLights);
+
+  // Propagate the transforms changed by physics and swarms
+  TaskGraph::addTask(_N(UpdateDirtyTransformsFinal), updateDirtyTransforms,
+                     kNodeTransforms, kNodeTransforms);
+
+  // Day/night cycle and post effects
+  TaskGraph::addTask(_N(DayNightCycle), updateDayNightCycle, kWorld, kWorld);
+  TaskGraph::addTask(_N(BlendPostEffects), blendPostEffects,
+                     kNodeTransforms | kPostEffects, kPostEffects);
+
+  // Event listeners might touch anything
+  TaskGraph::addTask(_N(FireEvents), fireEvents, kAll, kAll,
+                     TaskFlags::kMainThread);
+
+  TaskGraph::compile();
+}
+
+// <-
+
 void TaskManager::executeTasks()
 {
 #if defined(_INTR_PROFILING_ENABLED)
@@ -67,6 +175,10 @@ void TaskManager::executeTasks()
 
   _INTR_PROFILE_CPU("TaskManager", "Execute Tasks");
 
+  Memory::FrameAllocator::beginFrame();
+  // Blocks freed by other threads would otherwise wait for their owner
+  Memory::Tlsf::MainAllocator::returnRemoteFrees();
+
   if (_frameCounter > 0u)
   {
     _INTR_PROFILE_CPU("TaskManager", "Limit To Max FPS");
@@ -93,58 +205,11 @@ void TaskManager::executeTasks()
   {
     _INTR_PROFILE_CPU("TaskManager", "Non-Rendering Tasks");
 
-    // Events and input
-    {
-      _INTR_PROFILE_CPU("TaskManager", "Pump Events");
-
-      Input::System::reset();
-      SystemEventProvider::SDL::pumpEvents();
-    }
-
-    // Game state update
-    {
-      GameStates::Manager::update(modDeltaT);
-    }
-
-    // Scripts
-    {
-      Components::ScriptManager::tickScripts(
-          Components::ScriptManager::_activeRefs, modDeltaT);
-    }
-
-    // Physics
-    {
-      _INTR_PROFILE_CPU("TaskManager", "Update From Physics Results");
-
-      Components::RigidBodyManager::updateNodesFromActors(
-          Components::RigidBodyManager::_activeRefs);
-      Components::RigidBodyManager::updateActorsFromNodes(
-          Components::RigidBodyManager::_activeRefs);
-      Physics::System::renderLineDebugGeometry();
-    }
-
-    // Swarms
-    {
-      _INTR_PROFILE_CPU("TaskManager", "Swarms");
-
-      Components::SwarmManager::simulateSwarms(
-          Components::SwarmManager::_activeRefs, modDeltaT);
-    }
-
-    // Update the day/night cycle
-    {
-      World::updateDayNightCycle(modDeltaT);
-    }
-
-    // Post effect system
-    {
-      Components::PostEffectVolumeManager::blendPostEffects(
-          Components::PostEffectVolumeManager::_activeRefs);
-    }
+    TaskGraph::execute(modDeltaT);
 
-    // Fire events
+    if (Settings::Manager::_dumpTaskGraph && _frameCounter == 1u)
     {
-      Resources::EventManager::fireEvents();
+      TaskGraph::writeGraphviz("task_graph.dot");
     }
   }
 
@@ -20,6 +20,7 @@ namespace Core
 {
 struct TaskManager
 {
+  static void init();
   static void executeTasks();
 
   static float _lastDeltaT;
@@ -31,6 +31,17 @@ _INTR_INLINE Atomic interlockedSub(Atomic& p_Value, Atomic p_Sub)
 {
   return __sync_add_and_fetch(&p_Value, -p_Sub) + p_Sub;
 }
+
+_INTR_INLINE uint32_t interlockedOr(volatile uint32_t& p_Value, uint32_t p_Or)
+{
+  return __sync_fetch_and_or(&p_Value, p_Or);
+}
+
+_INTR_INLINE uint32_t interlockedAnd(volatile uint32_t& p_Value,
+                                     uint32_t p_And)
+{
+  return __sync_fetch_and_and(&p_Value, p_And);
+}
 }
 }
 }
@@ -31,6 +31,17 @@ _INTR_INLINE Atomic interlockedSub(Atomic& p_Value, Atomic p_Sub)
 {
   return InterlockedAddNoFence64(&p_Value, -p_Sub) + p_Sub;
 }
+
+_INTR_INLINE uint32_t interlockedOr(volatile uint32_t& p_Value, uint32_t p_Or)
+{
+  return (uint32_t)_InterlockedOr((volatile long*)&p_Value, (long)p_Or);
+}
+
+_INTR_INLINE uint32_t interlockedAnd(volatile uint32_t& p_Value,
+                                     uint32_t p_And)
+{
+  return (uint32_t)_InterlockedAnd((volatile long*)&p_Value, (long)p_And);
+}
 }
 }
 }
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+
 // Precompiled header file
 #include "stdafx.h"
 
@@ -23,8 +24,234 @@ namespace Memory
 {
 namespace Tlsf
 {
-Allocator* MainAllocator::_allocator = nullptr;
-std::once_flag MainAllocator::_onceFlag;
+namespace
+{
+// Stored in front of each allocation to find the owning heap when freeing
+struct BlockHeader
+{
+  ThreadHeap* heap;
+  uint32_t offset;
+  uint32_t padding;
+};
+static_assert(sizeof(BlockHeader) == 16u, "Unexpected block header size");
+
+// Releases the heap of a thread when the thread exits
+struct ThreadHeapReleaser
+{
+  ~ThreadHeapReleaser() { MainAllocator::releaseThreadHeap(); }
+};
+}
+
+// Static members
+thread_local ThreadHeap* MainAllocator::_threadHeap = nullptr;
+ThreadHeap MainAllocator::_threadHeaps[_INTR_TLSF_MAX_THREAD_HEAP_COUNT];
+std::atomic<uint32_t> MainAllocator::_threadHeapCount;
+uint32_t
+    MainAllocator::_freeThreadHeapIndices[_INTR_TLSF_MAX_THREAD_HEAP_COUNT];
+uint32_t MainAllocator::_freeThreadHeapCount = 0u;
+std::mutex MainAllocator::_threadHeapMutex;
+
+// <-
+
+void ThreadHeap::init(uint32_t p_SizeInBytes)
+{
+  _allocator = new Allocator(p_SizeInBytes);
+}
+
+// <-
+
+void* ThreadHeap::allocate(uint32_t p_Size, uint32_t p_Alignment)
+{
+  lock();
+  if (_remoteFrees.load(std::memory_order_relaxed) != nullptr)
+  {
+    returnRemoteFreesLocked();
+  }
+
+  // The header is placed directly in front of the returned memory
+  const uint32_t alignment =
+      std::max(p_Alignment, (uint32_t)sizeof(BlockHeader));
+  const uint32_t blockSize = p_Size + alignment;
+
+  uint8_t* block = (uint8_t*)_allocator->allocateAligned(blockSize, alignment);
+  if (block == nullptr)
+  {
+    const uint32_t poolSize =
+        std::max(_INTR_TLSF_THREAD_HEAP_SIZE_IN_MB * 1024u * 1024u,
+                 blockSize * 2u + (uint32_t)tlsf_pool_overhead());
+    _allocator->addPool(poolSize);
+
+    block = (uint8_t*)_allocator->allocateAligned(blockSize, alignment);
+    _INTR_FATAL_CHECK(block != nullptr, "Tlsf allocation failed");
+  }
+
+  uint8_t* mem = block + alignment;
+  BlockHeader* header = (BlockHeader*)mem - 1u;
+  header->heap = this;
+  header->offset = alignment;
+
+  // The counters are only changed while holding the lock
+  const uint64_t allocatedBytes =
+      _allocatedBytes.load(std::memory_order_relaxed) +
+      Allocator::blockSize(block);
+  _allocatedBytes.store(allocatedBytes, std::memory_order_relaxed);
+
+  if (allocatedBytes > _highWaterMark.load(std::memory_order_relaxed))
+  {
+    _highWaterMark.store(allocatedBytes, std::memory_order_relaxed);
+  }
+
+  unlock();
+  return mem;
+}
+
+// <-
+
+void ThreadHeap::free(void* p_Block)
+{
+  lock();
+  if (_remoteFrees.load(std::memory_order_relaxed) != nullptr)
+  {
+    returnRemoteFreesLocked();
+  }
+  freeLocked(p_Block);
+  unlock();
+}
+
+// <-
+
+void ThreadHeap::freeLocked(void* p_Block)
+{
+  _allocatedBytes.store(_allocatedBytes.load(std::memory_order_relaxed) -
+                            Allocator::blockSize(p_Block),
+                        std::memory_order_relaxed);
+  _allocator->free(p_Block);
+}
+
+// <-
+
+void ThreadHeap::freeRemote(void* p_Block)
+{
+  void* head = _remoteFrees.load(std::memory_order_relaxed);
+
+  do
+  {
+    *(void**)p_Block = head;
+  } while (!_remoteFrees.compare_exchange_weak(
+      head, p_Block, std::memory_order_release, std::memory_order_relaxed));
+}
+
+// <-
+
+void ThreadHeap::returnRemoteFreesLocked()
+{
+  void* block = _remoteFrees.exchange(nullptr, std::memory_order_acquire);
+
+  while (block != nullptr)
+  {
+    void* nextBlock = *(void**)block;
+    freeLocked(block);
+    block = nextBlock;
+  }
+}
+
+// <-
+
+void MainAllocator::free(void* p_Mem)
+{
+  _INTR_ASSERT(p_Mem && "Tried to free nullptr");
+
+  const BlockHeader* header = (const BlockHeader*)p_Mem - 1u;
+  ThreadHeap* heap = header->heap;
+  void* block = (uint8_t*)p_Mem - header->offset;
+
+  if (heap == _threadHeap)
+  {
+    heap->free(block);
+  }
+  else
+  {
+    heap->freeRemote(block);
+  }
+}
+
+// <-
+
+void MainAllocator::returnRemoteFrees()
+{
+  // Heaps which are locked by their owner return their blocks on their own
+  for (uint32_t heapIdx = 0u; heapIdx < getThreadHeapCount(); ++heapIdx)
+  {
+    _threadHeaps[heapIdx].returnRemoteFrees();
+  }
+}
+
+// <-
+
+void MainAllocator::releaseThreadHeap()
+{
+  ThreadHeap* heap = _threadHeap;
+
+  // The heap of the main thread is never handed out again
+  if (heap == nullptr || heap == &_threadHeaps[0])
+  {
+    return;
+  }
+
+  // Blocks still allocated from the heap are freed remotely from now on
+  _threadHeap = nullptr;
+  heap->returnRemoteFrees();
+
+  std::lock_guard<std::mutex> lock(_threadHeapMutex);
+  _freeThreadHeapIndices[_freeThreadHeapCount++] =
+      (uint32_t)(heap - _threadHeaps);
+}
+
+// <-
+
+ThreadHeap* MainAllocator::acquireThreadHeap()
+{
+  static thread_local ThreadHeapReleaser releaser;
+
+  {
+    std::lock_guard<std::mutex> lock(_threadHeapMutex);
+
+    if (_freeThreadHeapCount > 0u)
+    {
+      return &_threadHeaps[_freeThreadHeapIndices[--_freeThreadHeapCount]];
+    }
+  }
+
+  const uint32_t heapIdx = _threadHeapCount.fetch_add(1u);
+  _INTR_FATAL_CHECK(heapIdx < _INTR_TLSF_MAX_THREAD_HEAP_COUNT,
+                    "Maximum thread heap count exceeded");
+
+  // The first heap is acquired during static initialization by the main
+  // thread
+  ThreadHeap& heap = _threadHeaps[heapIdx];
+  heap.init((heapIdx == 0u ? _INTR_TLSF_SIZE_IN_MB
+                           : _INTR_TLSF_THREAD_HEAP_SIZE_IN_MB) *
+            1024u * 1024u);
+
+  return &heap;
+}
+
+// <-
+
+void MainAllocator::logStats()
+{
+  _INTR_LOG_INFO("Thread heaps:");
+  _INTR_LOG_PUSH();
+
+  for (uint32_t heapIdx = 0u; heapIdx < getThreadHeapCount(); ++heapIdx)
+  {
+    _INTR_LOG_INFO("Heap #%u: %.2f MB allocated, %.2f MB high-water mark",
+                   heapIdx, getAllocatedBytes(heapIdx) / (1024.0f * 1024.0f),
+                   getHighWaterMark(heapIdx) / (1024.0f * 1024.0f));
+  }
+
+  _INTR_LOG_POP();
+}
 }
 }
 }
@@ -12,13 +12,15 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+
 #pragma once
 
+// Initial size of the heap of the main thread
 #define _INTR_TLSF_SIZE_IN_MB 256u
-#define _INTR_TLSF_INIT_ON_DEMAND()                                            \
-  std::call_once(_onceFlag, []() {                                             \
-    _allocator = new Allocator(_INTR_TLSF_SIZE_IN_MB * 1024u * 1024u);         \
-  });
+// Initial size of the heaps of all other threads and the minimum size of the
+// pools added when a heap runs out of memory
+#define _INTR_TLSF_THREAD_HEAP_SIZE_IN_MB 16u
+#define _INTR_TLSF_MAX_THREAD_HEAP_COUNT 64u
 
 namespace Intrinsic
 {
@@ -55,6 +57,15 @@ struct Allocator
 
   // <-
 
+  _INTR_INLINE void addPool(uint32_t p_Size)
+  {
+    void* mem = malloc(p_Size);
+    _INTR_ASSERT(mem && "Failed to allocate Tlsf pool");
+    tlsf_add_pool(_memoryPool, mem, p_Size);
+  }
+
+  // <-
+
   _INTR_INLINE void* allocate(uint32_t p_Size)
   {
     void* mem = tlsf_malloc(_memoryPool, p_Size);
@@ -77,24 +88,169 @@ struct Allocator
     tlsf_free(_memoryPool, p_Mem);
   }
 
+  // <-
+
+  _INTR_INLINE static uint32_t blockSize(void* p_Mem)
+  {
+    return (uint32_t)tlsf_block_size(p_Mem);
+  }
+
   tlsf_t _memoryPool;
   void* _mem;
 };
 
+// <-
+
+// Heap owned by a single thread. Blocks freed by other threads are pushed to
+// a lock-free list and returned to the heap by the owning thread on its next
+// allocation or free, or once per frame for all heaps. The lock is only
+// contended while the blocks of another thread's heap are returned
+struct ThreadHeap
+{
+  void* allocate(uint32_t p_Size, uint32_t p_Alignment);
+  void free(void* p_Block);
+  void freeRemote(void* p_Block);
+
+  // <-
+
+  _INTR_INLINE void returnRemoteFrees()
+  {
+    if (_remoteFrees.load(std::memory_order_relaxed) != nullptr && tryLock())
+    {
+      returnRemoteFreesLocked();
+      unlock();
+    }
+  }
+
+  // <-
+
+  _INTR_INLINE bool isInitialized() const { return _allocator != nullptr; }
+
+  void init(uint32_t p_SizeInBytes);
+
+  // <-
+
+  _INTR_INLINE void lock()
+  {
+    while (_locked.exchange(true, std::memory_order_acquire))
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  // <-
+
+  _INTR_INLINE bool tryLock()
+  {
+    return !_locked.exchange(true, std::memory_order_acquire);
+  }
+
+  // <-
+
+  _INTR_INLINE void unlock()
+  {
+    _locked.store(false, std::memory_order_release);
+  }
+
+  Allocator* _allocator;
+  std::atomic<void*> _remoteFrees;
+  std::atomic<bool> _locked;
+  std::atomic<uint64_t> _allocatedBytes;
+  std::atomic<uint64_t> _highWaterMark;
+
+private:
+  void freeLocked(void* p_Block);
+  void returnRemoteFreesLocked();
+};
+
+// <-
+
+// Each thread allocates from its own heap and memory can be freed from any
+// thread. The heaps of exited threads are handed to new threads. All members
+// are zero initialized so the allocator can be used during static
+// initialization
 struct MainAllocator
 {
-  static void* allocate(uint32_t p_Size)
+  _INTR_INLINE static void* allocate(uint32_t p_Size)
+  {
+    return getThreadHeap()->allocate(p_Size, 0u);
+  }
+
+  // <-
+
+  _INTR_INLINE static void* allocateAligned(uint32_t p_Size,
+                                            uint32_t p_Alignment)
+  {
+    return getThreadHeap()->allocate(p_Size, p_Alignment);
+  }
+
+  // <-
+
+  static void free(void* p_Mem);
+
+  // <-
+
+  // Returns the blocks freed by other threads to all heaps, including the
+  // heaps of idle threads
+  static void returnRemoteFrees();
+
+  // Returns the heap of the calling thread to the pool of free heaps, called
+  // on thread exit
+  static void releaseThreadHeap();
+
+  // <-
+
+  _INTR_INLINE static uint32_t getThreadHeapCount()
+  {
+    return std::min(_threadHeapCount.load(std::memory_order_acquire),
+                    _INTR_TLSF_MAX_THREAD_HEAP_COUNT);
+  }
+
+  // <-
+
+  // Amount of memory currently allocated from the heap with the given index
+  _INTR_INLINE static uint64_t getAllocatedBytes(uint32_t p_HeapIdx)
   {
-    _INTR_TLSF_INIT_ON_DEMAND();
+    return _threadHeaps[p_HeapIdx]._allocatedBytes.load(
+        std::memory_order_relaxed);
+  }
 
-    return _allocator->allocate(p_Size);
+  // <-
+
+  // Peak amount of memory ever allocated from the heap with the given index
+  _INTR_INLINE static uint64_t getHighWaterMark(uint32_t p_HeapIdx)
+  {
+    return _threadHeaps[p_HeapIdx]._highWaterMark.load(
+        std::memory_order_relaxed);
   }
 
-  static void free(void* p_Mem) { _allocator->free(p_Mem); }
+  // <-
+
+  static void logStats();
 
 private:
-  static Allocator* _allocator;
-  static std::once_flag _onceFlag;
+  _INTR_INLINE static ThreadHeap* getThreadHeap()
+  {
+    if (_threadHeap == nullptr)
+    {
+      _threadHeap = acquireThreadHeap();
+    }
+
+    return _threadHeap;
+  }
+
+  // <-
+
+  static ThreadHeap* acquireThreadHeap();
+
+  static thread_local ThreadHeap* _threadHeap;
+  static ThreadHeap _threadHeaps[_INTR_TLSF_MAX_THREAD_HEAP_COUNT];
+  static std::atomic<uint32_t> _threadHeapCount;
+
+  // Heaps of exited threads
+  static uint32_t _freeThreadHeapIndices[_INTR_TLSF_MAX_THREAD_HEAP_COUNT];
+  static uint32_t _freeThreadHeapCount;
+  static std::mutex _threadHeapMutex;
 };
 }
 }
@@ -0,0 +1,470 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Precompiled header file
+#include "stdafx.h"
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace TransformKernel
+{
+namespace
+{
+_INTR_INLINE void computeSingle(const Batch& p_Batch, uint32_t p_Idx)
+{
+  const glm::vec3 pos = glm::vec3(p_Batch.posX[p_Idx], p_Batch.posY[p_Idx],
+                                  p_Batch.posZ[p_Idx]);
+  const glm::quat orient =
+      glm::quat(p_Batch.rotW[p_Idx], p_Batch.rotX[p_Idx],
+                p_Batch.rotY[p_Idx], p_Batch.rotZ[p_Idx]);
+  const glm::vec3 size = glm::vec3(p_Batch.sizeX[p_Idx], p_Batch.sizeY[p_Idx],
+                                   p_Batch.sizeZ[p_Idx]);
+  const glm::mat3 rot = glm::mat3_cast(orient);
+
+  // World matrix = translation * rotation * scale
+  glm::mat4& worldMatrix = *p_Batch.worldMatrix[p_Idx];
+  worldMatrix[0] = glm::vec4(rot[0] * size.x, 0.0f);
+  worldMatrix[1] = glm::vec4(rot[1] * size.y, 0.0f);
+  worldMatrix[2] = glm::vec4(rot[2] * size.z, 0.0f);
+  worldMatrix[3] = glm::vec4(pos, 1.0f);
+
+  // Closed form inverse: inverse scale * transposed rotation * -translation
+  glm::mat3 invRotScale = glm::transpose(rot);
+  const glm::vec3 invSize = 1.0f / size;
+  invRotScale[0] *= invSize;
+  invRotScale[1] *= invSize;
+  invRotScale[2] *= invSize;
+
+  glm::mat4& inverseWorldMatrix = *p_Batch.inverseWorldMatrix[p_Idx];
+  inverseWorldMatrix[0] = glm::vec4(invRotScale[0], 0.0f);
+  inverseWorldMatrix[1] = glm::vec4(invRotScale[1], 0.0f);
+  inverseWorldMatrix[2] = glm::vec4(invRotScale[2], 0.0f);
+  inverseWorldMatrix[3] = glm::vec4(-(invRotScale * pos), 1.0f);
+
+  if (p_Batch.worldAABB[p_Idx] != nullptr)
+  {
+    const glm::vec3 center =
+        glm::vec3(p_Batch.centerX[p_Idx], p_Batch.centerY[p_Idx],
+                  p_Batch.centerZ[p_Idx]);
+    const glm::vec3 halfExtent =
+        glm::vec3(p_Batch.halfExtentX[p_Idx], p_Batch.halfExtentY[p_Idx],
+                  p_Batch.halfExtentZ[p_Idx]);
+
+    const glm::mat3 rotScale = glm::mat3(worldMatrix);
+    const glm::vec3 worldCenter = rotScale * center + pos;
+    const glm::vec3 worldHalfExtent =
+        glm::abs(rotScale[0]) * halfExtent.x +
+        glm::abs(rotScale[1]) * halfExtent.y +
+        glm::abs(rotScale[2]) * halfExtent.z;
+
+    *p_Batch.worldAABB[p_Idx] = Math::AABB(worldCenter - worldHalfExtent,
+                                           worldCenter + worldHalfExtent);
+    *p_Batch.worldBoundingSphere[p_Idx] = {worldCenter,
+                                           glm::length(worldHalfExtent)};
+  }
+}
+
+// <-
+
+_INTR_INLINE void storeBounds(const Batch& p_Batch, uint32_t p_FirstIdx,
+                              uint32_t p_Count, const float* p_CenterX,
+                              const float* p_CenterY, const float* p_CenterZ,
+                              const float* p_HalfExtentX,
+                              const float* p_HalfExtentY,
+                              const float* p_HalfExtentZ,
+                              const float* p_Radius)
+{
+  for (uint32_t i = 0u; i < p_Count; ++i)
+  {
+    Math::AABB* worldAABB = p_Batch.worldAABB[p_FirstIdx + i];
+    if (worldAABB == nullptr)
+    {
+      continue;
+    }
+
+    const glm::vec3 center =
+        glm::vec3(p_CenterX[i], p_CenterY[i], p_CenterZ[i]);
+    const glm::vec3 halfExtent =
+        glm::vec3(p_HalfExtentX[i], p_HalfExtentY[i], p_HalfExtentZ[i]);
+
+    *worldAABB = Math::AABB(center - halfExtent, center + halfExtent);
+    *p_Batch.worldBoundingSphere[p_FirstIdx + i] = {center, p_Radius[i]};
+  }
+}
+
+// <-
+
+// Stores one column of four matrices given as SoA
+_INTR_INLINE void storeColumnSse(glm::mat4* const* p_Matrices,
+                                 uint32_t p_Column, __m128 p_X, __m128 p_Y,
+                                 __m128 p_Z, __m128 p_W)
+{
+  _MM_TRANSPOSE4_PS(p_X, p_Y, p_Z, p_W);
+
+  _mm_storeu_ps(&(*p_Matrices[0])[p_Column][0], p_X);
+  _mm_storeu_ps(&(*p_Matrices[1])[p_Column][0], p_Y);
+  _mm_storeu_ps(&(*p_Matrices[2])[p_Column][0], p_Z);
+  _mm_storeu_ps(&(*p_Matrices[3])[p_Column][0], p_W);
+}
+
+// <-
+
+_INTR_TARGET_AVX2 _INTR_INLINE void
+storeColumnAvx2(glm::mat4* const* p_Matrices, uint32_t p_Column, __m256 p_X,
+                __m256 p_Y, __m256 p_Z, __m256 p_W)
+{
+  storeColumnSse(p_Matrices, p_Column, _mm256_castps256_ps128(p_X),
+                 _mm256_castps256_ps128(p_Y), _mm256_castps256_ps128(p_Z),
+                 _mm256_castps256_ps128(p_W));
+  storeColumnSse(p_Matrices + 4u, p_Column, _mm256_extractf128_ps(p_X, 1),
+                 _mm256_extractf128_ps(p_Y, 1), _mm256_extractf128_ps(p_Z, 1),
+                 _mm256_extractf128_ps(p_W, 1));
+}
+
+// <-
+
+KernelFunction selectKernel()
+{
+  if (Simd::isAvx2Supported())
+  {
+    _INTR_LOG_INFO("Using AVX2 transform kernel...");
+    return computeAvx2;
+  }
+
+  _INTR_LOG_INFO("Using SSE transform kernel...");
+  return computeSse;
+}
+}
+
+// <-
+
+void computeScalar(const Batch& p_Batch)
+{
+  for (uint32_t i = 0u; i < p_Batch.count; ++i)
+  {
+    computeSingle(p_Batch, i);
+  }
+}
+
+// <-
+
+void computeSse(const Batch& p_Batch)
+{
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 two = _mm_set1_ps(2.0f);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+  alignas(16) float centerX[4u], centerY[4u], centerZ[4u];
+  alignas(16) float halfExtentX[4u], halfExtentY[4u], halfExtentZ[4u];
+  alignas(16) float radius[4u];
+
+  uint32_t i = 0u;
+  for (; i + 4u <= p_Batch.count; i += 4u)
+  {
+    const __m128 px = _mm_load_ps(&p_Batch.posX[i]);
+    const __m128 py = _mm_load_ps(&p_Batch.posY[i]);
+    const __m128 pz = _mm_load_ps(&p_Batch.posZ[i]);
+    const __m128 qx = _mm_load_ps(&p_Batch.rotX[i]);
+    const __m128 qy = _mm_load_ps(&p_Batch.rotY[i]);
+    const __m128 qz = _mm_load_ps(&p_Batch.rotZ[i]);
+    const __m128 qw = _mm_load_ps(&p_Batch.rotW[i]);
+    const __m128 sx = _mm_load_ps(&p_Batch.sizeX[i]);
+    const __m128 sy = _mm_load_ps(&p_Batch.sizeY[i]);
+    const __m128 sz = _mm_load_ps(&p_Batch.sizeZ[i]);
+
+    // Rotation matrix from the quaternion
+    const __m128 qx2 = _mm_mul_ps(qx, two);
+    const __m128 qy2 = _mm_mul_ps(qy, two);
+    const __m128 qz2 = _mm_mul_ps(qz, two);
+    const __m128 xx = _mm_mul_ps(qx, qx2);
+    const __m128 yy = _mm_mul_ps(qy, qy2);
+    const __m128 zz = _mm_mul_ps(qz, qz2);
+    const __m128 xy = _mm_mul_ps(qx, qy2);
+    const __m128 xz = _mm_mul_ps(qx, qz2);
+    const __m128 yz = _mm_mul_ps(qy, qz2);
+    const __m128 wx = _mm_mul_ps(qw, qx2);
+    const __m128 wy = _mm_mul_ps(qw, qy2);
+    const __m128 wz = _mm_mul_ps(qw, qz2);
+
+    const __m128 r00 = _mm_sub_ps(one, _mm_add_ps(yy, zz));
+    const __m128 r01 = _mm_add_ps(xy, wz);
+    const __m128 r02 = _mm_sub_ps(xz, wy);
+    const __m128 r10 = _mm_sub_ps(xy, wz);
+    const __m128 r11 = _mm_sub_ps(one, _mm_add_ps(xx, zz));
+    const __m128 r12 = _mm_add_ps(yz, wx);
+    const __m128 r20 = _mm_add_ps(xz, wy);
+    const __m128 r21 = _mm_sub_ps(yz, wx);
+    const __m128 r22 = _mm_sub_ps(one, _mm_add_ps(xx, yy));
+
+    // World matrix = translation * rotation * scale
+    const __m128 m00 = _mm_mul_ps(r00, sx);
+    const __m128 m01 = _mm_mul_ps(r01, sx);
+    const __m128 m02 = _mm_mul_ps(r02, sx);
+    const __m128 m10 = _mm_mul_ps(r10, sy);
+    const __m128 m11 = _mm_mul_ps(r11, sy);
+    const __m128 m12 = _mm_mul_ps(r12, sy);
+    const __m128 m20 = _mm_mul_ps(r20, sz);
+    const __m128 m21 = _mm_mul_ps(r21, sz);
+    const __m128 m22 = _mm_mul_ps(r22, sz);
+
+    glm::mat4* const* worldMatrices = &p_Batch.worldMatrix[i];
+    storeColumnSse(worldMatrices, 0u, m00, m01, m02, zero);
+    storeColumnSse(worldMatrices, 1u, m10, m11, m12, zero);
+    storeColumnSse(worldMatrices, 2u, m20, m21, m22, zero);
+    storeColumnSse(worldMatrices, 3u, px, py, pz, one);
+
+    // Closed form inverse: inverse scale * transposed rotation * -translation
+    const __m128 isx = _mm_div_ps(one, sx);
+    const __m128 isy = _mm_div_ps(one, sy);
+    const __m128 isz = _mm_div_ps(one, sz);
+
+    const __m128 i00 = _mm_mul_ps(r00, isx);
+    const __m128 i01 = _mm_mul_ps(r10, isy);
+    const __m128 i02 = _mm_mul_ps(r20, isz);
+    const __m128 i10 = _mm_mul_ps(r01, isx);
+    const __m128 i11 = _mm_mul_ps(r11, isy);
+    const __m128 i12 = _mm_mul_ps(r21, isz);
+    const __m128 i20 = _mm_mul_ps(r02, isx);
+    const __m128 i21 = _mm_mul_ps(r12, isy);
+    const __m128 i22 = _mm_mul_ps(r22, isz);
+
+    const __m128 i30 = _mm_sub_ps(
+        zero, Simd::simdMadd(i00, px, Simd::simdMadd(i10, py,
+                                                     _mm_mul_ps(i20, pz))));
+    const __m128 i31 = _mm_sub_ps(
+        zero, Simd::simdMadd(i01, px, Simd::simdMadd(i11, py,
+                                                     _mm_mul_ps(i21, pz))));
+    const __m128 i32 = _mm_sub_ps(
+        zero, Simd::simdMadd(i02, px, Simd::simdMadd(i12, py,
+                                                     _mm_mul_ps(i22, pz))));
+
+    glm::mat4* const* inverseWorldMatrices = &p_Batch.inverseWorldMatrix[i];
+    storeColumnSse(inverseWorldMatrices, 0u, i00, i01, i02, zero);
+    storeColumnSse(inverseWorldMatrices, 1u, i10, i11, i12, zero);
+    storeColumnSse(inverseWorldMatrices, 2u, i20, i21, i22, zero);
+    storeColumnSse(inverseWorldMatrices, 3u, i30, i31, i32, one);
+
+    // World space AABB and bounding sphere
+    const __m128 cx = _mm_load_ps(&p_Batch.centerX[i]);
+    const __m128 cy = _mm_load_ps(&p_Batch.centerY[i]);
+    const __m128 cz = _mm_load_ps(&p_Batch.centerZ[i]);
+    const __m128 hx = _mm_load_ps(&p_Batch.halfExtentX[i]);
+    const __m128 hy = _mm_load_ps(&p_Batch.halfExtentY[i]);
+    const __m128 hz = _mm_load_ps(&p_Batch.halfExtentZ[i]);
+
+    const __m128 wcx = Simd::simdMadd(
+        m00, cx, Simd::simdMadd(m10, cy, Simd::simdMadd(m20, cz, px)));
+    const __m128 wcy = Simd::simdMadd(
+        m01, cx, Simd::simdMadd(m11, cy, Simd::simdMadd(m21, cz, py)));
+    const __m128 wcz = Simd::simdMadd(
+        m02, cx, Simd::simdMadd(m12, cy, Simd::simdMadd(m22, cz, pz)));
+
+    const __m128 whx = Simd::simdMadd(
+        _mm_and_ps(m00, absMask), hx,
+        Simd::simdMadd(_mm_and_ps(m10, absMask), hy,
+                       _mm_mul_ps(_mm_and_ps(m20, absMask), hz)));
+    const __m128 why = Simd::simdMadd(
+        _mm_and_ps(m01, absMask), hx,
+        Simd::simdMadd(_mm_and_ps(m11, absMask), hy,
+                       _mm_mul_ps(_mm_and_ps(m21, absMask), hz)));
+    const __m128 whz = Simd::simdMadd(
+        _mm_and_ps(m02, absMask), hx,
+        Simd::simdMadd(_mm_and_ps(m12, absMask), hy,
+                       _mm_mul_ps(_mm_and_ps(m22, absMask), hz)));
+
+    const __m128 r = _mm_sqrt_ps(Simd::simdMadd(
+        whx, whx, Simd::simdMadd(why, why, _mm_mul_ps(whz, whz))));
+
+    _mm_store_ps(centerX, wcx);
+    _mm_store_ps(centerY, wcy);
+    _mm_store_ps(centerZ, wcz);
+    _mm_store_ps(halfExtentX, whx);
+    _mm_store_ps(halfExtentY, why);
+    _mm_store_ps(halfExtentZ, whz);
+    _mm_store_ps(radius, r);
+
+    storeBounds(p_Batch, i, 4u, centerX, centerY, centerZ, halfExtentX,
+                halfExtentY, halfExtentZ, radius);
+  }
+
+  for (; i < p_Batch.count; ++i)
+  {
+    computeSingle(p_Batch, i);
+  }
+}
+
+// <-
+
+_INTR_TARGET_AVX2 void computeAvx2(const Batch& p_Batch)
+{
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 two = _mm256_set1_ps(2.0f);
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+  alignas(32) float centerX[8u], centerY[8u], centerZ[8u];
+  alignas(32) float halfExtentX[8u], halfExtentY[8u], halfExtentZ[8u];
+  alignas(32) float radius[8u];
+
+  uint32_t i = 0u;
+  for (; i + 8u <= p_Batch.count; i += 8u)
+  {
+    const __m256 px = _mm256_load_ps(&p_Batch.posX[i]);
+    const __m256 py = _mm256_load_ps(&p_Batch.posY[i]);
+    const __m256 pz = _mm256_load_ps(&p_Batch.posZ[i]);
+    const __m256 qx = _mm256_load_ps(&p_Batch.rotX[i]);
+    const __m256 qy = _mm256_load_ps(&p_Batch.rotY[i]);
+    const __m256 qz = _mm256_load_ps(&p_Batch.rotZ[i]);
+    const __m256 qw = _mm256_load_ps(&p_Batch.rotW[i]);
+    const __m256 sx = _mm256_load_ps(&p_Batch.sizeX[i]);
+    const __m256 sy = _mm256_load_ps(&p_Batch.sizeY[i]);
+    const __m256 sz = _mm256_load_ps(&p_Batch.sizeZ[i]);
+
+    // Rotation matrix from the quaternion
+    const __m256 qx2 = _mm256_mul_ps(qx, two);
+    const __m256 qy2 = _mm256_mul_ps(qy, two);
+    const __m256 qz2 = _mm256_mul_ps(qz, two);
+    const __m256 xx = _mm256_mul_ps(qx, qx2);
+    const __m256 yy = _mm256_mul_ps(qy, qy2);
+    const __m256 zz = _mm256_mul_ps(qz, qz2);
+    const __m256 xy = _mm256_mul_ps(qx, qy2);
+    const __m256 xz = _mm256_mul_ps(qx, qz2);
+    const __m256 yz = _mm256_mul_ps(qy, qz2);
+    const __m256 wx = _mm256_mul_ps(qw, qx2);
+    const __m256 wy = _mm256_mul_ps(qw, qy2);
+    const __m256 wz = _mm256_mul_ps(qw, qz2);
+
+    const __m256 r00 = _mm256_sub_ps(one, _mm256_add_ps(yy, zz));
+    const __m256 r01 = _mm256_add_ps(xy, wz);
+    const __m256 r02 = _mm256_sub_ps(xz, wy);
+    const __m256 r10 = _mm256_sub_ps(xy, wz);
+    const __m256 r11 = _mm256_sub_ps(one, _mm256_add_ps(xx, zz));
+    const __m256 r12 = _mm256_add_ps(yz, wx);
+    const __m256 r20 = _mm256_add_ps(xz, wy);
+    const __m256 r21 = _mm256_sub_ps(yz, wx);
+    const __m256 r22 = _mm256_sub_ps(one, _mm256_add_ps(xx, yy));
+
+    // World matrix = translation * rotation * scale
+    const __m256 m00 = _mm256_mul_ps(r00, sx);
+    const __m256 m01 = _mm256_mul_ps(r01, sx);
+    const __m256 m02 = _mm256_mul_ps(r02, sx);
+    const __m256 m10 = _mm256_mul_ps(r10, sy);
+    const __m256 m11 = _mm256_mul_ps(r11, sy);
+    const __m256 m12 = _mm256_mul_ps(r12, sy);
+    const __m256 m20 = _mm256_mul_ps(r20, sz);
+    const __m256 m21 = _mm256_mul_ps(r21, sz);
+    const __m256 m22 = _mm256_mul_ps(r22, sz);
+
+    glm::mat4* const* worldMatrices = &p_Batch.worldMatrix[i];
+    storeColumnAvx2(worldMatrices, 0u, m00, m01, m02, zero);
+    storeColumnAvx2(worldMatrices, 1u, m10, m11, m12, zero);
+    storeColumnAvx2(worldMatrices, 2u, m20, m21, m22, zero);
+    storeColumnAvx2(worldMatrices, 3u, px, py, pz, one);
+
+    // Closed form inverse: inverse scale * transposed rotation * -translation
+    const __m256 isx = _mm256_div_ps(one, sx);
+    const __m256 isy = _mm256_div_ps(one, sy);
+    const __m256 isz = _mm256_div_ps(one, sz);
+
+    const __m256 i00 = _mm256_mul_ps(r00, isx);
+    const __m256 i01 = _mm256_mul_ps(r10, isy);
+    const __m256 i02 = _mm256_mul_ps(r20, isz);
+    const __m256 i10 = _mm256_mul_ps(r01, isx);
+    const __m256 i11 = _mm256_mul_ps(r11, isy);
+    const __m256 i12 = _mm256_mul_ps(r21, isz);
+    const __m256 i20 = _mm256_mul_ps(r02, isx);
+    const __m256 i21 = _mm256_mul_ps(r12, isy);
+    const __m256 i22 = _mm256_mul_ps(r22, isz);
+
+    const __m256 i30 = _mm256_sub_ps(
+        zero, _mm256_fmadd_ps(
+                  i00, px,
+                  _mm256_fmadd_ps(i10, py, _mm256_mul_ps(i20, pz))));
+    const __m256 i31 = _mm256_sub_ps(
+        zero, _mm256_fmadd_ps(
+                  i01, px,
+                  _mm256_fmadd_ps(i11, py, _mm256_mul_ps(i21, pz))));
+    const __m256 i32 = _mm256_sub_ps(
+        zero, _mm256_fmadd_ps(
+                  i02, px,
+                  _mm256_fmadd_ps(i12, py, _mm256_mul_ps(i22, pz))));
+
+    glm::mat4* const* inverseWorldMatrices = &p_Batch.inverseWorldMatrix[i];
+    storeColumnAvx2(inverseWorldMatrices, 0u, i00, i01, i02, zero);
+    storeColumnAvx2(inverseWorldMatrices, 1u, i10, i11, i12, zero);
+    storeColumnAvx2(inverseWorldMatrices, 2u, i20, i21, i22, zero);
+    storeColumnAvx2(inverseWorldMatrices, 3u, i30, i31, i32, one);
+
+    // World space AABB and bounding sphere
+    const __m256 cx = _mm256_load_ps(&p_Batch.centerX[i]);
+    const __m256 cy = _mm256_load_ps(&p_Batch.centerY[i]);
+    const __m256 cz = _mm256_load_ps(&p_Batch.centerZ[i]);
+    const __m256 hx = _mm256_load_ps(&p_Batch.halfExtentX[i]);
+    const __m256 hy = _mm256_load_ps(&p_Batch.halfExtentY[i]);
+    const __m256 hz = _mm256_load_ps(&p_Batch.halfExtentZ[i]);
+
+    const __m256 wcx = _mm256_fmadd_ps(
+        m00, cx, _mm256_fmadd_ps(m10, cy, _mm256_fmadd_ps(m20, cz, px)));
+    const __m256 wcy = _mm256_fmadd_ps(
+        m01, cx, _mm256_fmadd_ps(m11, cy, _mm256_fmadd_ps(m21, cz, py)));
+    const __m256 wcz = _mm256_fmadd_ps(
+        m02, cx, _mm256_fmadd_ps(m12, cy, _mm256_fmadd_ps(m22, cz, pz)));
+
+    const __m256 whx = _mm256_fmadd_ps(
+        _mm256_and_ps(m00, absMask), hx,
+        _mm256_fmadd_ps(_mm256_and_ps(m10, absMask), hy,
+                        _mm256_mul_ps(_mm256_and_ps(m20, absMask), hz)));
+    const __m256 why = _mm256_fmadd_ps(
+        _mm256_and_ps(m01, absMask), hx,
+        _mm256_fmadd_ps(_mm256_and_ps(m11, absMask), hy,
+                        _mm256_mul_ps(_mm256_and_ps(m21, absMask), hz)));
+    const __m256 whz = _mm256_fmadd_ps(
+        _mm256_and_ps(m02, absMask), hx,
+        _mm256_fmadd_ps(_mm256_and_ps(m12, absMask), hy,
+                        _mm256_mul_ps(_mm256_and_ps(m22, absMask), hz)));
+
+    const __m256 r = _mm256_sqrt_ps(_mm256_fmadd_ps(
+        whx, whx, _mm256_fmadd_ps(why, why, _mm256_mul_ps(whz, whz))));
+
+    _mm256_store_ps(centerX, wcx);
+    _mm256_store_ps(centerY, wcy);
+    _mm256_store_ps(centerZ, wcz);
+    _mm256_store_ps(halfExtentX, whx);
+    _mm256_store_ps(halfExtentY, why);
+    _mm256_store_ps(halfExtentZ, whz);
+    _mm256_store_ps(radius, r);
+
+    storeBounds(p_Batch, i, 8u, centerX, centerY, centerZ, halfExtentX,
+                halfExtentY, halfExtentZ, radius);
+  }
+
+  for (; i < p_Batch.count; ++i)
+  {
+    computeSingle(p_Batch, i);
+  }
+}
+
+// <-
+
+KernelFunction getKernel()
+{
+  static const KernelFunction kernel = selectKernel();
+  return kernel;
+}
+}
+}
+}
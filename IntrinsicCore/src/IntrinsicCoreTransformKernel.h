@@ -0,0 +1,164 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace Intrinsic
+{
+namespace Core
+{
+namespace TransformKernel
+{
+enum
+{
+  kMaxBatchSize = 64u
+};
+
+// <-
+
+/**
+ * A batch of world space transformations to compute the world matrices,
+ * inverse world matrices and bounds for. The inputs are stored as SoA so
+ * multiple transformations can be processed with a single instruction.
+ */
+struct Batch
+{
+  Batch() : count(0u) {}
+
+  /**
+   * Adds a transformation to the batch. The bounds are only computed if
+   * p_LocalAABB is not null.
+   */
+  _INTR_INLINE void add(const glm::vec3& p_Position,
+                        const glm::quat& p_Orientation,
+                        const glm::vec3& p_Size, const Math::AABB* p_LocalAABB,
+                        glm::mat4* p_WorldMatrix,
+                        glm::mat4* p_InverseWorldMatrix,
+                        Math::AABB* p_WorldAABB,
+                        Math::Sphere* p_WorldBoundingSphere)
+  {
+    _INTR_ASSERT(count < kMaxBatchSize);
+
+    posX[count] = p_Position.x;
+    posY[count] = p_Position.y;
+    posZ[count] = p_Position.z;
+    rotX[count] = p_Orientation.x;
+    rotY[count] = p_Orientation.y;
+    rotZ[count] = p_Orientation.z;
+    rotW[count] = p_Orientation.w;
+    sizeX[count] = p_Size.x;
+    sizeY[count] = p_Size.y;
+    sizeZ[count] = p_Size.z;
+
+    if (p_LocalAABB != nullptr)
+    {
+      const glm::vec3 center = Math::calcAABBCenter(*p_LocalAABB);
+      const glm::vec3 halfExtent = Math::calcAABBHalfExtent(*p_LocalAABB);
+
+      centerX[count] = center.x;
+      centerY[count] = center.y;
+      centerZ[count] = center.z;
+      halfExtentX[count] = halfExtent.x;
+      halfExtentY[count] = halfExtent.y;
+      halfExtentZ[count] = halfExtent.z;
+
+      worldAABB[count] = p_WorldAABB;
+      worldBoundingSphere[count] = p_WorldBoundingSphere;
+    }
+    else
+    {
+      centerX[count] = centerY[count] = centerZ[count] = 0.0f;
+      halfExtentX[count] = halfExtentY[count] = halfExtentZ[count] = 0.0f;
+
+      worldAABB[count] = nullptr;
+      worldBoundingSphere[count] = nullptr;
+    }
+
+    worldMatrix[count] = p_WorldMatrix;
+    inverseWorldMatrix[count] = p_InverseWorldMatrix;
+
+    ++count;
+  }
+
+  // Inputs
+  alignas(32) float posX[kMaxBatchSize];
+  alignas(32) float posY[kMaxBatchSize];
+  alignas(32) float posZ[kMaxBatchSize];
+  alignas(32) float rotX[kMaxBatchSize];
+  alignas(32) float rotY[kMaxBatchSize];
+  alignas(32) float rotZ[kMaxBatchSize];
+  alignas(32) float rotW[kMaxBatchSize];
+  alignas(32) float sizeX[kMaxBatchSize];
+  alignas(32) float sizeY[kMaxBatchSize];
+  alignas(32) float sizeZ[kMaxBatchSize];
+  alignas(32) float centerX[kMaxBatchSize];
+  alignas(32) float centerY[kMaxBatchSize];
+  alignas(32) float centerZ[kMaxBatchSize];
+  alignas(32) float halfExtentX[kMaxBatchSize];
+  alignas(32) float halfExtentY[kMaxBatchSize];
+  alignas(32) float halfExtentZ[kMaxBatchSize];
+
+  // Outputs
+  glm::mat4* worldMatrix[kMaxBatchSize];
+  glm::mat4* inverseWorldMatrix[kMaxBatchSize];
+  Math::AABB* worldAABB[kMaxBatchSize];
+  Math::Sphere* worldBoundingSphere[kMaxBatchSize];
+
+  uint32_t count;
+};
+
+// <-
+
+typedef void (*KernelFunction)(const Batch& p_Batch);
+
+/**
+ * Reference implementation processing a single transformation at a time.
+ */
+void computeScalar(const Batch& p_Batch);
+
+/**
+ * Processes four transformations at a time using SSE.
+ */
+void computeSse(const Batch& p_Batch);
+
+/**
+ * Processes eight transformations at a time using AVX2. Only call this if
+ * Simd::isAvx2Supported() returns true.
+ */
+void computeAvx2(const Batch& p_Batch);
+
+// <-
+
+/**
+ * Returns the fastest kernel supported by the CPU. The kernel is selected
+ * once on the first call.
+ */
+KernelFunction getKernel();
+
+// <-
+
+/**
+ * Computes the world matrices, inverse world matrices and bounds for all
+ * transformations in the batch and resets the batch afterwards.
+ */
+_INTR_INLINE void computeAndReset(Batch& p_Batch)
+{
+  static const KernelFunction kernel = getKernel();
+
+  kernel(p_Batch);
+  p_Batch.count = 0u;
+}
+}
+}
+}
@@ -80,7 +80,7 @@ Components::NodeRef World::cloneNodeFull(Components::NodeRef p_Ref)
         Components::NodeManager::_entity(referenceNodes[i]);
 
     Entity::EntityRef clonedEntityRef = Entity::EntityManager::createEntity(
-        Entity::EntityManager::_name(referenceEntityRef).getString().c_str());
+        Entity::EntityManager::_name(referenceEntityRef).c_str());
 
     for (auto propCompIt =
              Application::_componentPropertyCompilerMapping.begin();
@@ -88,7 +88,7 @@ Components::NodeRef World::cloneNodeFull(Components::NodeRef p_Ref)
          ++propCompIt)
     {
       rapidjson::Value componentType = rapidjson::Value(
-          propCompIt->first.getString().c_str(), doc.GetAllocator());
+          propCompIt->first.c_str(), doc.GetAllocator());
 
       auto compManagerEntryIt =
           Application::_componentManagerMapping.find(componentType.GetString());
@@ -304,7 +304,7 @@ void World::saveNodeHierarchy(const _INTR_STRING& p_FilePath,
     {
       rapidjson::Value node = rapidjson::Value(rapidjson::kObjectType);
       rapidjson::Value name = rapidjson::Value(
-          Entity::EntityManager::_name(entityRef).getString().c_str(),
+          Entity::EntityManager::_name(entityRef).c_str(),
           saveDesc.GetAllocator());
 
       node.AddMember("name", name, saveDesc.GetAllocator());
@@ -324,7 +324,7 @@ void World::saveNodeHierarchy(const _INTR_STRING& p_FilePath,
            ++propCompIt)
       {
         rapidjson::Value componentType = rapidjson::Value(
-            propCompIt->first.getString().c_str(), saveDesc.GetAllocator());
+            propCompIt->first.c_str(), saveDesc.GetAllocator());
 
         auto compManagerEntryIt = Application::_componentManagerMapping.find(
             componentType.GetString());
@@ -64,6 +64,7 @@
 #include <limits>
 #include <vector>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <ctime>
 #include <fstream>
@@ -71,6 +72,7 @@
 #include <algorithm>
 #include <cfloat>
 #include <cmath>
+#include <immintrin.h>
 #include <thread>
 #include <mutex>
 
@@ -84,6 +86,7 @@
 // STL allocator include
 #include "IntrinsicCoreTlsfAllocator.h"
 #include "IntrinsicCoreStlAllocator.h"
+#include "IntrinsicCoreFrameAllocator.h"
 
 // Lua related includes
 extern "C" {
@@ -152,17 +155,24 @@ namespace CComponents = Intrinsic::Core::Components;
 
 // Core related includes
 #include "IntrinsicCoreTriangleOptimizer.h"
+#include "IntrinsicCoreMeshSimplifier.h"
 #include "IntrinsicCoreSettingsManager.h"
 #include "IntrinsicCoreLockFreeStack.h"
+#include "IntrinsicCoreLockFreeMpscQueue.h"
+#include "IntrinsicCorePagedArray.h"
 #include "IntrinsicCoreLinearOffsetAllocator.h"
+#include "IntrinsicCoreFreeListOffsetAllocator.h"
 #include "IntrinsicCoreLockFreeFixedBlockAllocator.h"
 #include "IntrinsicCoreStringUtil.h"
 #include "IntrinsicCoreUtil.h"
 #include "IntrinsicCoreSimd.h"
 #include "IntrinsicCoreMath.h"
+#include "IntrinsicCoreTransformKernel.h"
+#include "IntrinsicCoreCullingKernel.h"
 #include "IntrinsicCoreName.h"
 #include "IntrinsicCoreTimingHelper.h"
 #include "IntrinsicCoreDod.h"
+#include "IntrinsicCoreDynamicAabbTree.h"
 #include "IntrinsicCoreRenderingIBL.h"
 #include "IntrinsicCoreJsonHelper.h"
 #include "IntrinsicCoreEntity.h"
@@ -176,6 +186,7 @@ namespace CComponents = Intrinsic::Core::Components;
 #include "IntrinsicCoreResourcesMesh.h"
 #include "IntrinsicCoreComponentsNode.h"
 #include "IntrinsicCoreComponentsMesh.h"
+#include "IntrinsicCoreOcclusionCulling.h"
 #include "IntrinsicCoreComponentsSwarm.h"
 #include "IntrinsicCoreComponentsRigidBody.h"
 #include "IntrinsicCoreComponentsCamera.h"
@@ -192,6 +203,7 @@ namespace CComponents = Intrinsic::Core::Components;
 #include "IntrinsicCoreComponentsPostEffectVolume.h"
 #include "IntrinsicCoreRenderingSkyModel.h"
 
+#include "IntrinsicCoreTaskGraph.h"
 #include "IntrinsicCoreTaskManager.h"
 #include "IntrinsicCorePhysicsSystem.h"
 #include "IntrinsicCoreInputSystem.h"
@@ -203,6 +215,7 @@ namespace CComponents = Intrinsic::Core::Components;
 #include "IntrinsicCoreResourcesScript.h"
 #include "IntrinsicCoreComponentsScript.h"
 #include "IntrinsicCorePhysicsHelper.h"
+#include "IntrinsicCoreMicroBenchmarks.h"
 
 // Renderer includes
 #include "stdafx_renderer.h"
@@ -55,6 +55,7 @@
 #include "IntrinsicRendererResourcesMaterial.h"
 #include "IntrinsicRendererUniformManager.h"
 #include "IntrinsicRendererMaterialBuffer.h"
+#include "IntrinsicRendererMeshBufferPool.h"
 #include "IntrinsicRendererRenderPassBase.h"
 #include "IntrinsicRendererResourcesDrawCall.h"
 #include "IntrinsicRendererResourcesComputeCall.h"
@@ -67,4 +68,7 @@
 #include "IntrinsicRendererRenderPassClustering.h"
 #include "IntrinsicRendererRenderPassBloom.h"
 #include "IntrinsicRendererRenderPassPerPixelPicking.h"
+#include "IntrinsicRendererGpuCulling.h"
+#include "IntrinsicRendererInstancing.h"
+#include "IntrinsicRendererTransformBuffer.h"
 #include "IntrinsicRendererDrawCallDispatcher.h"
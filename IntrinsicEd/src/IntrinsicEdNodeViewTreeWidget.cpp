@@ -101,7 +101,7 @@ void IntrinsicEdNodeViewTreeWidget::onPopulateNodeTree()
     const Name& name = Entity::EntityManager::_name(entityRef);
 
     QTreeWidgetItem* item = nullptr;
-    QString nodeTitle = name.getString().c_str();
+    QString nodeTitle = name.c_str();
 
     if (!Components::NodeManager::_parent(nodeRef).isValid())
     {
@@ -133,7 +133,7 @@ void IntrinsicEdNodeViewTreeWidget::onPopulateNodeTree()
         Dod::Components::ComponentManagerEntry& entry = it->second;
         if (entry.getComponentForEntityFunction(entityRef).isValid())
         {
-          iconToUse = IntrinsicEd::getIcon(compName.getString());
+          iconToUse = IntrinsicEd::getIcon(_INTR_STRING(compName.getString()));
           break;
         }
       }
@@ -177,7 +177,7 @@ void IntrinsicEdNodeViewTreeWidget::createAddComponentContextMenu(QMenu* p_Menu)
     for (auto it = Application::_componentManagerMapping.begin();
          it != Application::_componentManagerMapping.end(); ++it)
     {
-      const _INTR_STRING& compName = it->first.getString();
+      const Name& compName = it->first;
       Dod::Components::ComponentManagerEntry& entry = it->second;
       sortedComponents[compName.c_str()] = &entry;
     }
@@ -216,7 +216,7 @@ void IntrinsicEdNodeViewTreeWidget::createRemoveComponentContextMenu(
     for (auto it = Application::_componentManagerMapping.begin();
          it != Application::_componentManagerMapping.end(); ++it)
     {
-      const _INTR_STRING& compName = it->first.getString();
+      const Name& compName = it->first;
       Dod::Components::ComponentManagerEntry& entry = it->second;
       sortedComponents[compName.c_str()] = &entry;
     }
@@ -415,7 +415,6 @@ void IntrinsicEdNodeViewTreeWidget::createNode(QTreeWidgetItem* p_Parent)
 
       item->setText(0, Entity::EntityManager::_name(
                            Components::NodeManager::_entity(nodeRef))
-                           .getString()
                            .c_str());
       item->setIcon(0, QIcon(":/Icons/target"));
     }
@@ -427,7 +426,6 @@ void IntrinsicEdNodeViewTreeWidget::createNode(QTreeWidgetItem* p_Parent)
 
       item->setText(0, Entity::EntityManager::_name(
                            Components::NodeManager::_entity(nodeRef))
-                           .getString()
                            .c_str());
       item->setIcon(0, QIcon(":/Icons/globe"));
     }
@@ -492,7 +490,8 @@ void IntrinsicEdNodeViewTreeWidget::onSaveNodeAsPrefab()
 
   const _INTR_STRING fileName =
       "media/prefabs/" +
-      Entity::EntityManager::_name(currentEntity).getString() + ".prefab.json";
+      _INTR_STRING(Entity::EntityManager::_name(currentEntity).getString()) +
+      ".prefab.json";
 
   const QString filePath =
       QFileDialog::getSaveFileName(this, tr("Save Prefab"), fileName.c_str(),
@@ -619,7 +618,7 @@ void IntrinsicEdNodeViewTreeWidget::onItemChanged(QTreeWidgetItem* item,
       {
         Entity::EntityManager::rename(entityRef, newName);
         item->setText(
-            0, Entity::EntityManager::_name(entityRef).getString().c_str());
+            0, Entity::EntityManager::_name(entityRef).c_str());
       }
     }
   }
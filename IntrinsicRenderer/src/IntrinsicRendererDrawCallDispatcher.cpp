@@ -21,106 +21,297 @@ namespace Renderer
 {
 namespace
 {
-struct DrawCallParallelTaskSet : enki::ITaskSet
+void recordDrawCallRange(VkCommandBuffer p_CommandBuffer,
+                         const Resources::DrawCallRefFrameArray& p_DrawCalls,
+                         uint32_t p_RangeStart, uint32_t p_RangeEnd,
+                         const InstancedDrawArray* p_InstancedDraws,
+                         const IndirectDrawArray* p_IndirectDraws)
 {
-  void ExecuteRange(enki::TaskSetPartition p_Range, uint32_t p_ThreadNum)
+  // Secondary command buffers start without any bound state, so the state is
+  // tracked per command buffer and only the changes are recorded
+  VkPipeline currentPipeline = VK_NULL_HANDLE;
+  VkPipelineLayout currentPipelineLayout = VK_NULL_HANDLE;
+  VkDescriptorSet currentDescSet = VK_NULL_HANDLE;
+  uint32_t currentMaterialBufferEntryIdx = (uint32_t)-1;
+  const _INTR_ARRAY(uint32_t)* currentDynamicOffsets = nullptr;
+  const _INTR_ARRAY(VkBuffer)* currentVtxBuffers = nullptr;
+  const _INTR_ARRAY(VkDeviceSize)* currentVtxBufferOffsets = nullptr;
+  VkBuffer currentIndexBuffer = VK_NULL_HANDLE;
+  VkDeviceSize currentIndexBufferOffset = 0u;
+  VkIndexType currentIndexType = VK_INDEX_TYPE_MAX_ENUM;
+
+  uint32_t pipelineBindCount = 0u;
+  uint32_t descriptorSetBindCount = 0u;
+  uint32_t vertexBufferBindCount = 0u;
+  uint32_t indexBufferBindCount = 0u;
+
+  for (uint32_t dcIdx = p_RangeStart; dcIdx < p_RangeEnd; ++dcIdx)
   {
-    _INTR_PROFILE_CPU("General", "Dispatch Draw Calls Job");
-
-    RenderSystem::beginSecondaryCommandBuffer(
-        _secondaryCmdBufferIdx,
-        Resources::RenderPassManager::_vkRenderPass(_renderPassRef),
-        Resources::FramebufferManager::_vkFrameBuffer(_framebufferRef));
+    Resources::DrawCallRef drawCallRef = p_DrawCalls[dcIdx];
+    _INTR_ASSERT(Resources::DrawCallManager::isAlive(drawCallRef));
+
+    Resources::PipelineRef pipelineRef =
+        Resources::DrawCallManager::_descPipeline(drawCallRef);
+    uint32_t instanceCount =
+        Resources::DrawCallManager::_descInstanceCount(drawCallRef);
+    uint32_t firstInstance = 0u;
+    const IndirectDraw* indirectDraw =
+        p_IndirectDraws != nullptr &&
+                (*p_IndirectDraws)[dcIdx].maxDrawCount > 0u
+            ? &(*p_IndirectDraws)[dcIdx]
+            : nullptr;
+
+    // Indirect draws fetch their node ids from the mesh instances as well
+    bool instanced = indirectDraw != nullptr;
+    if (p_InstancedDraws != nullptr &&
+        (*p_InstancedDraws)[dcIdx].instanceCount > 0u)
+    {
+      instanceCount = (*p_InstancedDraws)[dcIdx].instanceCount;
+      firstInstance = (*p_InstancedDraws)[dcIdx].firstInstance;
+      instanced = true;
+    }
 
-    VkCommandBuffer secondCmdBuffer =
-        *RenderSystem::getSecondaryCommandBuffers(_secondaryCmdBufferIdx);
+    if (instanced)
+    {
+      const Resources::MaterialPass::MaterialPass& materialPass =
+          Resources::MaterialManager::_materialPasses
+              [Resources::DrawCallManager::_descMaterialPass(drawCallRef)];
 
-    VkPipeline currentPipeline = VK_NULL_HANDLE;
+      // Shares the pipeline layout with the regular pipeline
+      pipelineRef = Resources::MaterialManager::_materialPassPipelines
+          [materialPass.instancedPipelineIdx];
+    }
 
-    for (uint32_t dcIdx = _rangeStart; dcIdx < _rangeEnd; ++dcIdx)
+    VkPipeline newPipeline =
+        Resources::PipelineManager::_vkPipeline(pipelineRef);
+    if (newPipeline != currentPipeline)
     {
-      Resources::DrawCallRef drawCallRef = (*_visibleDrawCallRefs)[dcIdx];
-      _INTR_ASSERT(Resources::DrawCallManager::isAlive(drawCallRef));
+      vkCmdBindPipeline(p_CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+                        newPipeline);
+      currentPipeline = newPipeline;
+      ++pipelineBindCount;
+    }
 
-      Resources::PipelineRef pipelineRef =
-          Resources::DrawCallManager::_descPipeline(drawCallRef);
+    // Bind descriptor sets
+    {
       Resources::PipelineLayoutRef pipelineLayoutRef =
           Resources::PipelineManager::_descPipelineLayout(pipelineRef);
+      VkPipelineLayout newPipelineLayout =
+          Resources::PipelineLayoutManager::_vkPipelineLayout(
+              pipelineLayoutRef);
+      VkDescriptorSet newDescSet =
+          Resources::DrawCallManager::_vkDescriptorSet(drawCallRef);
+      const _INTR_ARRAY(uint32_t)& newDynamicOffsets =
+          Resources::DrawCallManager::_dynamicOffsets(drawCallRef);
+      _INTR_ASSERT(newDescSet);
+
+      // Switching the layout invalidates the bound sets
+      if (newPipelineLayout != currentPipelineLayout)
+      {
+        vkCmdBindDescriptorSets(
+            p_CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, newPipelineLayout,
+            1u, 1u, &Resources::ImageManager::_globalTextureDescriptorSet, 0u,
+            nullptr);
+        currentPipelineLayout = newPipelineLayout;
+        currentDescSet = VK_NULL_HANDLE;
+        currentMaterialBufferEntryIdx = (uint32_t)-1;
+        ++descriptorSetBindCount;
+      }
 
-      VkPipeline newPipeline =
-          Resources::PipelineManager::_vkPipeline(pipelineRef);
-      if (newPipeline != currentPipeline)
+      // Bindless material passes receive the material buffer entry as their
+      // only push constant
+      if (Resources::PipelineLayoutManager::_descPushConstantSizeInBytes(
+              pipelineLayoutRef) > 0u)
       {
-        vkCmdBindPipeline(secondCmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-                          newPipeline);
-        currentPipeline = newPipeline;
+        const uint32_t materialBufferEntryIdx =
+            Resources::DrawCallManager::_descMaterialBufferEntryIdx(
+                drawCallRef);
+
+        if (materialBufferEntryIdx != currentMaterialBufferEntryIdx)
+        {
+          vkCmdPushConstants(
+              p_CommandBuffer, newPipelineLayout,
+              Resources::PipelineLayoutManager::_descPushConstantStageFlags(
+                  pipelineLayoutRef),
+              0u, sizeof(uint32_t), &materialBufferEntryIdx);
+          currentMaterialBufferEntryIdx = materialBufferEntryIdx;
+        }
       }
 
-      VkDescriptorSet descSets[2] = {
-          Resources::DrawCallManager::_vkDescriptorSet(drawCallRef),
-          Resources::ImageManager::_globalTextureDescriptorSet};
+      if (newDescSet != currentDescSet || currentDynamicOffsets == nullptr ||
+          newDynamicOffsets.size() != currentDynamicOffsets->size() ||
+          memcmp(newDynamicOffsets.data(), currentDynamicOffsets->data(),
+                 newDynamicOffsets.size() * sizeof(uint32_t)) != 0)
+      {
+        vkCmdBindDescriptorSets(
+            p_CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, newPipelineLayout,
+            0u, 1u, &newDescSet, (uint32_t)newDynamicOffsets.size(),
+            newDynamicOffsets.data());
+        currentDescSet = newDescSet;
+        currentDynamicOffsets = &newDynamicOffsets;
+        ++descriptorSetBindCount;
+      }
+    }
 
-      _INTR_ASSERT(Resources::DrawCallManager::_vkDescriptorSet(drawCallRef));
-      vkCmdBindDescriptorSets(
-          secondCmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-          Resources::PipelineLayoutManager::_vkPipelineLayout(
-              pipelineLayoutRef),
-          0u, 2u, descSets,
-          (uint32_t)Resources::DrawCallManager::_dynamicOffsets(drawCallRef)
-              .size(),
-          Resources::DrawCallManager::_dynamicOffsets(drawCallRef).data());
+    // Bind vertex buffers, limited to the range of changed bindings
+    {
+      const _INTR_ARRAY(VkBuffer)& vtxBuffers =
+          Resources::DrawCallManager::_vertexBuffers(drawCallRef);
+      const _INTR_ARRAY(VkDeviceSize)& vtxBufferOffsets =
+          Resources::DrawCallManager::_vertexBufferOffsets(drawCallRef);
+
+      uint32_t firstChangedBinding = (uint32_t)vtxBuffers.size();
+      uint32_t lastChangedBinding = 0u;
+      for (uint32_t i = 0u; i < vtxBuffers.size(); ++i)
+      {
+        if (currentVtxBuffers == nullptr || i >= currentVtxBuffers->size() ||
+            (*currentVtxBuffers)[i] != vtxBuffers[i] ||
+            (*currentVtxBufferOffsets)[i] != vtxBufferOffsets[i])
+        {
+          firstChangedBinding = std::min(firstChangedBinding, i);
+          lastChangedBinding = i;
+        }
+      }
 
-      // Bind vertex buffers
+      if (firstChangedBinding < vtxBuffers.size())
       {
-        _INTR_ARRAY(VkBuffer)& vtxBuffers =
-            Resources::DrawCallManager::_vertexBuffers(drawCallRef);
-        vkCmdBindVertexBuffers(
-            secondCmdBuffer, 0u, (uint32_t)vtxBuffers.size(), vtxBuffers.data(),
-            Resources::DrawCallManager::_vertexBufferOffsets(drawCallRef)
-                .data());
+        vkCmdBindVertexBuffers(p_CommandBuffer, firstChangedBinding,
+                               lastChangedBinding - firstChangedBinding + 1u,
+                               &vtxBuffers[firstChangedBinding],
+                               &vtxBufferOffsets[firstChangedBinding]);
+        ++vertexBufferBindCount;
       }
 
-      // Draw
+      currentVtxBuffers = &vtxBuffers;
+      currentVtxBufferOffsets = &vtxBufferOffsets;
+    }
+
+    // Draw
+    {
+      Resources::BufferRef indexBufferRef =
+          Resources::DrawCallManager::_descIndexBuffer(drawCallRef);
+      if (indexBufferRef.isValid())
       {
-        Resources::BufferRef indexBufferRef =
-            Resources::DrawCallManager::_descIndexBuffer(drawCallRef);
-        if (indexBufferRef.isValid())
+        VkBuffer indexBuffer =
+            Resources::BufferManager::_vkBuffer(indexBufferRef);
+        const VkDeviceSize indexBufferOffset =
+            Resources::DrawCallManager::_indexBufferOffset(drawCallRef);
+        const VkIndexType indexType =
+            Resources::BufferManager::_descBufferType(indexBufferRef) ==
+                    BufferType::kIndex16
+                ? VK_INDEX_TYPE_UINT16
+                : VK_INDEX_TYPE_UINT32;
+
+        if (indexBuffer != currentIndexBuffer ||
+            indexBufferOffset != currentIndexBufferOffset ||
+            indexType != currentIndexType)
         {
-          const VkIndexType indexType =
-              Resources::BufferManager::_descBufferType(indexBufferRef) ==
-                      BufferType::kIndex16
-                  ? VK_INDEX_TYPE_UINT16
-                  : VK_INDEX_TYPE_UINT32;
-          vkCmdBindIndexBuffer(
-              secondCmdBuffer,
-              Resources::BufferManager::_vkBuffer(indexBufferRef),
-              Resources::DrawCallManager::_indexBufferOffset(drawCallRef),
-              indexType);
-          vkCmdDrawIndexed(
-              secondCmdBuffer,
-              Resources::DrawCallManager::_descIndexCount(drawCallRef),
-              Resources::DrawCallManager::_descInstanceCount(drawCallRef), 0u,
-              0u, 0u);
+          vkCmdBindIndexBuffer(p_CommandBuffer, indexBuffer, indexBufferOffset,
+                               indexType);
+          currentIndexBuffer = indexBuffer;
+          currentIndexBufferOffset = indexBufferOffset;
+          currentIndexType = indexType;
+          ++indexBufferBindCount;
+        }
+
+        if (indirectDraw != nullptr)
+        {
+          VkBuffer drawArgumentBuffer = Resources::BufferManager::_vkBuffer(
+              GpuCulling::_drawArgumentBuffer);
+          const VkDeviceSize drawArgumentOffset =
+              indirectDraw->firstDrawArgument *
+              sizeof(VkDrawIndexedIndirectCommand);
+
+          // The draw arguments of the batch have been written by the GPU
+          // culling pass
+          if (RenderSystem::_vkCmdDrawIndexedIndirectCount != nullptr)
+          {
+            RenderSystem::_vkCmdDrawIndexedIndirectCount(
+                p_CommandBuffer, drawArgumentBuffer, drawArgumentOffset,
+                Resources::BufferManager::_vkBuffer(
+                    GpuCulling::_drawCountBuffer),
+                indirectDraw->drawCountIdx * sizeof(uint32_t),
+                indirectDraw->maxDrawCount,
+                sizeof(VkDrawIndexedIndirectCommand));
+          }
+          else if (RenderSystem::_vkPhysicalDeviceFeatures.multiDrawIndirect)
+          {
+            vkCmdDrawIndexedIndirect(p_CommandBuffer, drawArgumentBuffer,
+                                     drawArgumentOffset,
+                                     indirectDraw->maxDrawCount,
+                                     sizeof(VkDrawIndexedIndirectCommand));
+          }
+          else
+          {
+            for (uint32_t i = 0u; i < indirectDraw->maxDrawCount; ++i)
+            {
+              vkCmdDrawIndexedIndirect(
+                  p_CommandBuffer, drawArgumentBuffer,
+                  drawArgumentOffset +
+                      i * sizeof(VkDrawIndexedIndirectCommand),
+                  1u, sizeof(VkDrawIndexedIndirectCommand));
+            }
+          }
         }
         else
         {
-          vkCmdDraw(secondCmdBuffer,
-                    Resources::DrawCallManager::_descVertexCount(drawCallRef),
-                    Resources::DrawCallManager::_descInstanceCount(drawCallRef),
-                    0u, 0u);
+          vkCmdDrawIndexed(
+              p_CommandBuffer,
+              Resources::DrawCallManager::_descIndexCount(drawCallRef),
+              instanceCount,
+              Resources::DrawCallManager::_descFirstIndex(drawCallRef),
+              Resources::DrawCallManager::_descVertexOffset(drawCallRef),
+              firstInstance);
         }
-
-        DrawCallDispatcher::_dispatchedDrawCallCount++;
       }
+      else
+      {
+        vkCmdDraw(
+            p_CommandBuffer,
+            Resources::DrawCallManager::_descVertexCount(drawCallRef),
+            Resources::DrawCallManager::_descInstanceCount(drawCallRef),
+            (uint32_t)Resources::DrawCallManager::_descVertexOffset(
+                drawCallRef),
+            0u);
+      }
+
+      DrawCallDispatcher::_dispatchedDrawCallCount++;
     }
+  }
+
+  DrawCallDispatcher::_pipelineBindCount += pipelineBindCount;
+  DrawCallDispatcher::_descriptorSetBindCount += descriptorSetBindCount;
+  DrawCallDispatcher::_vertexBufferBindCount += vertexBufferBindCount;
+  DrawCallDispatcher::_indexBufferBindCount += indexBufferBindCount;
+}
+
+// <-
+
+struct DrawCallParallelTaskSet : enki::ITaskSet
+{
+  void ExecuteRange(enki::TaskSetPartition p_Range, uint32_t p_ThreadNum)
+  {
+    _INTR_PROFILE_CPU("General", "Dispatch Draw Calls Job");
+
+    RenderSystem::beginSecondaryCommandBuffer(
+        _secondaryCmdBufferIdx,
+        Resources::RenderPassManager::_vkRenderPass(_renderPassRef),
+        Resources::FramebufferManager::_vkFrameBuffer(_framebufferRef));
+
+    recordDrawCallRange(
+        *RenderSystem::getSecondaryCommandBuffers(_secondaryCmdBufferIdx),
+        *_visibleDrawCallRefs, _rangeStart, _rangeEnd, _instancedDraws,
+        _indirectDraws);
 
     RenderSystem::endSecondaryCommandBuffer(_secondaryCmdBufferIdx);
   }
 
   uint32_t _secondaryCmdBufferIdx;
-  Resources::DrawCallRefArray* _visibleDrawCallRefs;
+  Resources::DrawCallRefFrameArray* _visibleDrawCallRefs;
   Resources::FramebufferRef _framebufferRef;
   Resources::RenderPassRef _renderPassRef;
+  const InstancedDrawArray* _instancedDraws;
+  const IndirectDrawArray* _indirectDraws;
 
   uint32_t _rangeStart;
   uint32_t _rangeEnd;
@@ -131,18 +322,28 @@ uint32_t _activeTaskCount = 0u;
 }
 
 std::atomic<uint32_t> DrawCallDispatcher::_dispatchedDrawCallCount;
+std::atomic<uint32_t> DrawCallDispatcher::_pipelineBindCount;
+std::atomic<uint32_t> DrawCallDispatcher::_descriptorSetBindCount;
+std::atomic<uint32_t> DrawCallDispatcher::_vertexBufferBindCount;
+std::atomic<uint32_t> DrawCallDispatcher::_indexBufferBindCount;
 uint32_t DrawCallDispatcher::_totalDispatchedDrawCallCountPerFrame = 0u;
 uint32_t DrawCallDispatcher::_totalDispatchCallsPerFrame = 0u;
+uint32_t DrawCallDispatcher::_totalBindCountPerFrame = 0u;
 
 // <-
 
-void DrawCallDispatcher::queueDrawCalls(Core::Dod::RefArray& p_DrawCalls,
-                                        Core::Dod::Ref p_RenderPass,
-                                        Core::Dod::Ref p_Framebuffer)
+void DrawCallDispatcher::queueDrawCalls(
+    Core::Dod::RefFrameArray& p_DrawCalls, Core::Dod::Ref p_RenderPass,
+    Core::Dod::Ref p_Framebuffer, const InstancedDrawArray* p_InstancedDraws,
+    const IndirectDrawArray* p_IndirectDraws)
 {
   _INTR_PROFILE_CPU("General", "Queue Draw Calls");
 
   _dispatchedDrawCallCount = 0u;
+  _pipelineBindCount = 0u;
+  _descriptorSetBindCount = 0u;
+  _vertexBufferBindCount = 0u;
+  _indexBufferBindCount = 0u;
   const uint32_t dcCount = (uint32_t)p_DrawCalls.size();
 
   if (dcCount == 0u)
@@ -168,6 +369,14 @@ void DrawCallDispatcher::queueDrawCalls(Core::Dod::RefArray& p_DrawCalls,
     DrawCallParallelTaskSet& task = _tasks[_activeTaskCount];
     task._framebufferRef = p_Framebuffer;
     task._renderPassRef = p_RenderPass;
+    task._instancedDraws =
+        p_InstancedDraws != nullptr && !p_InstancedDraws->empty()
+            ? p_InstancedDraws
+            : nullptr;
+    task._indirectDraws =
+        p_IndirectDraws != nullptr && !p_IndirectDraws->empty()
+            ? p_IndirectDraws
+            : nullptr;
     task._visibleDrawCallRefs = &p_DrawCalls;
     task._rangeStart = dcCount - dcRangeLeft;
     task._rangeEnd = task._rangeStart + dcsPerBatch;
@@ -195,20 +404,46 @@ void DrawCallDispatcher::queueDrawCalls(Core::Dod::RefArray& p_DrawCalls,
   }
 
   _totalDispatchedDrawCallCountPerFrame += _dispatchedDrawCallCount;
+  _totalBindCountPerFrame += _pipelineBindCount + _descriptorSetBindCount +
+                             _vertexBufferBindCount + _indexBufferBindCount;
   ++_totalDispatchCallsPerFrame;
 }
 
 // <-
 
+void DrawCallDispatcher::recordDrawCalls(
+    Core::Dod::RefFrameArray& p_DrawCalls, VkCommandBuffer p_CommandBuffer)
+{
+  _INTR_PROFILE_CPU("General", "Record Draw Calls");
+
+  _dispatchedDrawCallCount = 0u;
+  _pipelineBindCount = 0u;
+  _descriptorSetBindCount = 0u;
+  _vertexBufferBindCount = 0u;
+  _indexBufferBindCount = 0u;
+
+  recordDrawCallRange(p_CommandBuffer, p_DrawCalls, 0u,
+                      (uint32_t)p_DrawCalls.size(), nullptr, nullptr);
+
+  _totalDispatchedDrawCallCountPerFrame += _dispatchedDrawCallCount;
+  _totalBindCountPerFrame += _pipelineBindCount + _descriptorSetBindCount +
+                             _vertexBufferBindCount + _indexBufferBindCount;
+}
+
+// <-
+
 void DrawCallDispatcher::onFrameEnded()
 {
   _INTR_PROFILE_COUNTER_SET("Total Dispatched Draw Calls",
                             _totalDispatchedDrawCallCountPerFrame);
   _INTR_PROFILE_COUNTER_SET("Total Draw Call Dispatch Calls",
                             _totalDispatchCallsPerFrame);
+  _INTR_PROFILE_COUNTER_SET("Total Draw Call State Binds",
+                            _totalBindCountPerFrame);
 
   _totalDispatchCallsPerFrame = 0u;
   _totalDispatchedDrawCallCountPerFrame = 0u;
+  _totalBindCountPerFrame = 0u;
   _activeTaskCount = 0u;
 }
 }
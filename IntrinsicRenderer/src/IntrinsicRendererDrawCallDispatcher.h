@@ -21,13 +21,28 @@ namespace Renderer
 struct DrawCallDispatcher
 {
   static void onFrameEnded();
-  static void queueDrawCalls(Core::Dod::RefArray& p_DrawCalls,
-                             Core::Dod::Ref p_RenderPass,
-                             Core::Dod::Ref p_Framebuffer);
+  static void queueDrawCalls(
+      Core::Dod::RefFrameArray& p_DrawCalls, Core::Dod::Ref p_RenderPass,
+      Core::Dod::Ref p_Framebuffer,
+      const InstancedDrawArray* p_InstancedDraws = nullptr,
+      const IndirectDrawArray* p_IndirectDraws = nullptr);
+
+  /**
+   * Records the draw calls into the given secondary command buffer on the
+   * calling thread. Used for command buffers which are kept across frames.
+   */
+  static void recordDrawCalls(Core::Dod::RefFrameArray& p_DrawCalls,
+                              VkCommandBuffer p_CommandBuffer);
 
   static std::atomic<uint32_t> _dispatchedDrawCallCount;
+  // State changes recorded by the last call to queueDrawCalls
+  static std::atomic<uint32_t> _pipelineBindCount;
+  static std::atomic<uint32_t> _descriptorSetBindCount;
+  static std::atomic<uint32_t> _vertexBufferBindCount;
+  static std::atomic<uint32_t> _indexBufferBindCount;
   static uint32_t _totalDispatchedDrawCallCountPerFrame;
   static uint32_t _totalDispatchCallsPerFrame;
+  static uint32_t _totalBindCountPerFrame;
 };
 }
 }
@@ -150,7 +150,8 @@ enum Enum
   kIndex16,
   kIndex32,
   kUniform,
-  kStorage
+  kStorage,
+  kIndirect
 };
 }
 
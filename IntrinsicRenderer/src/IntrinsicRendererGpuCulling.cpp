@@ -0,0 +1,479 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Precompiled header file
+#include "stdafx.h"
+
+#define GPU_CULLING_THREADS 64u
+#define GPU_CULLING_INITIAL_INSTANCES_PER_FRAME (_INTR_MAX_DRAW_CALL_COUNT * 4u)
+
+using namespace RResources;
+
+namespace Intrinsic
+{
+namespace Renderer
+{
+struct PerInstanceDataGpuCulling
+{
+  uint32_t data[4];
+  glm::vec4 frustumPlanes[Math::FrustumPlane::kCount];
+};
+
+namespace
+{
+BufferRef _cullingInstanceBuffer;
+CullingInstance* _cullingInstanceBufferGpuMemory = nullptr;
+
+PipelineRef _cullingPipelineRef;
+ComputeCallRef _cullingComputeCallRef;
+
+// Grows if the draw calls of a frame don't fit
+uint32_t _maxInstanceCountPerFrame = GPU_CULLING_INITIAL_INSTANCES_PER_FRAME;
+uint32_t _currentInstanceCount = 0u;
+uint32_t _currentBatchCount = 0u;
+uint32_t _requiredInstanceCount = 0u;
+
+_INTR_INLINE bool isSameBatch(DrawCallRef p_Lhs, DrawCallRef p_Rhs)
+{
+  // Batches are dispatched using the bound state of their first draw call
+  return DrawCallManager::_descPipeline(p_Lhs) ==
+             DrawCallManager::_descPipeline(p_Rhs) &&
+         DrawCallManager::_descMaterial(p_Lhs) ==
+             DrawCallManager::_descMaterial(p_Rhs) &&
+         DrawCallManager::_descIndexBuffer(p_Lhs) ==
+             DrawCallManager::_descIndexBuffer(p_Rhs) &&
+         DrawCallManager::_indexBufferOffset(p_Lhs) ==
+             DrawCallManager::_indexBufferOffset(p_Rhs) &&
+         DrawCallManager::_vertexBuffers(p_Lhs) ==
+             DrawCallManager::_vertexBuffers(p_Rhs) &&
+         DrawCallManager::_vertexBufferOffsets(p_Lhs) ==
+             DrawCallManager::_vertexBufferOffsets(p_Rhs);
+}
+
+// <-
+
+void createBuffers()
+{
+  BufferRefArray buffersToCreate = {_cullingInstanceBuffer,
+                                    GpuCulling::_drawArgumentBuffer,
+                                    GpuCulling::_drawCountBuffer};
+
+  // The instances and the draw arguments of the frames in flight are kept
+  // apart. Each batch holds at least one instance
+  const uint32_t instanceCount =
+      _maxInstanceCountPerFrame * _INTR_VK_PER_INSTANCE_DATA_BUFFER_COUNT;
+
+  BufferManager::_descSizeInBytes(_cullingInstanceBuffer) =
+      instanceCount * sizeof(CullingInstance);
+  BufferManager::_descSizeInBytes(GpuCulling::_drawArgumentBuffer) =
+      instanceCount * sizeof(VkDrawIndexedIndirectCommand);
+  BufferManager::_descSizeInBytes(GpuCulling::_drawCountBuffer) =
+      instanceCount * sizeof(uint32_t);
+
+  BufferManager::createResources(buffersToCreate);
+
+  _cullingInstanceBufferGpuMemory =
+      (CullingInstance*)BufferManager::getGpuMemory(_cullingInstanceBuffer);
+}
+
+// <-
+
+void bindBuffers()
+{
+  ComputeCallManager::bindBuffer(
+      _cullingComputeCallRef, _N(PerInstance), GpuProgramType::kCompute,
+      UniformManager::_perInstanceUniformBuffer, UboType::kPerInstanceCompute,
+      sizeof(PerInstanceDataGpuCulling));
+  ComputeCallManager::bindBuffer(
+      _cullingComputeCallRef, _N(CullingInstanceBuffer),
+      GpuProgramType::kCompute, _cullingInstanceBuffer, UboType::kInvalidUbo,
+      BufferManager::_descSizeInBytes(_cullingInstanceBuffer));
+  ComputeCallManager::bindBuffer(
+      _cullingComputeCallRef, _N(DrawArgumentBuffer), GpuProgramType::kCompute,
+      GpuCulling::_drawArgumentBuffer, UboType::kInvalidUbo,
+      BufferManager::_descSizeInBytes(GpuCulling::_drawArgumentBuffer));
+  ComputeCallManager::bindBuffer(
+      _cullingComputeCallRef, _N(DrawCountBuffer), GpuProgramType::kCompute,
+      GpuCulling::_drawCountBuffer, UboType::kInvalidUbo,
+      BufferManager::_descSizeInBytes(GpuCulling::_drawCountBuffer));
+  ComputeCallManager::bindBuffer(
+      _cullingComputeCallRef, _N(TransformBuffer), GpuProgramType::kCompute,
+      TransformBuffer::_transformBuffer, UboType::kInvalidUbo,
+      BufferManager::_descSizeInBytes(TransformBuffer::_transformBuffer));
+}
+
+// <-
+
+struct CullingInstanceUpdateParallelTaskSet : enki::ITaskSet
+{
+  virtual ~CullingInstanceUpdateParallelTaskSet() {}
+
+  void ExecuteRange(enki::TaskSetPartition p_Range,
+                    uint32_t p_ThreadNum) override
+  {
+    _INTR_PROFILE_CPU("General", "Culling Instance Updt. Job");
+
+    const DrawCallRefFrameArray& drawCalls = *_drawCalls;
+
+    for (uint32_t instIdx = p_Range.start; instIdx < p_Range.end; ++instIdx)
+    {
+      DrawCallRef dcRef = drawCalls[instIdx];
+      CullingInstance& instance = _instances[instIdx];
+      const uint32_t batchIdx = (*_batchIdxPerInstance)[instIdx];
+
+      const Math::AABB& localAABB = DrawCallManager::_descLocalAABB(dcRef);
+      instance.aabbCenter = glm::vec4(Math::calcAABBCenter(localAABB), 0.0f);
+      instance.aabbHalfExtent =
+          glm::vec4(Math::calcAABBHalfExtent(localAABB), 0.0f);
+      instance.drawData[0] = DrawCallManager::_descIndexCount(dcRef);
+      instance.drawData[1] = _firstMeshInstanceIdx + instIdx;
+      instance.drawData[2] = _firstDrawCountIdx + batchIdx;
+      // The world matrix is read from the transform buffer
+      instance.drawData[3] =
+          CComponents::MeshManager::_node(
+              DrawCallManager::_descMeshComponent(dcRef))
+              ._id;
+      instance.drawOffsets[0] = DrawCallManager::_descFirstIndex(dcRef);
+      instance.drawOffsets[1] =
+          (uint32_t)DrawCallManager::_descVertexOffset(dcRef);
+      instance.drawOffsets[2] =
+          _firstInstanceIdx + (*_firstInstancePerBatch)[batchIdx];
+      instance.drawOffsets[3] = 0u;
+    }
+  }
+
+  const DrawCallRefFrameArray* _drawCalls;
+  const _INTR_FRAME_ARRAY(uint32_t)* _batchIdxPerInstance;
+  const _INTR_FRAME_ARRAY(uint32_t)* _firstInstancePerBatch;
+  CullingInstance* _instances;
+  uint32_t _firstInstanceIdx;
+  uint32_t _firstMeshInstanceIdx;
+  uint32_t _firstDrawCountIdx;
+};
+
+CullingInstanceUpdateParallelTaskSet _cullingInstanceUpdateTaskSet;
+}
+
+// Static members
+BufferRef GpuCulling::_drawArgumentBuffer;
+BufferRef GpuCulling::_drawCountBuffer;
+
+// <-
+
+void GpuCulling::init()
+{
+  _INTR_LOG_INFO("Inititializing GPU Culling...");
+
+  PipelineLayoutRefArray pipelineLayoutsToCreate;
+  PipelineRefArray pipelinesToCreate;
+  ComputeCallRefArray computeCallsToCreate;
+
+  if (RenderSystem::_vkCmdDrawIndexedIndirectCount == nullptr)
+  {
+    _INTR_LOG_WARNING("Count based indirect draws are not supported, culled "
+                      "draw arguments are dispatched with an instance count "
+                      "of zero...");
+  }
+
+  // Buffers
+  {
+    _cullingInstanceBuffer =
+        BufferManager::createBuffer(_N(CullingInstanceBuffer));
+    {
+      BufferManager::resetToDefault(_cullingInstanceBuffer);
+      BufferManager::addResourceFlags(
+          _cullingInstanceBuffer,
+          Dod::Resources::ResourceFlags::kResourceVolatile);
+
+      BufferManager::_descBufferType(_cullingInstanceBuffer) =
+          BufferType::kStorage;
+      BufferManager::_descMemoryPoolType(_cullingInstanceBuffer) =
+          MemoryPoolType::kStaticStagingBuffers;
+    }
+
+    _drawArgumentBuffer = BufferManager::createBuffer(_N(DrawArgumentBuffer));
+    {
+      BufferManager::resetToDefault(_drawArgumentBuffer);
+      BufferManager::addResourceFlags(
+          _drawArgumentBuffer,
+          Dod::Resources::ResourceFlags::kResourceVolatile);
+
+      BufferManager::_descBufferType(_drawArgumentBuffer) =
+          BufferType::kIndirect;
+    }
+
+    _drawCountBuffer = BufferManager::createBuffer(_N(DrawCountBuffer));
+    {
+      BufferManager::resetToDefault(_drawCountBuffer);
+      BufferManager::addResourceFlags(
+          _drawCountBuffer, Dod::Resources::ResourceFlags::kResourceVolatile);
+
+      BufferManager::_descBufferType(_drawCountBuffer) = BufferType::kIndirect;
+    }
+
+    createBuffers();
+  }
+
+  // Pipeline layouts
+  PipelineLayoutRef pipelineLayoutCulling;
+  {
+    pipelineLayoutCulling =
+        PipelineLayoutManager::createPipelineLayout(_N(GpuCulling));
+    PipelineLayoutManager::resetToDefault(pipelineLayoutCulling);
+
+    GpuProgramManager::reflectPipelineLayout(
+        8u, {GpuProgramManager::getResourceByName("gpu_culling.comp")},
+        pipelineLayoutCulling);
+  }
+  pipelineLayoutsToCreate.push_back(pipelineLayoutCulling);
+
+  PipelineLayoutManager::createResources(pipelineLayoutsToCreate);
+
+  // Pipelines
+  {
+    _cullingPipelineRef = PipelineManager::createPipeline(_N(GpuCulling));
+    PipelineManager::resetToDefault(_cullingPipelineRef);
+
+    PipelineManager::_descComputeProgram(_cullingPipelineRef) =
+        GpuProgramManager::getResourceByName("gpu_culling.comp");
+    PipelineManager::_descPipelineLayout(_cullingPipelineRef) =
+        pipelineLayoutCulling;
+  }
+  pipelinesToCreate.push_back(_cullingPipelineRef);
+
+  PipelineManager::createResources(pipelinesToCreate);
+
+  // Compute calls
+  _cullingComputeCallRef =
+      ComputeCallManager::createComputeCall(_N(GpuCulling));
+  {
+    ComputeCallManager::resetToDefault(_cullingComputeCallRef);
+    ComputeCallManager::addResourceFlags(
+        _cullingComputeCallRef,
+        Dod::Resources::ResourceFlags::kResourceVolatile);
+    ComputeCallManager::_descPipeline(_cullingComputeCallRef) =
+        _cullingPipelineRef;
+
+    bindBuffers();
+
+    computeCallsToCreate.push_back(_cullingComputeCallRef);
+  }
+
+  ComputeCallManager::createResources(computeCallsToCreate);
+}
+
+// <-
+
+void GpuCulling::onFrameEnded()
+{
+  // The draw calls which didn't fit have been dispatched directly. The
+  // buffers of the frames in flight are released once they are done
+  if (_requiredInstanceCount > _maxInstanceCountPerFrame)
+  {
+    _maxInstanceCountPerFrame =
+        std::max(_requiredInstanceCount, _maxInstanceCountPerFrame * 2u);
+    _INTR_LOG_INFO("Growing GPU culling buffers to %u instances per frame...",
+                   _maxInstanceCountPerFrame);
+
+    ComputeCallManager::destroyResources({_cullingComputeCallRef});
+    BufferManager::destroyResources(
+        {_cullingInstanceBuffer, _drawArgumentBuffer, _drawCountBuffer});
+
+    createBuffers();
+    bindBuffers();
+    ComputeCallManager::createResources({_cullingComputeCallRef});
+  }
+
+  _currentInstanceCount = 0u;
+  _currentBatchCount = 0u;
+  _requiredInstanceCount = 0u;
+}
+
+// <-
+
+void GpuCulling::cullDrawCalls(DrawCallRefFrameArray& p_DrawCalls,
+                               CResources::FrustumRef p_FrustumRef,
+                               IndirectDrawArray& p_IndirectDraws)
+{
+  _INTR_PROFILE_CPU("General", "GPU Culling");
+
+  p_IndirectDraws.clear();
+
+  const uint32_t dcCount = (uint32_t)p_DrawCalls.size();
+  if (dcCount == 0u)
+  {
+    return;
+  }
+
+  // Batch consecutive draw calls, which are sorted by pipeline, material and
+  // mesh
+  DrawCallRefFrameArray instanceDrawCalls;
+  instanceDrawCalls.reserve(dcCount);
+  _INTR_FRAME_ARRAY(uint32_t) batchIdxPerInstance;
+  batchIdxPerInstance.reserve(dcCount);
+  _INTR_FRAME_ARRAY(uint32_t) firstInstancePerBatch;
+  firstInstancePerBatch.reserve(dcCount);
+
+  DrawCallRefFrameArray batchedDrawCalls;
+  batchedDrawCalls.reserve(dcCount);
+  p_IndirectDraws.reserve(dcCount);
+
+  for (uint32_t dcIdx = 0u; dcIdx < dcCount; ++dcIdx)
+  {
+    DrawCallRef dcRef = p_DrawCalls[dcIdx];
+
+    if (!Instancing::isInstanceable(dcRef))
+    {
+      batchedDrawCalls.push_back(dcRef);
+      p_IndirectDraws.push_back({0u, 0u, 0u});
+      continue;
+    }
+
+    const bool continuesBatch = !p_IndirectDraws.empty() &&
+                                p_IndirectDraws.back().maxDrawCount > 0u &&
+                                isSameBatch(batchedDrawCalls.back(), dcRef);
+    if (!continuesBatch)
+    {
+      const uint32_t batchIdx = (uint32_t)firstInstancePerBatch.size();
+      firstInstancePerBatch.push_back((uint32_t)instanceDrawCalls.size());
+
+      // Offset by the first instance and draw count of this call below
+      batchedDrawCalls.push_back(dcRef);
+      p_IndirectDraws.push_back(
+          {(uint32_t)instanceDrawCalls.size(), 0u, batchIdx});
+    }
+
+    ++p_IndirectDraws.back().maxDrawCount;
+    batchIdxPerInstance.push_back((uint32_t)firstInstancePerBatch.size() - 1u);
+    instanceDrawCalls.push_back(dcRef);
+  }
+
+  const uint32_t instanceCount = (uint32_t)instanceDrawCalls.size();
+  const uint32_t batchCount = (uint32_t)firstInstancePerBatch.size();
+  _requiredInstanceCount += instanceCount;
+
+  if (instanceCount == 0u ||
+      _currentInstanceCount + instanceCount > _maxInstanceCountPerFrame)
+  {
+    p_IndirectDraws.clear();
+    return;
+  }
+
+  const uint32_t firstMeshInstanceIdx =
+      Instancing::writeMeshInstances(instanceDrawCalls);
+  if (firstMeshInstanceIdx == _INTR_INSTANCING_INVALID_INSTANCE_IDX)
+  {
+    p_IndirectDraws.clear();
+    return;
+  }
+
+  // Instances, draw arguments and draw counts of the frames in flight are
+  // kept apart
+  const uint32_t frameOffset = (RenderSystem::_backbufferIndex %
+                                _INTR_VK_PER_INSTANCE_DATA_BUFFER_COUNT) *
+                               _maxInstanceCountPerFrame;
+  const uint32_t firstInstanceIdx = frameOffset + _currentInstanceCount;
+  const uint32_t firstDrawCountIdx = frameOffset + _currentBatchCount;
+  _currentInstanceCount += instanceCount;
+  _currentBatchCount += batchCount;
+
+  for (uint32_t i = 0u; i < p_IndirectDraws.size(); ++i)
+  {
+    IndirectDraw& indirectDraw = p_IndirectDraws[i];
+    if (indirectDraw.maxDrawCount > 0u)
+    {
+      indirectDraw.firstDrawArgument += firstInstanceIdx;
+      indirectDraw.drawCountIdx += firstDrawCountIdx;
+    }
+  }
+
+  // Write culling instances
+  {
+    _cullingInstanceUpdateTaskSet._drawCalls = &instanceDrawCalls;
+    _cullingInstanceUpdateTaskSet._batchIdxPerInstance = &batchIdxPerInstance;
+    _cullingInstanceUpdateTaskSet._firstInstancePerBatch =
+        &firstInstancePerBatch;
+    _cullingInstanceUpdateTaskSet._instances =
+        &_cullingInstanceBufferGpuMemory[firstInstanceIdx];
+    _cullingInstanceUpdateTaskSet._firstInstanceIdx = firstInstanceIdx;
+    _cullingInstanceUpdateTaskSet._firstMeshInstanceIdx = firstMeshInstanceIdx;
+    _cullingInstanceUpdateTaskSet._firstDrawCountIdx = firstDrawCountIdx;
+    _cullingInstanceUpdateTaskSet.m_SetSize = instanceCount;
+
+    Application::_scheduler.AddTaskSetToPipe(&_cullingInstanceUpdateTaskSet);
+    Application::_scheduler.WaitforTaskSet(&_cullingInstanceUpdateTaskSet);
+  }
+
+  const bool compactDrawArguments =
+      RenderSystem::_vkCmdDrawIndexedIndirectCount != nullptr;
+
+  PerInstanceDataGpuCulling cullingData = {};
+  {
+    cullingData.data[0] = firstInstanceIdx;
+    cullingData.data[1] = instanceCount;
+    cullingData.data[2] = compactDrawArguments ? 1u : 0u;
+
+    const Math::FrustumPlanes& frustumPlanes =
+        CResources::FrustumManager::_frustumPlanesViewSpace(p_FrustumRef);
+    for (uint32_t planeIdx = 0u; planeIdx < Math::FrustumPlane::kCount;
+         ++planeIdx)
+    {
+      cullingData.frustumPlanes[planeIdx] =
+          glm::vec4(frustumPlanes.n[planeIdx], frustumPlanes.d[planeIdx]);
+    }
+  }
+
+  VkCommandBuffer primaryCmdBuffer = RenderSystem::getPrimaryCommandBuffer();
+
+  // The visible draw arguments are counted per batch
+  if (compactDrawArguments)
+  {
+    vkCmdFillBuffer(primaryCmdBuffer,
+                    BufferManager::_vkBuffer(_drawCountBuffer),
+                    firstDrawCountIdx * sizeof(uint32_t),
+                    batchCount * sizeof(uint32_t), 0u);
+
+    BufferManager::insertBufferMemoryBarrier(
+        _drawCountBuffer, VK_ACCESS_TRANSFER_WRITE_BIT,
+        VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+  }
+
+  ComputeCallManager::_descDimensions(_cullingComputeCallRef) =
+      glm::uvec3((instanceCount + GPU_CULLING_THREADS - 1u) /
+                     GPU_CULLING_THREADS,
+                 1u, 1u);
+  ComputeCallManager::updateUniformMemory({_cullingComputeCallRef},
+                                          &cullingData,
+                                          sizeof(PerInstanceDataGpuCulling));
+
+  RenderSystem::dispatchComputeCall(_cullingComputeCallRef, primaryCmdBuffer);
+
+  BufferManager::insertBufferMemoryBarrier(
+      _drawArgumentBuffer, VK_ACCESS_SHADER_WRITE_BIT,
+      VK_ACCESS_INDIRECT_COMMAND_READ_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+      VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT);
+  if (compactDrawArguments)
+  {
+    BufferManager::insertBufferMemoryBarrier(
+        _drawCountBuffer, VK_ACCESS_SHADER_WRITE_BIT,
+        VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT);
+  }
+
+  p_DrawCalls.swap(batchedDrawCalls);
+}
+}
+}
@@ -0,0 +1,64 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace Intrinsic
+{
+namespace Renderer
+{
+struct CullingInstance
+{
+  glm::vec4 aabbCenter;
+  glm::vec4 aabbHalfExtent;
+  // x: index count, y: mesh instance, z: draw count index, w: node id
+  uint32_t drawData[4];
+  // x: first index, y: vertex offset, z: first draw argument of the batch
+  uint32_t drawOffsets[4];
+};
+
+struct IndirectDraw
+{
+  uint32_t firstDrawArgument;
+  // Zero if the draw call is dispatched directly using its regular pipeline
+  uint32_t maxDrawCount;
+  // Indexes the draw counts if count based indirect draws are supported
+  uint32_t drawCountIdx;
+};
+typedef _INTR_FRAME_ARRAY(IndirectDraw) IndirectDrawArray;
+
+struct GpuCulling
+{
+  static void init();
+  static void onFrameEnded();
+
+  /**
+   * Merges consecutive draw calls sharing the instanced pipeline, material and
+   * mesh buffer blocks into batches, placed at the position of the first draw
+   * call of each batch. Records a compute dispatch which culls the sub mesh
+   * bounds of each draw call against the frustum and writes the draw arguments
+   * of the visible ones, so it has to be called outside of a render pass.
+   *
+   * Fills one entry per remaining draw call or leaves the array empty if the
+   * draw calls have to be dispatched directly.
+   */
+  static void cullDrawCalls(Resources::DrawCallRefFrameArray& p_DrawCalls,
+                            CResources::FrustumRef p_FrustumRef,
+                            IndirectDrawArray& p_IndirectDraws);
+
+  static Resources::BufferRef _drawArgumentBuffer;
+  static Resources::BufferRef _drawCountBuffer;
+};
+}
+}
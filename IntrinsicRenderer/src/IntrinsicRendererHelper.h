@@ -173,6 +173,10 @@ mapBufferTypeToVkUsageFlagBits(BufferType::Enum p_BufferType)
     return VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
   case BufferType::kStorage:
     return VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+  case BufferType::kIndirect:
+    // Indirect arguments are written by compute shaders
+    return (VkBufferUsageFlagBits)(VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                                   VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
   }
 
   _INTR_ASSERT(false && "Failed to map buffer type");
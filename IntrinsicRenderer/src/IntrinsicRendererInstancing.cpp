@@ -0,0 +1,351 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Precompiled header file
+#include "stdafx.h"
+
+#define INSTANCING_INITIAL_INSTANCES_PER_FRAME (_INTR_MAX_DRAW_CALL_COUNT * 4u)
+
+using namespace RResources;
+
+namespace Intrinsic
+{
+namespace Renderer
+{
+namespace
+{
+// The index buffer block and the index range identify the sub mesh and its LOD
+struct InstanceGroupKey
+{
+  _INTR_INLINE bool operator==(const InstanceGroupKey& p_Rhs) const
+  {
+    return pipeline == p_Rhs.pipeline && material == p_Rhs.material &&
+           indexBuffer == p_Rhs.indexBuffer &&
+           firstIndex == p_Rhs.firstIndex && indexCount == p_Rhs.indexCount &&
+           vertexOffset == p_Rhs.vertexOffset;
+  }
+
+  uint32_t pipeline;
+  uint32_t material;
+  uint32_t indexBuffer;
+  uint32_t firstIndex;
+  uint32_t indexCount;
+  int32_t vertexOffset;
+};
+}
+}
+}
+
+namespace std
+{
+template <> class hash<Intrinsic::Renderer::InstanceGroupKey>
+{
+public:
+  size_t operator()(const Intrinsic::Renderer::InstanceGroupKey& p_Key) const
+  {
+    return (size_t)Intrinsic::Core::Math::hash64(
+        (const char*)&p_Key, sizeof(Intrinsic::Renderer::InstanceGroupKey));
+  }
+};
+};
+
+namespace Intrinsic
+{
+namespace Renderer
+{
+namespace
+{
+struct InstanceGroup
+{
+  uint32_t drawCallCount;
+  uint32_t firstInstance;
+  uint32_t writtenInstanceCount;
+};
+
+MeshInstance* _meshInstanceBufferGpuMemory = nullptr;
+
+// Grows if the instances of a frame don't fit
+uint32_t _maxInstanceCountPerFrame = INSTANCING_INITIAL_INSTANCES_PER_FRAME;
+uint32_t _currentInstanceCount = 0u;
+uint32_t _requiredInstanceCount = 0u;
+
+_INTR_HASH_MAP(InstanceGroupKey, uint32_t) _groupMapping;
+
+_INTR_INLINE InstanceGroupKey calcGroupKey(DrawCallRef p_DrawCallRef)
+{
+  InstanceGroupKey key;
+  key.pipeline = DrawCallManager::_descPipeline(p_DrawCallRef)._id;
+  key.material = DrawCallManager::_descMaterial(p_DrawCallRef)._id;
+  key.indexBuffer = DrawCallManager::_descIndexBuffer(p_DrawCallRef)._id;
+  key.firstIndex = DrawCallManager::_descFirstIndex(p_DrawCallRef);
+  key.indexCount = DrawCallManager::_descIndexCount(p_DrawCallRef);
+  key.vertexOffset = DrawCallManager::_descVertexOffset(p_DrawCallRef);
+
+  return key;
+}
+
+// <-
+
+void createBuffers()
+{
+  // Instances of the frames in flight are kept apart
+  BufferManager::_descSizeInBytes(Instancing::_meshInstanceBuffer) =
+      _maxInstanceCountPerFrame * _INTR_VK_PER_INSTANCE_DATA_BUFFER_COUNT *
+      sizeof(MeshInstance);
+  BufferManager::createResources({Instancing::_meshInstanceBuffer});
+
+  _meshInstanceBufferGpuMemory = (MeshInstance*)BufferManager::getGpuMemory(
+      Instancing::_meshInstanceBuffer);
+}
+
+// <-
+
+struct MeshInstanceUpdateParallelTaskSet : enki::ITaskSet
+{
+  virtual ~MeshInstanceUpdateParallelTaskSet() {}
+
+  void ExecuteRange(enki::TaskSetPartition p_Range,
+                    uint32_t p_ThreadNum) override
+  {
+    _INTR_PROFILE_CPU("General", "Mesh Instance Updt. Job");
+
+    for (uint32_t instIdx = p_Range.start; instIdx < p_Range.end; ++instIdx)
+    {
+      CComponents::MeshRef meshCompRef =
+          DrawCallManager::_descMeshComponent((*_instanceDrawCalls)[instIdx]);
+
+      MeshInstance& instance = _instances[instIdx];
+      instance.data[0] = CComponents::MeshManager::_node(meshCompRef)._id;
+      instance.colorTint =
+          CComponents::MeshManager::_descColorTint(meshCompRef);
+    }
+  }
+
+  const DrawCallRefFrameArray* _instanceDrawCalls;
+  MeshInstance* _instances;
+};
+
+MeshInstanceUpdateParallelTaskSet _meshInstanceUpdateTaskSet;
+}
+
+// Static members
+BufferRef Instancing::_meshInstanceBuffer;
+
+// <-
+
+void Instancing::init()
+{
+  _INTR_LOG_INFO("Inititializing Instancing...");
+
+  _meshInstanceBuffer = BufferManager::createBuffer(_N(MeshInstanceBuffer));
+  {
+    BufferManager::resetToDefault(_meshInstanceBuffer);
+    BufferManager::addResourceFlags(
+        _meshInstanceBuffer, Dod::Resources::ResourceFlags::kResourceVolatile);
+
+    BufferManager::_descBufferType(_meshInstanceBuffer) = BufferType::kStorage;
+    BufferManager::_descMemoryPoolType(_meshInstanceBuffer) =
+        MemoryPoolType::kStaticStagingBuffers;
+  }
+
+  createBuffers();
+}
+
+// <-
+
+void Instancing::onFrameEnded()
+{
+  // The draw calls which didn't fit have been dispatched without instancing.
+  // The buffer of the frames in flight is released once they are done
+  if (_requiredInstanceCount > _maxInstanceCountPerFrame)
+  {
+    _maxInstanceCountPerFrame =
+        std::max(_requiredInstanceCount, _maxInstanceCountPerFrame * 2u);
+    _INTR_LOG_INFO("Growing mesh instance buffer to %u instances per frame...",
+                   _maxInstanceCountPerFrame);
+
+    BufferManager::destroyResources({_meshInstanceBuffer});
+    createBuffers();
+    DrawCallManager::updateBufferBindings(_meshInstanceBuffer);
+  }
+
+  _currentInstanceCount = 0u;
+  _requiredInstanceCount = 0u;
+}
+
+// <-
+
+bool Instancing::isInstanceable(DrawCallRef p_DrawCallRef)
+{
+  const uint8_t materialPassIdx =
+      DrawCallManager::_descMaterialPass(p_DrawCallRef);
+
+  return MaterialManager::_materialPasses[materialPassIdx]
+                 .instancedPipelineIdx !=
+             _INTR_MATERIAL_PASS_INVALID_PIPELINE_IDX &&
+         DrawCallManager::_descIndexBuffer(p_DrawCallRef).isValid() &&
+         DrawCallManager::_descMeshComponent(p_DrawCallRef).isValid();
+}
+
+// <-
+
+uint32_t
+Instancing::writeMeshInstances(const DrawCallRefFrameArray& p_DrawCalls)
+{
+  const uint32_t instanceCount = (uint32_t)p_DrawCalls.size();
+  _requiredInstanceCount += instanceCount;
+
+  if (_currentInstanceCount + instanceCount > _maxInstanceCountPerFrame)
+  {
+    return _INTR_INSTANCING_INVALID_INSTANCE_IDX;
+  }
+
+  // Instances of the frames in flight are kept apart
+  const uint32_t firstInstanceIdx =
+      (RenderSystem::_backbufferIndex %
+       _INTR_VK_PER_INSTANCE_DATA_BUFFER_COUNT) *
+          _maxInstanceCountPerFrame +
+      _currentInstanceCount;
+  _currentInstanceCount += instanceCount;
+
+  {
+    _meshInstanceUpdateTaskSet._instanceDrawCalls = &p_DrawCalls;
+    _meshInstanceUpdateTaskSet._instances =
+        &_meshInstanceBufferGpuMemory[firstInstanceIdx];
+    _meshInstanceUpdateTaskSet.m_SetSize = instanceCount;
+
+    Application::_scheduler.AddTaskSetToPipe(&_meshInstanceUpdateTaskSet);
+    Application::_scheduler.WaitforTaskSet(&_meshInstanceUpdateTaskSet);
+  }
+
+  return firstInstanceIdx;
+}
+
+// <-
+
+void Instancing::mergeDrawCalls(DrawCallRefFrameArray& p_DrawCalls,
+                                InstancedDrawArray& p_InstancedDraws)
+{
+  _INTR_PROFILE_CPU("General", "Merge Instanced Draw Calls");
+
+  p_InstancedDraws.clear();
+
+  const uint32_t dcCount = (uint32_t)p_DrawCalls.size();
+  if (dcCount == 0u)
+  {
+    return;
+  }
+
+  // Group draw calls
+  _groupMapping.clear();
+  _INTR_FRAME_ARRAY(InstanceGroup) groups;
+  groups.reserve(dcCount);
+  _INTR_FRAME_ARRAY(uint32_t) groupIdxPerDrawCall;
+  groupIdxPerDrawCall.resize(dcCount);
+
+  for (uint32_t dcIdx = 0u; dcIdx < dcCount; ++dcIdx)
+  {
+    DrawCallRef dcRef = p_DrawCalls[dcIdx];
+
+    uint32_t groupIdx = (uint32_t)groups.size();
+    if (isInstanceable(dcRef))
+    {
+      const InstanceGroupKey groupKey = calcGroupKey(dcRef);
+      auto groupIt = _groupMapping.find(groupKey);
+      if (groupIt != _groupMapping.end())
+      {
+        groupIdx = groupIt->second;
+      }
+      else
+      {
+        _groupMapping[groupKey] = groupIdx;
+      }
+    }
+
+    if (groupIdx == groups.size())
+    {
+      groups.push_back({0u, 0u, 0u});
+    }
+
+    ++groups[groupIdx].drawCallCount;
+    groupIdxPerDrawCall[dcIdx] = groupIdx;
+  }
+
+  if (groups.size() == dcCount)
+  {
+    return;
+  }
+
+  // Reserve instances for groups with more than one draw call
+  uint32_t instanceCount = 0u;
+  for (uint32_t groupIdx = 0u; groupIdx < groups.size(); ++groupIdx)
+  {
+    InstanceGroup& group = groups[groupIdx];
+    if (group.drawCallCount > 1u)
+    {
+      group.firstInstance = instanceCount;
+      instanceCount += group.drawCallCount;
+    }
+  }
+
+  // Compact the draw calls, keeping the first draw call of each group
+  DrawCallRefFrameArray mergedDrawCalls;
+  mergedDrawCalls.reserve(groups.size());
+  p_InstancedDraws.reserve(groups.size());
+  DrawCallRefFrameArray instanceDrawCalls;
+  instanceDrawCalls.resize(instanceCount);
+
+  for (uint32_t dcIdx = 0u; dcIdx < dcCount; ++dcIdx)
+  {
+    DrawCallRef dcRef = p_DrawCalls[dcIdx];
+    InstanceGroup& group = groups[groupIdxPerDrawCall[dcIdx]];
+
+    if (group.drawCallCount == 1u)
+    {
+      mergedDrawCalls.push_back(dcRef);
+      p_InstancedDraws.push_back({0u, 0u});
+      continue;
+    }
+
+    if (group.writtenInstanceCount == 0u)
+    {
+      mergedDrawCalls.push_back(dcRef);
+      // Offset by the first written mesh instance below
+      p_InstancedDraws.push_back({group.firstInstance, group.drawCallCount});
+    }
+
+    instanceDrawCalls[group.firstInstance + group.writtenInstanceCount] =
+        dcRef;
+    ++group.writtenInstanceCount;
+  }
+
+  const uint32_t firstInstanceIdx = writeMeshInstances(instanceDrawCalls);
+  if (firstInstanceIdx == _INTR_INSTANCING_INVALID_INSTANCE_IDX)
+  {
+    p_InstancedDraws.clear();
+    return;
+  }
+
+  for (uint32_t i = 0u; i < p_InstancedDraws.size(); ++i)
+  {
+    if (p_InstancedDraws[i].instanceCount > 0u)
+    {
+      p_InstancedDraws[i].firstInstance += firstInstanceIdx;
+    }
+  }
+
+  p_DrawCalls.swap(mergedDrawCalls);
+}
+}
+}
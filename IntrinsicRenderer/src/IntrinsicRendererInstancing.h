@@ -0,0 +1,70 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#define _INTR_INSTANCING_INVALID_INSTANCE_IDX ((uint32_t)-1)
+
+namespace Intrinsic
+{
+namespace Renderer
+{
+struct MeshInstance
+{
+  uint32_t data[4]; // x: node id
+  glm::vec4 colorTint;
+};
+
+struct InstancedDraw
+{
+  uint32_t firstInstance;
+  // Zero if the draw call is dispatched using its regular pipeline
+  uint32_t instanceCount;
+};
+typedef _INTR_FRAME_ARRAY(InstancedDraw) InstancedDrawArray;
+
+struct Instancing
+{
+  static void init();
+  static void onFrameEnded();
+
+  /**
+   * Merges the visible draw calls sharing pipeline, sub mesh and material into
+   * a single instanced draw call, placed at the position of the first draw
+   * call of each group. Fills the mesh instance buffer with the node ids and
+   * color tints of the mesh components.
+   *
+   * Fills one entry per remaining draw call or leaves the array empty if
+   * nothing has been merged.
+   */
+  static void mergeDrawCalls(Resources::DrawCallRefFrameArray& p_DrawCalls,
+                             InstancedDrawArray& p_InstancedDraws);
+
+  /**
+   * Writes one mesh instance per draw call to the mesh instance buffer.
+   *
+   * Returns the index of the first instance or
+   * _INTR_INSTANCING_INVALID_INSTANCE_IDX if the instances of this frame don't
+   * fit in the buffer.
+   */
+  static uint32_t
+  writeMeshInstances(const Resources::DrawCallRefFrameArray& p_DrawCalls);
+
+  // True if the material pass provides an instanced pipeline for the mesh
+  static bool isInstanceable(Resources::DrawCallRef p_DrawCallRef);
+
+  static Resources::BufferRef _meshInstanceBuffer;
+};
+}
+}
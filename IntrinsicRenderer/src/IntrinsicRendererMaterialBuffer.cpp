@@ -37,7 +37,8 @@ void MaterialBuffer::init()
 
     BufferManager::_descBufferType(_materialBuffer) = BufferType::kStorage;
     BufferManager::_descSizeInBytes(_materialBuffer) =
-        sizeof(MaterialBufferEntry) * _INTR_MAX_MATERIAL_COUNT;
+        sizeof(MaterialBufferEntry) *
+        (_INTR_VK_MAX_MATERIAL_COUNT + 2u /* Default buffers */);
     buffersToCreate.push_back(_materialBuffer);
   }
 
@@ -61,9 +62,9 @@ void MaterialBuffer::init()
   BufferManager::createResources(buffersToCreate);
 
   _materialBufferEntries.clear();
-  for (uint32_t i = 0u; i < _INTR_MAX_MATERIAL_COUNT; ++i)
+  for (uint32_t i = 0u; i < _INTR_VK_MAX_MATERIAL_COUNT; ++i)
   {
-    _materialBufferEntries.push_back(_INTR_MAX_MATERIAL_COUNT - 1u - i +
+    _materialBufferEntries.push_back(_INTR_VK_MAX_MATERIAL_COUNT - 1u - i +
                                      2u /* Offset for the default buffers */);
   }
 
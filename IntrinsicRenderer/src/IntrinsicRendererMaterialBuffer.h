@@ -34,6 +34,13 @@ struct MaterialBufferEntry
   float translucencyThicknessFactor;
   float emissiveIntensity;
   uint32_t materialFlags;
+
+  // Only read by the bindless material passes, which sample the global texture
+  // array instead of binding the material textures per draw call
+  glm::vec4 uvOffsetScale;
+  glm::vec4 uvAnimation;
+  glm::vec4 pbrBias; // w: average normal length
+  uint32_t textureIds[4]; // Albedo, normal, PBR and emissive
 };
 
 struct MaterialBuffer
@@ -42,6 +49,9 @@ struct MaterialBuffer
 
   _INTR_INLINE static uint32_t allocateMaterialBufferEntry()
   {
+    _INTR_FATAL_CHECK(!_materialBufferEntries.empty(),
+                      "Material buffer exhausted");
+
     const uint32_t idx = _materialBufferEntries.back();
     _materialBufferEntries.pop_back();
 
@@ -0,0 +1,381 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Precompiled header file
+#include "stdafx.h"
+
+// Blocks are allocated on demand and have to fit into a single GPU memory page
+#define MESH_BUFFER_POOL_VERTICES_PER_BLOCK (1024u * 1024u)
+#define MESH_BUFFER_POOL_INDICES_PER_BLOCK (4u * 1024u * 1024u)
+#define MESH_BUFFER_POOL_STAGING_BUFFER_SIZE_IN_BYTES (16u * 1024u * 1024u)
+
+using namespace RResources;
+using namespace CResources;
+
+namespace Intrinsic
+{
+namespace Renderer
+{
+namespace
+{
+// Has to match the strides of the default mesh vertex layout
+const uint32_t _vertexStreamStrides[MeshVertexStream::kCount] = {6u, 4u, 6u,
+                                                                 6u, 6u, 4u};
+
+_INTR_ARRAY(Memory::FreeListOffsetAllocator) _vertexAllocatorPerBlock;
+_INTR_ARRAY(Memory::FreeListOffsetAllocator) _indexAllocatorPerBlock;
+
+struct PendingCopy
+{
+  VkBuffer dstBuffer;
+  VkBufferCopy region;
+};
+
+BufferRef _stagingBuffer;
+uint8_t* _stagingBufferGpuMemory = nullptr;
+uint32_t _stagingBufferOffset = 0u;
+_INTR_ARRAY(PendingCopy) _pendingCopies;
+
+// <-
+
+_INTR_INLINE uint32_t createVertexBlock()
+{
+  const uint32_t blockIdx =
+      (uint32_t)MeshBufferPool::_vertexBuffersPerBlock.size();
+
+  const Name vertexStreamNames[MeshVertexStream::kCount] = {
+      _N(MeshPositionVb), _N(MeshUv0Vb),      _N(MeshNormalVb),
+      _N(MeshTangentVb),  _N(MeshBinormalVb), _N(MeshVtxColorVb)};
+
+  BufferRefArray vertexBuffers;
+  for (uint32_t streamIdx = 0u; streamIdx < MeshVertexStream::kCount;
+       ++streamIdx)
+  {
+    BufferRef vertexBuffer =
+        BufferManager::createBuffer(vertexStreamNames[streamIdx]);
+    {
+      BufferManager::resetToDefault(vertexBuffer);
+      BufferManager::addResourceFlags(
+          vertexBuffer, Dod::Resources::ResourceFlags::kResourceVolatile);
+
+      // The three component streams are fetched using four component formats,
+      // so the last vertex reads past its stride
+      BufferManager::_descBufferType(vertexBuffer) = BufferType::kVertex;
+      BufferManager::_descSizeInBytes(vertexBuffer) =
+          MESH_BUFFER_POOL_VERTICES_PER_BLOCK *
+              _vertexStreamStrides[streamIdx] +
+          sizeof(uint16_t);
+      vertexBuffers.push_back(vertexBuffer);
+    }
+  }
+
+  BufferManager::createResources(vertexBuffers);
+
+  MeshBufferPool::_vertexBuffersPerBlock.push_back(vertexBuffers);
+  _vertexAllocatorPerBlock.resize(blockIdx + 1u);
+  _vertexAllocatorPerBlock[blockIdx].init(MESH_BUFFER_POOL_VERTICES_PER_BLOCK);
+
+  return blockIdx;
+}
+
+// <-
+
+_INTR_INLINE uint32_t createIndexBlock(BufferType::Enum p_IndexBufferType)
+{
+  const uint32_t blockIdx =
+      (uint32_t)MeshBufferPool::_indexBufferPerBlock.size();
+
+  BufferRefArray buffersToCreate;
+
+  BufferRef indexBuffer = BufferManager::createBuffer(_N(MeshIb));
+  {
+    BufferManager::resetToDefault(indexBuffer);
+    BufferManager::addResourceFlags(
+        indexBuffer, Dod::Resources::ResourceFlags::kResourceVolatile);
+
+    BufferManager::_descBufferType(indexBuffer) = p_IndexBufferType;
+    BufferManager::_descSizeInBytes(indexBuffer) =
+        MESH_BUFFER_POOL_INDICES_PER_BLOCK *
+        (p_IndexBufferType == BufferType::kIndex16 ? sizeof(uint16_t)
+                                                   : sizeof(uint32_t));
+    buffersToCreate.push_back(indexBuffer);
+  }
+
+  BufferManager::createResources(buffersToCreate);
+
+  MeshBufferPool::_indexBufferPerBlock.push_back(indexBuffer);
+  _indexAllocatorPerBlock.resize(blockIdx + 1u);
+  _indexAllocatorPerBlock[blockIdx].init(MESH_BUFFER_POOL_INDICES_PER_BLOCK);
+
+  return blockIdx;
+}
+
+// <-
+
+_INTR_INLINE void stageCopy(VkBuffer p_DstBuffer, uint32_t p_DstOffsetInBytes,
+                            const uint8_t* p_Data, uint32_t p_SizeInBytes)
+{
+  // Large uploads are split across multiple flushes
+  while (p_SizeInBytes > 0u)
+  {
+    if (_stagingBufferOffset == MESH_BUFFER_POOL_STAGING_BUFFER_SIZE_IN_BYTES)
+    {
+      MeshBufferPool::flushUploads();
+    }
+
+    const uint32_t sizeInBytes = glm::min(
+        p_SizeInBytes,
+        MESH_BUFFER_POOL_STAGING_BUFFER_SIZE_IN_BYTES - _stagingBufferOffset);
+    memcpy(&_stagingBufferGpuMemory[_stagingBufferOffset], p_Data,
+           sizeInBytes);
+
+    PendingCopy copy;
+    {
+      copy.dstBuffer = p_DstBuffer;
+      copy.region.srcOffset = _stagingBufferOffset;
+      copy.region.dstOffset = p_DstOffsetInBytes;
+      copy.region.size = sizeInBytes;
+    }
+    _pendingCopies.push_back(copy);
+
+    _stagingBufferOffset += sizeInBytes;
+    p_DstOffsetInBytes += sizeInBytes;
+    p_Data += sizeInBytes;
+    p_SizeInBytes -= sizeInBytes;
+  }
+}
+
+// <-
+
+// Packs a range into the user data of a resource release entry
+_INTR_INLINE void releaseRange(const Name& p_TypeName,
+                               const MeshBufferRange& p_Range)
+{
+  if (p_Range.count == 0u)
+  {
+    return;
+  }
+
+  RenderSystem::releaseResource(
+      p_TypeName,
+      (void*)((uint64_t)p_Range.blockIdx << 32u | (uint64_t)p_Range.offset),
+      (void*)(uint64_t)p_Range.count);
+}
+}
+
+// Static members
+_INTR_ARRAY(BufferRefArray) MeshBufferPool::_vertexBuffersPerBlock;
+BufferRefArray MeshBufferPool::_indexBufferPerBlock;
+
+// <-
+
+void MeshBufferPool::init()
+{
+  _INTR_LOG_INFO("Inititializing Mesh Buffer Pool...");
+
+  BufferRefArray buffersToCreate;
+
+  _stagingBuffer = BufferManager::createBuffer(_N(_MeshStagingBuffer));
+  {
+    BufferManager::resetToDefault(_stagingBuffer);
+    BufferManager::addResourceFlags(
+        _stagingBuffer, Dod::Resources::ResourceFlags::kResourceVolatile);
+
+    BufferManager::_descBufferType(_stagingBuffer) = BufferType::kStorage;
+    BufferManager::_descMemoryPoolType(_stagingBuffer) =
+        MemoryPoolType::kStaticStagingBuffers;
+    BufferManager::_descSizeInBytes(_stagingBuffer) =
+        MESH_BUFFER_POOL_STAGING_BUFFER_SIZE_IN_BYTES;
+    buffersToCreate.push_back(_stagingBuffer);
+  }
+
+  BufferManager::createResources(buffersToCreate);
+
+  _stagingBufferGpuMemory =
+      (uint8_t*)BufferManager::getGpuMemory(_stagingBuffer);
+}
+
+// <-
+
+MeshBufferRange MeshBufferPool::allocateVertices(uint32_t p_Count)
+{
+  _INTR_ASSERT(p_Count <= MESH_BUFFER_POOL_VERTICES_PER_BLOCK &&
+               "Sub mesh exceeds the size of a vertex block");
+
+  // Empty ranges still reference a valid block
+  MeshBufferRange range = {0u, 0u, p_Count};
+  if (p_Count == 0u)
+  {
+    if (_vertexAllocatorPerBlock.empty())
+    {
+      createVertexBlock();
+    }
+    return range;
+  }
+
+  for (; range.blockIdx < _vertexAllocatorPerBlock.size(); ++range.blockIdx)
+  {
+    range.offset = _vertexAllocatorPerBlock[range.blockIdx].allocate(p_Count);
+    if (range.offset != _INTR_FREE_LIST_INVALID_OFFSET)
+    {
+      return range;
+    }
+  }
+
+  range.blockIdx = createVertexBlock();
+  range.offset = _vertexAllocatorPerBlock[range.blockIdx].allocate(p_Count);
+
+  return range;
+}
+
+// <-
+
+MeshBufferRange
+MeshBufferPool::allocateIndices(BufferType::Enum p_IndexBufferType,
+                                uint32_t p_Count)
+{
+  _INTR_ASSERT(p_Count <= MESH_BUFFER_POOL_INDICES_PER_BLOCK &&
+               "Sub mesh exceeds the size of an index block");
+
+  // Empty ranges still reference a valid block
+  MeshBufferRange range = {0u, 0u, p_Count};
+  if (p_Count == 0u)
+  {
+    if (_indexAllocatorPerBlock.empty())
+    {
+      createIndexBlock(p_IndexBufferType);
+    }
+    return range;
+  }
+
+  for (; range.blockIdx < _indexAllocatorPerBlock.size(); ++range.blockIdx)
+  {
+    if (BufferManager::_descBufferType(
+            _indexBufferPerBlock[range.blockIdx]) != p_IndexBufferType)
+    {
+      continue;
+    }
+
+    range.offset = _indexAllocatorPerBlock[range.blockIdx].allocate(p_Count);
+    if (range.offset != _INTR_FREE_LIST_INVALID_OFFSET)
+    {
+      return range;
+    }
+  }
+
+  range.blockIdx = createIndexBlock(p_IndexBufferType);
+  range.offset = _indexAllocatorPerBlock[range.blockIdx].allocate(p_Count);
+
+  return range;
+}
+
+// <-
+
+void MeshBufferPool::uploadVertices(const MeshBufferRange& p_Range,
+                                    MeshVertexStream::Enum p_Stream,
+                                    const void* p_Data, uint32_t p_Count)
+{
+  _INTR_ASSERT(p_Count <= p_Range.count);
+
+  if (p_Count == 0u)
+  {
+    return;
+  }
+
+  const uint32_t stride = _vertexStreamStrides[p_Stream];
+  stageCopy(BufferManager::_vkBuffer(
+                _vertexBuffersPerBlock[p_Range.blockIdx][p_Stream]),
+            p_Range.offset * stride, (const uint8_t*)p_Data, p_Count * stride);
+}
+
+// <-
+
+void MeshBufferPool::uploadIndices(const MeshBufferRange& p_Range,
+                                   const void* p_Data)
+{
+  if (p_Range.count == 0u)
+  {
+    return;
+  }
+
+  BufferRef indexBuffer = _indexBufferPerBlock[p_Range.blockIdx];
+  const uint32_t indexSize =
+      BufferManager::_descBufferType(indexBuffer) == BufferType::kIndex16
+          ? sizeof(uint16_t)
+          : sizeof(uint32_t);
+
+  stageCopy(BufferManager::_vkBuffer(indexBuffer), p_Range.offset * indexSize,
+            (const uint8_t*)p_Data, p_Range.count * indexSize);
+}
+
+// <-
+
+void MeshBufferPool::flushUploads()
+{
+  if (_pendingCopies.empty())
+  {
+    return;
+  }
+
+  _INTR_PROFILE_CPU("General", "Flush Mesh Uploads");
+
+  VkCommandBuffer copyCmd = RenderSystem::beginTemporaryCommandBuffer();
+
+  for (uint32_t i = 0u; i < _pendingCopies.size(); ++i)
+  {
+    const PendingCopy& copy = _pendingCopies[i];
+    vkCmdCopyBuffer(copyCmd, BufferManager::_vkBuffer(_stagingBuffer),
+                    copy.dstBuffer, 1u, &copy.region);
+  }
+
+  RenderSystem::flushTemporaryCommandBuffer();
+
+  _pendingCopies.clear();
+  _stagingBufferOffset = 0u;
+}
+
+// <-
+
+void MeshBufferPool::releaseVertices(const MeshBufferRange& p_Range)
+{
+  releaseRange(_N(MeshVertexRange), p_Range);
+}
+
+// <-
+
+void MeshBufferPool::releaseIndices(const MeshBufferRange& p_Range)
+{
+  releaseRange(_N(MeshIndexRange), p_Range);
+}
+
+// <-
+
+void MeshBufferPool::freeReleasedRange(const Name& p_TypeName,
+                                       void* p_UserData0, void* p_UserData1)
+{
+  const uint32_t blockIdx = (uint32_t)((uint64_t)p_UserData0 >> 32u);
+  const uint32_t offset = (uint32_t)(uint64_t)p_UserData0;
+  const uint32_t count = (uint32_t)(uint64_t)p_UserData1;
+
+  if (p_TypeName == _N(MeshVertexRange))
+  {
+    _vertexAllocatorPerBlock[blockIdx].free(offset, count);
+  }
+  else
+  {
+    _indexAllocatorPerBlock[blockIdx].free(offset, count);
+  }
+}
+}
+}
@@ -0,0 +1,92 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace Intrinsic
+{
+namespace Renderer
+{
+// Matches the bindings of the default mesh vertex layout
+namespace MeshVertexStream
+{
+enum Enum
+{
+  kPosition,
+  kUV0,
+  kNormal,
+  kTangent,
+  kBinormal,
+  kVertexColor,
+
+  kCount
+};
+}
+
+struct MeshBufferPool
+{
+  static void init();
+
+  /**
+   * Allocates a range of vertices, which is shared by all vertex streams of
+   * the block. Draw calls use the offset of the range as their vertex offset.
+   */
+  static CResources::MeshBufferRange allocateVertices(uint32_t p_Count);
+
+  /**
+   * Allocates a range of indices from a block of the given index buffer type.
+   * The indices are relative to the vertex range and draw calls use the
+   * offset of the range as their first index.
+   */
+  static CResources::MeshBufferRange
+  allocateIndices(BufferType::Enum p_IndexBufferType, uint32_t p_Count);
+
+  /**
+   * Copies the data of a single vertex stream or the indices of the given
+   * range to the staging buffer. The copies to the blocks are submitted when
+   * calling flushUploads() or as soon as the staging buffer is full.
+   */
+  static void uploadVertices(const CResources::MeshBufferRange& p_Range,
+                             MeshVertexStream::Enum p_Stream,
+                             const void* p_Data, uint32_t p_Count);
+  static void uploadIndices(const CResources::MeshBufferRange& p_Range,
+                            const void* p_Data);
+  static void flushUploads();
+
+  // Ranges are released once the frames in flight are done using them
+  static void releaseVertices(const CResources::MeshBufferRange& p_Range);
+  static void releaseIndices(const CResources::MeshBufferRange& p_Range);
+  static void freeReleasedRange(const Name& p_TypeName, void* p_UserData0,
+                                void* p_UserData1);
+
+  // <-
+
+  _INTR_INLINE static const Resources::BufferRefArray&
+  getVertexBuffers(const CResources::MeshBufferRange& p_Range)
+  {
+    return _vertexBuffersPerBlock[p_Range.blockIdx];
+  }
+  _INTR_INLINE static Resources::BufferRef
+  getIndexBuffer(const CResources::MeshBufferRange& p_Range)
+  {
+    return _indexBufferPerBlock[p_Range.blockIdx];
+  }
+
+  // Device local, one buffer per vertex stream for each vertex block
+  static _INTR_ARRAY(Resources::BufferRefArray) _vertexBuffersPerBlock;
+  // Device local, either 16 or 32 bit indices
+  static Resources::BufferRefArray _indexBufferPerBlock;
+};
+}
+}
@@ -15,17 +15,29 @@
 #pragma once
 
 #define _INTR_VK_SECONDARY_COMMAND_BUFFER_COUNT 128u
+// Secondary command buffers kept across frames, one per shadow map
+#define _INTR_VK_PERSISTENT_SECONDARY_COMMAND_BUFFER_COUNT                     \
+  _INTR_MAX_SHADOW_MAP_COUNT
 
 #define _INTR_VK_PER_INSTANCE_DATA_BUFFER_COUNT 2u
 
-#define _INTR_VK_PER_INSTANCE_BLOCK_SMALL_SIZE_IN_BYTES 512u
-#define _INTR_VK_PER_INSTANCE_BLOCK_SMALL_COUNT _INTR_MAX_DRAW_CALL_COUNT
+// Per instance blocks are allocated for each non instanced draw and compute
+// call per frame, independent of the amount of draw calls alive. Small blocks
+// match the largest minUniformBufferOffsetAlignment allowed by the spec
+#define _INTR_VK_PER_INSTANCE_BLOCK_SMALL_SIZE_IN_BYTES 256u
+#define _INTR_VK_PER_INSTANCE_BLOCK_SMALL_COUNT 65536u
 #define _INTR_VK_PER_INSTANCE_BLOCK_LARGE_SIZE_IN_BYTES 2048u
-#define _INTR_VK_PER_INSTANCE_BLOCK_LARGE_COUNT 256u
+#define _INTR_VK_PER_INSTANCE_BLOCK_LARGE_COUNT 1024u
+// Small blocks per persistent region, one region per persistent secondary
+// command buffer and swapchain image
+#define _INTR_VK_PER_INSTANCE_PERSISTENT_BLOCK_COUNT 2048u
 
 #define _INTR_VK_PER_FRAME_BLOCK_SIZE_IN_BYTES 512u
+// Materials with GPU resources (material buffer entries and per material
+// blocks for the vertex and fragment stage) alive at the same time
+#define _INTR_VK_MAX_MATERIAL_COUNT 8192u
 #define _INTR_VK_PER_MATERIAL_BLOCK_SIZE_IN_BYTES 256u
-#define _INTR_VK_PER_MATERIAL_BLOCK_COUNT _INTR_MAX_MATERIAL_COUNT
+#define _INTR_VK_PER_MATERIAL_BLOCK_COUNT (_INTR_VK_MAX_MATERIAL_COUNT * 2u)
 
 #define _INTR_VK_PER_INSTANCE_UNIFORM_MEMORY_IN_BYTES                          \
   (_INTR_VK_PER_INSTANCE_DATA_BUFFER_COUNT *                                   \
@@ -40,7 +52,8 @@
 
 #define _INTR_PSSM_SPLIT_COUNT 4u
 #define _INTR_MAX_SHADOW_MAP_COUNT 4u
-#define _INTR_MAX_FRUSTUMS_PER_FRAME_COUNT 16u
+// Frustums the per frustum buffer holds for each frame before growing
+#define _INTR_VK_INITIAL_FRUSTUMS_PER_FRAME_COUNT 16u
 
 // Vulkan macros
 #if !defined(_INTR_FINAL_BUILD)
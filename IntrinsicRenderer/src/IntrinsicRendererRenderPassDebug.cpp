@@ -61,17 +61,21 @@ bool _parseBenchmark = true;
 
 void displayWorldBoundingSpheres()
 {
-  for (uint32_t i = 0u; i < Components::NodeManager::_activeRefs.size(); ++i)
+  if (CResources::FrustumManager::_visibleNodesPerFrustum.empty())
   {
-    Components::NodeRef nodeRef = Components::NodeManager::_activeRefs[i];
+    return;
+  }
 
-    if ((Components::NodeManager::_visibilityMask(nodeRef) & 1u) > 0u)
-    {
-      Math::Sphere& worldBoundingSphere =
-          Components::NodeManager::_worldBoundingSphere(nodeRef);
-      Debug::renderSphere(worldBoundingSphere.p, worldBoundingSphere.r,
-                          glm::vec3(0.0f, 1.0f, 0.0f));
-    }
+  // Display the Nodes visible in the first frustum
+  const Dod::RefArray& visibleNodes =
+      CResources::FrustumManager::_visibleNodesPerFrustum[0];
+
+  for (uint32_t i = 0u; i < visibleNodes.size(); ++i)
+  {
+    Math::Sphere& worldBoundingSphere =
+        Components::NodeManager::_worldBoundingSphere(visibleNodes[i]);
+    Debug::renderSphere(worldBoundingSphere.p, worldBoundingSphere.r,
+                        glm::vec3(0.0f, 1.0f, 0.0f));
   }
 }
 
@@ -519,17 +523,15 @@ void Debug::render(float p_DeltaT, Components::CameraRef p_CameraRef)
   _INTR_PROFILE_CPU("Render Pass", "Render Debug Geometry");
   _INTR_PROFILE_GPU("Render Debug Geometry");
 
-  static DrawCallRefArray visibleDrawCalls;
-  static DrawCallRefArray visibleMeshDrawCalls;
-  visibleMeshDrawCalls.clear();
-  visibleDrawCalls.clear();
-
   if (GameStates::Manager::getActiveGameState() !=
       GameStates::GameState::kEditing)
   {
     return;
   }
 
+  DrawCallRefFrameArray visibleDrawCalls;
+  DrawCallRefFrameArray visibleMeshDrawCalls;
+
   GameStates::Editing::findVisibleEditingDrawCalls(visibleDrawCalls);
   GameStates::Editing::updatePerInstanceData();
 
@@ -587,6 +589,8 @@ void Debug::render(float p_DeltaT, Components::CameraRef p_CameraRef)
         p_CameraRef, 0u,
         MaterialManager::getMaterialPassId(_N(GBufferWireframe)))
         .copy(visibleMeshDrawCalls);
+    CComponents::MeshManager::selectLods(visibleMeshDrawCalls, p_CameraRef,
+                                         0u);
     // Update per mesh uniform data
     CComponents::MeshManager::updateUniformData(visibleMeshDrawCalls);
 
@@ -619,6 +623,14 @@ void Debug::render(float p_DeltaT, Components::CameraRef p_CameraRef)
                                        _framebufferRef);
     _INTR_PROFILE_COUNTER_SET("Dispatched Draw Calls (Debug)",
                               DrawCallDispatcher::_dispatchedDrawCallCount);
+    _INTR_PROFILE_COUNTER_SET("Pipeline Binds (Debug)",
+                              DrawCallDispatcher::_pipelineBindCount);
+    _INTR_PROFILE_COUNTER_SET("Descriptor Set Binds (Debug)",
+                              DrawCallDispatcher::_descriptorSetBindCount);
+    _INTR_PROFILE_COUNTER_SET("Vertex Buffer Binds (Debug)",
+                              DrawCallDispatcher::_vertexBufferBindCount);
+    _INTR_PROFILE_COUNTER_SET("Index Buffer Binds (Debug)",
+                              DrawCallDispatcher::_indexBufferBindCount);
   }
   RenderSystem::endRenderPass(_renderPassRef);
 
@@ -135,7 +135,14 @@ void GenericFullscreen::init(const rapidjson::Value& p_RenderPassDesc)
           _drawCallRef, _N(PerFrame), GpuProgramType::kVertex,
           UniformManager::_perFrameUniformBuffer, UboType::kPerFrameVertex,
           sizeof(RenderProcess::PerFrameDataVertex));
-      ;
+    }
+    if (p_RenderPassDesc.HasMember("needsPerFrustumBufferVertex") &&
+        p_RenderPassDesc["needsPerFrustumBufferVertex"].GetBool())
+    {
+      DrawCallManager::bindBuffer(
+          _drawCallRef, _N(PerFrustumBuffer), GpuProgramType::kVertex,
+          UniformManager::_perFrustumBuffer, UboType::kInvalidUbo,
+          BufferManager::_descSizeInBytes(UniformManager::_perFrustumBuffer));
     }
 
     for (uint32_t i = 0u; i < inputs.Size(); ++i)
@@ -34,19 +34,6 @@ void GenericMesh::init(const rapidjson::Value& p_RenderPassDesc)
   {
     _materialPassNames.push_back(materialPassDescs[i].GetString());
   }
-
-  if (p_RenderPassDesc["renderOrder"] == "FrontToBack")
-  {
-    _renderOrder = RenderOrder::kFrontToBack;
-  }
-  else if (p_RenderPassDesc["renderOrder"] == "BackToFront")
-  {
-    _renderOrder = RenderOrder::kBackToFront;
-  }
-  else
-  {
-    _INTR_ASSERT(false && "Unknown render order");
-  }
 }
 
 // <-
@@ -68,8 +55,9 @@ void GenericMesh::render(float p_DeltaT, Components::CameraRef p_CameraRef)
   _INTR_PROFILE_GPU_DEFINE(GenericMeshGPU, _name.c_str());
   _INTR_PROFILE_GPU_CUSTOM(GenericMeshGPU, _name.c_str());
 
-  static DrawCallRefArray visibleDrawCalls;
-  visibleDrawCalls.clear();
+  DrawCallRefFrameArray visibleDrawCalls;
+  InstancedDrawArray instancedDraws;
+  IndirectDrawArray indirectDraws;
 
   if (_materialPassIds.size() != _materialPassNames.size())
   {
@@ -91,10 +79,20 @@ void GenericMesh::render(float p_DeltaT, Components::CameraRef p_CameraRef)
         .copy(visibleDrawCalls);
   }
 
-  if (_renderOrder == RenderOrder::kFrontToBack)
-    DrawCallManager::sortDrawCallsFrontToBack(visibleDrawCalls);
-  else if (_renderOrder == RenderOrder::kBackToFront)
-    DrawCallManager::sortDrawCallsBackToFront(visibleDrawCalls);
+  CComponents::MeshManager::selectLods(visibleDrawCalls, p_CameraRef, 0u);
+  DrawCallManager::sortDrawCalls(visibleDrawCalls);
+
+  // GPU culling batches the instanceable draw calls itself
+  if (Settings::Manager::_gpuCulling)
+  {
+    GpuCulling::cullDrawCalls(visibleDrawCalls,
+                              Components::CameraManager::_frustum(p_CameraRef),
+                              indirectDraws);
+  }
+  else if (Settings::Manager::_instancing)
+  {
+    Instancing::mergeDrawCalls(visibleDrawCalls, instancedDraws);
+  }
 
   // Update per mesh uniform data
   {
@@ -110,7 +108,8 @@ void GenericMesh::render(float p_DeltaT, Components::CameraRef p_CameraRef)
       _renderPassRef, fbRef, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS,
       (uint32_t)_clearValues.size(), _clearValues.data());
   {
-    DrawCallDispatcher::queueDrawCalls(visibleDrawCalls, _renderPassRef, fbRef);
+    DrawCallDispatcher::queueDrawCalls(visibleDrawCalls, _renderPassRef, fbRef,
+                                       &instancedDraws, &indirectDraws);
   }
   RenderSystem::endRenderPass(_renderPassRef);
 }
@@ -34,7 +34,6 @@ private:
 
   _INTR_ARRAY(_INTR_STRING) _materialPassNames;
   _INTR_ARRAY(uint8_t) _materialPassIds;
-  RenderOrder::Enum _renderOrder;
 };
 }
 }
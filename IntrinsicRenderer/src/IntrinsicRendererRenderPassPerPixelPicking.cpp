@@ -186,8 +186,7 @@ void PerPixelPicking::render(float p_DeltaT, Components::CameraRef p_CameraRef)
   _INTR_PROFILE_CPU("Render Pass", "Render Per Pixel Picking");
   _INTR_PROFILE_GPU("Render Per Pixel Picking");
 
-  static DrawCallRefArray visibleDrawCalls;
-  visibleDrawCalls.clear();
+  DrawCallRefFrameArray visibleDrawCalls;
 
   RenderProcess::Default::getVisibleDrawCalls(
       p_CameraRef, 0u, MaterialManager::getMaterialPassId(_N(PerPixelPicking)))
@@ -198,6 +197,8 @@ void PerPixelPicking::render(float p_DeltaT, Components::CameraRef p_CameraRef)
     return;
   }
 
+  CComponents::MeshManager::selectLods(visibleDrawCalls, p_CameraRef, 0u);
+
   // Update per mesh uniform data
   {
     CComponents::MeshManager::updateUniformData(visibleDrawCalls);
@@ -224,6 +225,14 @@ void PerPixelPicking::render(float p_DeltaT, Components::CameraRef p_CameraRef)
                                        _framebufferRef);
     _INTR_PROFILE_COUNTER_SET("Dispatched Draw Calls (Per Pixel Picking)",
                               DrawCallDispatcher::_dispatchedDrawCallCount);
+    _INTR_PROFILE_COUNTER_SET("Pipeline Binds (Per Pixel Picking)",
+                              DrawCallDispatcher::_pipelineBindCount);
+    _INTR_PROFILE_COUNTER_SET("Descriptor Set Binds (Per Pixel Picking)",
+                              DrawCallDispatcher::_descriptorSetBindCount);
+    _INTR_PROFILE_COUNTER_SET("Vertex Buffer Binds (Per Pixel Picking)",
+                              DrawCallDispatcher::_vertexBufferBindCount);
+    _INTR_PROFILE_COUNTER_SET("Index Buffer Binds (Per Pixel Picking)",
+                              DrawCallDispatcher::_indexBufferBindCount);
   }
   RenderSystem::endRenderPass(_renderPassRef);
 
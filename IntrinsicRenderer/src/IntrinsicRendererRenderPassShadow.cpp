@@ -30,11 +30,123 @@ ImageRef _shadowBufferImageRef;
 _INTR_ARRAY(FramebufferRef) _framebufferRefs;
 RenderPassRef _renderPassRef;
 
+// Sun rotations below ~0.25 degrees are ignored to keep the static caster
+// command buffers alive
+const float _sunDirChangeThreshold = 0.99999f;
+glm::vec3 _sunDir = glm::vec3(0.0f, 0.0f, 1.0f);
+
+struct StaticCasterCacheEntry
+{
+  uint64_t signature;
+  glm::mat4 viewProjMatrix;
+  // Indexes the matrices in the per frame data
+  uint32_t frustumId;
+  bool valid;
+};
+
+// One entry per shadow map and swapchain image
+_INTR_ARRAY(StaticCasterCacheEntry) _staticCasterCache;
+
+// <-
+
+_INTR_INLINE uint64_t
+calcStaticCasterSignature(const DrawCallRefFrameArray& p_DrawCalls)
+{
+  // Independent of the order since the draw calls are sorted by depth
+  uint64_t signature = p_DrawCalls.size();
+
+  for (uint32_t dcIdx = 0u; dcIdx < p_DrawCalls.size(); ++dcIdx)
+  {
+    DrawCallRef dcRef = p_DrawCalls[dcIdx];
+
+    const glm::mat4& worldMatrix = Components::NodeManager::_worldMatrix(
+        Components::MeshManager::_node(
+            DrawCallManager::_descMeshComponent(dcRef)));
+    VkPipeline vkPipeline =
+        PipelineManager::_vkPipeline(DrawCallManager::_descPipeline(dcRef));
+    VkDescriptorSet vkDescSet = DrawCallManager::_vkDescriptorSet(dcRef);
+
+    uint64_t dcHash =
+        Math::hash64((const char*)&worldMatrix, sizeof(glm::mat4));
+    dcHash = dcHash * 31u +
+             Math::hash64((const char*)&vkPipeline, sizeof(VkPipeline));
+    dcHash = dcHash * 31u +
+             Math::hash64((const char*)&vkDescSet, sizeof(VkDescriptorSet));
+    dcHash = dcHash * 31u + ((uint64_t)dcRef._generation << 24u | dcRef._id);
+    // Recorded with the index range of the selected LOD
+    dcHash = dcHash * 31u + DrawCallManager::_descFirstIndex(dcRef);
+
+    signature += dcHash;
+  }
+
+  return signature;
+}
+
+// <-
+
+_INTR_INLINE bool updateStaticCasterCache(uint32_t p_ShadowMapIdx,
+                                          FrustumRef p_FrustumRef,
+                                          uint32_t p_FrustumId,
+                                          DrawCallRefFrameArray& p_DrawCalls)
+{
+  _INTR_PROFILE_CPU("Render Pass", "Updt. Static Shadow Casters");
+
+  StaticCasterCacheEntry& entry =
+      _staticCasterCache[RenderSystem::_backbufferIndex *
+                             _INTR_MAX_SHADOW_MAP_COUNT +
+                         p_ShadowMapIdx];
+  const uint64_t signature = calcStaticCasterSignature(p_DrawCalls);
+  const glm::mat4& viewProjMatrix =
+      FrustumManager::_viewProjectionMatrix(p_FrustumRef);
+
+  if (entry.valid && entry.signature == signature &&
+      entry.viewProjMatrix == viewProjMatrix &&
+      entry.frustumId == p_FrustumId)
+  {
+    ++Shadow::_reusedStaticCasterCmdBufferCount;
+    return true;
+  }
+
+  // A caster, the light or the cascade moved
+  if (entry.valid)
+  {
+    ++Shadow::_invalidatedStaticCasterCmdBufferCount;
+    entry.valid = false;
+  }
+
+  DrawCallManager::sortDrawCalls(p_DrawCalls);
+
+  // The recorded dynamic offsets have to stay valid across frames
+  UniformManager::beginPersistentPerInstanceDataAllocation(p_ShadowMapIdx);
+  Components::MeshManager::updateUniformData(p_DrawCalls);
+  if (!UniformManager::endPersistentPerInstanceDataAllocation())
+  {
+    return false;
+  }
+
+  RenderSystem::beginPersistentSecondaryCommandBuffer(
+      p_ShadowMapIdx, RenderPassManager::_vkRenderPass(_renderPassRef),
+      FramebufferManager::_vkFrameBuffer(_framebufferRefs[p_ShadowMapIdx]));
+  DrawCallDispatcher::recordDrawCalls(
+      p_DrawCalls,
+      RenderSystem::getPersistentSecondaryCommandBuffer(p_ShadowMapIdx));
+  RenderSystem::endPersistentSecondaryCommandBuffer(p_ShadowMapIdx);
+
+  entry.signature = signature;
+  entry.viewProjMatrix = viewProjMatrix;
+  entry.frustumId = p_FrustumId;
+  entry.valid = true;
+
+  ++Shadow::_recordedStaticCasterCmdBufferCount;
+  return true;
+}
+
 // <-
 
 _INTR_INLINE void calculateFrustumForSplit(uint32_t p_SplitIdx,
                                            FrustumRef p_FrustumRef,
-                                           Components::CameraRef p_CameraRef)
+                                           Components::CameraRef p_CameraRef,
+                                           const glm::vec3& p_SunDir)
 {
   _INTR_PROFILE_CPU("Render Pass", "Calc. Shadow Map Matrices");
 
@@ -51,12 +163,7 @@ _INTR_INLINE void calculateFrustumForSplit(uint32_t p_SplitIdx,
   const float worldBoundsHalfExtentLength = glm::length(worldBoundsHalfExtent);
   const glm::vec3 worldBoundsCenter = Math::calcAABBCenter(worldBounds);
 
-  glm::vec3 euler =
-      glm::eulerAngles(PostEffectManager::calcActualSunOrientation(
-          PostEffectManager::_blendTargetRef));
-  const glm::vec3 sunDir = glm::quat(euler) * glm::vec3(0.0f, 0.0f, 1.0f);
-
-  const glm::vec3 eye = worldBoundsHalfExtentLength * sunDir;
+  const glm::vec3 eye = worldBoundsHalfExtentLength * p_SunDir;
   const glm::vec3 center = glm::vec3(0.0f, 0.0f, 0.0f);
 
   glm::mat4& shadowViewMatrix = FrustumManager::_descViewMatrix(p_FrustumRef);
@@ -152,6 +259,9 @@ _INTR_INLINE void calculateFrustumForSplit(uint32_t p_SplitIdx,
 
 // Static members
 glm::uvec2 Shadow::_shadowMapSize = glm::uvec2(1536u, 1536u);
+uint32_t Shadow::_recordedStaticCasterCmdBufferCount = 0u;
+uint32_t Shadow::_reusedStaticCasterCmdBufferCount = 0u;
+uint32_t Shadow::_invalidatedStaticCasterCmdBufferCount = 0u;
 
 // <-
 
@@ -219,7 +329,11 @@ void Shadow::init()
 
 // <-
 
-void Shadow::onReinitRendering() {}
+void Shadow::onReinitRendering()
+{
+  // Pipelines and draw calls get recreated
+  _staticCasterCache.clear();
+}
 
 // <-
 
@@ -238,12 +352,23 @@ void Shadow::prepareFrustums(Components::CameraRef p_CameraRef,
   }
   p_ShadowFrustums.clear();
 
+  glm::vec3 euler =
+      glm::eulerAngles(PostEffectManager::calcActualSunOrientation(
+          PostEffectManager::_blendTargetRef));
+  const glm::vec3 sunDir = glm::quat(euler) * glm::vec3(0.0f, 0.0f, 1.0f);
+
+  if (!Settings::Manager::_staticShadowCaching ||
+      glm::dot(sunDir, _sunDir) < _sunDirChangeThreshold)
+  {
+    _sunDir = sunDir;
+  }
+
   for (uint32_t shadowMapIdx = 0u; shadowMapIdx < _INTR_PSSM_SPLIT_COUNT;
        ++shadowMapIdx)
   {
     FrustumRef frustumRef = FrustumManager::createFrustum(_N(ShadowFrustum));
 
-    calculateFrustumForSplit(shadowMapIdx, frustumRef, p_CameraRef);
+    calculateFrustumForSplit(shadowMapIdx, frustumRef, p_CameraRef, _sunDir);
 
     p_ShadowFrustums.push_back(frustumRef);
   }
@@ -258,9 +383,27 @@ void Shadow::render(float p_DeltaT, Components::CameraRef p_CameraRef)
 
   _INTR_PROFILE_COUNTER_SET("Dispatched Draw Calls (Shadows)",
                             DrawCallDispatcher::_dispatchedDrawCallCount);
+  _INTR_PROFILE_COUNTER_SET("Pipeline Binds (Shadows)",
+                            DrawCallDispatcher::_pipelineBindCount);
+  _INTR_PROFILE_COUNTER_SET("Descriptor Set Binds (Shadows)",
+                            DrawCallDispatcher::_descriptorSetBindCount);
+  _INTR_PROFILE_COUNTER_SET("Vertex Buffer Binds (Shadows)",
+                            DrawCallDispatcher::_vertexBufferBindCount);
+  _INTR_PROFILE_COUNTER_SET("Index Buffer Binds (Shadows)",
+                            DrawCallDispatcher::_indexBufferBindCount);
 
   const _INTR_ARRAY(FrustumRef)& shadowFrustums =
       RenderProcess::Default::_shadowFrustums[p_CameraRef];
+
+  const uint32_t staticCasterCacheSize =
+      (uint32_t)RenderSystem::_vkSwapchainImages.size() *
+      _INTR_MAX_SHADOW_MAP_COUNT;
+  if (_staticCasterCache.size() != staticCasterCacheSize)
+  {
+    _staticCasterCache.clear();
+    _staticCasterCache.resize(staticCasterCacheSize);
+  }
+
   for (uint32_t shadowMapIdx = 0u; shadowMapIdx < shadowFrustums.size();
        ++shadowMapIdx)
   {
@@ -275,12 +418,39 @@ void Shadow::render(float p_DeltaT, Components::CameraRef p_CameraRef)
 
     const uint32_t frustumIdx = shadowMapIdx + 1u;
 
-    static DrawCallRefArray visibleDrawCalls;
-    visibleDrawCalls.clear();
+    DrawCallRefFrameArray visibleDrawCalls;
+    DrawCallRefFrameArray staticDrawCalls;
+    InstancedDrawArray instancedDraws;
+    IndirectDrawArray indirectDraws;
 
     RenderProcess::Default::getVisibleDrawCalls(
         p_CameraRef, frustumIdx, MaterialManager::getMaterialPassId(_N(Shadow)))
         .copy(visibleDrawCalls);
+
+    // Static casters of the (non-animated) shadow pass are kept in a
+    // persistent command buffer
+    if (Settings::Manager::_staticShadowCaching)
+    {
+      uint32_t dynamicDrawCallCount = 0u;
+      for (uint32_t dcIdx = 0u; dcIdx < visibleDrawCalls.size(); ++dcIdx)
+      {
+        DrawCallRef dcRef = visibleDrawCalls[dcIdx];
+        Components::MeshRef meshCompRef =
+            DrawCallManager::_descMeshComponent(dcRef);
+
+        if (meshCompRef.isValid() &&
+            Components::MeshManager::_staticShadowCaster(meshCompRef))
+        {
+          staticDrawCalls.push_back(dcRef);
+        }
+        else
+        {
+          visibleDrawCalls[dynamicDrawCallCount++] = dcRef;
+        }
+      }
+      visibleDrawCalls.resize(dynamicDrawCallCount);
+    }
+
     RenderProcess::Default::getVisibleDrawCalls(
         p_CameraRef, frustumIdx,
         MaterialManager::getMaterialPassId(_N(ShadowFoliage)))
@@ -290,11 +460,45 @@ void Shadow::render(float p_DeltaT, Components::CameraRef p_CameraRef)
         MaterialManager::getMaterialPassId(_N(ShadowGrass)))
         .copy(visibleDrawCalls);
 
-    DrawCallManager::sortDrawCallsFrontToBack(visibleDrawCalls);
+    Components::MeshManager::selectLods(visibleDrawCalls, p_CameraRef,
+                                        frustumIdx);
+    Components::MeshManager::selectLods(staticDrawCalls, p_CameraRef,
+                                        frustumIdx);
+
+    Components::MeshManager::updatePerInstanceData(p_CameraRef, frustumIdx);
+
+    bool staticDrawCallsCached = false;
+    if (!staticDrawCalls.empty())
+    {
+      const uint32_t frustumId =
+          RenderProcess::Default::_cameraToIdMapping[p_CameraRef] + frustumIdx;
+      staticDrawCallsCached = updateStaticCasterCache(
+          shadowMapIdx, frustumRef, frustumId, staticDrawCalls);
+
+      // Out of persistent memory, dispatched with the dynamic casters instead
+      if (!staticDrawCallsCached)
+      {
+        visibleDrawCalls.insert(visibleDrawCalls.end(),
+                                staticDrawCalls.begin(), staticDrawCalls.end());
+      }
+    }
+
+    DrawCallManager::sortDrawCalls(visibleDrawCalls);
 
     // Update per mesh uniform data
     {
-      Components::MeshManager::updatePerInstanceData(p_CameraRef, frustumIdx);
+      // Instances and batches use the frustum of the per instance data of
+      // their first draw call
+      if (Settings::Manager::_gpuCulling)
+      {
+        GpuCulling::cullDrawCalls(visibleDrawCalls, frustumRef,
+                                  indirectDraws);
+      }
+      else if (Settings::Manager::_instancing)
+      {
+        Instancing::mergeDrawCalls(visibleDrawCalls, instancedDraws);
+      }
+
       CComponents::MeshManager::updateUniformData(visibleDrawCalls);
     }
 
@@ -308,10 +512,27 @@ void Shadow::render(float p_DeltaT, Components::CameraRef p_CameraRef)
         _renderPassRef, _framebufferRefs[shadowMapIdx],
         VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS, 1u, clearValues);
     {
-      DrawCallDispatcher::queueDrawCalls(visibleDrawCalls, _renderPassRef,
-                                         _framebufferRefs[shadowMapIdx]);
+      if (staticDrawCallsCached)
+      {
+        VkCommandBuffer staticCmdBuffer =
+            RenderSystem::getPersistentSecondaryCommandBuffer(shadowMapIdx);
+        vkCmdExecuteCommands(RenderSystem::getPrimaryCommandBuffer(), 1u,
+                             &staticCmdBuffer);
+      }
+
+      DrawCallDispatcher::queueDrawCalls(
+          visibleDrawCalls, _renderPassRef, _framebufferRefs[shadowMapIdx],
+          &instancedDraws, &indirectDraws);
       _INTR_PROFILE_COUNTER_ADD("Dispatched Draw Calls (Shadows)",
                                 DrawCallDispatcher::_dispatchedDrawCallCount);
+      _INTR_PROFILE_COUNTER_ADD("Pipeline Binds (Shadows)",
+                                DrawCallDispatcher::_pipelineBindCount);
+      _INTR_PROFILE_COUNTER_ADD("Descriptor Set Binds (Shadows)",
+                                DrawCallDispatcher::_descriptorSetBindCount);
+      _INTR_PROFILE_COUNTER_ADD("Vertex Buffer Binds (Shadows)",
+                                DrawCallDispatcher::_vertexBufferBindCount);
+      _INTR_PROFILE_COUNTER_ADD("Index Buffer Binds (Shadows)",
+                                DrawCallDispatcher::_indexBufferBindCount);
     }
     RenderSystem::endRenderPass(_renderPassRef);
 
@@ -34,6 +34,11 @@ struct Shadow
   static void render(float p_DeltaT, Components::CameraRef p_CameraRef);
 
   static glm::uvec2 _shadowMapSize;
+
+  // Command buffers of static shadow casters
+  static uint32_t _recordedStaticCasterCmdBufferCount;
+  static uint32_t _reusedStaticCasterCmdBufferCount;
+  static uint32_t _invalidatedStaticCasterCmdBufferCount;
 };
 }
 }
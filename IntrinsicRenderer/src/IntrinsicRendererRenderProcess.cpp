@@ -182,15 +182,38 @@ Dod::RefArray Default::_activeFrustums;
 
 _INTR_HASH_MAP(Components::CameraRef, _INTR_ARRAY(Dod::Ref))
 Default::_shadowFrustums;
-_INTR_HASH_MAP(Components::CameraRef, uint8_t)
+_INTR_HASH_MAP(Components::CameraRef, uint32_t)
 Default::_cameraToIdMapping;
 
-Containers::LockFreeStack<Core::Dod::Ref, _INTR_MAX_DRAW_CALL_COUNT>
-    RenderProcess::Default::_visibleDrawCallsPerMaterialPass
-        [_INTR_MAX_FRUSTUMS_PER_FRAME_COUNT][_INTR_MAX_MATERIAL_PASS_COUNT];
-Containers::LockFreeStack<Dod::Ref, _INTR_MAX_MESH_COMPONENT_COUNT>
-    RenderProcess::Default::_visibleMeshComponents
-        [_INTR_MAX_FRUSTUMS_PER_FRAME_COUNT];
+_INTR_ARRAY(FrustumVisibility*) Default::_frustumVisibility;
+
+// <-
+
+void Default::prepareFrustumVisibility(uint32_t p_FrustumCount)
+{
+  while (_frustumVisibility.size() < p_FrustumCount)
+  {
+    _frustumVisibility.push_back(new FrustumVisibility());
+  }
+
+  // Grow the stacks with the managers so every draw call and mesh component
+  // alive can be visible
+  const uint32_t meshComponentCount =
+      Components::MeshManager::getActiveResourceCount();
+  for (uint32_t frustIdx = 0u; frustIdx < p_FrustumCount; ++frustIdx)
+  {
+    FrustumVisibility& frustumVisibility = *_frustumVisibility[frustIdx];
+
+    for (uint32_t matPassIdx = 0u;
+         matPassIdx < DrawCallManager::_drawCallsPerMaterialPass.size();
+         ++matPassIdx)
+    {
+      frustumVisibility.visibleDrawCallsPerMaterialPass[matPassIdx].reserve(
+          DrawCallManager::_drawCallsPerMaterialPass[matPassIdx].size());
+    }
+    frustumVisibility.visibleMeshComponents.reserve(meshComponentCount);
+  }
+}
 
 // <-
 
@@ -399,7 +422,7 @@ void Default::renderFrame(float p_DeltaT)
         Components::CameraRef camRef = _cameras[i];
 
         FrustumRef frustumRef = Components::CameraManager::_frustum(camRef);
-        _cameraToIdMapping[camRef] = (uint8_t)_activeFrustums.size();
+        _cameraToIdMapping[camRef] = (uint32_t)_activeFrustums.size();
         _activeFrustums.push_back(frustumRef);
 
         // Only allow shadows for the main view
@@ -418,11 +441,28 @@ void Default::renderFrame(float p_DeltaT)
 
       FrustumManager::cullNodes(RenderProcess::Default::_activeFrustums);
 
+      // Remove the Nodes hidden behind occluders from the main view
+      if (Settings::Manager::_occlusionCulling)
+      {
+        auto mainViewIt = _cameraToIdMapping.find(World::_activeCamera);
+        if (mainViewIt != _cameraToIdMapping.end())
+        {
+          OcclusionCulling::cullNodes(
+              Components::CameraManager::_frustum(World::_activeCamera),
+              mainViewIt->second);
+        }
+      }
+
       // Collect visible draw calls and mesh components
       Components::MeshManager::collectDrawCallsAndMeshComponents();
       UniformManager::resetAllocator();
     }
 
+    // Upload the transforms of the Nodes moved since the last frame
+    {
+      TransformBuffer::updateChangedTransforms();
+    }
+
     // Execute render steps
     {
       executeRenderSteps(p_DeltaT);
@@ -20,26 +20,47 @@ namespace Renderer
 {
 namespace RenderProcess
 {
+/**
+ * The draw calls and mesh components visible in a single active frustum.
+ */
+struct FrustumVisibility
+{
+  Containers::LockFreeStack<Core::Dod::Ref, _INTR_MAX_DRAW_CALL_COUNT>
+      visibleDrawCallsPerMaterialPass[_INTR_MAX_MATERIAL_PASS_COUNT];
+  Containers::LockFreeStack<Core::Dod::Ref, _INTR_MAX_MESH_COMPONENT_COUNT>
+      visibleMeshComponents;
+};
+
+// <-
+
 struct Default
 {
   static void loadRendererConfig();
   static void renderFrame(float p_DeltaT);
 
+  /**
+   * Makes sure visibility storage is available for the given number of
+   * active frustums and all draw calls and mesh components currently alive.
+   * Storage is never released, so this only allocates if the counts exceed
+   * all previous frames.
+   */
+  static void prepareFrustumVisibility(uint32_t p_FrustumCount);
+
   // Static members
   // ->
 
   static Core::Dod::RefArray _activeFrustums;
   static _INTR_HASH_MAP(Components::CameraRef,
                         _INTR_ARRAY(Dod::Ref)) _shadowFrustums;
-  static _INTR_HASH_MAP(CResources::FrustumRef, uint8_t) _cameraToIdMapping;
+  static _INTR_HASH_MAP(CResources::FrustumRef, uint32_t) _cameraToIdMapping;
 
   static _INTR_INLINE const
       Containers::LockFreeStack<Core::Dod::Ref, _INTR_MAX_DRAW_CALL_COUNT>&
       getVisibleDrawCalls(Components::CameraRef p_CameraRef,
                           uint32_t p_FrustumIdx, uint32_t p_MaterialPassIdx)
   {
-    return _visibleDrawCallsPerMaterialPass[_cameraToIdMapping[p_CameraRef] +
-                                            p_FrustumIdx][p_MaterialPassIdx];
+    return _frustumVisibility[_cameraToIdMapping[p_CameraRef] + p_FrustumIdx]
+        ->visibleDrawCallsPerMaterialPass[p_MaterialPassIdx];
   }
 
   static _INTR_INLINE const
@@ -47,16 +68,12 @@ struct Default
       getVisibleMeshComponents(Components::CameraRef p_CameraRef,
                                uint32_t p_FrustumIdx)
   {
-    return _visibleMeshComponents[_cameraToIdMapping[p_CameraRef] +
-                                  p_FrustumIdx];
+    return _frustumVisibility[_cameraToIdMapping[p_CameraRef] + p_FrustumIdx]
+        ->visibleMeshComponents;
   }
 
-  static Containers::LockFreeStack<Core::Dod::Ref, _INTR_MAX_DRAW_CALL_COUNT>
-      _visibleDrawCallsPerMaterialPass[_INTR_MAX_FRUSTUMS_PER_FRAME_COUNT]
-                                      [_INTR_MAX_MATERIAL_PASS_COUNT];
-  static Containers::LockFreeStack<Core::Dod::Ref,
-                                   _INTR_MAX_MESH_COMPONENT_COUNT>
-      _visibleMeshComponents[_INTR_MAX_FRUSTUMS_PER_FRAME_COUNT];
+  // Indexed by the active frustum index
+  static _INTR_ARRAY(FrustumVisibility*) _frustumVisibility;
 
   // <-
 };
@@ -275,7 +275,27 @@ void UniformManager::updatePerFrameUniformBufferData(Dod::Ref p_Camera)
 
     PerFrameDataVertex vertexData;
     {
-      // TODO: Nothing here yet
+      const Dod::RefArray& activeFrustums =
+          RenderProcess::Default::_activeFrustums;
+      Renderer::UniformManager::reservePerFrustumDataMemory(
+          (uint32_t)activeFrustums.size());
+
+      const uint32_t firstFrustumIdx =
+          Renderer::UniformManager::getFirstPerFrustumDataIdx();
+      vertexData.data0.x = firstFrustumIdx;
+
+      PerFrustumData* perFrustumData =
+          Renderer::UniformManager::_perFrustumMemory + firstFrustumIdx;
+      for (uint32_t frustumIdx = 0u; frustumIdx < activeFrustums.size();
+           ++frustumIdx)
+      {
+        FrustumRef frustumRef = activeFrustums[frustumIdx];
+
+        perFrustumData[frustumIdx].viewMatrix =
+            FrustumManager::_descViewMatrix(frustumRef);
+        perFrustumData[frustumIdx].viewProjMatrix =
+            FrustumManager::_viewProjectionMatrix(frustumRef);
+      }
     }
     memcpy(perFrameVertexMemory, &vertexData, sizeof(vertexData));
 
@@ -24,7 +24,15 @@ namespace RenderProcess
 {
 struct PerFrameDataVertex
 {
-  glm::vec4 _dummy;
+  // x: Index of the first frustum of this frame in the per frustum buffer
+  glm::uvec4 data0;
+};
+
+// Indexed by the ids of the active frustums
+struct PerFrustumData
+{
+  glm::mat4 viewMatrix;
+  glm::mat4 viewProjMatrix;
 };
 
 struct PerFrameDataFrament
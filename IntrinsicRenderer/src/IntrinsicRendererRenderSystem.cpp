@@ -28,7 +28,6 @@ const float _timeBetweenSwapChainUpdates = 1.0f;
 float _timePassedSinceLastSwapChainUpdate = _timeBetweenSwapChainUpdates;
 
 VkPhysicalDeviceProperties _vkPhysicalDeviceProps;
-VkPhysicalDeviceFeatures _vkPhysicalDeviceFeatures;
 
 _INTR_STRING getPipelineCacheUUID()
 {
@@ -53,6 +52,7 @@ VkInstance RenderSystem::_vkInstance = nullptr;
 VkPhysicalDevice RenderSystem::_vkPhysicalDevice = nullptr;
 VkPhysicalDeviceMemoryProperties
     RenderSystem::_vkPhysicalDeviceMemoryProperties;
+VkPhysicalDeviceFeatures RenderSystem::_vkPhysicalDeviceFeatures;
 
 VkDevice RenderSystem::_vkDevice = nullptr;
 VkPipelineCache RenderSystem::_vkPipelineCache = VK_NULL_HANDLE;
@@ -67,6 +67,8 @@ glm::uvec2 RenderSystem::_customBackbufferDimensions = glm::uvec2(0u, 0u);
 VkQueue RenderSystem::_vkQueue = nullptr;
 
 uint32_t RenderSystem::_vkGraphicsAndComputeQueueFamilyIndex = (uint32_t)-1;
+PFN_vkCmdDrawIndexedIndirectCountAMD
+    RenderSystem::_vkCmdDrawIndexedIndirectCount = nullptr;
 
 // <-
 
@@ -77,9 +79,11 @@ Format::Enum RenderSystem::_depthStencilFormatToUse = Format::kD32SFloat;
 // Private static members
 VkCommandPool RenderSystem::_vkPrimaryCommandPool;
 _INTR_ARRAY(VkCommandPool) RenderSystem::_vkSecondaryCommandPools;
+VkCommandPool RenderSystem::_vkPersistentSecondaryCommandPool;
 
 _INTR_ARRAY(VkCommandBuffer) RenderSystem::_vkCommandBuffers;
 _INTR_ARRAY(VkCommandBuffer) RenderSystem::_vkSecondaryCommandBuffers;
+_INTR_ARRAY(VkCommandBuffer) RenderSystem::_vkPersistentSecondaryCommandBuffers;
 
 VkCommandBuffer RenderSystem::_vkTempCommandBuffer = nullptr;
 VkFence RenderSystem::_vkTempCommandBufferFence = VK_NULL_HANDLE;
@@ -168,6 +172,10 @@ void RenderSystem::init(void* p_PlatformHandle, void* p_PlatformWindow)
   {
     UniformManager::init();
     MaterialBuffer::init();
+    MeshBufferPool::init();
+    TransformBuffer::init();
+    GpuCulling::init();
+    Instancing::init();
   }
 
   // Initializes render passes
@@ -260,6 +268,12 @@ void RenderSystem::releaseQueuedResources()
         vkDestroyPipeline(RenderSystem::_vkDevice, (VkPipeline)entry.userData0,
                           nullptr);
       }
+      else if (entry.typeName == _N(MeshVertexRange) ||
+               entry.typeName == _N(MeshIndexRange))
+      {
+        MeshBufferPool::freeReleasedRange(entry.typeName, entry.userData0,
+                                          entry.userData1);
+      }
       else
       {
         _INTR_ASSERT(false);
@@ -380,14 +394,17 @@ void RenderSystem::dispatchDrawCall(Dod::Ref p_DrawCall,
       vkCmdBindIndexBuffer(
           p_CommandBuffer, BufferManager::_vkBuffer(indexBufferRef),
           DrawCallManager::_indexBufferOffset(p_DrawCall), indexType);
-      vkCmdDrawIndexed(
-          p_CommandBuffer, DrawCallManager::_descIndexCount(p_DrawCall),
-          DrawCallManager::_descInstanceCount(p_DrawCall), 0u, 0u, 0u);
+      vkCmdDrawIndexed(p_CommandBuffer,
+                       DrawCallManager::_descIndexCount(p_DrawCall),
+                       DrawCallManager::_descInstanceCount(p_DrawCall),
+                       DrawCallManager::_descFirstIndex(p_DrawCall),
+                       DrawCallManager::_descVertexOffset(p_DrawCall), 0u);
     }
     else
     {
       vkCmdDraw(p_CommandBuffer, DrawCallManager::_descVertexCount(p_DrawCall),
-                DrawCallManager::_descInstanceCount(p_DrawCall), 0u, 0u);
+                DrawCallManager::_descInstanceCount(p_DrawCall),
+                (uint32_t)DrawCallManager::_descVertexOffset(p_DrawCall), 0u);
     }
   }
 }
@@ -679,6 +696,7 @@ void RenderSystem::initVkDevice()
 
   // Check if debug marker extension is supported
   bool debugMarkerExtPresent = false;
+  const char* drawIndirectCountExtName = nullptr;
   {
     uint32_t extensionCount;
     vkEnumerateDeviceExtensionProperties(_vkPhysicalDevice, nullptr,
@@ -697,6 +715,19 @@ void RenderSystem::initVkDevice()
         _INTR_LOG_INFO("Enabling debug markers...");
         debugMarkerExtPresent = true;
       }
+#if defined(VK_KHR_draw_indirect_count)
+      else if (strcmp(ext.extensionName,
+                      VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME) == 0u)
+      {
+        drawIndirectCountExtName = VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME;
+      }
+#endif // VK_KHR_draw_indirect_count
+      else if (strcmp(ext.extensionName,
+                      VK_AMD_DRAW_INDIRECT_COUNT_EXTENSION_NAME) == 0u &&
+               drawIndirectCountExtName == nullptr)
+      {
+        drawIndirectCountExtName = VK_AMD_DRAW_INDIRECT_COUNT_EXTENSION_NAME;
+      }
     }
   }
 
@@ -705,6 +736,11 @@ void RenderSystem::initVkDevice()
     enabledExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
     if (debugMarkerExtPresent)
       enabledExtensions.push_back(VK_EXT_DEBUG_MARKER_EXTENSION_NAME);
+    if (drawIndirectCountExtName != nullptr)
+    {
+      _INTR_LOG_INFO("Enabling %s...", drawIndirectCountExtName);
+      enabledExtensions.push_back(drawIndirectCountExtName);
+    }
   }
 
   _INTR_ARRAY(const char*) enabledLayers;
@@ -747,6 +783,18 @@ void RenderSystem::initVkDevice()
   if (debugMarkerExtPresent)
     Debugging::initDebugMarkers();
 
+  // Both extensions share the signature of the entry point
+  if (drawIndirectCountExtName != nullptr)
+  {
+    const bool khrExtPresent =
+        strcmp(drawIndirectCountExtName,
+               VK_AMD_DRAW_INDIRECT_COUNT_EXTENSION_NAME) != 0u;
+    _vkCmdDrawIndexedIndirectCount =
+        (PFN_vkCmdDrawIndexedIndirectCountAMD)vkGetDeviceProcAddr(
+            _vkDevice, khrExtPresent ? "vkCmdDrawIndexedIndirectCountKHR"
+                                     : "vkCmdDrawIndexedIndirectCountAMD");
+  }
+
   _INTR_LOG_POP();
 }
 
@@ -1137,6 +1185,24 @@ void RenderSystem::initVkCommandPools()
       _INTR_VK_CHECK_RESULT(result);
     }
   }
+
+  // Persistent second. command pool
+  {
+    VkCommandPoolCreateInfo commandPoolCreateInfo = {};
+    {
+      commandPoolCreateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+      commandPoolCreateInfo.pNext = nullptr;
+      commandPoolCreateInfo.queueFamilyIndex =
+          _vkGraphicsAndComputeQueueFamilyIndex;
+      commandPoolCreateInfo.flags =
+          VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    }
+
+    VkResult result =
+        vkCreateCommandPool(_vkDevice, &commandPoolCreateInfo, nullptr,
+                            &_vkPersistentSecondaryCommandPool);
+    _INTR_VK_CHECK_RESULT(result);
+  }
 }
 
 // <-
@@ -1223,6 +1289,27 @@ void RenderSystem::initVkCommandBuffers()
       _INTR_VK_CHECK_RESULT(result);
     }
   }
+
+  // Persistent secondary cmd buffers
+  {
+    const uint32_t actualPersistentCmdBufferCount =
+        (uint32_t)_vkSwapchainImages.size() *
+        _INTR_VK_PERSISTENT_SECONDARY_COMMAND_BUFFER_COUNT;
+    _vkPersistentSecondaryCommandBuffers.resize(actualPersistentCmdBufferCount);
+
+    VkCommandBufferAllocateInfo cmd = {};
+    {
+      cmd.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+      cmd.pNext = nullptr;
+      cmd.commandPool = _vkPersistentSecondaryCommandPool;
+      cmd.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+      cmd.commandBufferCount = actualPersistentCmdBufferCount;
+    }
+
+    VkResult result = vkAllocateCommandBuffers(
+        _vkDevice, &cmd, _vkPersistentSecondaryCommandBuffers.data());
+    _INTR_VK_CHECK_RESULT(result);
+  }
 }
 
 void RenderSystem::destroyVkCommandBuffers()
@@ -1245,6 +1332,11 @@ void RenderSystem::destroyVkCommandBuffers()
         1u, &_vkSecondaryCommandBuffers[i]);
   }
   _vkSecondaryCommandBuffers.clear();
+
+  vkFreeCommandBuffers(_vkDevice, _vkPersistentSecondaryCommandPool,
+                       (uint32_t)_vkPersistentSecondaryCommandBuffers.size(),
+                       _vkPersistentSecondaryCommandBuffers.data());
+  _vkPersistentSecondaryCommandBuffers.clear();
 }
 
 // <-
@@ -1368,6 +1460,8 @@ void RenderSystem::beginFrame()
 
   UniformManager::onFrameEnded();
   DrawCallDispatcher::onFrameEnded();
+  GpuCulling::onFrameEnded();
+  Instancing::onFrameEnded();
 }
 
 // <-
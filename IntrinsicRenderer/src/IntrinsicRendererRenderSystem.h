@@ -52,6 +52,18 @@ struct RenderSystem
 
   // <-
 
+  // Persistent secondary command buffers are not reset from frame to frame and
+  // only have to be re-recorded if their contents change
+  _INTR_INLINE static VkCommandBuffer
+  getPersistentSecondaryCommandBuffer(uint32_t p_CommandBufferIdx)
+  {
+    return _vkPersistentSecondaryCommandBuffers
+        [_backbufferIndex * _INTR_VK_PERSISTENT_SECONDARY_COMMAND_BUFFER_COUNT +
+         p_CommandBufferIdx];
+  }
+
+  // <-
+
   _INTR_INLINE static uint32_t requestSecondaryCommandBuffers(uint32_t p_Count)
   {
     _INTR_ASSERT((_allocatedSecondaryCmdBufferCount + p_Count) <
@@ -151,6 +163,45 @@ struct RenderSystem
 
   // <-
 
+  _INTR_INLINE static void
+  beginPersistentSecondaryCommandBuffer(uint32_t p_CmdBufferIdx,
+                                        VkRenderPass p_VkRenderPass,
+                                        VkFramebuffer p_VkFramebuffer)
+  {
+    VkCommandBufferInheritanceInfo inheritanceInfo = {};
+    {
+      inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+      inheritanceInfo.pNext = nullptr;
+      inheritanceInfo.renderPass = p_VkRenderPass;
+      inheritanceInfo.framebuffer = p_VkFramebuffer;
+    }
+
+    VkCommandBufferBeginInfo commandBufferBeginInfo = {};
+    {
+      commandBufferBeginInfo.sType =
+          VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+      commandBufferBeginInfo.pNext = nullptr;
+      commandBufferBeginInfo.flags =
+          VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+      commandBufferBeginInfo.pInheritanceInfo = &inheritanceInfo;
+    }
+
+    VkResult result = vkBeginCommandBuffer(
+        getPersistentSecondaryCommandBuffer(p_CmdBufferIdx),
+        &commandBufferBeginInfo);
+    _INTR_VK_CHECK_RESULT(result);
+  }
+
+  _INTR_INLINE static void
+  endPersistentSecondaryCommandBuffer(uint32_t p_CmdBufferIdx)
+  {
+    VkResult result =
+        vkEndCommandBuffer(getPersistentSecondaryCommandBuffer(p_CmdBufferIdx));
+    _INTR_VK_CHECK_RESULT(result);
+  }
+
+  // <-
+
   _INTR_INLINE static VkCommandBuffer beginTemporaryCommandBuffer()
   {
     VkCommandBufferBeginInfo cmdBufInfo = {};
@@ -284,6 +335,8 @@ struct RenderSystem
 
   static VkPhysicalDevice _vkPhysicalDevice;
   static VkPhysicalDeviceMemoryProperties _vkPhysicalDeviceMemoryProperties;
+  // All supported features are enabled
+  static VkPhysicalDeviceFeatures _vkPhysicalDeviceFeatures;
 
   static VkDevice _vkDevice;
   static VkPipelineCache _vkPipelineCache;
@@ -299,6 +352,10 @@ struct RenderSystem
 
   static uint32_t _vkGraphicsAndComputeQueueFamilyIndex;
 
+  // Provided by VK_KHR_draw_indirect_count or VK_AMD_draw_indirect_count,
+  // null if neither of the extensions is supported
+  static PFN_vkCmdDrawIndexedIndirectCountAMD _vkCmdDrawIndexedIndirectCount;
+
   // <-
 
   static uint32_t _backbufferIndex;
@@ -392,9 +449,11 @@ private:
 
   static VkCommandPool _vkPrimaryCommandPool;
   static _INTR_ARRAY(VkCommandPool) _vkSecondaryCommandPools;
+  static VkCommandPool _vkPersistentSecondaryCommandPool;
 
   static _INTR_ARRAY(VkCommandBuffer) _vkCommandBuffers;
   static _INTR_ARRAY(VkCommandBuffer) _vkSecondaryCommandBuffers;
+  static _INTR_ARRAY(VkCommandBuffer) _vkPersistentSecondaryCommandBuffers;
 
   static VkCommandBuffer _vkTempCommandBuffer;
   static VkFence _vkTempCommandBufferFence;
@@ -26,28 +26,28 @@ typedef _INTR_ARRAY(BufferRef) BufferRefArray;
 
 struct BufferData : Dod::Resources::ResourceDataBase
 {
-  BufferData() : Dod::Resources::ResourceDataBase(_INTR_MAX_BUFFER_COUNT)
+  BufferData()
   {
-    descBufferType.resize(_INTR_MAX_BUFFER_COUNT);
-    descMemoryPoolType.resize(_INTR_MAX_BUFFER_COUNT);
-    descSizeInBytes.resize(_INTR_MAX_BUFFER_COUNT);
-    descInitialData.resize(_INTR_MAX_BUFFER_COUNT);
+    registerArray(descBufferType);
+    registerArray(descMemoryPoolType);
+    registerArray(descSizeInBytes);
+    registerArray(descInitialData);
 
-    vkDescriptorBufferInfo.resize(_INTR_MAX_BUFFER_COUNT);
-    vkBuffer.resize(_INTR_MAX_BUFFER_COUNT);
-    memoryAllocationInfo.resize(_INTR_MAX_BUFFER_COUNT);
+    registerArray(vkDescriptorBufferInfo);
+    registerArray(vkBuffer);
+    registerArray(memoryAllocationInfo);
   }
 
   // Description
-  _INTR_ARRAY(BufferType::Enum) descBufferType;
-  _INTR_ARRAY(MemoryPoolType::Enum) descMemoryPoolType;
-  _INTR_ARRAY(uint32_t) descSizeInBytes;
-  _INTR_ARRAY(void*) descInitialData;
+  _INTR_PAGED_ARRAY(BufferType::Enum) descBufferType;
+  _INTR_PAGED_ARRAY(MemoryPoolType::Enum) descMemoryPoolType;
+  _INTR_PAGED_ARRAY(uint32_t) descSizeInBytes;
+  _INTR_PAGED_ARRAY(void*) descInitialData;
 
   // Resources
-  _INTR_ARRAY(VkDescriptorBufferInfo) vkDescriptorBufferInfo;
-  _INTR_ARRAY(VkBuffer) vkBuffer;
-  _INTR_ARRAY(GpuMemoryAllocationInfo) memoryAllocationInfo;
+  _INTR_PAGED_ARRAY(VkDescriptorBufferInfo) vkDescriptorBufferInfo;
+  _INTR_PAGED_ARRAY(VkBuffer) vkBuffer;
+  _INTR_PAGED_ARRAY(GpuMemoryAllocationInfo) memoryAllocationInfo;
 };
 
 struct BufferManager
@@ -38,7 +38,7 @@ void ComputeCallManager::createResources(
 
     // Allocate and init. descriptor set
     descSet = Resources::PipelineLayoutManager::allocateAndWriteDescriptorSet(
-        pipelineLayout, bindInfs);
+        pipelineLayout, bindInfs, _vkDescriptorPool(computeCallRef));
 
     _INTR_ARRAY(BindingInfo)& bindInfos = _descBindInfos(computeCallRef);
 
@@ -192,6 +192,47 @@ void ComputeCallManager::bindBuffer(ComputeCallRef p_DrawCallRef,
 
   _INTR_ASSERT(found);
 }
+
+// <-
+
+void ComputeCallManager::updateBufferBindings(Dod::Ref p_BufferRef)
+{
+  ComputeCallRefArray computeCallsToUpdate;
+
+  for (uint32_t i = 0u; i < _activeRefs.size(); ++i)
+  {
+    ComputeCallRef computeCallRef = _activeRefs[i];
+    if (_vkDescriptorSet(computeCallRef) == VK_NULL_HANDLE)
+    {
+      continue;
+    }
+
+    bool bound = false;
+    _INTR_ARRAY(BindingInfo)& bindInfos = _descBindInfos(computeCallRef);
+    for (uint32_t bindIdx = 0u; bindIdx < bindInfos.size(); ++bindIdx)
+    {
+      BindingInfo& bindInfo = bindInfos[bindIdx];
+
+      if (bindInfo.bindingType == BindingType::kStorageBuffer &&
+          bindInfo.resource == p_BufferRef)
+      {
+        bindInfo.bufferData.rangeInBytes =
+            BufferManager::_descSizeInBytes(p_BufferRef);
+        bound = true;
+      }
+    }
+
+    if (bound)
+    {
+      computeCallsToUpdate.push_back(computeCallRef);
+    }
+  }
+
+  // The previous descriptor sets are released once the frames in flight are
+  // done using them
+  destroyResources(computeCallsToUpdate);
+  createResources(computeCallsToUpdate);
+}
 }
 }
 }
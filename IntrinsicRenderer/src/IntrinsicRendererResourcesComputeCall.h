@@ -27,24 +27,25 @@ typedef _INTR_ARRAY(ComputeCallRef) ComputeCallRefArray;
 struct ComputeCallData : Dod::Resources::ResourceDataBase
 {
   ComputeCallData()
-      : Dod::Resources::ResourceDataBase(_INTR_MAX_COMPUTE_CALL_COUNT)
   {
-    descPipeline.resize(_INTR_MAX_COMPUTE_CALL_COUNT);
-    descBindInfos.resize(_INTR_MAX_COMPUTE_CALL_COUNT);
-    descDimensions.resize(_INTR_MAX_COMPUTE_CALL_COUNT);
+    registerArray(descPipeline);
+    registerArray(descBindInfos);
+    registerArray(descDimensions);
 
-    dynamicOffsets.resize(_INTR_MAX_COMPUTE_CALL_COUNT);
-    vkDescriptorSet.resize(_INTR_MAX_COMPUTE_CALL_COUNT);
+    registerArray(dynamicOffsets);
+    registerArray(vkDescriptorSet);
+    registerArray(vkDescriptorPool);
   }
 
   // Description
-  _INTR_ARRAY(PipelineRef) descPipeline;
-  _INTR_ARRAY(_INTR_ARRAY(BindingInfo)) descBindInfos;
-  _INTR_ARRAY(glm::uvec3) descDimensions;
+  _INTR_PAGED_ARRAY(PipelineRef) descPipeline;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(BindingInfo)) descBindInfos;
+  _INTR_PAGED_ARRAY(glm::uvec3) descDimensions;
 
   // Resources
-  _INTR_ARRAY(_INTR_ARRAY(uint32_t)) dynamicOffsets;
-  _INTR_ARRAY(VkDescriptorSet) vkDescriptorSet;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(uint32_t)) dynamicOffsets;
+  _INTR_PAGED_ARRAY(VkDescriptorSet) vkDescriptorSet;
+  _INTR_PAGED_ARRAY(VkDescriptorPool) vkDescriptorPool;
 };
 
 struct ComputeCallManager
@@ -151,13 +152,13 @@ struct ComputeCallManager
 
       if (vkDescSet != VK_NULL_HANDLE)
       {
-        VkDescriptorPool vkDescPool =
-            PipelineLayoutManager::_vkDescriptorPool(pipelineLayout);
+        VkDescriptorPool& vkDescPool = _vkDescriptorPool(ComputeCallRef);
         _INTR_ASSERT(vkDescPool != VK_NULL_HANDLE);
 
         RenderSystem::releaseResource(_N(VkDescriptorSet), (void*)vkDescSet,
                                       (void*)vkDescPool);
         vkDescSet = VK_NULL_HANDLE;
+        vkDescPool = VK_NULL_HANDLE;
       }
 
       _dynamicOffsets(ComputeCallRef).clear();
@@ -189,6 +190,13 @@ struct ComputeCallManager
                          uint8_t p_UboType, uint32_t p_RangeInBytes,
                          uint32_t p_OffsetInBytes = 0u);
 
+  /**
+   * Updates the bound range of the given storage buffer and recreates the
+   * descriptor sets of all compute calls binding it. Has to be called after
+   * resizing the buffer.
+   */
+  static void updateBufferBindings(Dod::Ref p_BufferRef);
+
   // Description
   _INTR_INLINE static PipelineRef& _descPipeline(PipelineLayoutRef p_Ref)
   {
@@ -214,6 +222,10 @@ struct ComputeCallManager
   {
     return _data.vkDescriptorSet[p_Ref._id];
   }
+  _INTR_INLINE static VkDescriptorPool& _vkDescriptorPool(ComputeCallRef p_Ref)
+  {
+    return _data.vkDescriptorPool[p_Ref._id];
+  }
 };
 }
 }
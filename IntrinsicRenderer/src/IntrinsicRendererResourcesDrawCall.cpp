@@ -29,9 +29,10 @@ DrawCallManager::_drawCallsPerMaterialPass;
 
 // <-
 
-void DrawCallManager::createResources(const DrawCallRefArray& p_DrawCalls)
+void DrawCallManager::createResources(const DrawCallRef* p_DrawCalls,
+                                      uint32_t p_DrawCallCount)
 {
-  for (uint32_t dcIdx = 0u; dcIdx < p_DrawCalls.size(); ++dcIdx)
+  for (uint32_t dcIdx = 0u; dcIdx < p_DrawCallCount; ++dcIdx)
   {
     DrawCallRef drawCallRef = p_DrawCalls[dcIdx];
 
@@ -45,8 +46,18 @@ void DrawCallManager::createResources(const DrawCallRefArray& p_DrawCalls)
     VkDescriptorSet& descSet = _vkDescriptorSet(drawCallRef);
     _INTR_ASSERT(descSet == VK_NULL_HANDLE);
 
-    descSet = Resources::PipelineLayoutManager::allocateAndWriteDescriptorSet(
-        pipelineLayout, bindInfos);
+    // Draw calls binding identical resources only differ in their dynamic
+    // offsets and push constants
+    if (PipelineLayoutManager::_descShareDescriptorSet(pipelineLayout))
+    {
+      descSet = PipelineLayoutManager::acquireSharedDescriptorSet(
+          pipelineLayout, bindInfos);
+    }
+    else
+    {
+      descSet = PipelineLayoutManager::allocateAndWriteDescriptorSet(
+          pipelineLayout, bindInfos, _vkDescriptorPool(drawCallRef));
+    }
 
     // Defaults for now
     _indexBufferOffset(drawCallRef) = 0ull;
@@ -172,6 +183,47 @@ void DrawCallManager::bindBuffer(DrawCallRef p_DrawCallRef, const Name& p_Name,
 
 // <-
 
+void DrawCallManager::updateBufferBindings(Dod::Ref p_BufferRef)
+{
+  DrawCallRefArray drawCallsToUpdate;
+
+  for (uint32_t i = 0u; i < _activeRefs.size(); ++i)
+  {
+    DrawCallRef drawCallRef = _activeRefs[i];
+    if (_vkDescriptorSet(drawCallRef) == VK_NULL_HANDLE)
+    {
+      continue;
+    }
+
+    bool bound = false;
+    _INTR_ARRAY(BindingInfo)& bindInfos = _descBindInfos(drawCallRef);
+    for (uint32_t bindIdx = 0u; bindIdx < bindInfos.size(); ++bindIdx)
+    {
+      BindingInfo& bindInfo = bindInfos[bindIdx];
+
+      if (bindInfo.bindingType == BindingType::kStorageBuffer &&
+          bindInfo.resource == p_BufferRef)
+      {
+        bindInfo.bufferData.rangeInBytes =
+            BufferManager::_descSizeInBytes(p_BufferRef);
+        bound = true;
+      }
+    }
+
+    if (bound)
+    {
+      drawCallsToUpdate.push_back(drawCallRef);
+    }
+  }
+
+  // The previous descriptor sets are released once the frames in flight are
+  // done using them
+  destroyResources(drawCallsToUpdate);
+  createResources(drawCallsToUpdate);
+}
+
+// <-
+
 DrawCallRef DrawCallManager::createDrawCallForMesh(
     const Name& p_Name, Dod::Ref p_Mesh, Dod::Ref p_Material,
     uint8_t p_MaterialPass, uint32_t p_PerInstanceDataVertexSize,
@@ -193,18 +245,41 @@ DrawCallRef DrawCallManager::createDrawCallForMesh(
 
     _INTR_ASSERT(PipelineManager::_vkPipeline(_descPipeline(drawCallMesh)));
 
+    // Sub meshes are ranges in the shared buffers of the mesh buffer pool,
+    // the LODs of a sub mesh are stored one after another in its index range
+    const MeshBufferRange& vertexRange =
+        MeshManager::_vertexRangePerSubMesh(p_Mesh)[p_SubMeshIdx];
+    const MeshBufferRangePerSubMeshArray& lodRanges =
+        MeshManager::_lodIndexRangesPerSubMesh(p_Mesh)[p_SubMeshIdx];
+
     _descVertexBuffers(drawCallMesh) =
-        MeshManager::_vertexBuffersPerSubMesh(p_Mesh)[p_SubMeshIdx];
-    _descIndexBuffer(drawCallMesh) =
-        MeshManager::_indexBufferPerSubMesh(p_Mesh)[p_SubMeshIdx];
-    _descVertexCount(drawCallMesh) =
-        (uint32_t)MeshManager::_descPositionsPerSubMesh(p_Mesh)[p_SubMeshIdx]
-            .size();
-    _descIndexCount(drawCallMesh) =
-        (uint32_t)MeshManager::_descIndicesPerSubMesh(p_Mesh)[p_SubMeshIdx]
-            .size();
+        MeshBufferPool::getVertexBuffers(vertexRange);
+    _descVertexCount(drawCallMesh) = vertexRange.count;
+    _descVertexOffset(drawCallMesh) = (int32_t)vertexRange.offset;
+    _descIndexBuffer(drawCallMesh) = MeshBufferPool::getIndexBuffer(
+        MeshManager::_indexRangePerSubMesh(p_Mesh)[p_SubMeshIdx]);
+
+    LodIndexRangeArray& lodIndexRanges = _descLodIndexRanges(drawCallMesh);
+    lodIndexRanges.resize(lodRanges.size());
+    for (uint32_t lodIdx = 0u; lodIdx < lodRanges.size(); ++lodIdx)
+    {
+      lodIndexRanges[lodIdx].firstIndex = lodRanges[lodIdx].offset;
+      lodIndexRanges[lodIdx].indexCount = lodRanges[lodIdx].count;
+    }
+    selectLod(drawCallMesh, 0u);
+    if (p_SubMeshIdx < MeshManager::_aabbPerSubMesh(p_Mesh).size())
+    {
+      _descLocalAABB(drawCallMesh) =
+          MeshManager::_aabbPerSubMesh(p_Mesh)[p_SubMeshIdx];
+    }
+    _descMesh(drawCallMesh) = p_Mesh;
     _descMaterial(drawCallMesh) = p_Material;
     _descMaterialPass(drawCallMesh) = p_MaterialPass;
+    if (p_Material.isValid())
+    {
+      _descMaterialBufferEntryIdx(drawCallMesh) =
+          MaterialManager::_materialBufferEntryIndex(p_Material);
+    }
 
     MaterialPass::BoundResources& boundResources =
         MaterialManager::_materialPassBoundResources
@@ -257,6 +332,43 @@ DrawCallRef DrawCallManager::createDrawCallForMesh(
                   ? p_PerInstanceDataFragmentSize
                   : p_PerInstanceDataVertexSize);
         }
+        else if (entry.resourceName == _N(MeshInstance))
+        {
+          // Only present in the layouts of passes with an instanced pipeline
+          if (MaterialManager::_materialPasses[p_MaterialPass]
+                  .instancedPipelineIdx !=
+              _INTR_MATERIAL_PASS_INVALID_PIPELINE_IDX)
+          {
+            DrawCallManager::bindBuffer(
+                drawCallMesh, entry.slotName, entry.shaderStage,
+                Instancing::_meshInstanceBuffer, UboType::kInvalidUbo,
+                BufferManager::_descSizeInBytes(
+                    Instancing::_meshInstanceBuffer));
+          }
+        }
+        else if (entry.resourceName == _N(TransformBuffer))
+        {
+          DrawCallManager::bindBuffer(
+              drawCallMesh, entry.slotName, entry.shaderStage,
+              TransformBuffer::_transformBuffer, UboType::kInvalidUbo,
+              BufferManager::_descSizeInBytes(
+                  TransformBuffer::_transformBuffer));
+        }
+        else if (entry.resourceName == _N(PerFrustum))
+        {
+          DrawCallManager::bindBuffer(
+              drawCallMesh, entry.slotName, entry.shaderStage,
+              UniformManager::_perFrustumBuffer, UboType::kInvalidUbo,
+              BufferManager::_descSizeInBytes(
+                  UniformManager::_perFrustumBuffer));
+        }
+        else if (entry.resourceName == _N(MaterialBuffer))
+        {
+          DrawCallManager::bindBuffer(
+              drawCallMesh, entry.slotName, entry.shaderStage,
+              MaterialBuffer::_materialBuffer, UboType::kInvalidUbo,
+              BufferManager::_descSizeInBytes(MaterialBuffer::_materialBuffer));
+        }
         else if (entry.resourceName == _N(PerFrame))
         {
           DrawCallManager::bindBuffer(
@@ -23,51 +23,75 @@ namespace Resources
 // Typedefs
 typedef Dod::Ref DrawCallRef;
 typedef _INTR_ARRAY(DrawCallRef) DrawCallRefArray;
+// Transient arrays of draw calls, valid for the current and the next frame
+typedef _INTR_FRAME_ARRAY(DrawCallRef) DrawCallRefFrameArray;
 
-struct DrawCallData : Dod::Resources::ResourceDataBase
+// The part of the index buffer of a draw call used by a single LOD
+struct LodIndexRange
 {
-  DrawCallData() : Dod::Resources::ResourceDataBase(_INTR_MAX_DRAW_CALL_COUNT)
-  {
-    descVertexCount.resize(_INTR_MAX_DRAW_CALL_COUNT);
-    descIndexCount.resize(_INTR_MAX_DRAW_CALL_COUNT);
-    descInstanceCount.resize(_INTR_MAX_DRAW_CALL_COUNT);
-
-    descPipeline.resize(_INTR_MAX_DRAW_CALL_COUNT);
-    descBindInfos.resize(_INTR_MAX_DRAW_CALL_COUNT);
-    descVertexBuffers.resize(_INTR_MAX_DRAW_CALL_COUNT);
-    descIndexBuffer.resize(_INTR_MAX_DRAW_CALL_COUNT);
-    descMaterial.resize(_INTR_MAX_DRAW_CALL_COUNT);
-    descMaterialPass.resize(_INTR_MAX_DRAW_CALL_COUNT);
-    descMeshComponent.resize(_INTR_MAX_DRAW_CALL_COUNT);
+  uint32_t firstIndex;
+  uint32_t indexCount;
+};
+typedef _INTR_ARRAY(LodIndexRange) LodIndexRangeArray;
 
-    dynamicOffsets.resize(_INTR_MAX_DRAW_CALL_COUNT);
-    vertexBuffers.resize(_INTR_MAX_DRAW_CALL_COUNT);
-    vkDescriptorSet.resize(_INTR_MAX_DRAW_CALL_COUNT);
-    vertexBufferOffsets.resize(_INTR_MAX_DRAW_CALL_COUNT);
-    indexBufferOffset.resize(_INTR_MAX_DRAW_CALL_COUNT);
-    sortingHash.resize(_INTR_MAX_DRAW_CALL_COUNT);
+struct DrawCallData : Dod::Resources::ResourceDataBase
+{
+  DrawCallData()
+  {
+    registerArray(descVertexCount);
+    registerArray(descIndexCount);
+    registerArray(descInstanceCount);
+    registerArray(descFirstIndex);
+    registerArray(descVertexOffset);
+
+    registerArray(descPipeline);
+    registerArray(descBindInfos);
+    registerArray(descVertexBuffers);
+    registerArray(descIndexBuffer);
+    registerArray(descMaterial);
+    registerArray(descMaterialPass);
+    registerArray(descMaterialBufferEntryIdx);
+    registerArray(descMesh);
+    registerArray(descMeshComponent);
+    registerArray(descLodIndexRanges);
+    registerArray(descLocalAABB);
+
+    registerArray(dynamicOffsets);
+    registerArray(vertexBuffers);
+    registerArray(vkDescriptorSet);
+    registerArray(vkDescriptorPool);
+    registerArray(vertexBufferOffsets);
+    registerArray(indexBufferOffset);
+    registerArray(sortingHash);
   }
 
   // Description
-  _INTR_ARRAY(uint32_t) descVertexCount;
-  _INTR_ARRAY(uint32_t) descIndexCount;
-  _INTR_ARRAY(uint32_t) descInstanceCount;
-
-  _INTR_ARRAY(PipelineRef) descPipeline;
-  _INTR_ARRAY(_INTR_ARRAY(BindingInfo)) descBindInfos;
-  _INTR_ARRAY(_INTR_ARRAY(BufferRef)) descVertexBuffers;
-  _INTR_ARRAY(BufferRef) descIndexBuffer;
-  _INTR_ARRAY(Dod::Ref) descMaterial;
-  _INTR_ARRAY(uint8_t) descMaterialPass;
-  _INTR_ARRAY(Dod::Ref) descMeshComponent;
+  _INTR_PAGED_ARRAY(uint32_t) descVertexCount;
+  _INTR_PAGED_ARRAY(uint32_t) descIndexCount;
+  _INTR_PAGED_ARRAY(uint32_t) descInstanceCount;
+  _INTR_PAGED_ARRAY(uint32_t) descFirstIndex;
+  _INTR_PAGED_ARRAY(int32_t) descVertexOffset;
+
+  _INTR_PAGED_ARRAY(PipelineRef) descPipeline;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(BindingInfo)) descBindInfos;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(BufferRef)) descVertexBuffers;
+  _INTR_PAGED_ARRAY(BufferRef) descIndexBuffer;
+  _INTR_PAGED_ARRAY(Dod::Ref) descMaterial;
+  _INTR_PAGED_ARRAY(uint8_t) descMaterialPass;
+  _INTR_PAGED_ARRAY(uint32_t) descMaterialBufferEntryIdx;
+  _INTR_PAGED_ARRAY(Dod::Ref) descMesh;
+  _INTR_PAGED_ARRAY(Dod::Ref) descMeshComponent;
+  _INTR_PAGED_ARRAY(LodIndexRangeArray) descLodIndexRanges;
+  _INTR_PAGED_ARRAY(Math::AABB) descLocalAABB;
 
   // Resources
-  _INTR_ARRAY(_INTR_ARRAY(uint32_t)) dynamicOffsets;
-  _INTR_ARRAY(VkDescriptorSet) vkDescriptorSet;
-  _INTR_ARRAY(_INTR_ARRAY(VkDeviceSize)) vertexBufferOffsets;
-  _INTR_ARRAY(_INTR_ARRAY(VkBuffer)) vertexBuffers;
-  _INTR_ARRAY(VkDeviceSize) indexBufferOffset;
-  _INTR_ARRAY(uint32_t) sortingHash;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(uint32_t)) dynamicOffsets;
+  _INTR_PAGED_ARRAY(VkDescriptorSet) vkDescriptorSet;
+  _INTR_PAGED_ARRAY(VkDescriptorPool) vkDescriptorPool;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(VkDeviceSize)) vertexBufferOffsets;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(VkBuffer)) vertexBuffers;
+  _INTR_PAGED_ARRAY(VkDeviceSize) indexBufferOffset;
+  _INTR_PAGED_ARRAY(uint64_t) sortingHash;
 };
 
 struct DrawCallManager
@@ -217,11 +241,62 @@ struct DrawCallManager
 
   // <-
 
+  /**
+   * Builds the sorting hash from the material pass, the render order of the
+   * pass, the state bits and the distance to the camera. Front to back passes
+   * are sorted by ascending pass index, back to front passes by descending
+   * pass index. Within each pass, draw calls are grouped by state and ordered
+   * front to back or ordered back to front and grouped by state afterwards.
+   */
+  _INTR_INLINE static uint64_t calcSortingHash(uint8_t p_MaterialPassIdx,
+                                               uint8_t p_RenderOrder,
+                                               uint64_t p_State,
+                                               float p_DistToCamera)
+  {
+    // The bit patterns of positive floats are ordered like their values, so
+    // dropping the lowest mantissa bits quantizes the depth to 24 bits
+    // without wrapping around
+    const float distToCamera = glm::max(p_DistToCamera, 0.0f);
+    uint32_t distBits;
+    memcpy(&distBits, &distToCamera, sizeof(uint32_t));
+    const uint64_t depth = distBits >> 7u;
+
+    if (p_RenderOrder == RenderOrder::kBackToFront)
+    {
+      return (uint64_t)(0xFFu - p_MaterialPassIdx) << 56u |
+             (~depth & 0xFFFFFFu) << 32u | (p_State & 0xFFFFFFFFu);
+    }
+
+    return (uint64_t)p_MaterialPassIdx << 56u |
+           (p_State & 0xFFFFFFFFu) << 24u | depth;
+  }
+
+  // <-
+
   _INTR_INLINE static void updateSortingHash(DrawCallRef p_DrawCall,
-                                             float p_DistToCamera2)
+                                             float p_DistToCamera)
   {
-    _sortingHash(p_DrawCall) =
-        (_descMaterialPass(p_DrawCall) << 16u) | (uint16_t)p_DistToCamera2;
+    // Valid ids are below the resource counts, invalid ones are masked to the
+    // largest value of the 11 bit fields
+    static_assert(_INTR_MAX_MATERIAL_PASS_COUNT <= 256u &&
+                      _INTR_MAX_PIPELINE_COUNT <= 1024u &&
+                      _INTR_MAX_MATERIAL_COUNT < 2048u &&
+                      _INTR_MAX_MESH_COUNT < 2048u,
+                  "Resource ids don't fit into the sorting hash");
+
+    const uint8_t materialPassIdx = _descMaterialPass(p_DrawCall);
+
+    // Mesh draw calls share the buffers of the mesh buffer pool, so the mesh
+    // instead of the index buffer groups the draw calls of each sub mesh
+    const uint64_t state =
+        ((uint64_t)_descPipeline(p_DrawCall)._id & 0x3FFu) << 22u |
+        ((uint64_t)_descMaterial(p_DrawCall)._id & 0x7FFu) << 11u |
+        ((uint64_t)_descMesh(p_DrawCall)._id & 0x7FFu);
+
+    _sortingHash(p_DrawCall) = calcSortingHash(
+        materialPassIdx,
+        MaterialManager::_materialPasses[materialPassIdx].renderOrder, state,
+        p_DistToCamera);
   }
 
   // <-
@@ -247,18 +322,39 @@ struct DrawCallManager
 
   // <-
 
+  /**
+   * Switches the draw call to the index range of the given LOD.
+   */
+  _INTR_INLINE static void selectLod(DrawCallRef p_Ref, uint32_t p_LodIdx)
+  {
+    const LodIndexRangeArray& lodIndexRanges = _descLodIndexRanges(p_Ref);
+    if (p_LodIdx < lodIndexRanges.size())
+    {
+      _descFirstIndex(p_Ref) = lodIndexRanges[p_LodIdx].firstIndex;
+      _descIndexCount(p_Ref) = lodIndexRanges[p_LodIdx].indexCount;
+    }
+  }
+
+  // <-
+
   _INTR_INLINE static void resetToDefault(BufferRef p_Ref)
   {
     _descVertexCount(p_Ref) = 0u;
     _descIndexCount(p_Ref) = 0u;
     _descInstanceCount(p_Ref) = 1u;
+    _descFirstIndex(p_Ref) = 0u;
+    _descVertexOffset(p_Ref) = 0;
     _descPipeline(p_Ref) = PipelineRef();
     _descBindInfos(p_Ref).clear();
     _descVertexBuffers(p_Ref).clear();
     _descIndexBuffer(p_Ref) = BufferRef();
     _descMaterial(p_Ref) = Dod::Ref();
     _descMaterialPass(p_Ref) = 0u;
+    _descMaterialBufferEntryIdx(p_Ref) = 0u;
+    _descMesh(p_Ref) = Dod::Ref();
     _descMeshComponent(p_Ref) = Dod::Ref();
+    _descLodIndexRanges(p_Ref).clear();
+    _descLocalAABB(p_Ref) = Math::AABB(glm::vec3(0.0f), glm::vec3(0.0f));
   }
 
   _INTR_INLINE static void destroyDrawCall(DrawCallRef p_Ref)
@@ -316,7 +412,12 @@ struct DrawCallManager
 
   // <-
 
-  static void createResources(const DrawCallRefArray& p_DrawCalls);
+  static void createResources(const DrawCallRef* p_DrawCalls,
+                              uint32_t p_DrawCallCount);
+  _INTR_INLINE static void createResources(const DrawCallRefArray& p_DrawCalls)
+  {
+    createResources(p_DrawCalls.data(), (uint32_t)p_DrawCalls.size());
+  }
 
   // <-
 
@@ -335,12 +436,20 @@ struct DrawCallManager
 
       if (vkDescSet != VK_NULL_HANDLE)
       {
-        VkDescriptorPool vkDescPool =
-            PipelineLayoutManager::_vkDescriptorPool(pipelineLayout);
-        _INTR_ASSERT(vkDescPool != VK_NULL_HANDLE);
+        if (vkDescSet ==
+            PipelineLayoutManager::_vkSharedDescriptorSet(pipelineLayout))
+        {
+          PipelineLayoutManager::releaseSharedDescriptorSet(pipelineLayout);
+        }
+        else
+        {
+          VkDescriptorPool& vkDescPool = _vkDescriptorPool(drawCallRef);
+          _INTR_ASSERT(vkDescPool != VK_NULL_HANDLE);
 
-        RenderSystem::releaseResource(_N(VkDescriptorSet), (void*)vkDescSet,
-                                      (void*)vkDescPool);
+          RenderSystem::releaseResource(_N(VkDescriptorSet), (void*)vkDescSet,
+                                        (void*)vkDescPool);
+          vkDescPool = VK_NULL_HANDLE;
+        }
         vkDescSet = VK_NULL_HANDLE;
       }
 
@@ -383,38 +492,19 @@ struct DrawCallManager
 
   // <-
 
-  _INTR_INLINE static void
-  sortDrawCallsFrontToBack(DrawCallRefArray& p_RefArray)
-  {
-    _INTR_PROFILE_CPU("General", "Sort Draw Calls");
-
-    struct Comparator
-    {
-      bool operator()(const Dod::Ref& a, const Dod::Ref& b) const
-      {
-        return _sortingHash(a) < _sortingHash(b);
-      }
-    } comp;
-
-    Algorithm::parallelSort<Dod::Ref, Comparator>(p_RefArray, comp);
-  }
-
-  // <-
-
-  _INTR_INLINE static void
-  sortDrawCallsBackToFront(DrawCallRefArray& p_RefArray)
+  _INTR_INLINE static void sortDrawCalls(DrawCallRefFrameArray& p_RefArray)
   {
     _INTR_PROFILE_CPU("General", "Sort Draw Calls");
 
-    struct Comparator
+    struct KeyFunction
     {
-      bool operator()(const Dod::Ref& a, const Dod::Ref& b) const
+      uint64_t operator()(const Dod::Ref& p_Ref) const
       {
-        return _sortingHash(a) > _sortingHash(b);
+        return _sortingHash(p_Ref);
       }
-    } comp;
+    } keyFunction;
 
-    Algorithm::parallelSort<Dod::Ref, Comparator>(p_RefArray, comp);
+    Algorithm::parallelRadixSort(p_RefArray, keyFunction);
   }
 
   // <-
@@ -429,6 +519,13 @@ struct DrawCallManager
                          uint8_t p_UboType, uint32_t p_RangeInBytes,
                          uint32_t p_OffsetInBytes = 0u);
 
+  /**
+   * Updates the bound range of the given storage buffer and recreates the
+   * descriptor sets of all draw calls binding it. Has to be called after
+   * resizing the buffer.
+   */
+  static void updateBufferBindings(Dod::Ref p_BufferRef);
+
   // Description
   _INTR_INLINE static uint32_t& _descVertexCount(DrawCallRef p_Ref)
   {
@@ -442,6 +539,14 @@ struct DrawCallManager
   {
     return _data.descInstanceCount[p_Ref._id];
   }
+  _INTR_INLINE static uint32_t& _descFirstIndex(DrawCallRef p_Ref)
+  {
+    return _data.descFirstIndex[p_Ref._id];
+  }
+  _INTR_INLINE static int32_t& _descVertexOffset(DrawCallRef p_Ref)
+  {
+    return _data.descVertexOffset[p_Ref._id];
+  }
 
   _INTR_INLINE static PipelineRef& _descPipeline(DrawCallRef p_Ref)
   {
@@ -467,6 +572,10 @@ struct DrawCallManager
   {
     return _data.descMaterial[p_Ref._id];
   }
+  _INTR_INLINE static Dod::Ref& _descMesh(DrawCallRef p_Ref)
+  {
+    return _data.descMesh[p_Ref._id];
+  }
   _INTR_INLINE static Dod::Ref& _descMeshComponent(DrawCallRef p_Ref)
   {
     return _data.descMeshComponent[p_Ref._id];
@@ -475,9 +584,24 @@ struct DrawCallManager
   {
     return _data.descMaterialPass[p_Ref._id];
   }
+  // Passed as push constant to the pipelines of bindless material passes
+  _INTR_INLINE static uint32_t& _descMaterialBufferEntryIdx(DrawCallRef p_Ref)
+  {
+    return _data.descMaterialBufferEntryIdx[p_Ref._id];
+  }
+  // Index ranges of all LODs, the active one is copied to the first index and
+  // index count
+  _INTR_INLINE static LodIndexRangeArray& _descLodIndexRanges(DrawCallRef p_Ref)
+  {
+    return _data.descLodIndexRanges[p_Ref._id];
+  }
+  _INTR_INLINE static Math::AABB& _descLocalAABB(DrawCallRef p_Ref)
+  {
+    return _data.descLocalAABB[p_Ref._id];
+  }
 
   // Resources
-  _INTR_INLINE static uint32_t& _sortingHash(DrawCallRef p_Ref)
+  _INTR_INLINE static uint64_t& _sortingHash(DrawCallRef p_Ref)
   {
     return _data.sortingHash[p_Ref._id];
   }
@@ -502,6 +626,10 @@ struct DrawCallManager
   {
     return _data.vkDescriptorSet[p_Ref._id];
   }
+  _INTR_INLINE static VkDescriptorPool& _vkDescriptorPool(DrawCallRef p_Ref)
+  {
+    return _data.vkDescriptorPool[p_Ref._id];
+  }
 
   // Static members
   static _INTR_ARRAY(_INTR_ARRAY(DrawCallRef)) _drawCallsPerMaterialPass;
@@ -28,22 +28,21 @@ typedef _INTR_ARRAY(AttachmentInfo) AttachmentInfoArray;
 struct FramebufferData : Dod::Resources::ResourceDataBase
 {
   FramebufferData()
-      : Dod::Resources::ResourceDataBase(_INTR_MAX_FRAMEBUFFER_COUNT)
   {
-    descRenderPass.resize(_INTR_MAX_FRAMEBUFFER_COUNT);
-    descAttachedImages.resize(_INTR_MAX_FRAMEBUFFER_COUNT);
-    descDimensions.resize(_INTR_MAX_FRAMEBUFFER_COUNT);
+    registerArray(descRenderPass);
+    registerArray(descAttachedImages);
+    registerArray(descDimensions);
 
-    vkFramebuffer.resize(_INTR_MAX_FRAMEBUFFER_COUNT);
+    registerArray(vkFramebuffer);
   }
 
   // Description
-  _INTR_ARRAY(Resources::RenderPassRef) descRenderPass;
-  _INTR_ARRAY(AttachmentInfoArray) descAttachedImages;
-  _INTR_ARRAY(glm::uvec2) descDimensions;
+  _INTR_PAGED_ARRAY(Resources::RenderPassRef) descRenderPass;
+  _INTR_PAGED_ARRAY(AttachmentInfoArray) descAttachedImages;
+  _INTR_PAGED_ARRAY(glm::uvec2) descDimensions;
 
   // Resources
-  _INTR_ARRAY(VkFramebuffer) vkFramebuffer;
+  _INTR_PAGED_ARRAY(VkFramebuffer) vkFramebuffer;
 };
 
 struct FramebufferManager
@@ -213,8 +213,9 @@ void GpuProgramManager::reflectPipelineLayout(
     uint32_t p_PoolCount, const Dod::RefArray& p_GpuPrograms,
     Dod::Ref p_PipelineLayoutToInit)
 {
-
   _INTR_ARRAY(BindingDescription) bindingDecs;
+  uint32_t pushConstantSizeInBytes = 0u;
+  uint32_t pushConstantStageFlags = 0u;
 
   for (uint32_t i = 0u; i < p_GpuPrograms.size(); ++i)
   {
@@ -308,6 +309,20 @@ void GpuProgramManager::reflectPipelineLayout(
 
       bindingDecs.push_back(bd);
     }
+
+    // Push constants, merged to a single range shared by all stages
+    for (uint32_t i = 0u; i < resources.push_constant_buffers.size(); ++i)
+    {
+      spirv_cross::Resource& res = resources.push_constant_buffers[i];
+
+      const uint32_t sizeInBytes = (uint32_t)glsl.get_declared_struct_size(
+          glsl.get_type(res.base_type_id));
+
+      pushConstantSizeInBytes = std::max(pushConstantSizeInBytes, sizeInBytes);
+      pushConstantStageFlags |= Helper::mapGpuProgramTypeToVkShaderStage(
+          (GpuProgramType::Enum)GpuProgramManager::_descGpuProgramType(
+              gpuProgramRef));
+    }
   }
 
   std::sort(bindingDecs.begin(), bindingDecs.end(),
@@ -318,6 +333,10 @@ void GpuProgramManager::reflectPipelineLayout(
 
   PipelineLayoutManager::_descBindingDescs(p_PipelineLayoutToInit) =
       std::move(bindingDecs);
+  PipelineLayoutManager::_descPushConstantSizeInBytes(p_PipelineLayoutToInit) =
+      pushConstantSizeInBytes;
+  PipelineLayoutManager::_descPushConstantStageFlags(p_PipelineLayoutToInit) =
+      pushConstantStageFlags;
 }
 
 void GpuProgramManager::compileShaders(GpuProgramRefArray p_Refs,
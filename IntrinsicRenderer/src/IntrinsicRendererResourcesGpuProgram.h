@@ -29,28 +29,28 @@ typedef std::vector<uint32_t> SpirvBuffer;
 struct GpuProgramData : Dod::Resources::ResourceDataBase
 {
   GpuProgramData()
-      : Dod::Resources::ResourceDataBase(_INTR_MAX_GPU_PROGRAM_COUNT)
   {
-    descGpuProgramName.resize(_INTR_MAX_GPU_PROGRAM_COUNT);
-    descEntryPoint.resize(_INTR_MAX_GPU_PROGRAM_COUNT);
-    descGpuProgramType.resize(_INTR_MAX_GPU_PROGRAM_COUNT);
-    descPreprocessorDefines.resize(_INTR_MAX_GPU_PROGRAM_COUNT);
-
-    spirvBuffer.resize(_INTR_MAX_GPU_PROGRAM_COUNT);
-    vkShaderModule.resize(_INTR_MAX_GPU_PROGRAM_COUNT);
-    vkPipelineShaderStageCreateInfo.resize(_INTR_MAX_GPU_PROGRAM_COUNT);
+    registerArray(descGpuProgramName);
+    registerArray(descEntryPoint);
+    registerArray(descGpuProgramType);
+    registerArray(descPreprocessorDefines);
+
+    registerArray(spirvBuffer);
+    registerArray(vkShaderModule);
+    registerArray(vkPipelineShaderStageCreateInfo);
   }
 
   // Description
-  _INTR_ARRAY(_INTR_STRING) descGpuProgramName;
-  _INTR_ARRAY(_INTR_STRING) descEntryPoint;
-  _INTR_ARRAY(uint8_t) descGpuProgramType;
-  _INTR_ARRAY(_INTR_STRING) descPreprocessorDefines;
+  _INTR_PAGED_ARRAY(_INTR_STRING) descGpuProgramName;
+  _INTR_PAGED_ARRAY(_INTR_STRING) descEntryPoint;
+  _INTR_PAGED_ARRAY(uint8_t) descGpuProgramType;
+  _INTR_PAGED_ARRAY(_INTR_STRING) descPreprocessorDefines;
 
   // Resources
-  _INTR_ARRAY(SpirvBuffer) spirvBuffer;
-  _INTR_ARRAY(VkShaderModule) vkShaderModule;
-  _INTR_ARRAY(VkPipelineShaderStageCreateInfo) vkPipelineShaderStageCreateInfo;
+  _INTR_PAGED_ARRAY(SpirvBuffer) spirvBuffer;
+  _INTR_PAGED_ARRAY(VkShaderModule) vkShaderModule;
+  _INTR_PAGED_ARRAY(VkPipelineShaderStageCreateInfo)
+  vkPipelineShaderStageCreateInfo;
 };
 
 struct GpuProgramManager
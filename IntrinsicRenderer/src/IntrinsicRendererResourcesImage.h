@@ -27,48 +27,48 @@ typedef _INTR_ARRAY(_INTR_ARRAY(VkImageView)) ImageViewArray;
 
 struct ImageData : Dod::Resources::ResourceDataBase
 {
-  ImageData() : Dod::Resources::ResourceDataBase(_INTR_MAX_IMAGE_COUNT)
-  {
-    descImageType.resize(_INTR_MAX_IMAGE_COUNT);
-    descImageFormat.resize(_INTR_MAX_IMAGE_COUNT);
-    descImageFlags.resize(_INTR_MAX_IMAGE_COUNT);
-    descDimensions.resize(_INTR_MAX_IMAGE_COUNT);
-    descArrayLayerCount.resize(_INTR_MAX_IMAGE_COUNT);
-    descMipLevelCount.resize(_INTR_MAX_IMAGE_COUNT);
-    descFileName.resize(_INTR_MAX_IMAGE_COUNT);
-    descDirPath.resize(_INTR_MAX_IMAGE_COUNT);
-    descMemoryPoolType.resize(_INTR_MAX_IMAGE_COUNT);
-    descAvgNormLength.resize(_INTR_MAX_IMAGE_COUNT);
-    imageTextureType.resize(_INTR_MAX_IMAGE_COUNT);
-
-    vkImage.resize(_INTR_MAX_IMAGE_COUNT);
-    vkImageView.resize(_INTR_MAX_IMAGE_COUNT);
-    vkImageViewLinear.resize(_INTR_MAX_IMAGE_COUNT);
-    vkImageViewGamma.resize(_INTR_MAX_IMAGE_COUNT);
-    vkSubResourceImageViews.resize(_INTR_MAX_IMAGE_COUNT);
-    memoryAllocationInfo.resize(_INTR_MAX_IMAGE_COUNT);
+  ImageData()
+  {
+    registerArray(descImageType);
+    registerArray(descImageFormat);
+    registerArray(descImageFlags);
+    registerArray(descDimensions);
+    registerArray(descArrayLayerCount);
+    registerArray(descMipLevelCount);
+    registerArray(descFileName);
+    registerArray(descDirPath);
+    registerArray(descMemoryPoolType);
+    registerArray(descAvgNormLength);
+    registerArray(imageTextureType);
+
+    registerArray(vkImage);
+    registerArray(vkImageView);
+    registerArray(vkImageViewLinear);
+    registerArray(vkImageViewGamma);
+    registerArray(vkSubResourceImageViews);
+    registerArray(memoryAllocationInfo);
   }
 
   // Description
-  _INTR_ARRAY(ImageType::Enum) descImageType;
-  _INTR_ARRAY(MemoryPoolType::Enum) descMemoryPoolType;
-  _INTR_ARRAY(Format::Enum) descImageFormat;
-  _INTR_ARRAY(uint8_t) descImageFlags;
-  _INTR_ARRAY(glm::uvec3) descDimensions;
-  _INTR_ARRAY(uint32_t) descArrayLayerCount;
-  _INTR_ARRAY(uint32_t) descMipLevelCount;
-  _INTR_ARRAY(_INTR_STRING) descFileName;
-  _INTR_ARRAY(_INTR_STRING) descDirPath;
-  _INTR_ARRAY(float) descAvgNormLength;
+  _INTR_PAGED_ARRAY(ImageType::Enum) descImageType;
+  _INTR_PAGED_ARRAY(MemoryPoolType::Enum) descMemoryPoolType;
+  _INTR_PAGED_ARRAY(Format::Enum) descImageFormat;
+  _INTR_PAGED_ARRAY(uint8_t) descImageFlags;
+  _INTR_PAGED_ARRAY(glm::uvec3) descDimensions;
+  _INTR_PAGED_ARRAY(uint32_t) descArrayLayerCount;
+  _INTR_PAGED_ARRAY(uint32_t) descMipLevelCount;
+  _INTR_PAGED_ARRAY(_INTR_STRING) descFileName;
+  _INTR_PAGED_ARRAY(_INTR_STRING) descDirPath;
+  _INTR_PAGED_ARRAY(float) descAvgNormLength;
 
   // Resources
-  _INTR_ARRAY(VkImage) vkImage;
-  _INTR_ARRAY(VkImageView) vkImageView;
-  _INTR_ARRAY(VkImageView) vkImageViewLinear;
-  _INTR_ARRAY(VkImageView) vkImageViewGamma;
-  _INTR_ARRAY(ImageViewArray) vkSubResourceImageViews;
-  _INTR_ARRAY(GpuMemoryAllocationInfo) memoryAllocationInfo;
-  _INTR_ARRAY(ImageTextureType::Enum) imageTextureType;
+  _INTR_PAGED_ARRAY(VkImage) vkImage;
+  _INTR_PAGED_ARRAY(VkImageView) vkImageView;
+  _INTR_PAGED_ARRAY(VkImageView) vkImageViewLinear;
+  _INTR_PAGED_ARRAY(VkImageView) vkImageViewGamma;
+  _INTR_PAGED_ARRAY(ImageViewArray) vkSubResourceImageViews;
+  _INTR_PAGED_ARRAY(GpuMemoryAllocationInfo) memoryAllocationInfo;
+  _INTR_PAGED_ARRAY(ImageTextureType::Enum) imageTextureType;
 };
 
 struct ImageManager
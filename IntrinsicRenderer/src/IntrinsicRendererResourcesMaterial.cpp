@@ -136,6 +136,18 @@ void MaterialManager::createResources(const MaterialRefArray& p_Materiales)
         entry.refractionFactor = _descRefractionFactor(matRef);
         entry.translucencyThicknessFactor = _descTranslucencyThickness(matRef);
         entry.emissiveIntensity = _descEmissiveIntensity(matRef);
+
+        entry.uvOffsetScale = _descUvOffsetScale(matRef);
+        entry.uvAnimation = glm::vec4(_descUvAnimation(matRef), 0.0f, 0.0f);
+        entry.pbrBias = glm::vec4(_descPbrBias(matRef), avgNormalLength);
+        entry.textureIds[0] = ImageManager::getTextureId(
+            ImageManager::getResourceByName(_descAlbedoTextureName(matRef)));
+        entry.textureIds[1] = ImageManager::getTextureId(
+            ImageManager::getResourceByName(_descNormalTextureName(matRef)));
+        entry.textureIds[2] = ImageManager::getTextureId(
+            ImageManager::getResourceByName(_descPbrTextureName(matRef)));
+        entry.textureIds[3] = ImageManager::getTextureId(
+            ImageManager::getResourceByName(_descEmissiveTextureName(matRef)));
       }
       MaterialBuffer::updateMaterialBufferEntry(materialBufferEntryIdx, entry);
     }
@@ -262,8 +274,10 @@ void MaterialManager::loadMaterialPassConfig()
   for (uint32_t matPassIdx = 0u; matPassIdx < _materialPasses.size();
        ++matPassIdx)
   {
-    for (uint32_t i = 0u; i < _INTR_MAX_FRUSTUMS_PER_FRAME_COUNT; ++i)
-      RenderProcess::Default::_visibleDrawCallsPerMaterialPass[i][matPassIdx]
+    for (uint32_t i = 0u; i < RenderProcess::Default::_frustumVisibility.size();
+         ++i)
+      RenderProcess::Default::_frustumVisibility[i]
+          ->visibleDrawCallsPerMaterialPass[matPassIdx]
           .clear();
   }
 
@@ -329,6 +343,44 @@ void MaterialManager::loadMaterialPassConfig()
 
       MaterialPass::MaterialPass matPass = {};
       matPass.name = materialPassName;
+      matPass.instancedPipelineIdx = _INTR_MATERIAL_PASS_INVALID_PIPELINE_IDX;
+      matPass.bindless =
+          Settings::Manager::_bindlessMaterials &&
+          materialPassDesc.HasMember("bindlessFragmentGpuProgram");
+
+      // Bindless passes replace the fragment programs and the bound resources
+      const char* boundResourcesMember =
+          matPass.bindless ? "bindlessBoundResources" : "boundResources";
+      const char* baseFragmentProgramMember =
+          matPass.bindless ? "bindlessFragmentGpuProgram"
+                           : "baseFragmentGpuProgram";
+      const char* instancedFragmentProgramMember =
+          matPass.bindless ? "bindlessInstancedFragmentGpuProgram"
+                           : "instancedFragmentGpuProgram";
+
+      if (materialPassDesc.HasMember("lodBias"))
+      {
+        matPass.lodBias = (uint8_t)materialPassDesc["lodBias"].GetUint();
+      }
+      if (materialPassDesc.HasMember("minScreenSize"))
+      {
+        matPass.minScreenSize = materialPassDesc["minScreenSize"].GetFloat();
+      }
+      if (materialPassDesc.HasMember("renderOrder"))
+      {
+        if (materialPassDesc["renderOrder"] == "FrontToBack")
+        {
+          matPass.renderOrder = RenderOrder::kFrontToBack;
+        }
+        else if (materialPassDesc["renderOrder"] == "BackToFront")
+        {
+          matPass.renderOrder = RenderOrder::kBackToFront;
+        }
+        else
+        {
+          _INTR_ASSERT(false && "Unknown render order");
+        }
+      }
 
       {
         RenderPassRef renderPassRef = RenderPassManager::_getResourceByName(
@@ -347,7 +399,7 @@ void MaterialManager::loadMaterialPassConfig()
         for (uint32_t i = 0u; i < _materialPassBoundResources.size(); ++i)
         {
           if (_materialPassBoundResources[i].name ==
-              materialPassDesc["boundResources"].GetString())
+              materialPassDesc[boundResourcesMember].GetString())
           {
             matPass.boundResoucesIdx = i;
             break;
@@ -362,14 +414,24 @@ void MaterialManager::loadMaterialPassConfig()
           PipelineLayoutManager::resetToDefault(pipelineLayoutRef);
 
           GpuProgramRefArray programsToReflect;
-          if (materialPassDesc.HasMember("baseFragmentGpuProgram"))
+          if (materialPassDesc.HasMember(baseFragmentProgramMember))
           {
             GpuProgramRef fragmentProgram =
                 Resources::GpuProgramManager::getResourceByName(
-                    materialPassDesc["baseFragmentGpuProgram"].GetString());
+                    materialPassDesc[baseFragmentProgramMember].GetString());
             programsToReflect.push_back(fragmentProgram);
           }
-          if (materialPassDesc.HasMember("baseVertexGpuProgram"))
+          // The instanced variant binds the mesh instance buffer on top of the
+          // resources of the base program, so both pipelines can share the
+          // layout
+          if (materialPassDesc.HasMember("instancedVertexGpuProgram"))
+          {
+            GpuProgramRef vertexProgram =
+                Resources::GpuProgramManager::getResourceByName(
+                    materialPassDesc["instancedVertexGpuProgram"].GetString());
+            programsToReflect.push_back(vertexProgram);
+          }
+          else if (materialPassDesc.HasMember("baseVertexGpuProgram"))
           {
             GpuProgramRef vertexProgram =
                 Resources::GpuProgramManager::getResourceByName(
@@ -377,31 +439,57 @@ void MaterialManager::loadMaterialPassConfig()
             programsToReflect.push_back(vertexProgram);
           }
 
+          // Sets per descriptor pool, additional pools are created when the
+          // draw call count exceeds it
           GpuProgramManager::reflectPipelineLayout(
               _INTR_MAX_DRAW_CALL_COUNT, programsToReflect, pipelineLayoutRef);
+          PipelineLayoutManager::_descShareDescriptorSet(pipelineLayoutRef) =
+              matPass.bindless;
 
           _materialPassPipelineLayouts.push_back(pipelineLayoutRef);
           matPass.pipelineLayoutIdx =
               (uint8_t)(_materialPassPipelineLayouts.size() - 1u);
         }
 
-        // Pipeline
-        PipelineRef pipelineRef;
+        // Pipelines, followed by the instanced variant if available
+        const uint32_t pipelineCount =
+            materialPassDesc.HasMember("instancedVertexGpuProgram") ? 2u : 1u;
+
+        for (uint32_t pipelineIdx = 0u; pipelineIdx < pipelineCount;
+             ++pipelineIdx)
         {
-          pipelineRef = PipelineManager::createPipeline(materialPassName);
+          const bool instanced = pipelineIdx == 1u;
+
+          _INTR_STRING pipelineName = materialPassDesc["name"].GetString();
+          if (instanced)
+          {
+            pipelineName += "Instanced";
+          }
+
+          PipelineRef pipelineRef =
+              PipelineManager::createPipeline(pipelineName);
           PipelineManager::resetToDefault(pipelineRef);
 
-          if (materialPassDesc.HasMember("baseFragmentGpuProgram"))
+          const char* vertexProgramMember =
+              instanced ? "instancedVertexGpuProgram" : "baseVertexGpuProgram";
+          const char* fragmentProgramMember = baseFragmentProgramMember;
+          if (instanced &&
+              materialPassDesc.HasMember(instancedFragmentProgramMember))
+          {
+            fragmentProgramMember = instancedFragmentProgramMember;
+          }
+
+          if (materialPassDesc.HasMember(fragmentProgramMember))
           {
             PipelineManager::_descFragmentProgram(pipelineRef) =
                 GpuProgramManager::getResourceByName(
-                    materialPassDesc["baseFragmentGpuProgram"].GetString());
+                    materialPassDesc[fragmentProgramMember].GetString());
           }
-          if (materialPassDesc.HasMember("baseVertexGpuProgram"))
+          if (materialPassDesc.HasMember(vertexProgramMember))
           {
             PipelineManager::_descVertexProgram(pipelineRef) =
                 GpuProgramManager::getResourceByName(
-                    materialPassDesc["baseVertexGpuProgram"].GetString());
+                    materialPassDesc[vertexProgramMember].GetString());
           }
           PipelineManager::_descRenderPass(pipelineRef) = renderPassRef;
           PipelineManager::_descPipelineLayout(pipelineRef) = pipelineLayoutRef;
@@ -474,7 +562,15 @@ void MaterialManager::loadMaterialPassConfig()
           }
 
           _materialPassPipelines.push_back(pipelineRef);
-          matPass.pipelineIdx = (uint8_t)(_materialPassPipelines.size() - 1u);
+          if (instanced)
+          {
+            matPass.instancedPipelineIdx =
+                (uint8_t)(_materialPassPipelines.size() - 1u);
+          }
+          else
+          {
+            matPass.pipelineIdx = (uint8_t)(_materialPassPipelines.size() - 1u);
+          }
         }
 
         _materialPasses.push_back(matPass);
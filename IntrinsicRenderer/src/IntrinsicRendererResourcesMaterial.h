@@ -14,6 +14,8 @@
 
 #pragma once
 
+#define _INTR_MATERIAL_PASS_INVALID_PIPELINE_IDX ((uint8_t)-1)
+
 namespace Intrinsic
 {
 namespace Renderer
@@ -56,8 +58,26 @@ struct MaterialPass
 {
   Name name;
   uint8_t pipelineIdx;
+  // Pipeline fetching the per instance data from the mesh instance buffer or
+  // _INTR_MATERIAL_PASS_INVALID_PIPELINE_IDX if the pass can't be instanced
+  uint8_t instancedPipelineIdx;
   uint8_t pipelineLayoutIdx;
   uint8_t boundResoucesIdx;
+
+  // Bindless passes sample the material textures from the global texture array
+  // and fetch the material parameters from the material buffer, so all of
+  // their draw calls share a single descriptor set
+  bool bindless;
+
+  // Added to the LOD selected for each mesh, e.g. to render shadows using
+  // coarser LODs
+  uint8_t lodBias;
+
+  // Meshes covering less than this fraction of the viewport are skipped
+  float minScreenSize;
+
+  // Depth order of the draw calls when sorted
+  RenderOrder::Enum renderOrder;
 };
 
 struct BoundResourceEntry
@@ -77,37 +97,37 @@ struct BoundResources
 
 struct MaterialData : Dod::Resources::ResourceDataBase
 {
-  MaterialData() : Dod::Resources::ResourceDataBase(_INTR_MAX_MATERIAL_COUNT)
-  {
-    descAlbedoTextureName.resize(_INTR_MAX_MATERIAL_COUNT);
-    descEmissiveTextureName.resize(_INTR_MAX_MATERIAL_COUNT);
-    descAlbedo1TextureName.resize(_INTR_MAX_MATERIAL_COUNT);
-    descAlbedo2TextureName.resize(_INTR_MAX_MATERIAL_COUNT);
-    descNormalTextureName.resize(_INTR_MAX_MATERIAL_COUNT);
-    descNormal1TextureName.resize(_INTR_MAX_MATERIAL_COUNT);
-    descNormal2TextureName.resize(_INTR_MAX_MATERIAL_COUNT);
-    descPbrTextureName.resize(_INTR_MAX_MATERIAL_COUNT);
-    descPbr1TextureName.resize(_INTR_MAX_MATERIAL_COUNT);
-    descPbr2TextureName.resize(_INTR_MAX_MATERIAL_COUNT);
-
-    descBlendMaskTextureName.resize(_INTR_MAX_MATERIAL_COUNT);
-    descFoamTextureName.resize(_INTR_MAX_MATERIAL_COUNT);
-    descRefractionFactor.resize(_INTR_MAX_MATERIAL_COUNT);
-
-    descTranslucencyThickness.resize(_INTR_MAX_MATERIAL_COUNT);
-    descEmissiveIntensity.resize(_INTR_MAX_MATERIAL_COUNT);
-
-    descUvOffsetScale.resize(_INTR_MAX_MATERIAL_COUNT);
-    descUvAnimation.resize(_INTR_MAX_MATERIAL_COUNT);
-    descPbrBias.resize(_INTR_MAX_MATERIAL_COUNT);
-    descWaterParams.resize(_INTR_MAX_MATERIAL_COUNT);
-
-    descMaterialPassMask.resize(_INTR_MAX_MATERIAL_COUNT);
-
-    perMaterialDataVertexOffset.resize(_INTR_MAX_MATERIAL_COUNT);
-    perMaterialDataFragmentOffset.resize(_INTR_MAX_MATERIAL_COUNT);
-    materialBufferEntryIndex.resize(_INTR_MAX_MATERIAL_COUNT);
-    materialPassMask.resize(_INTR_MAX_MATERIAL_COUNT);
+  MaterialData()
+  {
+    registerArray(descAlbedoTextureName);
+    registerArray(descEmissiveTextureName);
+    registerArray(descAlbedo1TextureName);
+    registerArray(descAlbedo2TextureName);
+    registerArray(descNormalTextureName);
+    registerArray(descNormal1TextureName);
+    registerArray(descNormal2TextureName);
+    registerArray(descPbrTextureName);
+    registerArray(descPbr1TextureName);
+    registerArray(descPbr2TextureName);
+
+    registerArray(descBlendMaskTextureName);
+    registerArray(descFoamTextureName);
+    registerArray(descRefractionFactor);
+
+    registerArray(descTranslucencyThickness);
+    registerArray(descEmissiveIntensity);
+
+    registerArray(descUvOffsetScale);
+    registerArray(descUvAnimation);
+    registerArray(descPbrBias);
+    registerArray(descWaterParams);
+
+    registerArray(descMaterialPassMask);
+
+    registerArray(perMaterialDataVertexOffset);
+    registerArray(perMaterialDataFragmentOffset);
+    registerArray(materialBufferEntryIndex);
+    registerArray(materialPassMask);
 
     memset(perMaterialDataFragmentOffset.data(), 0xFF,
            perMaterialDataFragmentOffset.size() * sizeof(uint32_t));
@@ -118,36 +138,36 @@ struct MaterialData : Dod::Resources::ResourceDataBase
   }
 
   // Description
-  _INTR_ARRAY(Name) descAlbedoTextureName;
-  _INTR_ARRAY(Name) descEmissiveTextureName;
-  _INTR_ARRAY(Name) descAlbedo1TextureName;
-  _INTR_ARRAY(Name) descAlbedo2TextureName;
-  _INTR_ARRAY(Name) descNormalTextureName;
-  _INTR_ARRAY(Name) descNormal1TextureName;
-  _INTR_ARRAY(Name) descNormal2TextureName;
-  _INTR_ARRAY(Name) descPbrTextureName;
-  _INTR_ARRAY(Name) descPbr1TextureName;
-  _INTR_ARRAY(Name) descPbr2TextureName;
-
-  _INTR_ARRAY(Name) descBlendMaskTextureName;
-  _INTR_ARRAY(Name) descFoamTextureName;
-  _INTR_ARRAY(float) descRefractionFactor;
-
-  _INTR_ARRAY(float) descTranslucencyThickness;
-  _INTR_ARRAY(float) descEmissiveIntensity;
-
-  _INTR_ARRAY(glm::vec4) descUvOffsetScale;
-  _INTR_ARRAY(glm::vec2) descUvAnimation;
-  _INTR_ARRAY(glm::vec3) descPbrBias;
-  _INTR_ARRAY(glm::vec4) descWaterParams;
-
-  _INTR_ARRAY(_INTR_ARRAY(Name)) descMaterialPassMask;
+  _INTR_PAGED_ARRAY(Name) descAlbedoTextureName;
+  _INTR_PAGED_ARRAY(Name) descEmissiveTextureName;
+  _INTR_PAGED_ARRAY(Name) descAlbedo1TextureName;
+  _INTR_PAGED_ARRAY(Name) descAlbedo2TextureName;
+  _INTR_PAGED_ARRAY(Name) descNormalTextureName;
+  _INTR_PAGED_ARRAY(Name) descNormal1TextureName;
+  _INTR_PAGED_ARRAY(Name) descNormal2TextureName;
+  _INTR_PAGED_ARRAY(Name) descPbrTextureName;
+  _INTR_PAGED_ARRAY(Name) descPbr1TextureName;
+  _INTR_PAGED_ARRAY(Name) descPbr2TextureName;
+
+  _INTR_PAGED_ARRAY(Name) descBlendMaskTextureName;
+  _INTR_PAGED_ARRAY(Name) descFoamTextureName;
+  _INTR_PAGED_ARRAY(float) descRefractionFactor;
+
+  _INTR_PAGED_ARRAY(float) descTranslucencyThickness;
+  _INTR_PAGED_ARRAY(float) descEmissiveIntensity;
+
+  _INTR_PAGED_ARRAY(glm::vec4) descUvOffsetScale;
+  _INTR_PAGED_ARRAY(glm::vec2) descUvAnimation;
+  _INTR_PAGED_ARRAY(glm::vec3) descPbrBias;
+  _INTR_PAGED_ARRAY(glm::vec4) descWaterParams;
+
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(Name)) descMaterialPassMask;
 
   // Resources
-  _INTR_ARRAY(uint32_t) perMaterialDataVertexOffset;
-  _INTR_ARRAY(uint32_t) perMaterialDataFragmentOffset;
-  _INTR_ARRAY(uint32_t) materialBufferEntryIndex;
-  _INTR_ARRAY(uint32_t) materialPassMask;
+  _INTR_PAGED_ARRAY(uint32_t) perMaterialDataVertexOffset;
+  _INTR_PAGED_ARRAY(uint32_t) perMaterialDataFragmentOffset;
+  _INTR_PAGED_ARRAY(uint32_t) materialBufferEntryIndex;
+  _INTR_PAGED_ARRAY(uint32_t) materialPassMask;
 };
 
 struct MaterialManager
@@ -212,7 +232,7 @@ struct MaterialManager
 
     _INTR_STRING materialPassNames;
     for (auto& matPass : _materialPasses)
-      materialPassNames += "," + matPass.name.getString();
+      materialPassNames += "," + _INTR_STRING(matPass.name.getString());
 
     p_Properties.AddMember(
         "materialPassMask",
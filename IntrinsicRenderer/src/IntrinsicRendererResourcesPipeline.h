@@ -26,50 +26,50 @@ typedef _INTR_ARRAY(PipelineRef) PipelineRefArray;
 
 struct PipelineData : Dod::Resources::ResourceDataBase
 {
-  PipelineData() : Dod::Resources::ResourceDataBase(_INTR_MAX_PIPELINE_COUNT)
+  PipelineData()
   {
-    descVertexLayout.resize(_INTR_MAX_PIPELINE_COUNT);
-    descPipelineLayout.resize(_INTR_MAX_PIPELINE_COUNT);
-    descRenderPass.resize(_INTR_MAX_PIPELINE_COUNT);
-    descVertexProgram.resize(_INTR_MAX_PIPELINE_COUNT);
-    descFragmentProgram.resize(_INTR_MAX_PIPELINE_COUNT);
-    descGeometryProgram.resize(_INTR_MAX_PIPELINE_COUNT);
-    descComputeProgram.resize(_INTR_MAX_PIPELINE_COUNT);
-
-    descDepthStencilState.resize(_INTR_MAX_PIPELINE_COUNT);
-    descInputAssemblyState.resize(_INTR_MAX_PIPELINE_COUNT);
-    descRasterizationState.resize(_INTR_MAX_PIPELINE_COUNT);
-    descBlendStates.resize(_INTR_MAX_PIPELINE_COUNT);
-
-    descScissorRenderSize.resize(_INTR_MAX_PIPELINE_COUNT);
-    descViewportRenderSize.resize(_INTR_MAX_PIPELINE_COUNT);
-    descAbsoluteScissorDimensions.resize(_INTR_MAX_PIPELINE_COUNT);
-    descAbsoluteViewportDimensions.resize(_INTR_MAX_PIPELINE_COUNT);
-
-    vkPipeline.resize(_INTR_MAX_RENDER_PASS_COUNT);
+    registerArray(descVertexLayout);
+    registerArray(descPipelineLayout);
+    registerArray(descRenderPass);
+    registerArray(descVertexProgram);
+    registerArray(descFragmentProgram);
+    registerArray(descGeometryProgram);
+    registerArray(descComputeProgram);
+
+    registerArray(descDepthStencilState);
+    registerArray(descInputAssemblyState);
+    registerArray(descRasterizationState);
+    registerArray(descBlendStates);
+
+    registerArray(descScissorRenderSize);
+    registerArray(descViewportRenderSize);
+    registerArray(descAbsoluteScissorDimensions);
+    registerArray(descAbsoluteViewportDimensions);
+
+    registerArray(vkPipeline);
   }
 
   // Description
-  _INTR_ARRAY(VertexLayoutRef) descVertexLayout;
-  _INTR_ARRAY(PipelineLayoutRef) descPipelineLayout;
-  _INTR_ARRAY(RenderPassRef) descRenderPass;
-  _INTR_ARRAY(GpuProgramRef) descVertexProgram;
-  _INTR_ARRAY(GpuProgramRef) descFragmentProgram;
-  _INTR_ARRAY(GpuProgramRef) descGeometryProgram;
-  _INTR_ARRAY(GpuProgramRef) descComputeProgram;
-
-  _INTR_ARRAY(uint8_t) descDepthStencilState;
-  _INTR_ARRAY(uint8_t) descInputAssemblyState;
-  _INTR_ARRAY(uint8_t) descRasterizationState;
-  _INTR_ARRAY(_INTR_ARRAY(uint8_t)) descBlendStates;
-
-  _INTR_ARRAY(uint8_t) descScissorRenderSize;
-  _INTR_ARRAY(uint8_t) descViewportRenderSize;
-  _INTR_ARRAY(glm::uvec2) descAbsoluteScissorDimensions;
-  _INTR_ARRAY(glm::uvec2) descAbsoluteViewportDimensions;
+  _INTR_PAGED_ARRAY(VertexLayoutRef) descVertexLayout;
+  _INTR_PAGED_ARRAY(PipelineLayoutRef) descPipelineLayout;
+  _INTR_PAGED_ARRAY(RenderPassRef) descRenderPass;
+  _INTR_PAGED_ARRAY(GpuProgramRef) descVertexProgram;
+  _INTR_PAGED_ARRAY(GpuProgramRef) descFragmentProgram;
+  _INTR_PAGED_ARRAY(GpuProgramRef) descGeometryProgram;
+  _INTR_PAGED_ARRAY(GpuProgramRef) descComputeProgram;
+
+  _INTR_PAGED_ARRAY(uint8_t) descDepthStencilState;
+  _INTR_PAGED_ARRAY(uint8_t) descInputAssemblyState;
+  _INTR_PAGED_ARRAY(uint8_t) descRasterizationState;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(uint8_t)) descBlendStates;
+
+  _INTR_PAGED_ARRAY(uint8_t) descScissorRenderSize;
+  _INTR_PAGED_ARRAY(uint8_t) descViewportRenderSize;
+  _INTR_PAGED_ARRAY(glm::uvec2) descAbsoluteScissorDimensions;
+  _INTR_PAGED_ARRAY(glm::uvec2) descAbsoluteViewportDimensions;
 
   // Resources
-  _INTR_ARRAY(VkPipeline) vkPipeline;
+  _INTR_PAGED_ARRAY(VkPipeline) vkPipeline;
 };
 
 struct PipelineManager
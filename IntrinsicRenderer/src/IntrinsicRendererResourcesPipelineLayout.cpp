@@ -21,6 +21,46 @@ namespace Renderer
 {
 namespace Resources
 {
+namespace
+{
+VkDescriptorPool createDescriptorPool(PipelineLayoutRef p_Ref)
+{
+  _INTR_ARRAY(BindingDescription)& bindingInfos =
+      PipelineLayoutManager::_descBindingDescs(p_Ref);
+
+  _INTR_ARRAY(VkDescriptorPoolSize) poolSizes;
+  poolSizes.resize(bindingInfos.size());
+
+  uint32_t maxPoolCount = 0u;
+  for (uint32_t i = 0u; i < bindingInfos.size(); ++i)
+  {
+    BindingDescription& info = bindingInfos[i];
+
+    poolSizes[i].type = Helper::mapBindingTypeToVkDescriptorType(
+        (BindingType::Enum)info.bindingType);
+    poolSizes[i].descriptorCount = info.poolCount;
+    maxPoolCount = std::max(maxPoolCount, info.poolCount);
+  }
+
+  VkDescriptorPoolCreateInfo descriptorPool = {};
+  descriptorPool.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  descriptorPool.pNext = nullptr;
+  descriptorPool.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+  descriptorPool.maxSets = maxPoolCount;
+  descriptorPool.poolSizeCount = (uint32_t)poolSizes.size();
+  descriptorPool.pPoolSizes = poolSizes.data();
+
+  VkDescriptorPool pool;
+  VkResult result = vkCreateDescriptorPool(RenderSystem::_vkDevice,
+                                           &descriptorPool, nullptr, &pool);
+  _INTR_VK_CHECK_RESULT(result);
+
+  return pool;
+}
+}
+
+// <-
+
 void PipelineLayoutManager::createResources(
     const PipelineLayoutRefArray& p_PipelineLayouts)
 {
@@ -70,13 +110,21 @@ void PipelineLayoutManager::createResources(
     // Add global image descriptor set layouts
     descSetLayouts.push_back(ImageManager::_globalTextureDescriptorSetLayout);
 
+    VkPushConstantRange pushConstantRange = {};
+    {
+      pushConstantRange.stageFlags = _descPushConstantStageFlags(ref);
+      pushConstantRange.offset = 0u;
+      pushConstantRange.size = _descPushConstantSizeInBytes(ref);
+    }
+
     {
       VkPipelineLayoutCreateInfo pPipelineLayoutCreateInfo = {};
       pPipelineLayoutCreateInfo.sType =
           VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
       pPipelineLayoutCreateInfo.pNext = nullptr;
-      pPipelineLayoutCreateInfo.pushConstantRangeCount = 0;
-      pPipelineLayoutCreateInfo.pPushConstantRanges = nullptr;
+      pPipelineLayoutCreateInfo.pushConstantRangeCount =
+          pushConstantRange.size > 0u ? 1u : 0u;
+      pPipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
       pPipelineLayoutCreateInfo.setLayoutCount =
           (uint32_t)descSetLayouts.size();
       pPipelineLayoutCreateInfo.pSetLayouts = descSetLayouts.data();
@@ -89,31 +137,7 @@ void PipelineLayoutManager::createResources(
 
     if (!bindingInfos.empty())
     {
-      _INTR_ARRAY(VkDescriptorPoolSize) poolSizes;
-      poolSizes.resize(bindingInfos.size());
-
-      uint32_t maxPoolCount = 0u;
-      for (uint32_t i = 0u; i < bindingInfos.size(); ++i)
-      {
-        BindingDescription& info = bindingInfos[i];
-
-        poolSizes[i].type = Helper::mapBindingTypeToVkDescriptorType(
-            (BindingType::Enum)info.bindingType);
-        poolSizes[i].descriptorCount = info.poolCount;
-        maxPoolCount = std::max(maxPoolCount, info.poolCount);
-      }
-
-      VkDescriptorPoolCreateInfo descriptorPool = {};
-      descriptorPool.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-      descriptorPool.pNext = nullptr;
-      descriptorPool.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-      descriptorPool.maxSets = maxPoolCount;
-      descriptorPool.poolSizeCount = (uint32_t)poolSizes.size();
-      descriptorPool.pPoolSizes = poolSizes.data();
-
-      VkResult result = vkCreateDescriptorPool(RenderSystem::_vkDevice,
-                                               &descriptorPool, nullptr, &pool);
-      _INTR_VK_CHECK_RESULT(result);
+      pool = createDescriptorPool(ref);
     }
   }
 }
@@ -148,6 +172,19 @@ void PipelineLayoutManager::destroyResources(
       vkDestroyDescriptorPool(RenderSystem::_vkDevice, descPool, nullptr);
       descPool = VK_NULL_HANDLE;
 
+      _INTR_ARRAY(VkDescriptorPool)& fullDescPools =
+          _vkFullDescriptorPools(ref);
+      for (uint32_t poolIdx = 0u; poolIdx < fullDescPools.size(); ++poolIdx)
+      {
+        vkDestroyDescriptorPool(RenderSystem::_vkDevice,
+                                fullDescPools[poolIdx], nullptr);
+      }
+      fullDescPools.clear();
+
+      _vkSharedDescriptorSet(ref) = VK_NULL_HANDLE;
+      _vkSharedDescriptorSetPool(ref) = VK_NULL_HANDLE;
+      _sharedDescriptorSetUserCount(ref) = 0u;
+
       // Invalidate descriptor sets allocated from this pool
       for (uint32_t dcIdx = 0u; dcIdx < DrawCallManager::_activeRefs.size();
            ++dcIdx)
@@ -162,6 +199,7 @@ void PipelineLayoutManager::destroyResources(
           if (plRef == ref)
           {
             DrawCallManager::_vkDescriptorSet(dcRef) = nullptr;
+            DrawCallManager::_vkDescriptorPool(dcRef) = nullptr;
           }
         }
       }
@@ -172,15 +210,19 @@ void PipelineLayoutManager::destroyResources(
 // <-
 
 VkDescriptorSet PipelineLayoutManager::allocateAndWriteDescriptorSet(
-    PipelineLayoutRef p_Ref, const _INTR_ARRAY(BindingInfo) & p_BindInfos)
+    PipelineLayoutRef p_Ref, const _INTR_ARRAY(BindingInfo) & p_BindInfos,
+    VkDescriptorPool& p_DescriptorPool)
 {
-  if (_vkDescriptorPool(p_Ref))
+  VkDescriptorPool& descPool = _vkDescriptorPool(p_Ref);
+  p_DescriptorPool = VK_NULL_HANDLE;
+
+  if (descPool)
   {
     VkDescriptorSetAllocateInfo allocInfo = {};
     {
       allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
       allocInfo.pNext = nullptr;
-      allocInfo.descriptorPool = _vkDescriptorPool(p_Ref);
+      allocInfo.descriptorPool = descPool;
       allocInfo.descriptorSetCount = 1u;
       allocInfo.pSetLayouts = &_vkDescriptorSetLayout(p_Ref);
     }
@@ -188,8 +230,23 @@ VkDescriptorSet PipelineLayoutManager::allocateAndWriteDescriptorSet(
     VkDescriptorSet descSet;
     VkResult result =
         vkAllocateDescriptorSets(RenderSystem::_vkDevice, &allocInfo, &descSet);
+
+    // Keep the exhausted (or fragmented) pool around for the sets allocated
+    // from it and continue with a new one. Drivers without
+    // VK_KHR_maintenance1 report exhausted pools using various error codes
+    if (result != VK_SUCCESS)
+    {
+      _vkFullDescriptorPools(p_Ref).push_back(descPool);
+      descPool = createDescriptorPool(p_Ref);
+
+      allocInfo.descriptorPool = descPool;
+      result = vkAllocateDescriptorSets(RenderSystem::_vkDevice, &allocInfo,
+                                        &descSet);
+    }
     _INTR_VK_CHECK_RESULT(result);
 
+    p_DescriptorPool = descPool;
+
     _INTR_ARRAY(VkWriteDescriptorSet) writes;
     _INTR_ARRAY(VkDescriptorImageInfo) imageInfos;
     _INTR_ARRAY(VkDescriptorBufferInfo) bufferInfos;
@@ -280,6 +337,42 @@ VkDescriptorSet PipelineLayoutManager::allocateAndWriteDescriptorSet(
 
   return VK_NULL_HANDLE;
 }
+
+// <-
+
+VkDescriptorSet PipelineLayoutManager::acquireSharedDescriptorSet(
+    PipelineLayoutRef p_Ref, const _INTR_ARRAY(BindingInfo) & p_BindInfos)
+{
+  _INTR_ASSERT(_descShareDescriptorSet(p_Ref));
+
+  VkDescriptorSet& sharedDescSet = _vkSharedDescriptorSet(p_Ref);
+  if (sharedDescSet == VK_NULL_HANDLE)
+  {
+    sharedDescSet = allocateAndWriteDescriptorSet(
+        p_Ref, p_BindInfos, _vkSharedDescriptorSetPool(p_Ref));
+    _sharedDescriptorSetUserCount(p_Ref) = 0u;
+  }
+
+  ++_sharedDescriptorSetUserCount(p_Ref);
+  return sharedDescSet;
+}
+
+// <-
+
+void PipelineLayoutManager::releaseSharedDescriptorSet(PipelineLayoutRef p_Ref)
+{
+  VkDescriptorSet& sharedDescSet = _vkSharedDescriptorSet(p_Ref);
+  uint32_t& userCount = _sharedDescriptorSetUserCount(p_Ref);
+  _INTR_ASSERT(sharedDescSet != VK_NULL_HANDLE && userCount > 0u);
+
+  if (--userCount == 0u)
+  {
+    RenderSystem::releaseResource(_N(VkDescriptorSet), (void*)sharedDescSet,
+                                  (void*)_vkSharedDescriptorSetPool(p_Ref));
+    sharedDescSet = VK_NULL_HANDLE;
+    _vkSharedDescriptorSetPool(p_Ref) = VK_NULL_HANDLE;
+  }
+}
 }
 }
 }
@@ -27,22 +27,37 @@ typedef Dod::RefArray PipelineLayoutRefArray;
 struct PipelineLayoutData : Dod::Resources::ResourceDataBase
 {
   PipelineLayoutData()
-      : Dod::Resources::ResourceDataBase(_INTR_MAX_PIPELINE_LAYOUT_COUNT)
   {
-    bindingDescs.resize(_INTR_MAX_PIPELINE_LAYOUT_COUNT);
-
-    vkPipelineLayout.resize(_INTR_MAX_PIPELINE_LAYOUT_COUNT);
-    vkDescriptorSetLayout.resize(_INTR_MAX_PIPELINE_LAYOUT_COUNT);
-    vkDescriptorPool.resize(_INTR_MAX_PIPELINE_LAYOUT_COUNT);
+    registerArray(bindingDescs);
+    registerArray(descPushConstantSizeInBytes);
+    registerArray(descPushConstantStageFlags);
+    registerArray(descShareDescriptorSet);
+
+    registerArray(vkPipelineLayout);
+    registerArray(vkDescriptorSetLayout);
+    registerArray(vkDescriptorPool);
+    registerArray(vkFullDescriptorPools);
+    registerArray(vkSharedDescriptorSet);
+    registerArray(vkSharedDescriptorSetPool);
+    registerArray(sharedDescriptorSetUserCount);
   }
 
   // Description
-  _INTR_ARRAY(_INTR_ARRAY(BindingDescription)) bindingDescs;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(BindingDescription)) bindingDescs;
+  _INTR_PAGED_ARRAY(uint32_t) descPushConstantSizeInBytes;
+  _INTR_PAGED_ARRAY(uint32_t) descPushConstantStageFlags;
+  _INTR_PAGED_ARRAY(bool) descShareDescriptorSet;
 
   // Resources
-  _INTR_ARRAY(VkPipelineLayout) vkPipelineLayout;
-  _INTR_ARRAY(VkDescriptorSetLayout) vkDescriptorSetLayout;
-  _INTR_ARRAY(VkDescriptorPool) vkDescriptorPool;
+  _INTR_PAGED_ARRAY(VkPipelineLayout) vkPipelineLayout;
+  _INTR_PAGED_ARRAY(VkDescriptorSetLayout) vkDescriptorSetLayout;
+  // Descriptor sets are allocated from the current pool, new pools are added
+  // as soon as it is exhausted
+  _INTR_PAGED_ARRAY(VkDescriptorPool) vkDescriptorPool;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(VkDescriptorPool)) vkFullDescriptorPools;
+  _INTR_PAGED_ARRAY(VkDescriptorSet) vkSharedDescriptorSet;
+  _INTR_PAGED_ARRAY(VkDescriptorPool) vkSharedDescriptorSetPool;
+  _INTR_PAGED_ARRAY(uint32_t) sharedDescriptorSetUserCount;
 };
 
 struct PipelineLayoutManager
@@ -69,6 +84,9 @@ struct PipelineLayoutManager
   _INTR_INLINE static void resetToDefault(BufferRef p_Ref)
   {
     _descBindingDescs(p_Ref).clear();
+    _descPushConstantSizeInBytes(p_Ref) = 0u;
+    _descPushConstantStageFlags(p_Ref) = 0u;
+    _descShareDescriptorSet(p_Ref) = false;
   }
 
   _INTR_INLINE static void destroyPipelineLayout(PipelineLayoutRef p_Ref)
@@ -141,9 +159,20 @@ struct PipelineLayoutManager
     }
   }
 
+  // Returns the pool the set has been allocated from, which is required to
+  // free the set again
   static VkDescriptorSet
   allocateAndWriteDescriptorSet(PipelineLayoutRef p_Ref,
-                                const _INTR_ARRAY(BindingInfo) & p_BindInfos);
+                                const _INTR_ARRAY(BindingInfo) & p_BindInfos,
+                                VkDescriptorPool& p_DescriptorPool);
+
+  // Returns the descriptor set shared by all users of a layout with
+  // _descShareDescriptorSet enabled. The set is written using the bind infos of
+  // the first user and freed again when the last user releases it
+  static VkDescriptorSet
+  acquireSharedDescriptorSet(PipelineLayoutRef p_Ref,
+                             const _INTR_ARRAY(BindingInfo) & p_BindInfos);
+  static void releaseSharedDescriptorSet(PipelineLayoutRef p_Ref);
 
   // Description
   _INTR_INLINE static _INTR_ARRAY(BindingDescription) &
@@ -151,6 +180,21 @@ struct PipelineLayoutManager
   {
     return _data.bindingDescs[p_Ref._id];
   }
+  _INTR_INLINE static uint32_t&
+  _descPushConstantSizeInBytes(PipelineLayoutRef p_Ref)
+  {
+    return _data.descPushConstantSizeInBytes[p_Ref._id];
+  }
+  // Shader stages accessing the push constants as VkShaderStageFlags
+  _INTR_INLINE static uint32_t&
+  _descPushConstantStageFlags(PipelineLayoutRef p_Ref)
+  {
+    return _data.descPushConstantStageFlags[p_Ref._id];
+  }
+  _INTR_INLINE static bool& _descShareDescriptorSet(PipelineLayoutRef p_Ref)
+  {
+    return _data.descShareDescriptorSet[p_Ref._id];
+  }
 
   // Resources
   _INTR_INLINE static VkPipelineLayout&
@@ -168,6 +212,26 @@ struct PipelineLayoutManager
   {
     return _data.vkDescriptorPool[p_Ref._id];
   }
+  _INTR_INLINE static _INTR_ARRAY(VkDescriptorPool) &
+      _vkFullDescriptorPools(PipelineLayoutRef p_Ref)
+  {
+    return _data.vkFullDescriptorPools[p_Ref._id];
+  }
+  _INTR_INLINE static VkDescriptorSet&
+  _vkSharedDescriptorSet(PipelineLayoutRef p_Ref)
+  {
+    return _data.vkSharedDescriptorSet[p_Ref._id];
+  }
+  _INTR_INLINE static VkDescriptorPool&
+  _vkSharedDescriptorSetPool(PipelineLayoutRef p_Ref)
+  {
+    return _data.vkSharedDescriptorSetPool[p_Ref._id];
+  }
+  _INTR_INLINE static uint32_t&
+  _sharedDescriptorSetUserCount(PipelineLayoutRef p_Ref)
+  {
+    return _data.sharedDescriptorSetUserCount[p_Ref._id];
+  }
 };
 }
 }
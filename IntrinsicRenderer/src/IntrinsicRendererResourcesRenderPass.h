@@ -29,18 +29,17 @@ typedef _INTR_ARRAY(AttachmentDescription) AttachmentArray;
 struct RenderPassData : Dod::Resources::ResourceDataBase
 {
   RenderPassData()
-      : Dod::Resources::ResourceDataBase(_INTR_MAX_RENDER_PASS_COUNT)
   {
-    descAttachments.resize(_INTR_MAX_RENDER_PASS_COUNT);
+    registerArray(descAttachments);
 
-    vkRenderPass.resize(_INTR_MAX_RENDER_PASS_COUNT);
+    registerArray(vkRenderPass);
   }
 
   // Description
-  _INTR_ARRAY(_INTR_ARRAY(AttachmentDescription)) descAttachments;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(AttachmentDescription)) descAttachments;
 
   // Resources
-  _INTR_ARRAY(VkRenderPass) vkRenderPass;
+  _INTR_PAGED_ARRAY(VkRenderPass) vkRenderPass;
 };
 
 struct RenderPassManager
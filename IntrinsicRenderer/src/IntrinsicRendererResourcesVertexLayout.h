@@ -27,26 +27,25 @@ typedef Dod::RefArray VertexLayoutRefArray;
 struct VertexLayoutData : Dod::Resources::ResourceDataBase
 {
   VertexLayoutData()
-      : Dod::Resources::ResourceDataBase(_INTR_MAX_VERTEX_LAYOUT_COUNT)
   {
-    descVertexBindings.resize(_INTR_MAX_VERTEX_LAYOUT_COUNT);
-    descVertexAttributes.resize(_INTR_MAX_VERTEX_LAYOUT_COUNT);
+    registerArray(descVertexBindings);
+    registerArray(descVertexAttributes);
 
-    vkVertexInputBindingDescs.resize(_INTR_MAX_VERTEX_LAYOUT_COUNT);
-    vkVertexInputAttributeDescs.resize(_INTR_MAX_VERTEX_LAYOUT_COUNT);
-    vkPipelineVertexInputStateCreateInfo.resize(_INTR_MAX_VERTEX_LAYOUT_COUNT);
+    registerArray(vkVertexInputBindingDescs);
+    registerArray(vkVertexInputAttributeDescs);
+    registerArray(vkPipelineVertexInputStateCreateInfo);
   }
 
   // Description
-  _INTR_ARRAY(_INTR_ARRAY(VertexBinding)) descVertexBindings;
-  _INTR_ARRAY(_INTR_ARRAY(VertexAttribute)) descVertexAttributes;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(VertexBinding)) descVertexBindings;
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(VertexAttribute)) descVertexAttributes;
 
   // Resources
-  _INTR_ARRAY(_INTR_ARRAY(VkVertexInputBindingDescription))
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(VkVertexInputBindingDescription))
   vkVertexInputBindingDescs;
-  _INTR_ARRAY(_INTR_ARRAY(VkVertexInputAttributeDescription))
+  _INTR_PAGED_ARRAY(_INTR_ARRAY(VkVertexInputAttributeDescription))
   vkVertexInputAttributeDescs;
-  _INTR_ARRAY(VkPipelineVertexInputStateCreateInfo)
+  _INTR_PAGED_ARRAY(VkPipelineVertexInputStateCreateInfo)
   vkPipelineVertexInputStateCreateInfo;
 };
 
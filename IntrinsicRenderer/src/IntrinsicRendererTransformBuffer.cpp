@@ -0,0 +1,205 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Precompiled header file
+#include "stdafx.h"
+
+// Unchanged entries in between are uploaded as well if the gap is this small,
+// which keeps the number of copy regions low
+#define TRANSFORM_BUFFER_MAX_COALESCED_GAP 16u
+
+using namespace RResources;
+
+namespace Intrinsic
+{
+namespace Renderer
+{
+namespace
+{
+BufferRef _transformStagingBuffer;
+glm::mat4* _transformStagingBufferGpuMemory = nullptr;
+
+// Grows with the capacity of the Node storage
+uint32_t _maxNodeCount = _INTR_MAX_NODE_COMPONENT_COUNT;
+
+CComponents::NodeRefArray _changedNodes;
+_INTR_ARRAY(uint32_t) _changedNodeIds;
+_INTR_ARRAY(VkBufferCopy) _copyRegions;
+
+// <-
+
+void createBuffers()
+{
+  BufferManager::_descSizeInBytes(TransformBuffer::_transformBuffer) =
+      _maxNodeCount * sizeof(glm::mat4);
+  // Staging memory of the frames in flight is kept apart
+  BufferManager::_descSizeInBytes(_transformStagingBuffer) =
+      _maxNodeCount * _INTR_VK_PER_INSTANCE_DATA_BUFFER_COUNT *
+      sizeof(glm::mat4);
+  BufferManager::createResources(
+      {TransformBuffer::_transformBuffer, _transformStagingBuffer});
+
+  _transformStagingBufferGpuMemory =
+      (glm::mat4*)BufferManager::getGpuMemory(_transformStagingBuffer);
+}
+}
+
+// Static members
+BufferRef TransformBuffer::_transformBuffer;
+
+// <-
+
+void TransformBuffer::init()
+{
+  _INTR_LOG_INFO("Inititializing Transform Buffer...");
+
+  _transformBuffer = BufferManager::createBuffer(_N(TransformBuffer));
+  {
+    BufferManager::resetToDefault(_transformBuffer);
+    BufferManager::addResourceFlags(
+        _transformBuffer, Dod::Resources::ResourceFlags::kResourceVolatile);
+
+    BufferManager::_descBufferType(_transformBuffer) = BufferType::kStorage;
+  }
+
+  _transformStagingBuffer =
+      BufferManager::createBuffer(_N(_TransformStagingBuffer));
+  {
+    BufferManager::resetToDefault(_transformStagingBuffer);
+    BufferManager::addResourceFlags(
+        _transformStagingBuffer,
+        Dod::Resources::ResourceFlags::kResourceVolatile);
+
+    BufferManager::_descBufferType(_transformStagingBuffer) =
+        BufferType::kStorage;
+    BufferManager::_descMemoryPoolType(_transformStagingBuffer) =
+        MemoryPoolType::kStaticStagingBuffers;
+  }
+
+  _maxNodeCount = std::max(_maxNodeCount,
+                           CComponents::NodeManager::getCapacity());
+  createBuffers();
+
+  _changedNodes.reserve(_INTR_MAX_NODE_COMPONENT_COUNT);
+  _changedNodeIds.reserve(_INTR_MAX_NODE_COMPONENT_COUNT);
+}
+
+// <-
+
+void TransformBuffer::updateChangedTransforms()
+{
+  _INTR_PROFILE_CPU("General", "Update Changed Transforms");
+
+  CComponents::NodeManager::takeChangedTransforms(_changedNodes);
+  _changedNodeIds.clear();
+
+  // The buffers of the frames in flight are released once they are done. The
+  // new buffer is filled with the transforms of all Nodes
+  const uint32_t nodeCapacity = CComponents::NodeManager::getCapacity();
+  if (nodeCapacity > _maxNodeCount)
+  {
+    _maxNodeCount = std::max(nodeCapacity, _maxNodeCount * 2u);
+    _INTR_LOG_INFO("Growing transform buffer to %u nodes...", _maxNodeCount);
+
+    BufferManager::destroyResources(
+        {_transformBuffer, _transformStagingBuffer});
+    createBuffers();
+    DrawCallManager::updateBufferBindings(_transformBuffer);
+    ComputeCallManager::updateBufferBindings(_transformBuffer);
+
+    const CComponents::NodeRefArray& activeNodes =
+        CComponents::NodeManager::_activeRefs;
+    for (uint32_t i = 0u; i < activeNodes.size(); ++i)
+    {
+      _changedNodeIds.push_back(activeNodes[i]._id);
+    }
+  }
+  else
+  {
+    // The changed flag keeps the ids unique
+    for (uint32_t i = 0u; i < _changedNodes.size(); ++i)
+    {
+      if (CComponents::NodeManager::isAlive(_changedNodes[i]))
+      {
+        _changedNodeIds.push_back(_changedNodes[i]._id);
+      }
+    }
+  }
+
+  if (_changedNodeIds.empty())
+  {
+    return;
+  }
+
+  std::sort(_changedNodeIds.begin(), _changedNodeIds.end());
+
+  // Staging memory of the frames in flight is kept apart
+  uint32_t stagingIdx = (RenderSystem::_backbufferIndex %
+                         _INTR_VK_PER_INSTANCE_DATA_BUFFER_COUNT) *
+                        _maxNodeCount;
+
+  _copyRegions.clear();
+  for (uint32_t i = 0u; i < _changedNodeIds.size();)
+  {
+    const uint32_t firstNodeId = _changedNodeIds[i];
+    uint32_t lastNodeId = firstNodeId;
+
+    for (++i; i < _changedNodeIds.size() &&
+              _changedNodeIds[i] - lastNodeId <=
+                  TRANSFORM_BUFFER_MAX_COALESCED_GAP;
+         ++i)
+    {
+      lastNodeId = _changedNodeIds[i];
+    }
+
+    VkBufferCopy copyRegion = {};
+    {
+      copyRegion.srcOffset = stagingIdx * sizeof(glm::mat4);
+      copyRegion.dstOffset = firstNodeId * sizeof(glm::mat4);
+      copyRegion.size = (lastNodeId - firstNodeId + 1u) * sizeof(glm::mat4);
+    }
+    _copyRegions.push_back(copyRegion);
+
+    // Only the id is used to access the data of the Nodes in the gaps
+    for (uint32_t nodeId = firstNodeId; nodeId <= lastNodeId; ++nodeId)
+    {
+      _transformStagingBufferGpuMemory[stagingIdx++] =
+          CComponents::NodeManager::_worldMatrix(
+              CComponents::NodeRef(nodeId, 0u));
+    }
+  }
+
+  _INTR_PROFILE_COUNTER_SET("Transform Uploads", _changedNodeIds.size());
+  _INTR_PROFILE_COUNTER_SET("Transform Upload Regions", _copyRegions.size());
+
+  // Wait for the previous frames to finish reading the transforms
+  BufferManager::insertBufferMemoryBarrier(
+      _transformBuffer, VK_ACCESS_SHADER_READ_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+      VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+          VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+      VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+  vkCmdCopyBuffer(RenderSystem::getPrimaryCommandBuffer(),
+                  BufferManager::_vkBuffer(_transformStagingBuffer),
+                  BufferManager::_vkBuffer(_transformBuffer),
+                  (uint32_t)_copyRegions.size(), _copyRegions.data());
+
+  BufferManager::insertBufferMemoryBarrier(
+      _transformBuffer, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+      VK_PIPELINE_STAGE_TRANSFER_BIT,
+      VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+          VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+}
+}
+}
@@ -0,0 +1,40 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace Intrinsic
+{
+namespace Renderer
+{
+struct TransformBuffer
+{
+  static void init();
+
+  /**
+   * Uploads the world matrices of the Nodes whose transformation changed since
+   * the last call. Changed entries close to each other are coalesced into a
+   * single copy region. Records the copies to the primary command buffer and
+   * thus has to be called outside of a render pass.
+   *
+   * Grows the buffer if the Node storage grew and uploads all world matrices
+   * again. Has to be called before recording the draw calls of the frame.
+   */
+  static void updateChangedTransforms();
+
+  // Device local, holds the world matrix of each Node indexed by its id
+  static Resources::BufferRef _transformBuffer;
+};
+}
+}
@@ -28,6 +28,7 @@ BufferRef _perFrameUniformBuffer;
 
 uint8_t* UniformManager::_perInstanceMemory = nullptr;
 uint8_t* UniformManager::_perFrameMemory = nullptr;
+RenderProcess::PerFrustumData* UniformManager::_perFrustumMemory = nullptr;
 Memory::Tlsf::Allocator _perMaterialAllocator;
 
 Memory::LockFreeFixedBlockAllocator<
@@ -46,9 +47,41 @@ Memory::LockFreeFixedBlockAllocator<_INTR_VK_PER_MATERIAL_BLOCK_COUNT,
 
 BufferRef UniformManager::_perInstanceUniformBuffer;
 BufferRef UniformManager::_perFrameUniformBuffer;
+BufferRef UniformManager::_perFrustumBuffer;
+uint32_t UniformManager::_maxFrustumCountPerFrame =
+    _INTR_VK_INITIAL_FRUSTUMS_PER_FRAME_COUNT;
 BufferRef UniformManager::_perMaterialUniformBuffer;
 BufferRef UniformManager::_perMaterialStagingUniformBuffer;
 
+uint32_t UniformManager::_persistentRegionCount = 0u;
+uint32_t UniformManager::_persistentRegionOffset = (uint32_t)-1;
+std::atomic<uint32_t> UniformManager::_persistentBlockCount;
+std::atomic<bool> UniformManager::_persistentRegionExhausted;
+
+namespace
+{
+_INTR_INLINE uint32_t calcPersistentRegionSizeInBytes()
+{
+  return _INTR_VK_PER_INSTANCE_BLOCK_SMALL_SIZE_IN_BYTES *
+         _INTR_VK_PER_INSTANCE_PERSISTENT_BLOCK_COUNT;
+}
+
+// <-
+
+void createPerFrustumBuffer()
+{
+  BufferManager::_descSizeInBytes(UniformManager::_perFrustumBuffer) =
+      UniformManager::_maxFrustumCountPerFrame *
+      (uint32_t)RenderSystem::_vkSwapchainImages.size() *
+      sizeof(RenderProcess::PerFrustumData);
+  BufferManager::createResources({UniformManager::_perFrustumBuffer});
+
+  UniformManager::_perFrustumMemory =
+      (RenderProcess::PerFrustumData*)BufferManager::getGpuMemory(
+          UniformManager::_perFrustumBuffer);
+}
+}
+
 // <-
 
 void UniformManager::init()
@@ -58,6 +91,10 @@ void UniformManager::init()
 
   BufferRefArray buffersToCreate;
 
+  // The persistent regions are placed behind the per frame ones
+  _persistentRegionCount = (uint32_t)RenderSystem::_vkSwapchainImages.size() *
+                           _INTR_VK_PERSISTENT_SECONDARY_COMMAND_BUFFER_COUNT;
+
   _perInstanceUniformBuffer =
       BufferManager::createBuffer(_N(_PerInstanceConstantBuffer));
   {
@@ -71,7 +108,8 @@ void UniformManager::init()
     BufferManager::_descBufferType(_perInstanceUniformBuffer) =
         BufferType::kUniform;
     BufferManager::_descSizeInBytes(_perInstanceUniformBuffer) =
-        _INTR_VK_PER_INSTANCE_UNIFORM_MEMORY_IN_BYTES;
+        _INTR_VK_PER_INSTANCE_UNIFORM_MEMORY_IN_BYTES +
+        _persistentRegionCount * calcPersistentRegionSizeInBytes();
     buffersToCreate.push_back(_perInstanceUniformBuffer);
   }
 
@@ -129,6 +167,19 @@ void UniformManager::init()
 
   BufferManager::createResources(buffersToCreate);
 
+  // Per frustum data, grows with the number of active frustums
+  _perFrustumBuffer = BufferManager::createBuffer(_N(PerFrustumBuffer));
+  {
+    BufferManager::resetToDefault(_perFrustumBuffer);
+    BufferManager::addResourceFlags(
+        _perFrustumBuffer, Dod::Resources::ResourceFlags::kResourceVolatile);
+
+    BufferManager::_descMemoryPoolType(_perFrustumBuffer) =
+        MemoryPoolType::kStaticStagingBuffers;
+    BufferManager::_descBufferType(_perFrustumBuffer) = BufferType::kStorage;
+  }
+  createPerFrustumBuffer();
+
   // Get host memory
   _perInstanceMemory = BufferManager::getGpuMemory(_perInstanceUniformBuffer);
   _perFrameMemory = BufferManager::getGpuMemory(_perFrameUniformBuffer);
@@ -152,6 +203,10 @@ void UniformManager::init()
   _INTR_LOG_INFO(
       "Allocated %.2f MB of per instance uniform memory...",
       Math::bytesToMegaBytes(_INTR_VK_PER_INSTANCE_UNIFORM_MEMORY_IN_BYTES));
+  _INTR_LOG_INFO("Allocated %.2f MB of persistent per instance uniform "
+                 "memory...",
+                 Math::bytesToMegaBytes(_persistentRegionCount *
+                                        calcPersistentRegionSizeInBytes()));
 
   // ... and the per material ones
   {
@@ -174,5 +229,61 @@ void UniformManager::onFrameEnded()
   _perInstanceAllocatorSmall[bufferIdx].reset();
   _perInstanceAllocatorLarge[bufferIdx].reset();
 }
+
+// <-
+
+void UniformManager::reservePerFrustumDataMemory(uint32_t p_FrustumCount)
+{
+  if (p_FrustumCount <= _maxFrustumCountPerFrame)
+  {
+    return;
+  }
+
+  // The buffer of the frames in flight is released once they are done
+  _maxFrustumCountPerFrame =
+      std::max(p_FrustumCount, _maxFrustumCountPerFrame * 2u);
+  _INTR_LOG_INFO("Growing per frustum buffer to %u frustums per frame...",
+                 _maxFrustumCountPerFrame);
+
+  BufferManager::destroyResources({_perFrustumBuffer});
+  createPerFrustumBuffer();
+  DrawCallManager::updateBufferBindings(_perFrustumBuffer);
+}
+
+// <-
+
+void UniformManager::beginPersistentPerInstanceDataAllocation(
+    uint32_t p_RegionIdx)
+{
+  _INTR_ASSERT(_persistentRegionOffset == (uint32_t)-1 &&
+               "Persistent allocation already in progress");
+  _INTR_ASSERT(p_RegionIdx <
+               _INTR_VK_PERSISTENT_SECONDARY_COMMAND_BUFFER_COUNT);
+
+  _persistentBlockCount = 0u;
+  _persistentRegionExhausted = false;
+
+  const uint32_t regionIdx =
+      RenderSystem::_backbufferIndex *
+          _INTR_VK_PERSISTENT_SECONDARY_COMMAND_BUFFER_COUNT +
+      p_RegionIdx;
+  if (regionIdx >= _persistentRegionCount)
+  {
+    // The swapchain grew since the regions have been laid out
+    _persistentRegionExhausted = true;
+    return;
+  }
+
+  _persistentRegionOffset = _INTR_VK_PER_INSTANCE_UNIFORM_MEMORY_IN_BYTES +
+                            regionIdx * calcPersistentRegionSizeInBytes();
+}
+
+// <-
+
+bool UniformManager::endPersistentPerInstanceDataAllocation()
+{
+  _persistentRegionOffset = (uint32_t)-1;
+  return !_persistentRegionExhausted;
+}
 }
 }
@@ -25,9 +25,39 @@ struct UniformManager
   static void init();
   static void onFrameEnded();
 
+  /**
+   * Grows the per frustum buffer if the given number of frustums doesn't fit
+   * into the region of a single frame and updates the draw calls binding it.
+   * Has to be called before recording the draw calls of the current frame.
+   */
+  static void reservePerFrustumDataMemory(uint32_t p_FrustumCount);
+
+  _INTR_INLINE static uint32_t getFirstPerFrustumDataIdx()
+  {
+    return RenderSystem::_backbufferIndex * _maxFrustumCountPerFrame;
+  }
+
   _INTR_INLINE static uint8_t* allocatePerInstanceDataMemory(uint32_t p_Size,
                                                              uint32_t& p_Offset)
   {
+    if (_persistentRegionOffset != (uint32_t)-1)
+    {
+      const uint32_t blockIdx =
+          p_Size < _INTR_VK_PER_INSTANCE_BLOCK_SMALL_SIZE_IN_BYTES
+              ? _persistentBlockCount.fetch_add(1u)
+              : _INTR_VK_PER_INSTANCE_PERSISTENT_BLOCK_COUNT;
+
+      if (blockIdx < _INTR_VK_PER_INSTANCE_PERSISTENT_BLOCK_COUNT)
+      {
+        p_Offset = _persistentRegionOffset +
+                   blockIdx * _INTR_VK_PER_INSTANCE_BLOCK_SMALL_SIZE_IN_BYTES;
+        return _perInstanceMemory + p_Offset;
+      }
+
+      // Fall back to the per frame memory
+      _persistentRegionExhausted = true;
+    }
+
     const uint32_t bufferIdx = R::RenderSystem::_backbufferIndex %
                                _INTR_VK_PER_INSTANCE_DATA_BUFFER_COUNT;
 
@@ -36,13 +66,12 @@ struct UniformManager
     {
       block = _perInstanceAllocatorSmall[bufferIdx].allocate();
     }
-    else if (p_Size < _INTR_VK_PER_INSTANCE_BLOCK_LARGE_SIZE_IN_BYTES)
-    {
-      block = _perInstanceAllocatorLarge[bufferIdx].allocate();
-    }
     else
     {
-      _INTR_ASSERT(false);
+      _INTR_FATAL_CHECK(
+          p_Size < _INTR_VK_PER_INSTANCE_BLOCK_LARGE_SIZE_IN_BYTES,
+          "Per instance data exceeds the large block size");
+      block = _perInstanceAllocatorLarge[bufferIdx].allocate();
     }
 
     p_Offset = block.memoryOffset;
@@ -51,6 +80,21 @@ struct UniformManager
 
   // <-
 
+  /**
+   * Redirects all per instance data allocations to the persistent region with
+   * the given index of the current backbuffer. The memory of a region stays
+   * valid across frames until the region is allocated from again.
+   */
+  static void beginPersistentPerInstanceDataAllocation(uint32_t p_RegionIdx);
+
+  /**
+   * Returns false if the region ran out of memory and some of the allocations
+   * fell back to the per frame memory.
+   */
+  static bool endPersistentPerInstanceDataAllocation();
+
+  // <-
+
   _INTR_INLINE static uint32_t allocatePerMaterialDataMemory()
   {
     return _perMaterialAllocator.allocate().memoryOffset;
@@ -96,10 +140,14 @@ struct UniformManager
   // Static members
   static uint8_t* _perInstanceMemory;
   static uint8_t* _perFrameMemory;
+  static RenderProcess::PerFrustumData* _perFrustumMemory;
 
   static BufferRef _perInstanceUniformBuffer;
   static BufferRef _perMaterialUniformBuffer;
   static BufferRef _perFrameUniformBuffer;
+  // Storage buffer, holds one region per swapchain image
+  static BufferRef _perFrustumBuffer;
+  static uint32_t _maxFrustumCountPerFrame;
 
 private:
   static Memory::LockFreeFixedBlockAllocator<
@@ -116,6 +164,11 @@ private:
       _perMaterialAllocator;
 
   static BufferRef _perMaterialStagingUniformBuffer;
+
+  static uint32_t _persistentRegionCount;
+  static uint32_t _persistentRegionOffset;
+  static std::atomic<uint32_t> _persistentBlockCount;
+  static std::atomic<bool> _persistentRegionExhausted;
 };
 }
 }
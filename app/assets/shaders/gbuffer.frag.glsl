@@ -14,21 +14,40 @@
 
 #version 450
 
+/* __PREPROCESSOR DEFINES__ */
+
 #extension GL_ARB_separate_shader_objects : enable
 #extension GL_ARB_shading_language_420pack : enable
 #extension GL_GOOGLE_include_directive : enable
 
 #include "lib_math.glsl"
 #include "gbuffer.inc.glsl"
+#include "lib_buffers.glsl"
 
 // Ubos
-PER_MATERIAL_UBO;
 PER_INSTANCE_UBO;
 
 // Bindings
+#if defined(BINDLESS)
+PUSH_CONSTANTS_BINDLESS;
+layout(binding = 2) readonly MATERIAL_BUFFER;
+layout(set = 1, binding = 0) uniform sampler2D globalTextures[4095];
+
+#define ALBEDO_TEX globalTextures[PER_MATERIAL.textureIds.x]
+#define NORMAL_TEX globalTextures[PER_MATERIAL.textureIds.y]
+#define PBR_TEX globalTextures[PER_MATERIAL.textureIds.z]
+#define EMISSIVE_TEX globalTextures[PER_MATERIAL.textureIds.w]
+#else
+PER_MATERIAL_UBO;
 BINDINGS_GBUFFER;
 layout(binding = 6) uniform sampler2D emissiveTex;
 
+#define ALBEDO_TEX albedoTex
+#define NORMAL_TEX normalTex
+#define PBR_TEX pbrTex
+#define EMISSIVE_TEX emissiveTex
+#endif // BINDLESS
+
 // Input
 layout(location = 0) in vec3 inNormal;
 layout(location = 1) in vec3 inTangent;
@@ -36,6 +55,10 @@ layout(location = 2) in vec3 inBinormal;
 layout(location = 3) in vec3 inColor;
 layout(location = 4) in vec2 inUV0;
 
+#if defined(INSTANCED)
+INSTANCE_COLOR_TINT_INPUT;
+#endif // INSTANCED
+
 // Output
 OUTPUT
 
@@ -46,15 +69,15 @@ void main()
 
   GBuffer gbuffer;
   {
-    gbuffer.albedo = texture(albedoTex, uv0) * uboPerInstance.colorTint;
-    gbuffer.normal = normalize(TBN * textureNormal(normalTex, uv0));
-    const vec2 pbr = texture(pbrTex, uv0).rg;
-    gbuffer.metalMask = pbr.r + uboPerMaterial.pbrBias.r;
-    gbuffer.specular = 0.5 + uboPerMaterial.pbrBias.g;
-    gbuffer.roughness = adjustRoughness(pbr.g + uboPerMaterial.pbrBias.b,
-                                        uboPerMaterial.data1.x);
-    gbuffer.materialBufferIdx = uboPerMaterial.data0.x;
-    gbuffer.emissive = texture(emissiveTex, uv0).r;
+    gbuffer.albedo = texture(ALBEDO_TEX, uv0) * INSTANCE_COLOR_TINT;
+    gbuffer.normal = normalize(TBN * textureNormal(NORMAL_TEX, uv0));
+    const vec2 pbr = texture(PBR_TEX, uv0).rg;
+    gbuffer.metalMask = pbr.r + PER_MATERIAL.pbrBias.r;
+    gbuffer.specular = 0.5 + PER_MATERIAL.pbrBias.g;
+    gbuffer.roughness =
+        adjustRoughness(pbr.g + PER_MATERIAL.pbrBias.b, AVG_NORMAL_LENGTH);
+    gbuffer.materialBufferIdx = MATERIAL_BUFFER_IDX;
+    gbuffer.emissive = texture(EMISSIVE_TEX, uv0).r;
     gbuffer.occlusion = 1.0;
   }
   writeGBuffer(gbuffer, outAlbedo, outNormal, outParameter0);
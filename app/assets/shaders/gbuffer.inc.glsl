@@ -12,23 +12,35 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+// Bindless variants fetch the material parameters from the material buffer
+// using the entry passed as push constant
+#if defined(BINDLESS)
+#define PER_MATERIAL materialParameters[pushConstants.materialBufferIdx]
+#define MATERIAL_BUFFER_IDX pushConstants.materialBufferIdx
+#define AVG_NORMAL_LENGTH PER_MATERIAL.pbrBias.w
+#else
+#define PER_MATERIAL uboPerMaterial
+#define MATERIAL_BUFFER_IDX uboPerMaterial.data0.x
+#define AVG_NORMAL_LENGTH uboPerMaterial.data1.x
+#endif // BINDLESS
+
 #define UV0_TRANSFORM_ANIMATED(_uv0)                                           \
-  vec2(_uv0.x* uboPerMaterial.uvOffsetScale.z +                                \
-           uboPerMaterial.uvOffsetScale.x,                                     \
-       (1.0 - _uv0.y) * uboPerMaterial.uvOffsetScale.w +                       \
-           uboPerMaterial.uvOffsetScale.y) +                                   \
-      uboPerMaterial.uvAnimation.xy* vec2(uboPerInstance.data0.w)
+  vec2(_uv0.x* PER_MATERIAL.uvOffsetScale.z +                                  \
+           PER_MATERIAL.uvOffsetScale.x,                                       \
+       (1.0 - _uv0.y) * PER_MATERIAL.uvOffsetScale.w +                         \
+           PER_MATERIAL.uvOffsetScale.y) +                                     \
+      PER_MATERIAL.uvAnimation.xy* vec2(uboPerInstance.data0.w)
 #define UV0_TRANSFORM_ANIMATED_FACTOR(_uv0, _fact)                             \
-  vec2(_uv0.x* uboPerMaterial.uvOffsetScale.z +                                \
-           uboPerMaterial.uvOffsetScale.x,                                     \
-       (1.0 - _uv0.y) * uboPerMaterial.uvOffsetScale.w +                       \
-           uboPerMaterial.uvOffsetScale.y) +                                   \
-      _fact* uboPerMaterial.uvAnimation.xy* vec2(uboPerInstance.data0.w)
+  vec2(_uv0.x* PER_MATERIAL.uvOffsetScale.z +                                  \
+           PER_MATERIAL.uvOffsetScale.x,                                       \
+       (1.0 - _uv0.y) * PER_MATERIAL.uvOffsetScale.w +                         \
+           PER_MATERIAL.uvOffsetScale.y) +                                     \
+      _fact* PER_MATERIAL.uvAnimation.xy* vec2(uboPerInstance.data0.w)
 #define UV0_TRANSFORM(_uv0)                                                    \
-  vec2(_uv0.x* uboPerMaterial.uvOffsetScale.z +                                \
-           uboPerMaterial.uvOffsetScale.x,                                     \
-       (1.0 - _uv0.y) * uboPerMaterial.uvOffsetScale.w +                       \
-           uboPerMaterial.uvOffsetScale.y)
+  vec2(_uv0.x* PER_MATERIAL.uvOffsetScale.z +                                  \
+           PER_MATERIAL.uvOffsetScale.x,                                       \
+       (1.0 - _uv0.y) * PER_MATERIAL.uvOffsetScale.w +                         \
+           PER_MATERIAL.uvOffsetScale.y)
 #define UV0(_uv0) vec2(_uv0.x, (1.0 - _uv0.y))
 
 #define PER_INSTANCE_UBO                                                       \
@@ -42,6 +54,16 @@
   }                                                                            \
   uboPerInstance
 
+// Instanced variants receive the color tint of each instance from the vertex
+// shader
+#if defined(INSTANCED)
+#define INSTANCE_COLOR_TINT_INPUT                                              \
+  layout(location = 7) flat in vec4 inColorTint
+#define INSTANCE_COLOR_TINT inColorTint
+#else
+#define INSTANCE_COLOR_TINT uboPerInstance.colorTint
+#endif // INSTANCED
+
 #define PER_MATERIAL_UBO                                                       \
   layout(binding = 2) uniform PerMaterial                                      \
                                                                                \
@@ -55,6 +77,14 @@
   }                                                                            \
   uboPerMaterial
 
+#define PUSH_CONSTANTS_BINDLESS                                                \
+  layout(push_constant) uniform PushConstants                                  \
+                                                                               \
+  {                                                                            \
+    uint materialBufferIdx;                                                    \
+  }                                                                            \
+  pushConstants
+
 #define BINDINGS_GBUFFER                                                       \
   layout(binding = 3) uniform sampler2D albedoTex;                             \
                                                                                \
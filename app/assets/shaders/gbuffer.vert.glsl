@@ -14,6 +14,8 @@
 
 #version 450
 
+/* __PREPROCESSOR DEFINES__ */
+
 #extension GL_ARB_separate_shader_objects : enable
 #extension GL_ARB_shading_language_420pack : enable
 #extension GL_GOOGLE_include_directive : enable
@@ -23,6 +25,11 @@
 out gl_PerVertex { vec4 gl_Position; };
 
 PER_INSTANCE_UBO;
+PER_FRAME_AND_FRUSTUM_BUFFERS_VERTEX;
+TRANSFORM_BUFFER;
+#if defined(INSTANCED)
+MESH_INSTANCE_BUFFER;
+#endif // INSTANCED
 INPUT();
 
 layout(location = 0) out vec3 outNormal;
@@ -30,17 +37,22 @@ layout(location = 1) out vec3 outTangent;
 layout(location = 2) out vec3 outBinormal;
 layout(location = 3) out vec3 outColor;
 layout(location = 4) out vec2 outUV0;
+#if defined(INSTANCED)
+INSTANCE_COLOR_TINT_OUTPUT;
+#endif // INSTANCED
 
 void main()
 {
-  gl_Position = uboPerInstance.worldViewProjMatrix * vec4(inPosition.xyz, 1.0);
+  const mat4 worldViewMatrix = VIEW_MATRIX * INSTANCE_WORLD_MATRIX;
+  gl_Position =
+      VIEW_PROJ_MATRIX * (INSTANCE_WORLD_MATRIX * vec4(inPosition.xyz, 1.0));
 
   outColor = inColor.xyz;
-  outNormal =
-      normalize(uboPerInstance.worldViewMatrix * vec4(inNormal, 0.0)).xyz;
-  outTangent =
-      normalize(uboPerInstance.worldViewMatrix * vec4(inTangent, 0.0)).xyz;
-  outBinormal =
-      normalize(uboPerInstance.worldViewMatrix * vec4(inBinormal, 0.0)).xyz;
+  outNormal = normalize(worldViewMatrix * vec4(inNormal, 0.0)).xyz;
+  outTangent = normalize(worldViewMatrix * vec4(inTangent, 0.0)).xyz;
+  outBinormal = normalize(worldViewMatrix * vec4(inBinormal, 0.0)).xyz;
   outUV0 = inUV0;
+#if defined(INSTANCED)
+  outColorTint = meshInstances[gl_InstanceIndex].colorTint;
+#endif // INSTANCED
 }
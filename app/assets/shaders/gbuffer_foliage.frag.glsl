@@ -44,6 +44,10 @@ layout(location = 3) in vec3 inColor;
 layout(location = 4) in vec2 inUV0;
 layout(location = 5) in vec3 inWorldPosition;
 
+#if defined(INSTANCED)
+INSTANCE_COLOR_TINT_INPUT;
+#endif // INSTANCED
+
 // Output
 OUTPUT
 
@@ -79,7 +83,7 @@ void main()
 #if !defined(PRE_PASS)
   GBuffer gbuffer;
   {
-    gbuffer.albedo = albedo * uboPerInstance.colorTint;
+    gbuffer.albedo = albedo * INSTANCE_COLOR_TINT;
     gbuffer.normal = normalize(TBN * normal);
     gbuffer.metalMask = pbr.r + uboPerMaterial.pbrBias.r;
     gbuffer.specular = 0.5 + uboPerMaterial.pbrBias.g;
@@ -27,6 +27,11 @@ out gl_PerVertex { vec4 gl_Position; };
 
 // Ubos
 PER_INSTANCE_UBO;
+PER_FRAME_AND_FRUSTUM_BUFFERS_VERTEX;
+TRANSFORM_BUFFER;
+#if defined(INSTANCED)
+MESH_INSTANCE_BUFFER;
+#endif // INSTANCED
 
 // Input
 INPUT();
@@ -38,16 +43,18 @@ layout(location = 2) out vec3 outBinormal;
 layout(location = 3) out vec3 outColor;
 layout(location = 4) out vec2 outUV0;
 layout(location = 5) out vec3 outWorldPosition;
+#if defined(INSTANCED)
+INSTANCE_COLOR_TINT_OUTPUT;
+#endif // INSTANCED
 
 void main()
 {
   vec3 localPos = inPosition.xyz;
-  outWorldPosition =
-      (uboPerInstance.worldMatrix * vec4(inPosition.xyz, 1.0)).xyz;
+  outWorldPosition = (INSTANCE_WORLD_MATRIX * vec4(inPosition.xyz, 1.0)).xyz;
   const vec3 worldNormal =
-      normalize((uboPerInstance.worldMatrix * vec4(inNormal.xyz, 0.0)).xyz);
+      normalize((INSTANCE_WORLD_MATRIX * vec4(inNormal.xyz, 0.0)).xyz);
   const vec2 windStrength = calcWindStrength(uboPerInstance.data0.w);
-  const vec3 pivotWS = vec3(uboPerInstance.worldMatrix[3]);
+  const vec3 pivotWS = vec3(INSTANCE_WORLD_MATRIX[3]);
 
 #if defined(GRASS)
   applyGrassWind(localPos, outWorldPosition, uboPerInstance.data0.w,
@@ -57,14 +64,16 @@ void main()
                 uboPerInstance.data0.w, windStrength);
 #endif // GRASS
 
-  gl_Position = uboPerInstance.worldViewProjMatrix * vec4(localPos, 1.0);
+  const mat4 worldViewMatrix = VIEW_MATRIX * INSTANCE_WORLD_MATRIX;
+  gl_Position =
+      VIEW_PROJ_MATRIX * (INSTANCE_WORLD_MATRIX * vec4(localPos, 1.0));
 
   outColor = inColor.xyz;
-  outNormal =
-      normalize(uboPerInstance.worldViewMatrix * vec4(inNormal, 0.0)).xyz;
-  outTangent =
-      normalize(uboPerInstance.worldViewMatrix * vec4(inTangent, 0.0)).xyz;
-  outBinormal =
-      normalize(uboPerInstance.worldViewMatrix * vec4(inBinormal, 0.0)).xyz;
+  outNormal = normalize(worldViewMatrix * vec4(inNormal, 0.0)).xyz;
+  outTangent = normalize(worldViewMatrix * vec4(inTangent, 0.0)).xyz;
+  outBinormal = normalize(worldViewMatrix * vec4(inBinormal, 0.0)).xyz;
   outUV0 = inUV0;
+#if defined(INSTANCED)
+  outColorTint = meshInstances[gl_InstanceIndex].colorTint;
+#endif // INSTANCED
 }
@@ -23,6 +23,8 @@
 out gl_PerVertex { vec4 gl_Position; };
 
 PER_INSTANCE_UBO;
+PER_FRAME_AND_FRUSTUM_BUFFERS_VERTEX;
+TRANSFORM_BUFFER;
 INPUT();
 
 layout(location = 0) out vec3 outNormal;
@@ -33,14 +35,13 @@ layout(location = 4) out vec2 outUV0;
 
 void main()
 {
-  gl_Position = uboPerInstance.worldViewProjMatrix * vec4(inPosition.xyz, 1.0);
+  const mat4 worldViewMatrix = VIEW_MATRIX * INSTANCE_WORLD_MATRIX;
+  gl_Position =
+      VIEW_PROJ_MATRIX * (INSTANCE_WORLD_MATRIX * vec4(inPosition.xyz, 1.0));
 
   outColor = inColor.xyz;
-  outNormal =
-      normalize(uboPerInstance.worldViewMatrix * vec4(inNormal, 0.0)).xyz;
-  outTangent =
-      normalize(uboPerInstance.worldViewMatrix * vec4(inTangent, 0.0)).xyz;
-  outBinormal =
-      normalize(uboPerInstance.worldViewMatrix * vec4(inBinormal, 0.0)).xyz;
+  outNormal = normalize(worldViewMatrix * vec4(inNormal, 0.0)).xyz;
+  outTangent = normalize(worldViewMatrix * vec4(inTangent, 0.0)).xyz;
+  outBinormal = normalize(worldViewMatrix * vec4(inBinormal, 0.0)).xyz;
   outUV0 = inUV0;
 }
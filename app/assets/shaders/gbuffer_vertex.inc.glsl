@@ -2,15 +2,39 @@
   layout(binding = 0) uniform PerInstance                                      \
                                                                                \
   {                                                                            \
-    mat4 worldMatrix;                                                          \
-    mat4 worldViewProjMatrix;                                                  \
-    mat4 worldViewMatrix;                                                      \
-    mat4 viewProjMatrix;                                                       \
-    mat4 viewMatrix;                                                           \
     vec4 data0;                                                                \
   }                                                                            \
   uboPerInstance
 
+struct PerFrustum
+{
+  mat4 viewMatrix;
+  mat4 viewProjMatrix;
+};
+
+// The frustums of the current frame start at the index stored in the per frame
+// data and are indexed by the ids of the active frustums
+#define PER_FRAME_AND_FRUSTUM_BUFFERS_VERTEX                                   \
+  layout(std430, binding = 17) buffer readonly PerFrustumBuffer                \
+  {                                                                            \
+    PerFrustum perFrustum[];                                                   \
+  };                                                                           \
+                                                                               \
+  layout(binding = 15) uniform PerFrame                                        \
+                                                                               \
+  {                                                                            \
+    uvec4 data0;                                                               \
+  }                                                                            \
+  uboPerFrame
+
+// The view and projection matrices are shared by all instances rendered to the
+// same frustum
+#define FRUSTUM_IDX int(uboPerInstance.data0.x)
+#define NODE_IDX int(uboPerInstance.data0.z)
+#define PER_FRUSTUM perFrustum[int(uboPerFrame.data0.x) + FRUSTUM_IDX]
+#define VIEW_MATRIX PER_FRUSTUM.viewMatrix
+#define VIEW_PROJ_MATRIX PER_FRUSTUM.viewProjMatrix
+
 #define INPUT()                                                                \
   layout(location = 0) in vec3 inPosition;                                     \
                                                                                \
@@ -23,3 +47,33 @@
   layout(location = 4) in vec3 inBinormal;                                     \
                                                                                \
   layout(location = 5) in vec4 inColor
+
+struct MeshInstance
+{
+  uvec4 data; // x: node id
+  vec4 colorTint;
+};
+
+#define MESH_INSTANCE_BUFFER                                                   \
+  layout(std430, binding = 14) buffer readonly MeshInstanceBuffer              \
+  {                                                                            \
+    MeshInstance meshInstances[];                                              \
+  }
+
+// World matrices of all nodes, indexed by the node id
+#define TRANSFORM_BUFFER                                                       \
+  layout(std430, binding = 16) buffer readonly TransformBuffer                 \
+  {                                                                            \
+    mat4 transforms[];                                                         \
+  }
+
+// Instanced variants fetch their node ids using the instance index, which
+// includes the first instance of the draw
+#if defined(INSTANCED)
+#define INSTANCE_WORLD_MATRIX                                                  \
+  transforms[meshInstances[gl_InstanceIndex].data.x]
+#define INSTANCE_COLOR_TINT_OUTPUT                                             \
+  layout(location = 7) flat out vec4 outColorTint
+#else
+#define INSTANCE_WORLD_MATRIX transforms[NODE_IDX]
+#endif // INSTANCED
@@ -0,0 +1,115 @@
+// Copyright 2017 Benjamin Glatzel
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#version 450
+
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+#extension GL_GOOGLE_include_directive : enable
+
+#define GPU_CULLING_THREADS 64u
+
+struct CullingInstance
+{
+  vec4 aabbCenter;
+  vec4 aabbHalfExtent;
+  uvec4 drawData; // x: index count, y: mesh instance, z: draw count idx,
+                  // w: node id
+  uvec4 drawOffsets; // x: first index, y: vertex offset, z: first draw arg.
+};
+
+struct DrawArguments
+{
+  uint indexCount;
+  uint instanceCount;
+  uint firstIndex;
+  int vertexOffset;
+  uint firstInstance;
+};
+
+layout(binding = 0) uniform PerInstance
+{
+  uvec4 data; // x: first instance, y: instance count, z: compact draw args.
+  vec4 frustumPlanes[6];
+}
+uboPerInstance;
+
+layout(binding = 1) buffer CullingInstanceBuffer
+{
+  CullingInstance cullingInstances[];
+};
+layout(binding = 2) buffer DrawArgumentBuffer
+{
+  DrawArguments drawArguments[];
+};
+layout(binding = 3) buffer readonly TransformBuffer
+{
+  mat4 transforms[];
+};
+layout(binding = 4) buffer DrawCountBuffer
+{
+  uint drawCounts[];
+};
+
+layout(local_size_x = GPU_CULLING_THREADS, local_size_y = 1) in;
+void main()
+{
+  if (gl_GlobalInvocationID.x >= uboPerInstance.data.y)
+  {
+    return;
+  }
+
+  const uint instanceIdx = uboPerInstance.data.x + gl_GlobalInvocationID.x;
+  const CullingInstance instance = cullingInstances[instanceIdx];
+
+  // Transform the AABB to world space
+  const mat4 worldMatrix = transforms[instance.drawData.w];
+  const vec3 center = (worldMatrix * vec4(instance.aabbCenter.xyz, 1.0)).xyz;
+  const mat3 absWorldMatrix =
+      mat3(abs(worldMatrix[0].xyz), abs(worldMatrix[1].xyz),
+           abs(worldMatrix[2].xyz));
+  const vec3 halfExtent = absWorldMatrix * instance.aabbHalfExtent.xyz;
+
+  bool visible = true;
+  for (uint i = 0u; i < 6u; ++i)
+  {
+    const vec4 plane = uboPerInstance.frustumPlanes[i];
+
+    if (dot(plane.xyz, center) + plane.w < -dot(abs(plane.xyz), halfExtent))
+    {
+      visible = false;
+      break;
+    }
+  }
+
+  // Either append the visible draw arguments to the ones of the batch and
+  // count them or keep the culled ones with an instance count of zero
+  uint drawArgumentIdx = instanceIdx;
+  if (uboPerInstance.data.z != 0u)
+  {
+    if (!visible)
+    {
+      return;
+    }
+
+    drawArgumentIdx = instance.drawOffsets.z +
+                      atomicAdd(drawCounts[instance.drawData.z], 1u);
+  }
+
+  drawArguments[drawArgumentIdx].indexCount = instance.drawData.x;
+  drawArguments[drawArgumentIdx].instanceCount = visible ? 1u : 0u;
+  drawArguments[drawArgumentIdx].firstIndex = instance.drawOffsets.x;
+  drawArguments[drawArgumentIdx].vertexOffset = int(instance.drawOffsets.y);
+  drawArguments[drawArgumentIdx].firstInstance = instance.drawData.y;
+}
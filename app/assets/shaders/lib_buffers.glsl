@@ -18,6 +18,11 @@ struct MaterialParameters
   float translucencyThickness;
   float emissiveIntensity;
   uint materialFlags;
+
+  vec4 uvOffsetScale;
+  vec4 uvAnimation;
+  vec4 pbrBias;
+  uvec4 textureIds;
 };
 
 #define MATERIAL_BUFFER                                                        \
@@ -23,9 +23,12 @@
 out gl_PerVertex { vec4 gl_Position; };
 
 PER_INSTANCE_UBO;
+PER_FRAME_AND_FRUSTUM_BUFFERS_VERTEX;
+TRANSFORM_BUFFER;
 INPUT();
 
 void main()
 {
-  gl_Position = uboPerInstance.worldViewProjMatrix * vec4(inPosition.xyz, 1.0);
+  gl_Position =
+      VIEW_PROJ_MATRIX * (INSTANCE_WORLD_MATRIX * vec4(inPosition.xyz, 1.0));
 }
@@ -14,6 +14,8 @@
 
 #version 450
 
+/* __PREPROCESSOR DEFINES__ */
+
 #extension GL_ARB_separate_shader_objects : enable
 #extension GL_ARB_shading_language_420pack : enable
 #extension GL_GOOGLE_include_directive : enable
@@ -24,6 +26,11 @@ out gl_PerVertex { vec4 gl_Position; };
 
 // Ubos
 PER_INSTANCE_UBO;
+PER_FRAME_AND_FRUSTUM_BUFFERS_VERTEX;
+TRANSFORM_BUFFER;
+#if defined(INSTANCED)
+MESH_INSTANCE_BUFFER;
+#endif // INSTANCED
 
 // Input
 INPUT();
@@ -36,7 +43,7 @@ const float maxNormalLen = 200.0;
 void main()
 {
   const vec3 localPos = inPosition;
-  vec3 worldNormal = (uboPerInstance.worldMatrix * vec4(inNormal.xyz, 0.0)).xyz;
+  vec3 worldNormal = (INSTANCE_WORLD_MATRIX * vec4(inNormal.xyz, 0.0)).xyz;
 
   const float worldNormalLen = length(worldNormal);
   if (worldNormalLen > maxNormalLen)
@@ -45,8 +52,8 @@ void main()
   }
 
   const vec3 worldPos =
-      (uboPerInstance.worldMatrix * vec4(localPos.xyz, 1.0)).xyz -
+      (INSTANCE_WORLD_MATRIX * vec4(localPos.xyz, 1.0)).xyz -
       worldNormal * 0.07; // Shadow bias
-  gl_Position = uboPerInstance.viewProjMatrix * vec4(worldPos, 1.0);
+  gl_Position = VIEW_PROJ_MATRIX * vec4(worldPos, 1.0);
   outUV0 = inUV0;
 }
@@ -27,6 +27,11 @@ out gl_PerVertex { vec4 gl_Position; };
 
 // Ubos
 PER_INSTANCE_UBO;
+PER_FRAME_AND_FRUSTUM_BUFFERS_VERTEX;
+TRANSFORM_BUFFER;
+#if defined(INSTANCED)
+MESH_INSTANCE_BUFFER;
+#endif // INSTANCED
 
 // Input
 INPUT();
@@ -38,12 +43,12 @@ void main()
 {
   vec3 localPos = inPosition;
   const vec3 initialWorldPos =
-      (uboPerInstance.worldMatrix * vec4(inPosition.xyz, 1.0)).xyz;
+      (INSTANCE_WORLD_MATRIX * vec4(inPosition.xyz, 1.0)).xyz;
   const vec3 worldNormalUnorm =
-      (uboPerInstance.worldMatrix * vec4(inNormal.xyz, 0.0)).xyz;
+      (INSTANCE_WORLD_MATRIX * vec4(inNormal.xyz, 0.0)).xyz;
   const vec3 worldNormal = normalize(worldNormalUnorm);
   const vec2 windStrength = calcWindStrength(uboPerInstance.data0.w);
-  const vec3 pivotWS = vec3(uboPerInstance.worldMatrix[3]);
+  const vec3 pivotWS = vec3(INSTANCE_WORLD_MATRIX[3]);
 
 #if defined(GRASS)
   applyGrassWind(localPos, initialWorldPos, uboPerInstance.data0.w,
@@ -54,9 +59,9 @@ void main()
 #endif // GRASS
 
   const vec3 worldPos =
-      (uboPerInstance.worldMatrix * vec4(localPos.xyz, 1.0)).xyz -
+      (INSTANCE_WORLD_MATRIX * vec4(localPos.xyz, 1.0)).xyz -
       worldNormalUnorm.xyz * 0.03; // Shadow bias
-  gl_Position = uboPerInstance.viewProjMatrix * vec4(worldPos, 1.0);
+  gl_Position = VIEW_PROJ_MATRIX * vec4(worldPos, 1.0);
 
   outUV0 = inUV0;
 }
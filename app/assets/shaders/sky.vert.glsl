@@ -24,6 +24,8 @@ out gl_PerVertex { vec4 gl_Position; };
 
 // Ubos
 PER_INSTANCE_UBO;
+PER_FRAME_AND_FRUSTUM_BUFFERS_VERTEX;
+TRANSFORM_BUFFER;
 
 // Input
 INPUT();
@@ -36,9 +38,10 @@ layout(location = 3) out vec3 outUpVS;
 
 void main()
 {
-  gl_Position = uboPerInstance.worldViewProjMatrix * vec4(inPosition.xyz, 1.0);
-  outUpVS = (uboPerInstance.viewMatrix * vec4(vec3(0.0, 1.0, 0.0), 0.0)).xyz;
-  outPosVS = (uboPerInstance.worldViewMatrix * vec4(inPosition.xyz, 1.0)).xyz;
+  const vec4 worldPos = INSTANCE_WORLD_MATRIX * vec4(inPosition.xyz, 1.0);
+  gl_Position = VIEW_PROJ_MATRIX * worldPos;
+  outUpVS = (VIEW_MATRIX * vec4(vec3(0.0, 1.0, 0.0), 0.0)).xyz;
+  outPosVS = (VIEW_MATRIX * worldPos).xyz;
   outUV0 = inUV0;
   outNormal = inNormal;
 }
@@ -4,8 +4,6 @@ function tick(p_EntityRef, p_DeltaT)
   local rotation = Quat.new(Vec3.new(0.0, p_DeltaT * 0.5, 0.0))
   local orientation = nodeComponent.getOrientation(nodeRef);
   nodeComponent.setOrientation(nodeRef, glm.rotate(rotation, orientation))
-
-  nodeComponent.updateTransforms(nodeRef)
 end
 
 function onCreate(p_EntityRef, p_DeltaT)